@@ -0,0 +1,34 @@
+QT += core gui widgets opengl xml concurrent network
+
+TARGET = YUViewBenchmark
+TEMPLATE = app
+CONFIG += console
+CONFIG += c++17
+CONFIG -= app_bundle
+CONFIG -= debug_and_release
+
+SOURCES += $$files(src/*.cpp, false)
+HEADERS += $$files(src/*.h, false)
+
+INCLUDEPATH += $$top_srcdir/YUViewLib/src
+LIBS += -L$$top_builddir/YUViewLib -lYUViewLib
+
+win32-msvc* {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/YUViewLib.lib
+} else {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/libYUViewLib.a
+}
+
+linux|macx {
+    SVNN = $$system("git describe --tags")
+}
+win32 {
+    SVNN = $$system("git describe --tags")
+    DEFINES += NOMINMAX
+}
+
+isEmpty(SVNN) {
+    SVNN = 0
+}
+VERSTR = '\\"$${SVNN}\\"'
+DEFINES += YUVIEW_VERSION=$${VERSTR}
@@ -0,0 +1,164 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+
+#include <QJsonObject>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace benchmark
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double measureSeconds(const std::function<void()> &function, int64_t nrIterations)
+{
+  const auto start = Clock::now();
+  for (int64_t i = 0; i < nrIterations; i++)
+    function();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+std::string formatDuration(double seconds)
+{
+  std::ostringstream stream;
+  stream << std::fixed << std::setprecision(3);
+  if (seconds >= 1.0)
+    stream << seconds << " s";
+  else if (seconds >= 1e-3)
+    stream << seconds * 1e3 << " ms";
+  else
+    stream << seconds * 1e6 << " us";
+  return stream.str();
+}
+
+} // namespace
+
+double Result::getMinSeconds() const
+{
+  if (this->secondsPerIteration.empty())
+    return 0.0;
+  return *std::min_element(this->secondsPerIteration.begin(), this->secondsPerIteration.end());
+}
+
+double Result::getMedianSeconds() const
+{
+  if (this->secondsPerIteration.empty())
+    return 0.0;
+  auto sorted = this->secondsPerIteration;
+  std::sort(sorted.begin(), sorted.end());
+  return sorted[sorted.size() / 2];
+}
+
+Result runBenchmark(const Benchmark &benchmark, const Options &options)
+{
+  Result result;
+  result.name       = benchmark.name;
+  result.throughput = benchmark.throughput;
+
+  const auto function = benchmark.setup();
+
+  // Warm up (caches, lazy initialization) and find the number of calls that take long enough to be
+  // measured reliably.
+  int64_t nrIterations = 1;
+  while (true)
+  {
+    const auto seconds = measureSeconds(function, nrIterations);
+    if (seconds >= options.minSecondsPerRepetition)
+      break;
+    const auto factor = (seconds > 0.0) ? options.minSecondsPerRepetition / seconds * 1.2 : 10.0;
+    nrIterations      = std::max(nrIterations + 1, int64_t(nrIterations * std::min(factor, 10.0)));
+  }
+  result.iterationsPerRepetition = nrIterations;
+
+  for (int i = 0; i < options.nrRepetitions; i++)
+    result.secondsPerIteration.push_back(measureSeconds(function, nrIterations) / nrIterations);
+
+  return result;
+}
+
+QJsonArray resultsToJson(const std::vector<Result> &results)
+{
+  QJsonArray array;
+  for (const auto &result : results)
+  {
+    QJsonArray secondsPerIteration;
+    for (const auto seconds : result.secondsPerIteration)
+      secondsPerIteration.append(seconds);
+
+    QJsonObject object;
+    object["name"]                    = QString::fromStdString(result.name);
+    object["iterationsPerRepetition"] = double(result.iterationsPerRepetition);
+    object["secondsPerIteration"]     = secondsPerIteration;
+    object["minSeconds"]              = result.getMinSeconds();
+    object["medianSeconds"]           = result.getMedianSeconds();
+    if (result.throughput.bytes > 0)
+      object["bytesPerSecond"] = double(result.throughput.bytes) / result.getMedianSeconds();
+    if (result.throughput.items > 0)
+      object["itemsPerSecond"] = double(result.throughput.items) / result.getMedianSeconds();
+    array.append(object);
+  }
+  return array;
+}
+
+std::string formatHeader()
+{
+  std::ostringstream stream;
+  stream << std::left << std::setw(56) << "Benchmark" << std::right << std::setw(14) << "Median"
+         << std::setw(14) << "Min" << std::setw(19) << "Throughput";
+  return stream.str();
+}
+
+std::string formatResult(const Result &result)
+{
+  std::ostringstream stream;
+  stream << std::left << std::setw(56) << result.name << std::right << std::setw(14)
+         << formatDuration(result.getMedianSeconds()) << std::setw(14)
+         << formatDuration(result.getMinSeconds());
+  stream << std::fixed << std::setprecision(1);
+  if (result.throughput.bytes > 0)
+    stream << std::setw(14)
+           << double(result.throughput.bytes) / result.getMedianSeconds() / 1e6 << " MB/s";
+  if (result.throughput.items > 0)
+    stream << std::setw(14)
+           << double(result.throughput.items) / result.getMedianSeconds() / 1e6 << " M/s";
+  return stream.str();
+}
+
+} // namespace benchmark
@@ -0,0 +1,89 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QJsonArray>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+
+// The amount of work that one call of a benchmark function does. Used to calculate the throughput.
+struct Throughput
+{
+  int64_t bytes{};
+  int64_t items{};
+};
+
+/* A benchmark prepares its (synthetic) input data in the setup function and returns the function
+ * that is measured. The function is called repeatedly and must do the same work in every call.
+ * The setup is not measured.
+ */
+struct Benchmark
+{
+  std::string                            name;
+  Throughput                             throughput;
+  std::function<std::function<void()>()> setup;
+};
+using BenchmarkList = std::vector<Benchmark>;
+
+struct Options
+{
+  // Every repetition calls the function until at least this much time passed
+  double minSecondsPerRepetition{0.2};
+  int    nrRepetitions{5};
+};
+
+struct Result
+{
+  std::string name;
+  Throughput  throughput;
+  int64_t     iterationsPerRepetition{};
+  // The mean time of one call of the function in every repetition
+  std::vector<double> secondsPerIteration;
+
+  double getMinSeconds() const;
+  double getMedianSeconds() const;
+};
+
+Result runBenchmark(const Benchmark &benchmark, const Options &options);
+
+QJsonArray  resultsToJson(const std::vector<Result> &results);
+std::string formatHeader();
+std::string formatResult(const Result &result);
+
+} // namespace benchmark
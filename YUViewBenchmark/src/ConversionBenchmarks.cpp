@@ -0,0 +1,207 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmarks.h"
+
+#include "SyntheticData.h"
+
+#include <video/rgb/ConversionRGB.h>
+#include <video/yuv/ConversionYUVSIMD.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <memory>
+#include <vector>
+
+namespace benchmark
+{
+
+namespace
+{
+
+using video::yuv::PackingOrder;
+using video::yuv::PixelFormatYUV;
+using video::yuv::Subsampling;
+
+constexpr auto FRAME_SIZE = Size(1920, 1080);
+
+// Gives access to the conversion of a raw frame to an image. This is exactly the conversion that
+// is done when a frame is drawn (or cached).
+class BenchmarkVideoHandlerYUV : public video::yuv::videoHandlerYUV
+{
+public:
+  using videoHandlerYUV::convertCachedRawFrame;
+};
+
+void addYUVConversionBenchmarks(BenchmarkList &benchmarks)
+{
+  const std::vector<PixelFormatYUV> pixelFormats = {
+      PixelFormatYUV(Subsampling::YUV_420, 8),
+      PixelFormatYUV(Subsampling::YUV_420, 10),
+      PixelFormatYUV(Subsampling::YUV_422, 8),
+      PixelFormatYUV(Subsampling::YUV_422, 10),
+      PixelFormatYUV(Subsampling::YUV_444, 8),
+      PixelFormatYUV(Subsampling::YUV_444, 10),
+      PixelFormatYUV(Subsampling::YUV_400, 8),
+      PixelFormatYUV(Subsampling::YUV_422, 8, PackingOrder::UYVY)};
+
+  for (const auto &pixelFormat : pixelFormats)
+  {
+    Benchmark benchmark;
+    benchmark.name             = "Conversion/YUV/" + pixelFormat.getName();
+    benchmark.throughput.bytes = pixelFormat.bytesPerFrame(FRAME_SIZE);
+    benchmark.throughput.items = int64_t(FRAME_SIZE.width) * FRAME_SIZE.height;
+    benchmark.setup            = [pixelFormat]() -> std::function<void()> {
+      auto handler = std::make_shared<BenchmarkVideoHandlerYUV>();
+      handler->setFrameSize(FRAME_SIZE);
+      handler->setPixelFormatYUV(pixelFormat);
+      const auto rawFrame = synthetic::createYUVFrame(pixelFormat, FRAME_SIZE);
+      return [handler, rawFrame]() { handler->convertCachedRawFrame(rawFrame); };
+    };
+    benchmarks.push_back(benchmark);
+  }
+}
+
+template <typename T>
+Benchmark createSIMDLineBenchmark(video::yuv::simd::InstructionSet instructionSet,
+                                  int                              bitDepth,
+                                  int                              chromaSubsamplingHor)
+{
+  using namespace video::yuv::simd;
+
+  const auto width = int(FRAME_SIZE.width);
+
+  Benchmark benchmark;
+  benchmark.name = "Conversion/YUVLine/" + std::string(getInstructionSetName(instructionSet)) +
+                   "/" + std::to_string(bitDepth) + "bit/" +
+                   (chromaSubsamplingHor == 2 ? "422" : "444");
+  benchmark.throughput.items = width;
+  benchmark.setup            = [=]() -> std::function<void()> {
+    int coefficients[5];
+    video::yuv::getColorConversionCoefficients(video::yuv::ColorConversion::BT709_LimitedRange,
+                                               coefficients);
+    const auto parameters = getConversionParameters(
+        {coefficients[0], coefficients[1], coefficients[2], coefficients[3], coefficients[4]},
+        bitDepth,
+        false);
+
+    // One line of each of the three planes
+    const auto format = PixelFormatYUV(Subsampling::YUV_444, unsigned(bitDepth));
+    const auto planes = synthetic::createYUVFrame(format, Size(unsigned(width), 1));
+    auto       dst    = std::make_shared<std::vector<uint8_t>>(size_t(width) * 4);
+
+    return [=]() {
+      const auto src = reinterpret_cast<const T *>(planes.constData());
+      convertLineToBGRA(instructionSet,
+                        src,
+                        src + width,
+                        src + 2 * width,
+                        dst->data(),
+                        width,
+                        chromaSubsamplingHor,
+                        parameters);
+    };
+  };
+  return benchmark;
+}
+
+void addSIMDLineBenchmarks(BenchmarkList &benchmarks)
+{
+  using video::yuv::simd::InstructionSet;
+
+  for (const auto instructionSet :
+       {InstructionSet::Scalar, InstructionSet::SSE4_1, InstructionSet::AVX2})
+  {
+    if (!video::yuv::simd::isInstructionSetSupported(instructionSet))
+      continue;
+    for (const auto chromaSubsamplingHor : {1, 2})
+    {
+      benchmarks.push_back(
+          createSIMDLineBenchmark<uint8_t>(instructionSet, 8, chromaSubsamplingHor));
+      benchmarks.push_back(
+          createSIMDLineBenchmark<uint16_t>(instructionSet, 10, chromaSubsamplingHor));
+    }
+  }
+}
+
+void addRGBConversionBenchmarks(BenchmarkList &benchmarks)
+{
+  using video::DataLayout;
+  using video::Endianness;
+  using video::rgb::AlphaMode;
+  using video::rgb::ChannelOrder;
+  using video::rgb::PixelFormatRGB;
+
+  const std::vector<PixelFormatRGB> pixelFormats = {
+      PixelFormatRGB(8, DataLayout::Packed, ChannelOrder::RGB),
+      PixelFormatRGB(8, DataLayout::Packed, ChannelOrder::BGR, AlphaMode::Last),
+      PixelFormatRGB(8, DataLayout::Planar, ChannelOrder::RGB),
+      PixelFormatRGB(10, DataLayout::Packed, ChannelOrder::RGB),
+      PixelFormatRGB(16, DataLayout::Planar, ChannelOrder::GBR, AlphaMode::None, Endianness::Big)};
+
+  for (const auto &pixelFormat : pixelFormats)
+  {
+    Benchmark benchmark;
+    benchmark.name             = "Conversion/RGB/" + pixelFormat.getName();
+    benchmark.throughput.bytes = int64_t(pixelFormat.bytesPerFrame(FRAME_SIZE));
+    benchmark.throughput.items = int64_t(FRAME_SIZE.width) * FRAME_SIZE.height;
+    benchmark.setup            = [pixelFormat]() -> std::function<void()> {
+      const auto rawFrame   = synthetic::createRGBFrame(pixelFormat, FRAME_SIZE);
+      const auto targetSize = size_t(FRAME_SIZE.width) * FRAME_SIZE.height * 4;
+      auto       target     = std::make_shared<std::vector<unsigned char>>(targetSize);
+      return [pixelFormat, rawFrame, target]() {
+        const bool componentInvert[4] = {false, false, false, false};
+        const int  componentScale[4]  = {1, 1, 1, 1};
+        video::rgb::convertInputRGBToARGB(rawFrame,
+                                          pixelFormat,
+                                          target->data(),
+                                          FRAME_SIZE,
+                                          componentInvert,
+                                          componentScale,
+                                          false,
+                                          true,
+                                          false);
+      };
+    };
+    benchmarks.push_back(benchmark);
+  }
+}
+
+} // namespace
+
+void addConversionBenchmarks(BenchmarkList &benchmarks)
+{
+  addYUVConversionBenchmarks(benchmarks);
+  addSIMDLineBenchmarks(benchmarks);
+  addRGBConversionBenchmarks(benchmarks);
+}
+
+} // namespace benchmark
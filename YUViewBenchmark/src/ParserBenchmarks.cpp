@@ -0,0 +1,191 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmarks.h"
+
+#include "SyntheticData.h"
+
+#include <filesource/FileSourceAnnexBFile.h>
+#include <filesource/StartCodeSearch.h>
+#include <parser/common/SubByteReaderLogging.h>
+#include <video/yuv/ConversionYUVSIMD.h>
+
+#include <QTemporaryDir>
+
+#include <memory>
+#include <stdexcept>
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr auto NR_EXP_GOLOMB_VALUES = size_t(100000);
+constexpr auto ANNEX_B_STREAM_SIZE  = size_t(16 * 1024 * 1024);
+
+// The plain reader only offers the reading functions to the derived classes
+class BenchmarkSubByteReader : public parser::SubByteReader
+{
+public:
+  using SubByteReader::readBits;
+  using SubByteReader::readUE_V;
+  using SubByteReader::SubByteReader;
+};
+
+void addSubByteReaderBenchmarks(BenchmarkList &benchmarks)
+{
+  const auto createData = []() {
+    return std::make_shared<ByteVector>(
+        synthetic::createExpGolombCodedValues(NR_EXP_GOLOMB_VALUES, 1024));
+  };
+
+  Benchmark readBits;
+  readBits.name             = "Parser/SubByteReader/readBits";
+  readBits.throughput.items = NR_EXP_GOLOMB_VALUES;
+  readBits.setup            = [createData]() -> std::function<void()> {
+    const auto data = createData();
+    return [data]() {
+      BenchmarkSubByteReader reader(*data);
+      for (size_t i = 0; i < NR_EXP_GOLOMB_VALUES; i++)
+        reader.readBits(7);
+    };
+  };
+  benchmarks.push_back(readBits);
+
+  Benchmark readUEV;
+  readUEV.name             = "Parser/SubByteReader/readUE_V";
+  readUEV.throughput.items = NR_EXP_GOLOMB_VALUES;
+  readUEV.setup            = [createData]() -> std::function<void()> {
+    const auto data = createData();
+    return [data]() {
+      BenchmarkSubByteReader reader(*data);
+      for (size_t i = 0; i < NR_EXP_GOLOMB_VALUES; i++)
+        reader.readUE_V();
+    };
+  };
+  benchmarks.push_back(readUEV);
+
+  // With a tree item, every value is also logged to a new child item (like when the packet tree of
+  // a bitstream is shown).
+  for (const auto logToTree : {false, true})
+  {
+    Benchmark readUEVLogging;
+    readUEVLogging.name = std::string("Parser/SubByteReaderLogging/readUEV/") +
+                          (logToTree ? "TreeItem" : "NoTreeItem");
+    readUEVLogging.throughput.items = NR_EXP_GOLOMB_VALUES;
+    readUEVLogging.setup            = [createData, logToTree]() -> std::function<void()> {
+      const auto data = createData();
+      return [data, logToTree]() {
+        const auto root = logToTree ? TreeItem::createRootItem() : std::shared_ptr<TreeItem>();
+        parser::reader::SubByteReaderLogging reader(*data, root, "values");
+        for (size_t i = 0; i < NR_EXP_GOLOMB_VALUES; i++)
+          reader.readUEV("value");
+      };
+    };
+    benchmarks.push_back(readUEVLogging);
+  }
+}
+
+void addStartCodeSearchBenchmarks(BenchmarkList &benchmarks)
+{
+  using video::yuv::simd::InstructionSet;
+
+  for (const auto instructionSet :
+       {InstructionSet::Scalar, InstructionSet::SSE4_1, InstructionSet::AVX2})
+  {
+    if (!video::yuv::simd::isInstructionSetSupported(instructionSet))
+      continue;
+
+    Benchmark benchmark;
+    benchmark.name = "Parser/StartCodeSearch/" +
+                     std::string(video::yuv::simd::getInstructionSetName(instructionSet));
+    benchmark.throughput.bytes = ANNEX_B_STREAM_SIZE;
+    benchmark.setup            = [instructionSet]() -> std::function<void()> {
+      size_t     nrNalUnits;
+      const auto data = std::make_shared<ByteVector>(
+          synthetic::createAnnexBStream(ANNEX_B_STREAM_SIZE, nrNalUnits));
+      return [data, instructionSet]() {
+        size_t pos = 0;
+        while (pos < data->size())
+          pos += filesource::findNextStartCode(
+                     instructionSet, data->data() + pos, data->size() - pos) +
+                 3;
+      };
+    };
+    benchmarks.push_back(benchmark);
+  }
+}
+
+void addAnnexBFileBenchmarks(BenchmarkList &benchmarks)
+{
+  for (const auto useFileMapping : {true, false})
+  {
+    Benchmark benchmark;
+    benchmark.name = std::string("Parser/AnnexBFile/getNextNALUnit/") +
+                     (useFileMapping ? "Mapped" : "Read");
+    benchmark.throughput.bytes = ANNEX_B_STREAM_SIZE;
+    benchmark.setup            = [useFileMapping]() -> std::function<void()> {
+      auto temporaryDir = std::make_shared<QTemporaryDir>();
+      if (!temporaryDir->isValid())
+        throw std::runtime_error("Error creating temporary directory");
+
+      size_t     nrNalUnits;
+      const auto data     = synthetic::createAnnexBStream(ANNEX_B_STREAM_SIZE, nrNalUnits);
+      const auto filePath = synthetic::writeFile(
+          *temporaryDir,
+          "stream.h264",
+          QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size())));
+
+      return [temporaryDir, filePath, useFileMapping]() {
+        FileSourceAnnexBFile annexBFile;
+        annexBFile.setUseFileMapping(useFileMapping);
+        if (!annexBFile.openFile(filePath.toStdString()))
+          throw std::runtime_error("Error opening the Annex B stream");
+        while (!annexBFile.atEnd())
+          annexBFile.getNextNALUnit();
+      };
+    };
+    benchmarks.push_back(benchmark);
+  }
+}
+
+} // namespace
+
+void addParserBenchmarks(BenchmarkList &benchmarks)
+{
+  addSubByteReaderBenchmarks(benchmarks);
+  addStartCodeSearchBenchmarks(benchmarks);
+  addAnnexBFileBenchmarks(benchmarks);
+}
+
+} // namespace benchmark
@@ -0,0 +1,203 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmarks.h"
+
+#include "SyntheticData.h"
+
+#include <statistics/StatisticsDataPainting.h>
+#include <statistics/StatisticsFileCSV.h>
+#include <statistics/StatisticsFileVTMBMS.h>
+
+#include <QImage>
+#include <QPainter>
+#include <QTemporaryDir>
+
+#include <memory>
+#include <stdexcept>
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr auto FRAME_SIZE = Size(1920, 1080);
+constexpr auto NR_FRAMES  = 8;
+constexpr auto BLOCK_SIZE = 16u;
+
+constexpr auto NR_BLOCKS_PER_FRAME = int64_t((FRAME_SIZE.width + BLOCK_SIZE - 1) / BLOCK_SIZE) *
+                                     ((FRAME_SIZE.height + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+enum class FileFormat
+{
+  CSV,
+  VTMBMS
+};
+
+// The statistics file together with the temporary directory that it is written to
+struct StatisticsFile
+{
+  std::shared_ptr<QTemporaryDir> directory;
+  QString                        filePath;
+};
+
+std::string createStatisticsFileData(FileFormat fileFormat)
+{
+  if (fileFormat == FileFormat::CSV)
+    return synthetic::createStatisticsFileCSV(FRAME_SIZE, NR_FRAMES, BLOCK_SIZE);
+  return synthetic::createStatisticsFileVTMBMS(FRAME_SIZE, NR_FRAMES, BLOCK_SIZE);
+}
+
+StatisticsFile writeStatisticsFile(FileFormat fileFormat)
+{
+  StatisticsFile file;
+  file.directory = std::make_shared<QTemporaryDir>();
+  if (!file.directory->isValid())
+    throw std::runtime_error("Error creating temporary directory");
+
+  const auto data     = createStatisticsFileData(fileFormat);
+  const auto fileName = (fileFormat == FileFormat::CSV) ? "stats.csv" : "stats.vtmbms";
+  file.filePath = synthetic::writeFile(*file.directory, fileName, QByteArray::fromStdString(data));
+  return file;
+}
+
+std::unique_ptr<stats::StatisticsFileBase> openStatisticsFile(FileFormat             fileFormat,
+                                                             const QString         &filePath,
+                                                             stats::StatisticsData &statisticsData)
+{
+  if (fileFormat == FileFormat::CSV)
+    return std::make_unique<stats::StatisticsFileCSV>(filePath, statisticsData);
+  return std::make_unique<stats::StatisticsFileVTMBMS>(filePath, statisticsData);
+}
+
+// Open and index the file. This is what happens when a statistics file is loaded.
+std::unique_ptr<stats::StatisticsFileBase> openAndIndexStatisticsFile(
+    FileFormat fileFormat, const QString &filePath, stats::StatisticsData &statisticsData)
+{
+  auto statisticsFile = openStatisticsFile(fileFormat, filePath, statisticsData);
+  if (!*statisticsFile)
+    throw std::runtime_error("Error opening statistics file " + filePath.toStdString());
+  std::atomic_bool breakFunction{false};
+  statisticsFile->readFrameAndTypePositionsFromFile(breakFunction);
+  return statisticsFile;
+}
+
+std::string getFormatName(FileFormat fileFormat)
+{
+  return fileFormat == FileFormat::CSV ? "CSV" : "VTMBMS";
+}
+
+void addStatisticsFileBenchmarks(BenchmarkList &benchmarks)
+{
+  for (const auto fileFormat : {FileFormat::CSV, FileFormat::VTMBMS})
+  {
+    // The file is only written in the setup. Here, only its size is needed.
+    const auto fileSize = int64_t(createStatisticsFileData(fileFormat).size());
+
+    Benchmark index;
+    index.name             = "Statistics/" + getFormatName(fileFormat) + "/Index";
+    index.throughput.bytes = fileSize;
+    index.setup            = [fileFormat]() -> std::function<void()> {
+      const auto file = writeStatisticsFile(fileFormat);
+      return [file, fileFormat]() {
+        stats::StatisticsData statisticsData;
+        openAndIndexStatisticsFile(fileFormat, file.filePath, statisticsData);
+      };
+    };
+    benchmarks.push_back(index);
+
+    Benchmark load;
+    load.name             = "Statistics/" + getFormatName(fileFormat) + "/LoadFrame";
+    load.throughput.items = NR_BLOCKS_PER_FRAME * 2;
+    load.setup            = [fileFormat]() -> std::function<void()> {
+      const auto file           = writeStatisticsFile(fileFormat);
+      auto       statisticsData = std::make_shared<stats::StatisticsData>();
+      std::shared_ptr<stats::StatisticsFileBase> statisticsFile =
+          openAndIndexStatisticsFile(fileFormat, file.filePath, *statisticsData);
+      return [file, statisticsData, statisticsFile]() {
+        // Load a different frame every time so that nothing can be reused
+        const auto frameIndex = (statisticsData->getFrameIndex() + 1) % NR_FRAMES;
+        for (const auto &type : statisticsData->getStatisticsTypes())
+          statisticsFile->loadStatisticData(*statisticsData, frameIndex, type.typeID);
+      };
+    };
+    benchmarks.push_back(load);
+  }
+}
+
+void addPaintingBenchmarks(BenchmarkList &benchmarks)
+{
+  for (const auto paintVectors : {false, true})
+  {
+    Benchmark benchmark;
+    benchmark.name = std::string("Statistics/Painting/") + (paintVectors ? "Vectors" : "Values");
+    benchmark.throughput.items = NR_BLOCKS_PER_FRAME;
+    benchmark.setup            = [paintVectors]() -> std::function<void()> {
+      const auto file           = writeStatisticsFile(FileFormat::CSV);
+      auto       statisticsData = std::make_shared<stats::StatisticsData>();
+      auto       statisticsFile =
+          openAndIndexStatisticsFile(FileFormat::CSV, file.filePath, *statisticsData);
+
+      // Render only the value or the vector type
+      for (auto &type : statisticsData->getStatisticsTypes())
+      {
+        type.render           = (paintVectors == type.hasVectorData);
+        type.renderValueData  = type.render && type.hasValueData;
+        type.renderVectorData = type.render && type.hasVectorData;
+        if (type.render)
+          statisticsFile->loadStatisticData(*statisticsData, 0, type.typeID);
+      }
+
+      auto image = std::make_shared<QImage>(
+          int(FRAME_SIZE.width), int(FRAME_SIZE.height), QImage::Format_ARGB32_Premultiplied);
+      return [statisticsData, image]() {
+        image->fill(Qt::black);
+        QPainter painter(image.get());
+        // The statistics are drawn centered around the origin
+        painter.translate(image->width() / 2, image->height() / 2);
+        stats::paintStatisticsData(&painter, *statisticsData, 0, 1.0);
+      };
+    };
+    benchmarks.push_back(benchmark);
+  }
+}
+
+} // namespace
+
+void addStatisticsBenchmarks(BenchmarkList &benchmarks)
+{
+  addStatisticsFileBenchmarks(benchmarks);
+  addPaintingBenchmarks(benchmarks);
+}
+
+} // namespace benchmark
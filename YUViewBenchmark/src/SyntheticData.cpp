@@ -0,0 +1,257 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SyntheticData.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace benchmark::synthetic
+{
+
+namespace
+{
+
+constexpr auto SEED = 42u;
+
+class BitWriter
+{
+public:
+  void writeBits(uint64_t value, unsigned nrBits)
+  {
+    for (unsigned i = nrBits; i > 0; i--)
+    {
+      this->currentByte = (this->currentByte << 1) | ((value >> (i - 1)) & 1);
+      if (++this->nrBitsInByte == 8)
+      {
+        this->data.push_back(this->currentByte);
+        this->currentByte  = 0;
+        this->nrBitsInByte = 0;
+      }
+    }
+  }
+
+  void writeUEV(uint64_t value)
+  {
+    const auto codeNum = value + 1;
+    unsigned   nrBits  = 0;
+    while ((codeNum >> nrBits) > 1)
+      nrBits++;
+    this->writeBits(0, nrBits);
+    this->writeBits(codeNum, nrBits + 1);
+  }
+
+  // Add the rbsp stop bit and the alignment bits
+  ByteVector finish()
+  {
+    this->writeBits(1, 1);
+    while (this->nrBitsInByte != 0)
+      this->writeBits(0, 1);
+    return this->data;
+  }
+
+private:
+  ByteVector    data;
+  unsigned char currentByte{};
+  unsigned      nrBitsInByte{};
+};
+
+ByteVector addEmulationPrevention(const ByteVector &rbsp)
+{
+  ByteVector data;
+  data.reserve(rbsp.size() + rbsp.size() / 64);
+  int nrZeros = 0;
+  for (const auto byte : rbsp)
+  {
+    if (nrZeros == 2 && byte <= 3)
+    {
+      data.push_back(3);
+      nrZeros = 0;
+    }
+    data.push_back(byte);
+    nrZeros = (byte == 0) ? nrZeros + 1 : 0;
+  }
+  return data;
+}
+
+QByteArray createRandomSamples(int64_t nrBytes, unsigned bitsPerSample, bool bigEndian)
+{
+  std::mt19937                            generator(SEED);
+  std::uniform_int_distribution<unsigned> distribution(0, (1u << bitsPerSample) - 1);
+
+  QByteArray data(int(nrBytes), 0);
+  auto       dst = reinterpret_cast<unsigned char *>(data.data());
+  if (bitsPerSample <= 8)
+  {
+    for (int64_t i = 0; i < nrBytes; i++)
+      dst[i] = (unsigned char)distribution(generator);
+    return data;
+  }
+
+  for (int64_t i = 0; i + 1 < nrBytes; i += 2)
+  {
+    const auto value = distribution(generator);
+    dst[i + (bigEndian ? 1 : 0)] = (unsigned char)(value & 0xff);
+    dst[i + (bigEndian ? 0 : 1)] = (unsigned char)(value >> 8);
+  }
+  return data;
+}
+
+} // namespace
+
+QByteArray createYUVFrame(const video::yuv::PixelFormatYUV &pixelFormat, Size frameSize)
+{
+  return createRandomSamples(pixelFormat.bytesPerFrame(frameSize),
+                             unsigned(pixelFormat.getBitsPerSample()),
+                             pixelFormat.isBigEndian());
+}
+
+QByteArray createRGBFrame(const video::rgb::PixelFormatRGB &pixelFormat, Size frameSize)
+{
+  return createRandomSamples(int64_t(pixelFormat.bytesPerFrame(frameSize)),
+                             pixelFormat.getBitsPerSample(),
+                             pixelFormat.getEndianess() == video::Endianness::Big);
+}
+
+ByteVector createExpGolombCodedValues(size_t nrValues, uint64_t maxValue)
+{
+  std::mt19937                            generator(SEED);
+  std::uniform_int_distribution<uint64_t> distribution(0, maxValue - 1);
+
+  BitWriter writer;
+  for (size_t i = 0; i < nrValues; i++)
+    writer.writeUEV(distribution(generator));
+  return addEmulationPrevention(writer.finish());
+}
+
+ByteVector createAnnexBStream(size_t size, size_t &nrNalUnits)
+{
+  std::mt19937                       generator(SEED);
+  std::uniform_int_distribution<int> nalSizeDistribution(200, 50000);
+  std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+  ByteVector data;
+  data.reserve(size);
+  nrNalUnits = 0;
+  while (data.size() < size)
+  {
+    data.insert(data.end(), {0, 0, 0, 1});
+    const auto nalSize = std::min(size_t(nalSizeDistribution(generator)), size - data.size());
+    for (size_t i = 0; i < nalSize; i++)
+    {
+      // No two zero bytes in a row. So there is no start code in the payload.
+      auto byte = (unsigned char)byteDistribution(generator);
+      if (byte == 0 && data.back() == 0)
+        byte = 1;
+      data.push_back(byte);
+    }
+    // A NAL unit must not end with a zero byte
+    if (data.back() == 0)
+      data.back() = 1;
+    nrNalUnits++;
+  }
+  return data;
+}
+
+std::string createStatisticsFileCSV(Size frameSize, int nrFrames, unsigned blockSize)
+{
+  std::mt19937                       generator(SEED);
+  std::uniform_int_distribution<int> valueDistribution(0, 4);
+  std::uniform_int_distribution<int> vectorDistribution(-64, 64);
+
+  std::ostringstream file;
+  file << "%;syntax-version;v1.2\n";
+  file << "%;seq-specs;synthetic;0;" << frameSize.width << ";" << frameSize.height << ";0;\n";
+  file << "%;type;0;PredMode;range;\n";
+  file << "%;defaultRange;0;4;jet\n";
+  file << "%;gridColor;255;255;255;\n";
+  file << "%;type;1;MVL0;vector;\n";
+  file << "%;vectorColor;200;0;0;255\n";
+  file << "%;scaleFactor;4\n";
+
+  for (int poc = 0; poc < nrFrames; poc++)
+  {
+    for (unsigned y = 0; y < frameSize.height; y += blockSize)
+      for (unsigned x = 0; x < frameSize.width; x += blockSize)
+        file << poc << ";" << x << ";" << y << ";" << blockSize << ";" << blockSize << ";0;"
+             << valueDistribution(generator) << "\n";
+    for (unsigned y = 0; y < frameSize.height; y += blockSize)
+      for (unsigned x = 0; x < frameSize.width; x += blockSize)
+        file << poc << ";" << x << ";" << y << ";" << blockSize << ";" << blockSize << ";1;"
+             << vectorDistribution(generator) << ";" << vectorDistribution(generator) << "\n";
+  }
+  return file.str();
+}
+
+std::string createStatisticsFileVTMBMS(Size frameSize, int nrFrames, unsigned blockSize)
+{
+  std::mt19937                       generator(SEED);
+  std::uniform_int_distribution<int> valueDistribution(0, 4);
+  std::uniform_int_distribution<int> vectorDistribution(-64, 64);
+
+  std::ostringstream file;
+  file << "# VTMBMS Block Statistics\n";
+  file << "# Sequence size: [" << frameSize.width << "x" << frameSize.height << "]\n";
+  file << "# Block Statistic Type: PredMode; Integer; [0, 4]\n";
+  file << "# Block Statistic Type: MVL0; Vector; Scale: 4\n";
+
+  for (int poc = 0; poc < nrFrames; poc++)
+  {
+    for (unsigned y = 0; y < frameSize.height; y += blockSize)
+    {
+      for (unsigned x = 0; x < frameSize.width; x += blockSize)
+      {
+        file << "BlockStat: POC " << poc << " @(" << x << ", " << y << ") [" << blockSize << "x"
+             << blockSize << "] PredMode=" << valueDistribution(generator) << "\n";
+        file << "BlockStat: POC " << poc << " @(" << x << ", " << y << ") [" << blockSize << "x"
+             << blockSize << "] MVL0={" << vectorDistribution(generator) << ", "
+             << vectorDistribution(generator) << "}\n";
+      }
+    }
+  }
+  return file.str();
+}
+
+QString writeFile(const QTemporaryDir &directory, const QString &fileName, const QByteArray &data)
+{
+  const auto filePath = directory.filePath(fileName);
+  QFile      file(filePath);
+  if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size())
+    throw std::runtime_error("Error writing file " + filePath.toStdString());
+  return filePath;
+}
+
+} // namespace benchmark::synthetic
@@ -0,0 +1,68 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+#include <video/rgb/PixelFormatRGB.h>
+#include <video/yuv/PixelFormatYUV.h>
+
+#include <QByteArray>
+#include <QTemporaryDir>
+
+#include <string>
+
+// Create the input data of the benchmarks. All data is pseudo random with a fixed seed so that
+// every run of the benchmarks does exactly the same work.
+namespace benchmark::synthetic
+{
+
+QByteArray createYUVFrame(const video::yuv::PixelFormatYUV &pixelFormat, Size frameSize);
+QByteArray createRGBFrame(const video::rgb::PixelFormatRGB &pixelFormat, Size frameSize);
+
+// A bitstream of the given number of ue(v) coded values (below maxValue). Emulation prevention
+// bytes are inserted just like in a real NAL unit.
+ByteVector createExpGolombCodedValues(size_t nrValues, uint64_t maxValue);
+
+// Random NAL units (with 4 byte start codes) of different sizes. The payload never contains a
+// start code.
+ByteVector createAnnexBStream(size_t size, size_t &nrNalUnits);
+
+// Statistics files with a value and a vector type that are set for every block of every frame
+std::string createStatisticsFileCSV(Size frameSize, int nrFrames, unsigned blockSize);
+std::string createStatisticsFileVTMBMS(Size frameSize, int nrFrames, unsigned blockSize);
+
+// Write the data to a new file in the directory and return the path of the file. Throws if
+// writing fails.
+QString writeFile(const QTemporaryDir &directory, const QString &fileName, const QByteArray &data);
+
+} // namespace benchmark::synthetic
@@ -0,0 +1,179 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.h"
+#include "Benchmarks.h"
+
+#include <video/yuv/ConversionYUVSIMD.h>
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSysInfo>
+#include <QThread>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+int exitWithError(const QString &message)
+{
+  std::cerr << message.toStdString() << "\n";
+  return 1;
+}
+
+QJsonObject getContext(const benchmark::Options &options)
+{
+  QJsonObject context;
+  context["version"]        = QString::fromUtf8(YUVIEW_VERSION);
+  context["date"]           = QDateTime::currentDateTime().toString(Qt::ISODate);
+  context["qtVersion"]      = QString::fromLatin1(qVersion());
+  context["cpu"]            = QSysInfo::currentCpuArchitecture();
+  context["os"]             = QSysInfo::prettyProductName();
+  context["nrThreads"]      = QThread::idealThreadCount();
+  context["instructionSet"] = QString::fromStdString(std::string(
+      video::yuv::simd::getInstructionSetName(video::yuv::simd::getSupportedInstructionSet())));
+  context["minSecondsPerRepetition"] = options.minSecondsPerRepetition;
+  context["nrRepetitions"]           = options.nrRepetitions;
+  return context;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  // Nothing is shown on screen. Without a display, Qt would refuse to start.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QApplication app(argc, argv);
+  // Not the name of the GUI so that the settings of the user do not change the results
+  QApplication::setApplicationName("YUViewBenchmark");
+  QApplication::setApplicationVersion(QString::fromUtf8(YUVIEW_VERSION));
+  QApplication::setOrganizationName("Institut für Nachrichtentechnik, RWTH Aachen University");
+  QApplication::setOrganizationDomain("ient.rwth-aachen.de");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Measure the performance of the conversion, parsing and statistics functions of YUView on "
+      "synthetic data.");
+  parser.addHelpOption();
+  parser.addVersionOption();
+
+  benchmark::Options options;
+
+  QCommandLineOption listOption("list", "Only list the names of the benchmarks.");
+  QCommandLineOption filterOption(
+      "filter", "Only run the benchmarks whose name matches the regular expression.", "regex");
+  QCommandLineOption minTimeOption(
+      "min-time",
+      "The minimum time of one repetition of a benchmark in seconds.",
+      "seconds",
+      QString::number(options.minSecondsPerRepetition));
+  QCommandLineOption repetitionsOption("repetitions",
+                                       "The number of repetitions of every benchmark.",
+                                       "n",
+                                       QString::number(options.nrRepetitions));
+  QCommandLineOption outputOption(
+      {"o", "output"}, "Write the results to this file in the JSON format.", "file");
+  parser.addOptions({listOption, filterOption, minTimeOption, repetitionsOption, outputOption});
+  parser.process(app);
+
+  bool ok{};
+  options.minSecondsPerRepetition = parser.value(minTimeOption).toDouble(&ok);
+  if (!ok || options.minSecondsPerRepetition <= 0.0)
+    return exitWithError("Invalid minimum time " + parser.value(minTimeOption));
+  options.nrRepetitions = parser.value(repetitionsOption).toInt(&ok);
+  if (!ok || options.nrRepetitions < 1)
+    return exitWithError("Invalid number of repetitions " + parser.value(repetitionsOption));
+
+  const QRegularExpression filter(parser.value(filterOption));
+  if (!filter.isValid())
+    return exitWithError("Invalid filter " + parser.value(filterOption));
+
+  benchmark::BenchmarkList allBenchmarks;
+  benchmark::addConversionBenchmarks(allBenchmarks);
+  benchmark::addParserBenchmarks(allBenchmarks);
+  benchmark::addStatisticsBenchmarks(allBenchmarks);
+
+  benchmark::BenchmarkList benchmarks;
+  for (const auto &benchmark : allBenchmarks)
+    if (filter.match(QString::fromStdString(benchmark.name)).hasMatch())
+      benchmarks.push_back(benchmark);
+
+  if (parser.isSet(listOption))
+  {
+    for (const auto &benchmark : benchmarks)
+      std::cout << benchmark.name << "\n";
+    return 0;
+  }
+
+  QFile outputFile;
+  if (parser.isSet(outputOption))
+  {
+    outputFile.setFileName(parser.value(outputOption));
+    if (!outputFile.open(QIODevice::WriteOnly))
+      return exitWithError("Error opening output file " + parser.value(outputOption));
+  }
+
+  std::cout << benchmark::formatHeader() << std::endl;
+
+  std::vector<benchmark::Result> results;
+  for (const auto &benchmark : benchmarks)
+  {
+    try
+    {
+      results.push_back(benchmark::runBenchmark(benchmark, options));
+    }
+    catch (const std::exception &e)
+    {
+      return exitWithError(QString::fromStdString(benchmark.name + " failed: " + e.what()));
+    }
+    std::cout << benchmark::formatResult(results.back()) << std::endl;
+  }
+
+  if (outputFile.isOpen())
+  {
+    QJsonObject root;
+    root["context"]    = getContext(options);
+    root["benchmarks"] = benchmark::resultsToJson(results);
+    outputFile.write(QJsonDocument(root).toJson());
+  }
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+# The CLI does not create any widgets (it runs a QGuiApplication) but YUViewLib is one static
+# library that also contains the GUI code, so it can only be linked with all of its Qt modules.
+QT += core gui widgets opengl xml concurrent network
+
+TARGET = YUViewCLI
+TEMPLATE = app
+CONFIG += console
+CONFIG += c++17
+CONFIG -= app_bundle
+CONFIG -= debug_and_release
+
+SOURCES += $$files(src/*.cpp, false)
+HEADERS += $$files(src/*.h, false)
+
+INCLUDEPATH += $$top_srcdir/YUViewLib/src
+LIBS += -L$$top_builddir/YUViewLib -lYUViewLib
+
+win32-msvc* {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/YUViewLib.lib
+} else {
+    PRE_TARGETDEPS += $$top_builddir/YUViewLib/libYUViewLib.a
+}
+
+unix:!mac {
+    isEmpty(PREFIX) {
+        PREFIX = /usr/local
+    }
+    isEmpty(BINDIR) {
+        BINDIR = bin
+    }
+
+    target.path = $$PREFIX/$$BINDIR/
+    INSTALLS += target
+}
+
+linux|macx {
+    SVNN = $$system("git describe --tags")
+}
+win32 {
+    SVNN = $$system("git describe --tags")
+    DEFINES += NOMINMAX
+}
+
+isEmpty(SVNN) {
+    SVNN = 0
+}
+VERSTR = '\\"$${SVNN}\\"'
+DEFINES += YUVIEW_VERSION=$${VERSTR}
@@ -0,0 +1,418 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "BatchJob.h"
+
+#include <playlistitem/playlistItemCompressedVideo.h>
+#include <playlistitem/playlistItemRawFile.h>
+#include <playlistitem/playlistItemStatisticsFile.h>
+#include <statistics/StatisticsFileCSV.h>
+#include <statistics/StatisticsFileVTMBMS.h>
+#include <video/videoHandler.h>
+#include <video/yuv/SequenceMetricsYUV.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QTextStream>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace batch
+{
+
+namespace
+{
+
+enum class FileType
+{
+  Raw,
+  Compressed,
+  Statistics,
+  Unknown
+};
+
+FileType getFileType(const QString &file)
+{
+  const auto extension = QFileInfo(file).suffix().toLower();
+
+  auto checkForExtension = [&extension](auto getSupportedFileExtensions) {
+    QStringList allExtensions, filtersList;
+    getSupportedFileExtensions(allExtensions, filtersList);
+    return allExtensions.contains(extension);
+  };
+
+  if (checkForExtension(playlistItemRawFile::getSupportedFileExtensions))
+    return FileType::Raw;
+  if (checkForExtension(playlistItemCompressedVideo::getSupportedFileExtensions))
+    return FileType::Compressed;
+  if (checkForExtension(playlistItemStatisticsFile::getSupportedFileExtensions))
+    return FileType::Statistics;
+  return FileType::Unknown;
+}
+
+std::unique_ptr<playlistItem> openVideoItem(const QString &file, const Options &options)
+{
+  const auto fileType = getFileType(file);
+  if (fileType == FileType::Raw)
+    return std::make_unique<playlistItemRawFile>(
+        file, options.rawFrameSize, options.rawPixelFormat);
+  if (fileType == FileType::Compressed)
+    return std::make_unique<playlistItemCompressedVideo>(file);
+  return {};
+}
+
+video::videoHandler *getVideoHandler(playlistItem *item)
+{
+  if (item == nullptr)
+    return {};
+  auto video = dynamic_cast<video::videoHandler *>(item->getFrameHandler());
+  if (video == nullptr || !video->isFormatValid())
+    return {};
+  return video;
+}
+
+QString getOutputFilePath(const QString &baseName, const Options &options, const QString &suffix)
+{
+  return QDir(options.outputDirectory).filePath(baseName + suffix);
+}
+
+void appendFrameRangeError(indexRange itemRange, const Options &options, Result &result)
+{
+  result.messages.append(QString("The frame range %1-%2 is outside of the frames %3-%4 of the file")
+                             .arg(options.frameRange->first)
+                             .arg(options.frameRange->second)
+                             .arg(itemRange.first)
+                             .arg(itemRange.second));
+}
+
+void appendInfo(playlistItem *item, Result &result)
+{
+  const auto info = item->getInfo();
+  result.messages.append(info.title);
+  for (const auto &infoItem : info.items)
+    result.messages.append(
+        QString::fromStdString("  " + infoItem.name + ": " + infoItem.text));
+}
+
+bool exportFrames(video::videoHandler *video,
+                  indexRange           frames,
+                  const QString       &outputBaseName,
+                  const Options       &options,
+                  Result              &result)
+{
+  for (int frameIdx = frames.first; frameIdx <= frames.second; frameIdx++)
+  {
+    video->loadFrame(frameIdx);
+    const auto image = video->getCurrentFrameAsImage();
+    if (video->getCurrentImageIndex() != frameIdx || image.isNull())
+    {
+      result.messages.append(QString("Error loading frame %1").arg(frameIdx));
+      return false;
+    }
+
+    const auto suffix   = QString("_%1.png").arg(frameIdx, 5, 10, QChar('0'));
+    const auto filePath = getOutputFilePath(outputBaseName, options, suffix);
+    if (!image.save(filePath))
+    {
+      result.messages.append("Error writing frame to " + filePath);
+      return false;
+    }
+  }
+  result.messages.append(QString("Exported %1 frames").arg(frames.second - frames.first + 1));
+  return true;
+}
+
+bool calculateMetrics(playlistItem        *item,
+                      video::videoHandler *video,
+                      indexRange           frames,
+                      const QString       &outputBaseName,
+                      const Options       &options,
+                      Result              &result)
+{
+  auto reference      = openVideoItem(options.referenceFile, options);
+  auto referenceVideo = getVideoHandler(reference.get());
+  if (referenceVideo == nullptr)
+  {
+    result.messages.append("Error opening the reference file " + options.referenceFile);
+    return false;
+  }
+
+  const auto referenceRange = reference->properties().startEndRange;
+  frames.second             = std::min(frames.second, referenceRange.second);
+  if (frames.second < frames.first)
+  {
+    result.messages.append(QString("The reference file has no frame %1").arg(frames.first));
+    return false;
+  }
+
+  const auto filePath = getOutputFilePath(outputBaseName, options, "_metrics.csv");
+  QFile      outputFile(filePath);
+  if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text))
+  {
+    result.messages.append("Error opening output file " + filePath);
+    return false;
+  }
+  QTextStream output(&outputFile);
+
+  // YUV items are compared in parallel on the raw frames (including SSIM and MS-SSIM). All other
+  // items are compared frame by frame using the difference calculation of the GUI.
+  auto yuvVideo     = dynamic_cast<video::yuv::videoHandlerYUV *>(video);
+  auto yuvReference = dynamic_cast<video::yuv::videoHandlerYUV *>(referenceVideo);
+  if (yuvVideo != nullptr && yuvReference != nullptr)
+  {
+    // Don't use more threads than the items have decoders. Each thread reads whole GOPs.
+    video::yuv::SequenceMetricsSettings settings;
+    for (const auto threadLimit : {item->cachingThreadLimit(), reference->cachingThreadLimit()})
+      if (threadLimit > 0)
+        settings.nrThreads =
+            (settings.nrThreads > 0) ? std::min(settings.nrThreads, threadLimit) : threadLimit;
+    settings.sequentialRanges = item->getSequentialCachingRanges(frames);
+
+    const auto sequenceMetrics = video::yuv::calculateSequenceMetrics(
+        yuvVideo, yuvReference, frames, frames.first, settings);
+    if (sequenceMetrics.error.isEmpty())
+    {
+      sequenceMetrics.writeCSV(output);
+      const auto nrFrames = frames.second - frames.first + 1;
+      result.messages.append(QString("Metrics of %1 of %2 frames written to %3")
+                                 .arg(sequenceMetrics.nrValidFrames)
+                                 .arg(nrFrames)
+                                 .arg(filePath));
+      return sequenceMetrics.nrValidFrames == nrFrames;
+    }
+    result.messages.append(sequenceMetrics.error + " Comparing frame by frame.");
+  }
+
+  for (int frameIdx = frames.first; frameIdx <= frames.second; frameIdx++)
+  {
+    QList<InfoItem> differenceInfo;
+    video->calculateDifference(referenceVideo, frameIdx, frameIdx, differenceInfo, 1, false);
+    if (differenceInfo.isEmpty())
+    {
+      result.messages.append(
+          QString("Error calculating the difference of frame %1").arg(frameIdx));
+      return false;
+    }
+
+    if (frameIdx == frames.first)
+    {
+      output << "Frame";
+      for (const auto &infoItem : differenceInfo)
+        output << ";" << QString::fromStdString(infoItem.name);
+      output << "\n";
+    }
+    output << frameIdx;
+    for (const auto &infoItem : differenceInfo)
+      output << ";" << QString::fromStdString(infoItem.text);
+    output << "\n";
+  }
+
+  result.messages.append("Metrics written to " + filePath);
+  return true;
+}
+
+void writeFrameTypeData(QTextStream &output, int poc, int typeID, const stats::FrameTypeData &data)
+{
+  const auto prefix = QString("%1;%2;").arg(poc).arg(typeID);
+  for (const auto &value : data.valueData)
+    output << prefix << value.pos[0] << ";" << value.pos[1] << ";" << value.size[0] << ";"
+           << value.size[1] << ";" << value.value << "\n";
+  for (const auto &vector : data.vectorData)
+  {
+    output << prefix << vector.pos[0] << ";" << vector.pos[1] << ";" << vector.size[0] << ";"
+           << vector.size[1] << ";" << vector.point[0].x << ";" << vector.point[0].y;
+    if (vector.isLine)
+      output << ";" << vector.point[1].x << ";" << vector.point[1].y;
+    output << "\n";
+  }
+  for (const auto &affine : data.affineTFData)
+  {
+    output << prefix << affine.pos[0] << ";" << affine.pos[1] << ";" << affine.size[0] << ";"
+           << affine.size[1];
+    for (const auto &point : affine.point)
+      output << ";" << point.x << ";" << point.y;
+    output << "\n";
+  }
+}
+
+bool exportStatistics(const QString &file,
+                      const QString &outputBaseName,
+                      const Options &options,
+                      Result        &result)
+{
+  stats::StatisticsData                      statisticsData;
+  std::unique_ptr<stats::StatisticsFileBase> statisticsFile;
+  if (QFileInfo(file).suffix().toLower() == "csv")
+    statisticsFile = std::make_unique<stats::StatisticsFileCSV>(file, statisticsData);
+  else
+    statisticsFile = std::make_unique<stats::StatisticsFileVTMBMS>(file, statisticsData);
+  if (!*statisticsFile)
+  {
+    result.messages.append("Error opening the statistics file");
+    return false;
+  }
+
+  std::atomic_bool breakFunction{false};
+  statisticsFile->readFrameAndTypePositionsFromFile(breakFunction);
+  if (!*statisticsFile)
+  {
+    result.messages.append("Error parsing the statistics file: " +
+                           statisticsFile->getErrorMessage());
+    return false;
+  }
+
+  const indexRange fileRange = {0, statisticsFile->getMaxPoc()};
+  const auto       frames    = getFramesToProcess(fileRange, options);
+  if (!frames)
+  {
+    appendFrameRangeError(fileRange, options, result);
+    return false;
+  }
+
+  const auto filePath = getOutputFilePath(outputBaseName, options, "_statistics.csv");
+  QFile      outputFile(filePath);
+  if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Text))
+  {
+    result.messages.append("Error opening output file " + filePath);
+    return false;
+  }
+  QTextStream output(&outputFile);
+
+  // The header lists the types. Every following line is a block with a value
+  // (POC;type;x;y;w;h;value), a vector (POC;type;x;y;w;h;vx;vy), a line
+  // (POC;type;x;y;w;h;x0;y0;x1;y1) or an affine transformation
+  // (POC;type;x;y;w;h;x0;y0;x1;y1;x2;y2). Polygon statistics are not exported.
+  auto &types = statisticsData.getStatisticsTypes();
+  for (const auto &type : types)
+    output << "%;type;" << type.typeID << ";" << type.typeName << "\n";
+
+  for (int poc = frames->first; poc <= frames->second; poc++)
+  {
+    statisticsData.setFrameIndex(poc);
+    for (const auto &type : types)
+      if (!statisticsData.hasDataForTypeID(type.typeID))
+        statisticsFile->loadStatisticData(statisticsData, poc, type.typeID);
+    for (const auto &type : types)
+      writeFrameTypeData(output, poc, type.typeID, statisticsData.getFrameTypeData(type.typeID));
+  }
+
+  result.messages.append("Statistics written to " + filePath);
+  return true;
+}
+
+} // namespace
+
+std::optional<indexRange> getFramesToProcess(indexRange itemRange, const Options &options)
+{
+  if (!options.frameRange)
+    return itemRange;
+
+  const indexRange frames = {std::max(itemRange.first, options.frameRange->first),
+                             std::min(itemRange.second, options.frameRange->second)};
+  if (frames.first > frames.second)
+    return {};
+  return frames;
+}
+
+QStringList getOutputBaseNames(const QStringList &files)
+{
+  // The output directory may be on a file system that is not case sensitive
+  QStringList baseNames;
+  for (const auto &file : files)
+    baseNames.append(QFileInfo(file).completeBaseName().toLower());
+
+  QStringList   outputBaseNames;
+  QSet<QString> uniqueNames;
+  for (int i = 0; i < files.size(); i++)
+  {
+    auto name = QFileInfo(files[i]).completeBaseName();
+    if (baseNames.count(baseNames[i]) > 1)
+      name += QString("_%1").arg(i + 1);
+    outputBaseNames.append(name);
+    uniqueNames.insert(name.toLower());
+  }
+
+  if (uniqueNames.size() != outputBaseNames.size())
+    return {};
+  return outputBaseNames;
+}
+
+Result processFile(const QString &file, const QString &outputBaseName, const Options &options)
+{
+  Result result;
+  result.file = file;
+
+  if (getFileType(file) == FileType::Statistics)
+  {
+    if (options.printInfo || options.exportFrames || !options.referenceFile.isEmpty())
+      result.messages.append("Only statistics can be exported from a statistics file");
+    result.success =
+        !options.exportStatistics || exportStatistics(file, outputBaseName, options, result);
+    return result;
+  }
+
+  auto item  = openVideoItem(file, options);
+  auto video = getVideoHandler(item.get());
+  if (video == nullptr)
+  {
+    result.messages.append("Error opening the file or the format could not be determined");
+    return result;
+  }
+
+  const auto itemRange = item->properties().startEndRange;
+  const auto frames    = getFramesToProcess(itemRange, options);
+
+  if (options.printInfo)
+    appendInfo(item.get(), result);
+  if (options.exportStatistics)
+    result.messages.append("Statistics can only be exported from statistics files");
+  if (!frames)
+  {
+    appendFrameRangeError(itemRange, options, result);
+    return result;
+  }
+
+  result.success = true;
+  if (options.exportFrames)
+    result.success = exportFrames(video, *frames, outputBaseName, options, result);
+  if (result.success && !options.referenceFile.isEmpty())
+    result.success = calculateMetrics(item.get(), video, *frames, outputBaseName, options, result);
+
+  return result;
+}
+
+} // namespace batch
@@ -0,0 +1,89 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <common/Typedef.h>
+
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+namespace batch
+{
+
+// What to do with each input file
+struct Options
+{
+  bool printInfo{};
+  bool exportFrames{};
+  bool exportStatistics{};
+
+  // If set, the difference metrics (MSE/PSNR and SSIM/MS-SSIM for YUV files) of every frame to
+  // this file are calculated
+  QString referenceFile;
+
+  // Output files are written to this directory
+  QString outputDirectory;
+
+  // Only process these frames. By default, all frames are processed.
+  std::optional<indexRange> frameRange;
+
+  // The format of raw input files if it can not be guessed from the file name
+  QSize   rawFrameSize;
+  QString rawPixelFormat;
+};
+
+struct Result
+{
+  QString     file;
+  bool        success{};
+  QStringList messages;
+};
+
+// Get the names that the output files of each input file start with. This is the base name of the
+// file. If multiple files have the same base name (ignoring the case), the position of the file in
+// the list is appended. Returns an empty list if the names can still not be told apart.
+QStringList getOutputBaseNames(const QStringList &files);
+
+// Get the frames of an item with the given range that are processed. This is the intersection of
+// the item range and the frame range of the options. Returns nothing if they do not overlap.
+std::optional<indexRange> getFramesToProcess(indexRange itemRange, const Options &options);
+
+// Process one input file. All output files start with outputBaseName. This creates its own items,
+// so multiple files can be processed in parallel. This function must not be called from the main
+// thread.
+Result processFile(const QString &file, const QString &outputBaseName, const Options &options);
+
+} // namespace batch
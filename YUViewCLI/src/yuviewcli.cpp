@@ -0,0 +1,204 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+*   <https://github.com/IENT/YUView>
+*   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   In addition, as a special exception, the copyright holders give
+*   permission to link the code of portions of this program with the
+*   OpenSSL library under certain conditions as described in each
+*   individual source file, and distribute linked combinations including
+*   the two.
+*   
+*   You must obey the GNU General Public License in all respects for all
+*   of the code used other than OpenSSL. If you modify file(s) with this
+*   exception, you may extend this exception to your version of the
+*   file(s), but you are not obligated to do so. If you do not wish to do
+*   so, delete this exception statement from your version. If you delete
+*   this exception statement from all source files in the program, then
+*   also delete it here.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "BatchJob.h"
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFuture>
+#include <QGuiApplication>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+std::optional<indexRange> parseFrameRange(const QString &text)
+{
+  const auto parts = text.split('-');
+  if (parts.size() > 2)
+    return {};
+
+  bool ok1{}, ok2{true};
+  auto first = parts[0].toInt(&ok1);
+  auto last  = (parts.size() == 2) ? parts[1].toInt(&ok2) : first;
+  if (!ok1 || !ok2 || first < 0 || last < first)
+    return {};
+  return indexRange(first, last);
+}
+
+std::optional<QSize> parseFrameSize(const QString &text)
+{
+  const auto parts = text.toLower().split('x');
+  if (parts.size() != 2)
+    return {};
+
+  bool ok1{}, ok2{};
+  auto width  = parts[0].toInt(&ok1);
+  auto height = parts[1].toInt(&ok2);
+  if (!ok1 || !ok2 || width <= 0 || height <= 0)
+    return {};
+  return QSize(width, height);
+}
+
+int exitWithError(const QString &message)
+{
+  std::cerr << message.toStdString() << "\n";
+  return 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  // No widgets are created but the images need a QGuiApplication. Nothing is shown on screen, so
+  // the offscreen platform is used. Without a display, Qt would refuse to start otherwise.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  qRegisterMetaType<recacheIndicator>("recacheIndicator");
+
+  QGuiApplication app(argc, argv);
+  // Same names as the GUI so that the settings (e.g. decoder library paths) are shared
+  QGuiApplication::setApplicationName("YUView");
+  QGuiApplication::setApplicationVersion(QString::fromUtf8(YUVIEW_VERSION));
+  QGuiApplication::setOrganizationName("Institut für Nachrichtentechnik, RWTH Aachen University");
+  QGuiApplication::setOrganizationDomain("ient.rwth-aachen.de");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Analyze video, bitstream and statistics files without the graphical user interface.");
+  parser.addHelpOption();
+  parser.addVersionOption();
+  parser.addPositionalArgument("files", "The files to process.", "files...");
+
+  QCommandLineOption infoOption("info", "Print the file information.");
+  QCommandLineOption exportFramesOption("export-frames", "Save every frame as a PNG image.");
+  QCommandLineOption exportStatisticsOption(
+      "export-statistics", "Write the data of statistics files to a CSV file.");
+  QCommandLineOption referenceOption(
+      "reference",
+      "Calculate the MSE/PSNR (and SSIM/MS-SSIM for YUV) of every frame to this file.",
+      "file");
+  QCommandLineOption outputOption(
+      {"o", "output-dir"}, "Write all output files to this directory.", "directory", ".");
+  QCommandLineOption framesOption(
+      "frames", "Only process the frames first to last (inclusive).", "first-last");
+  QCommandLineOption sizeOption("size", "The frame size of raw files.", "WxH");
+  QCommandLineOption pixelFormatOption(
+      "pixel-format", "The pixel format of raw files (e.g. 4:2:0 Y'CbCr 8-bit planar).", "format");
+  QCommandLineOption jobsOption(
+      {"j", "jobs"},
+      "The number of files to process in parallel.",
+      "n",
+      QString::number(QThread::idealThreadCount()));
+  parser.addOptions({infoOption,
+                     exportFramesOption,
+                     exportStatisticsOption,
+                     referenceOption,
+                     outputOption,
+                     framesOption,
+                     sizeOption,
+                     pixelFormatOption,
+                     jobsOption});
+  parser.process(app);
+
+  const auto files = parser.positionalArguments();
+  if (files.isEmpty())
+    return exitWithError("No input files given.");
+
+  batch::Options options;
+  options.printInfo        = parser.isSet(infoOption);
+  options.exportFrames     = parser.isSet(exportFramesOption);
+  options.exportStatistics = parser.isSet(exportStatisticsOption);
+  options.referenceFile    = parser.value(referenceOption);
+  options.outputDirectory  = parser.value(outputOption);
+  options.rawPixelFormat   = parser.value(pixelFormatOption);
+
+  if (!options.printInfo && !options.exportFrames && !options.exportStatistics &&
+      options.referenceFile.isEmpty())
+    return exitWithError("Nothing to do. Set at least one of --info, --export-frames, "
+                         "--export-statistics or --reference.");
+
+  if (parser.isSet(framesOption))
+  {
+    options.frameRange = parseFrameRange(parser.value(framesOption));
+    if (!options.frameRange)
+      return exitWithError("Invalid frame range " + parser.value(framesOption));
+  }
+
+  if (parser.isSet(sizeOption))
+  {
+    auto frameSize = parseFrameSize(parser.value(sizeOption));
+    if (!frameSize)
+      return exitWithError("Invalid frame size " + parser.value(sizeOption));
+    options.rawFrameSize = *frameSize;
+  }
+
+  bool ok{};
+  auto nrJobs = parser.value(jobsOption).toInt(&ok);
+  if (!ok || nrJobs < 1)
+    return exitWithError("Invalid number of jobs " + parser.value(jobsOption));
+
+  const auto outputBaseNames = batch::getOutputBaseNames(files);
+  if (outputBaseNames.isEmpty())
+    return exitWithError("The names of the output files of the input files can not be told apart.");
+
+  if (!QDir().mkpath(options.outputDirectory))
+    return exitWithError("Error creating the output directory " + options.outputDirectory);
+
+  // The items are created and used in the job threads. The main thread only collects the results.
+  QThreadPool pool;
+  pool.setMaxThreadCount(nrJobs);
+
+  std::vector<QFuture<batch::Result>> jobs;
+  for (int i = 0; i < files.size(); i++)
+    jobs.push_back(QtConcurrent::run(
+        &pool,
+        [file = files[i], outputBaseName = outputBaseNames[i], options]()
+        { return batch::processFile(file, outputBaseName, options); }));
+
+  auto allSucceeded = true;
+  for (auto &job : jobs)
+  {
+    const auto result = job.result();
+    std::cout << result.file.toStdString() << (result.success ? "" : " FAILED") << "\n";
+    for (const auto &message : result.messages)
+      std::cout << "  " << message.toStdString() << "\n";
+    allSucceeded &= result.success;
+  }
+
+  return allSucceeded ? 0 : 1;
+}
@@ -45,6 +45,7 @@
 #include <charconv>
 #include <string_view>
 
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
 #include <QThread>
@@ -145,6 +146,15 @@ QString getAbsPathFromAbsAndRel(const QString &currentPath,
   return {};
 }
 
+QString getFileKey(const QString &filePath)
+{
+  const QFileInfo fileInfo(filePath);
+  return QString("%1|%2|%3")
+      .arg(fileInfo.canonicalFilePath())
+      .arg(fileInfo.size())
+      .arg(fileInfo.lastModified().toMSecsSinceEpoch());
+}
+
 QString formatDataSize(double size, bool isBits)
 {
   unsigned divCounter = 0;
@@ -62,6 +62,10 @@ QString getAbsPathFromAbsAndRel(const QString &currentPath,
                                 const QString &absolutePath,
                                 const QString &relativePath);
 
+// Identify a file by its path, size and modification time. This is used as the key of data that
+// is cached on disk for the file (e.g. decoded frames or a stream index).
+QString getFileKey(const QString &filePath);
+
 // Format the data size as a huma readable string. If isBits is set, assumes bits, oterwise bytes.
 // From Qt 5.10 there is a built in function (QLocale::formattedDataSize). But we want to be 5.9
 // compatible.
@@ -32,6 +32,8 @@
 
 #include "decoderBase.h"
 
+#include <common/Functions.h>
+
 #include <QDir>
 #include <QSettings>
 
@@ -62,10 +64,74 @@ namespace decoder
 #define DEBUG_DECODERBASE(fmt, ...) ((void)0)
 #endif
 
+namespace
+{
+
+// Every caching decoder can decode a different GOP in parallel. However, each decoder needs its own
+// memory (e.g. for the reference pictures) so we limit the default number.
+constexpr auto MAX_DEFAULT_CACHING_DECODERS = 4;
+
+// The libraries limit the number of threads
+constexpr auto MAX_DECODER_THREADS = 64;
+
+// The caching decoders do not use these threads so that the interactive decoder still gets them
+// while caching is running.
+constexpr auto RESERVED_INTERACTIVE_THREADS_PERCENT = 50;
+
+int getNrThreads()
+{
+  QSettings settings;
+  settings.beginGroup("VideoCache");
+  int nrThreads = int(functions::getOptimalThreadCount());
+  if (settings.value("SetNrThreads", false).toBool())
+    nrThreads = settings.value("NrThreads", nrThreads).toInt();
+  return functions::clip(nrThreads, 1, MAX_DECODER_THREADS);
+}
+
+} // namespace
+
+int getNrCachingDecoders()
+{
+  QSettings settings;
+  settings.beginGroup("VideoCache");
+  const auto nrThreads = getNrThreads();
+
+  auto defaultNrDecoders = std::min(nrThreads, MAX_DEFAULT_CACHING_DECODERS);
+  auto nrDecoders        = settings.value("NrCachingDecoders", defaultNrDecoders).toInt();
+  return functions::clip(nrDecoders, 1, nrThreads);
+}
+
+DecoderThreading getDecoderThreading(bool cachingDecoder)
+{
+  const auto nrThreads = getNrThreads();
+
+  DecoderThreading threading;
+  if (cachingDecoder)
+  {
+    // The caching decoders share the threads that are not reserved for the interactive decoder.
+    // Each one decodes frames in parallel.
+    const auto nrSharedThreads = nrThreads - nrThreads * RESERVED_INTERACTIVE_THREADS_PERCENT / 100;
+    threading.nrThreads        = std::max(nrSharedThreads / getNrCachingDecoders(), 1);
+    threading.nrFrameThreads   = threading.nrThreads;
+    threading.nrTileThreads    = 1;
+  }
+  else
+  {
+    // The interactive decoder may use all threads. Without caching or while the caching decoders
+    // are idle nobody else needs them. No frame threading. Every additional frame in flight delays
+    // the output of the frame.
+    threading.nrThreads      = nrThreads;
+    threading.nrFrameThreads = 1;
+    threading.nrTileThreads  = nrThreads;
+  }
+  return threading;
+}
+
 decoderBase::decoderBase(bool cachingDecoder)
 {
   DEBUG_DECODERBASE("decoderBase::decoderBase create base%s", cachingDecoder ? " - caching" : "");
   isCachingDecoder = cachingDecoder;
+  threading        = getDecoderThreading(cachingDecoder);
 
   resetDecoder();
 }
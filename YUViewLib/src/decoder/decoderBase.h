@@ -35,6 +35,7 @@
 #include <common/EnumMapper.h>
 #include <filesource/FileSourceAnnexBFile.h>
 #include <statistics/StatisticsData.h>
+#include <video/RawFrameBuffer.h>
 #include <video/rgb/videoHandlerRGB.h>
 #include <video/yuv/videoHandlerYUV.h>
 
@@ -78,6 +79,25 @@ const auto DecodersHEVC =
 const auto DecodersVVC = std::vector<DecoderEngine>({DecoderEngine::VVDec, DecoderEngine::VTM});
 const auto DecodersAV1 = std::vector<DecoderEngine>({DecoderEngine::FFMpeg, DecoderEngine::Dav1d});
 
+// How many threads a decoder library may use. The interactive decoder must return the requested
+// frame as fast as possible. It uses all threads within one frame (tiles, wavefronts, slices) and
+// does not decode frames ahead. The caching decoders run in parallel to each other. Each of them
+// gets a share of the threads not reserved for the interactive decoder and decodes multiple frames
+// in parallel, which adds delay but gives the highest throughput.
+struct DecoderThreading
+{
+  int nrThreads{1};      // The total number of threads of the decoder
+  int nrFrameThreads{1}; // Frames decoded in parallel. This is also the maximum frame delay.
+  int nrTileThreads{1};  // Threads working on the same frame
+};
+
+// The number of caching decoders (VideoCache/NrCachingDecoders). There is at most one caching
+// decoder per thread (VideoCache/NrThreads).
+int getNrCachingDecoders();
+// The interactive decoder gets all threads of the VideoCache/NrThreads setting. The caching
+// decoders split the threads that are not reserved for the interactive decoder into equal shares.
+DecoderThreading getDecoderThreading(bool cachingDecoder);
+
 /* This class is the abstract base class for all decoders. All decoders work like this:
  * 1. Create an instance and configure it (if required)
  * 2. Push data to the decoder until it returns that it can not take any more data.
@@ -116,6 +136,15 @@ public:
   video::yuv::PixelFormatYUV getPixelFormatYUV() const { return this->formatYUV; }
   video::rgb::PixelFormatRGB getRGBPixelFormat() const { return this->formatRGB; }
   Size                       getFrameSize() const { return this->frameSize; }
+
+  // Get the current frame without copying it into one consecutive buffer (if the decoder supports
+  // this). The planes point to memory of the decoder and are only valid until the decoder is used
+  // again. The default implementation wraps the output of getRawFrameData.
+  virtual video::RawFrameBuffer getRawFrameBuffer()
+  {
+    return video::RawFrameBuffer(this->getRawFrameData());
+  }
+
   // Push data to the decoder (until no more data is needed)
   // In order to make the interface generic, the pushData function accepts data only without start
   // codes
@@ -147,8 +176,9 @@ public:
 protected:
   DecoderState decoderState{DecoderState::NeedsMoreData};
 
-  int  decodeSignal{0};  ///< Which signal should be decoded?
-  bool isCachingDecoder; ///< Is this the caching or the interactive decoder?
+  int              decodeSignal{0};  ///< Which signal should be decoded?
+  bool             isCachingDecoder; ///< Is this the caching or the interactive decoder?
+  DecoderThreading threading;        ///< How many threads the decoder library may use
 
   bool internalsSupported{false}; ///< Enable in the constructor if you support statistics
   Size frameSize{};
@@ -245,6 +245,8 @@ void decoderDav1d::allocateNewDecoder()
   DEBUG_DAV1D("decoderDav1d::allocateNewDecoder - decodeSignal %d", decodeSignal);
 
   this->lib.dav1d_default_settings(&settings);
+  settings.n_frame_threads = this->threading.nrFrameThreads;
+  settings.n_tile_threads  = this->threading.nrTileThreads;
 
   // Create new decoder object
   int err = this->lib.dav1d_open(&decoder, &settings);
@@ -385,6 +387,45 @@ QByteArray decoderDav1d::getRawFrameData()
   return currentOutputBuffer;
 }
 
+video::RawFrameBuffer decoderDav1d::getRawFrameBuffer()
+{
+  // The internal signals and the statistics are only retrieved when copying the frame
+  const auto s = this->curPicture.getFrameSize();
+  if (s.width <= 0 || s.height <= 0 || this->decoderState != DecoderState::RetrieveFrames ||
+      this->decodeSignal != 0 || this->statisticsEnabled())
+    return decoderBase::getRawFrameBuffer();
+
+  const auto layout           = this->curPicture.getSubsampling();
+  const auto nrPlanes         = (layout == Subsampling::YUV_400) ? 1 : 3;
+  const auto nrBytesPerSample = (this->curPicture.getBitDepth() > 8) ? 2 : 1;
+
+  std::vector<video::RawFrameBuffer::Plane> planes;
+  for (int c = 0; c < nrPlanes; c++)
+  {
+    auto width  = s.width;
+    auto height = s.height;
+    if (c != 0)
+    {
+      if (layout == Subsampling::YUV_420 || layout == Subsampling::YUV_422)
+        width /= 2;
+      if (layout == Subsampling::YUV_420)
+        height /= 2;
+    }
+
+    auto data = this->curPicture.getData(c);
+    if (data == nullptr)
+      return decoderBase::getRawFrameBuffer();
+
+    planes.push_back({data,
+                      this->curPicture.getStride((c == 0) ? 0 : 1),
+                      int(width) * nrBytesPerSample,
+                      int(height)});
+  }
+
+  DEBUG_DAV1D("decoderDav1d::getRawFrameBuffer wrapped %d planes", nrPlanes);
+  return video::RawFrameBuffer(std::move(planes), {});
+}
+
 bool decoderDav1d::pushData(QByteArray &data)
 {
   if (decoderState != DecoderState::NeedsMoreData)
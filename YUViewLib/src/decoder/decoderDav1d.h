@@ -122,9 +122,10 @@ public:
   void        setDecodeSignal(int signalID, bool &decoderResetNeeded) override;
 
   // Decoding / pushing data
-  bool       decodeNextFrame() override;
-  QByteArray getRawFrameData() override;
-  bool       pushData(QByteArray &data) override;
+  bool                  decodeNextFrame() override;
+  QByteArray            getRawFrameData() override;
+  video::RawFrameBuffer getRawFrameBuffer() override;
+  bool                  pushData(QByteArray &data) override;
 
   // Check if the given library file is an existing libde265 decoder that we can use.
   static bool checkLibraryFile(QString libFilePath, QString &error);
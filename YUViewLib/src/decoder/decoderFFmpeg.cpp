@@ -175,6 +175,35 @@ QByteArray decoderFFmpeg::getRawFrameData()
   return this->currentOutputBuffer;
 }
 
+video::RawFrameBuffer decoderFFmpeg::getRawFrameBuffer()
+{
+  // Only YUV frames can be wrapped. The statistics are only retrieved when copying the frame.
+  if (this->decoderState != DecoderState::RetrieveFrames || !frame ||
+      this->rawFormat != video::RawFormat::YUV || this->statisticsEnabled())
+    return decoderBase::getRawFrameBuffer();
+
+  const auto pixFmt           = this->getPixelFormatYUV();
+  const auto nrBytesPerSample = pixFmt.getBitsPerSample() <= 8 ? 1 : 2;
+
+  std::vector<video::RawFrameBuffer::Plane> planes;
+  for (unsigned plane = 0; plane < pixFmt.getNrPlanes(); plane++)
+  {
+    const auto component =
+        (plane == 0) ? video::yuv::Component::Luma : video::yuv::Component::Chroma;
+    auto data = frame.getData(plane);
+    if (data == nullptr)
+      return decoderBase::getRawFrameBuffer();
+
+    planes.push_back(
+        {data,
+         int64_t(frame.getLineSize(plane)),
+         int(this->frameSize.width / pixFmt.getSubsamplingHor(component) * nrBytesPerSample),
+         int(this->frameSize.height / pixFmt.getSubsamplingVer(component))});
+  }
+
+  return video::RawFrameBuffer(std::move(planes), {});
+}
+
 void decoderFFmpeg::copyCurImageToBuffer()
 {
   if (!frame)
@@ -476,6 +505,16 @@ bool decoderFFmpeg::createDecoder(FFmpeg::AVCodecIDWrapper         codecID,
     return this->setErrorB(
         QStringLiteral("Could not request motion vector retrieval. Return code %1").arg(ret));
 
+  // Frame threading delays the output by one frame per thread. Slice threading does not.
+  const auto threadType = this->threading.nrFrameThreads > 1 ? "frame+slice" : "slice";
+  const auto nrThreads  = QByteArray::number(this->threading.nrThreads);
+  ret                   = this->ff.dictSet(opts, "threads", nrThreads.constData(), 0);
+  if (ret >= 0)
+    ret = this->ff.dictSet(opts, "thread_type", threadType, 0);
+  if (ret < 0)
+    return this->setErrorB(
+        QStringLiteral("Could not set the number of decoder threads. Return code %1").arg(ret));
+
   // Open codec
   ret = this->ff.avcodecOpen2(decCtx, videoCodec, opts);
   if (ret < 0)
@@ -57,8 +57,9 @@ public:
   void resetDecoder() override;
 
   // Decoding / pushing data
-  bool       decodeNextFrame() override;
-  QByteArray getRawFrameData() override;
+  bool                  decodeNextFrame() override;
+  QByteArray            getRawFrameData() override;
+  video::RawFrameBuffer getRawFrameBuffer() override;
 
   // Push an AVPacket or raw data. When this returns false, pushing the given packet failed.
   // Probably the decoder switched to DecoderState::RetrieveFrames. Don't forget to push the given
@@ -35,6 +35,7 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <QSettings>
+#include <algorithm>
 #include <cstring>
 
 #include <common/Functions.h>
@@ -72,6 +73,9 @@ using Subsampling = video::yuv::Subsampling;
 namespace
 {
 
+// libde265 does not start more worker threads than this (MAX_THREADS in libde265)
+constexpr auto MAX_LIBDE265_THREADS = 32;
+
 Subsampling convertFromInternalSubsampling(de265_chroma fmt)
 {
   if (fmt == de265_chroma_mono)
@@ -157,6 +161,8 @@ void decoderLibde265::resolveLibraryFunctionPointers()
     return;
   if (!resolve(this->lib.de265_get_error_text, "de265_get_error_text"))
     return;
+  if (!resolve(this->lib.de265_isOK, "de265_isOK"))
+    return;
   if (!resolve(this->lib.de265_get_chroma_format, "de265_get_chroma_format"))
     return;
   if (!resolve(this->lib.de265_get_image_width, "de265_get_image_width"))
@@ -294,10 +300,11 @@ void decoderLibde265::allocateNewDecoder()
   // The highest temporal ID to decode. Set this to very high (all) by default.
   this->lib.de265_set_limit_TID(this->decoder, 100);
 
-  // Set the number of decoder threads. Libde265 can use wavefronts to utilize these.
-  // TODO: We should add a setting for this maybe?
-  auto err = this->lib.de265_start_worker_threads(this->decoder, 8);
-  if (err != DE265_OK)
+  // Set the number of decoder threads. Libde265 can use wavefronts to utilize these. Exceeding the
+  // maximum only gives a warning (DE265_WARNING_NUMBER_OF_THREADS_LIMITED_TO_MAXIMUM).
+  const auto nrThreads = std::min(this->threading.nrThreads, MAX_LIBDE265_THREADS);
+  auto       err       = this->lib.de265_start_worker_threads(this->decoder, nrThreads);
+  if (!this->lib.de265_isOK(err))
     return setError("Error starting libde265 worker threads (de265_start_worker_threads)");
 
   // The decoder is ready to receive data
@@ -411,6 +418,35 @@ QByteArray decoderLibde265::getRawFrameData()
   return this->currentOutputBuffer;
 }
 
+video::RawFrameBuffer decoderLibde265::getRawFrameBuffer()
+{
+  // The internal signals and the statistics are only retrieved when copying the frame
+  if (this->curImage == nullptr || this->decoderState != DecoderState::RetrieveFrames ||
+      this->decodeSignal != 0 || this->statisticsEnabled())
+    return decoderBase::getRawFrameBuffer();
+
+  auto cMode    = this->lib.de265_get_chroma_format(this->curImage);
+  int  nrPlanes = (cMode == de265_chroma_mono) ? 1 : 3;
+
+  std::vector<video::RawFrameBuffer::Plane> planes;
+  for (int c = 0; c < nrPlanes; c++)
+  {
+    int  stride;
+    auto data = this->lib.de265_get_image_plane(this->curImage, c, &stride);
+    if (data == nullptr)
+      return decoderBase::getRawFrameBuffer();
+
+    const int width            = this->lib.de265_get_image_width(this->curImage, c);
+    const int height           = this->lib.de265_get_image_height(this->curImage, c);
+    const int bitDepth         = this->lib.de265_get_bits_per_pixel(this->curImage, c);
+    const int nrBytesPerSample = (bitDepth > 8) ? 2 : 1;
+    planes.push_back({data, stride, width * nrBytesPerSample, height});
+  }
+
+  DEBUG_LIBDE265("decoderLibde265::getRawFrameBuffer wrapped %d planes", nrPlanes);
+  return video::RawFrameBuffer(std::move(planes), {});
+}
+
 bool decoderLibde265::pushData(QByteArray &data)
 {
   if (this->decoderState != DecoderState::NeedsMoreData)
@@ -52,6 +52,7 @@ struct LibraryFunctionsDe265
   de265_error (*de265_start_worker_threads)(de265_decoder_context *, int){};
   void (*de265_set_limit_TID)(de265_decoder_context *, int){};
   const char *(*de265_get_error_text)(de265_error){};
+  int (*de265_isOK)(de265_error){};
   de265_chroma (*de265_get_chroma_format)(const de265_image *){};
   int (*de265_get_image_width)(const de265_image *, int){};
   int (*de265_get_image_height)(const de265_image *, int){};
@@ -108,9 +109,10 @@ public:
   void setDecodeSignal(int signalID, bool &decoderResetNeeded) override;
 
   // Decoding / pushing data
-  bool       decodeNextFrame() override;
-  QByteArray getRawFrameData() override;
-  bool       pushData(QByteArray &data) override;
+  bool                  decodeNextFrame() override;
+  QByteArray            getRawFrameData() override;
+  video::RawFrameBuffer getRawFrameBuffer() override;
+  bool                  pushData(QByteArray &data) override;
 
   // Statistics
   void fillStatisticList(stats::StatisticsData &statisticsData) const override;
@@ -270,6 +270,10 @@ void decoderVVDec::allocateNewDecoder()
 
   params.logLevel = VVDEC_INFO;
 
+  // Parsing ahead delays the output by one frame per parse thread
+  params.threads      = this->threading.nrThreads;
+  params.parseThreads = this->threading.nrFrameThreads - 1;
+
   this->decoder = this->lib.vvdec_decoder_open(&params);
   if (this->decoder == nullptr)
   {
@@ -482,6 +486,33 @@ QByteArray decoderVVDec::getRawFrameData()
   return currentOutputBuffer;
 }
 
+video::RawFrameBuffer decoderVVDec::getRawFrameBuffer()
+{
+  // The internal signals and the statistics are only retrieved when copying the frame
+  if (this->decoderState != DecoderState::RetrieveFrames || this->currentFrame == nullptr ||
+      this->currentFrame->colorFormat == VVDEC_CF_INVALID || this->decodeSignal != 0 ||
+      this->statisticsEnabled())
+    return decoderBase::getRawFrameBuffer();
+
+  const auto bytesPerSample = this->currentFrame->bitDepth > 8 ? 2 : 1;
+
+  std::vector<video::RawFrameBuffer::Plane> planes;
+  for (unsigned c = 0; c < this->currentFrame->numPlanes; c++)
+  {
+    auto &component = this->currentFrame->planes[c];
+    if (component.ptr == nullptr)
+      return decoderBase::getRawFrameBuffer();
+
+    planes.push_back({component.ptr,
+                      int64_t(component.stride),
+                      int(component.width) * bytesPerSample,
+                      int(component.height)});
+  }
+
+  DEBUG_vvdec("decoderVVDec::getRawFrameBuffer wrapped %d planes", int(planes.size()));
+  return video::RawFrameBuffer(std::move(planes), {});
+}
+
 void decoderVVDec::copyImgToByteArray(QByteArray &dst)
 {
   auto fmt = this->currentFrame->colorFormat;
@@ -0,0 +1,222 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FileReadAhead.h"
+
+#include "FileSource.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+
+FileReadAhead::FileReadAhead(FileSource *fileSource,
+                             int64_t     maxBufferedBytes,
+                             int64_t     maxChunkBytes)
+    : fileSource(fileSource), maxBufferedBytes(maxBufferedBytes), maxChunkBytes(maxChunkBytes)
+{
+}
+
+FileReadAhead::~FileReadAhead()
+{
+  {
+    QMutexLocker locker(&this->mutex);
+    this->abort = true;
+  }
+  this->readFuture.waitForFinished();
+}
+
+void FileReadAhead::setPlannedRanges(const std::vector<Range> &ranges)
+{
+  QMutexLocker locker(&this->mutex);
+
+  this->plannedRangeSizes.clear();
+  for (const auto &range : ranges)
+    this->plannedRangeSizes[range.startPos] = range.nrBytes;
+
+  std::set<int64_t> availableStartPositions;
+  for (auto chunk = this->chunks.begin(); chunk != this->chunks.end();)
+  {
+    auto &pending = chunk->pendingRanges;
+    pending.erase(std::remove_if(pending.begin(),
+                                 pending.end(),
+                                 [this](const Range &range) { return !this->isPlanned(range); }),
+                  pending.end());
+    if (pending.empty())
+    {
+      chunk = this->removeChunk(chunk);
+      continue;
+    }
+    for (const auto &range : pending)
+      availableStartPositions.insert(range.startPos);
+    chunk++;
+  }
+  for (const auto &range : this->rangesBeingRead)
+    availableStartPositions.insert(range.startPos);
+
+  this->plannedRanges.clear();
+  for (const auto &range : ranges)
+    if (availableStartPositions.count(range.startPos) == 0)
+      this->plannedRanges.push_back(range);
+
+  this->startReadingIfNeeded();
+}
+
+std::shared_ptr<const char> FileReadAhead::takeRange(const Range &range)
+{
+  QMutexLocker locker(&this->mutex);
+
+  for (auto chunk = this->chunks.begin(); chunk != this->chunks.end(); chunk++)
+  {
+    auto &pending = chunk->pendingRanges;
+    auto  it      = std::find_if(pending.begin(), pending.end(), [&range](const Range &r) {
+      return r.startPos == range.startPos && r.nrBytes == range.nrBytes;
+    });
+    if (it == pending.end())
+      continue;
+
+    pending.erase(it);
+    const auto offset = range.startPos - chunk->startPos;
+    auto       data   = std::shared_ptr<const char>(chunk->data, chunk->data->constData() + offset);
+    if (pending.empty())
+    {
+      // The chunk was used up. This makes space to read the next one.
+      this->removeChunk(chunk);
+      this->startReadingIfNeeded();
+    }
+    return data;
+  }
+
+  // The caller reads this range itself. Don't read it (again) in the background.
+  this->plannedRangeSizes.erase(range.startPos);
+  this->plannedRanges.erase(std::remove_if(this->plannedRanges.begin(),
+                                           this->plannedRanges.end(),
+                                           [&range](const Range &r)
+                                           { return r.startPos == range.startPos; }),
+                            this->plannedRanges.end());
+  return {};
+}
+
+void FileReadAhead::clear()
+{
+  QMutexLocker locker(&this->mutex);
+  this->plannedRanges.clear();
+  this->plannedRangeSizes.clear();
+  this->chunks.clear();
+  this->nrBufferedBytes = 0;
+}
+
+int64_t FileReadAhead::getNrBufferedBytes() const
+{
+  QMutexLocker locker(&this->mutex);
+  return this->nrBufferedBytes;
+}
+
+bool FileReadAhead::isPlanned(const Range &range) const
+{
+  const auto it = this->plannedRangeSizes.find(range.startPos);
+  return it != this->plannedRangeSizes.end() && it->second == range.nrBytes;
+}
+
+void FileReadAhead::startReadingIfNeeded()
+{
+  if (this->reading || this->abort || this->plannedRanges.empty() ||
+      this->nrBufferedBytes >= this->maxBufferedBytes)
+    return;
+
+  this->reading    = true;
+  this->readFuture = QtConcurrent::run([this]() { this->readAheadLoop(); });
+}
+
+void FileReadAhead::readAheadLoop()
+{
+  while (true)
+  {
+    Chunk   chunk;
+    int64_t endPos;
+    {
+      QMutexLocker locker(&this->mutex);
+      if (this->abort || this->plannedRanges.empty() ||
+          this->nrBufferedBytes >= this->maxBufferedBytes)
+      {
+        this->reading = false;
+        return;
+      }
+
+      // Combine consecutive ranges into one chunk. A chunk contains at least one range.
+      chunk.startPos = this->plannedRanges.front().startPos;
+      endPos         = chunk.startPos;
+      while (!this->plannedRanges.empty())
+      {
+        const auto range    = this->plannedRanges.front();
+        const auto rangeEnd = range.startPos + range.nrBytes;
+        if (range.startPos != endPos ||
+            (rangeEnd - chunk.startPos > this->maxChunkBytes && !chunk.pendingRanges.empty()))
+          break;
+        chunk.pendingRanges.push_back(range);
+        endPos = rangeEnd;
+        this->plannedRanges.pop_front();
+      }
+      this->rangesBeingRead = chunk.pendingRanges;
+    }
+
+    chunk.data = std::make_shared<QByteArray>();
+    const auto nrBytesRead =
+        this->fileSource->readBytes(*chunk.data, chunk.startPos, endPos - chunk.startPos);
+
+    QMutexLocker locker(&this->mutex);
+    this->rangesBeingRead.clear();
+
+    // Only keep the ranges which could be read completely and which are still needed
+    auto &pending = chunk.pendingRanges;
+    pending.erase(std::remove_if(pending.begin(),
+                                 pending.end(),
+                                 [&](const Range &range)
+                                 {
+                                   return range.startPos + range.nrBytes >
+                                              chunk.startPos + nrBytesRead ||
+                                          !this->isPlanned(range);
+                                 }),
+                  pending.end());
+    if (!pending.empty())
+    {
+      this->nrBufferedBytes += chunk.data->size();
+      this->chunks.push_back(std::move(chunk));
+    }
+  }
+}
+
+std::deque<FileReadAhead::Chunk>::iterator
+FileReadAhead::removeChunk(std::deque<Chunk>::iterator chunk)
+{
+  this->nrBufferedBytes -= chunk->data->size();
+  return this->chunks.erase(chunk);
+}
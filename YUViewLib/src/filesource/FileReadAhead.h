@@ -0,0 +1,106 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QFuture>
+#include <QMutex>
+
+#include <deque>
+#include <memory>
+#include <map>
+#include <set>
+#include <vector>
+
+class FileSource;
+
+/* Read ranges of a file ahead of time in a background thread. The user announces which ranges of
+ * the file it will need next (e.g. the frames in the caching queue) and the read ahead thread reads
+ * them in large sequential chunks. When a range is needed, it can be taken from the buffer without
+ * copying. Ranges that were not read yet must be read by the caller as usual.
+ */
+class FileReadAhead
+{
+public:
+  struct Range
+  {
+    int64_t startPos{};
+    int64_t nrBytes{};
+  };
+
+  FileReadAhead(FileSource *fileSource, int64_t maxBufferedBytes, int64_t maxChunkBytes);
+  ~FileReadAhead();
+
+  // Set the ranges that will be needed next in the order in which they will be needed. This
+  // replaces the previously planned ranges. Buffered ranges that are no longer planned are dropped.
+  void setPlannedRanges(const std::vector<Range> &ranges);
+
+  // Take the given range from the buffer. The returned pointer keeps the read chunk alive. Returns
+  // nullptr if the range was not read ahead (yet). In this case it is also removed from the plan
+  // because the caller will read it.
+  std::shared_ptr<const char> takeRange(const Range &range);
+
+  // Drop all planned and buffered ranges (e.g. because the file was reopened)
+  void clear();
+
+  int64_t getNrBufferedBytes() const;
+
+private:
+  struct Chunk
+  {
+    int64_t                     startPos{};
+    std::shared_ptr<QByteArray> data;
+    // The ranges in this chunk which were not taken yet
+    std::vector<Range> pendingRanges;
+  };
+
+  bool isPlanned(const Range &range) const;
+  void startReadingIfNeeded();
+  void readAheadLoop();
+  std::deque<Chunk>::iterator removeChunk(std::deque<Chunk>::iterator chunk);
+
+  FileSource   *fileSource{};
+  const int64_t maxBufferedBytes{};
+  const int64_t maxChunkBytes{};
+
+  mutable QMutex             mutex;
+  std::deque<Range>          plannedRanges;
+  // The size of all planned ranges by their start position (including the ones that were read)
+  std::map<int64_t, int64_t> plannedRangeSizes;
+  std::vector<Range>         rangesBeingRead;
+  std::deque<Chunk>          chunks;
+  int64_t                    nrBufferedBytes{};
+  bool                       reading{};
+  bool                       abort{};
+  QFuture<void>              readFuture;
+};
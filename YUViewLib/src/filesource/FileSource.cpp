@@ -39,9 +39,15 @@
 #include <QDir>
 #include <QSettings>
 #include <QtGlobal>
+
+#include <algorithm>
 #ifdef Q_OS_WIN
 #include <windows.h>
 #endif
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #define FILESOURCE_DEBUG_SIMULATESLOWLOADING 0
 #if FILESOURCE_DEBUG_SIMULATESLOWLOADING && !NDEBUG
@@ -64,6 +70,14 @@ bool FileSource::openFile(const std::filesystem::path &filePath)
   if (this->isFileOpened && this->srcFile.isOpen())
     this->srcFile.close();
 
+  {
+    // Pointers that were handed out by getMappedData keep the old mapping alive
+    QMutexLocker locker(&this->readMutex);
+    this->mappedFile.reset();
+    this->mappedData = nullptr;
+    this->mappedSize = 0;
+  }
+
   this->srcFile.setFileName(QString::fromStdString(filePath.string()));
   this->isFileOpened = this->srcFile.open(QIODevice::ReadOnly);
   if (!this->isFileOpened)
@@ -96,6 +110,61 @@ int64_t FileSource::readBytes(QByteArray &targetBuffer, int64_t startPos, int64_
   return this->srcFile.read(targetBuffer.data(), nrBytes);
 }
 
+bool FileSource::mapFile()
+{
+  if (!this->isOk())
+    return false;
+
+  QMutexLocker locker(&this->readMutex);
+  if (this->mappedData != nullptr)
+    return true;
+
+  auto file = std::make_shared<QFile>(QString::fromStdString(this->fullFilePath.string()));
+  if (!file->open(QIODevice::ReadOnly) || file->size() <= 0)
+    return false;
+
+  const auto size = file->size();
+  const auto data = file->map(0, size);
+  if (data == nullptr)
+    return false;
+
+  this->mappedFile = file;
+  this->mappedData = data;
+  this->mappedSize = size;
+  return true;
+}
+
+std::shared_ptr<const unsigned char> FileSource::getMappedData(int64_t startPos, int64_t nrBytes)
+{
+  QMutexLocker locker(&this->readMutex);
+  if (this->mappedData == nullptr || startPos < 0 || nrBytes < 0 ||
+      startPos + nrBytes > this->mappedSize)
+    return {};
+
+  // The returned pointer shares the ownership of the mapped file
+  return std::shared_ptr<const unsigned char>(this->mappedFile, this->mappedData + startPos);
+}
+
+void FileSource::adviseReadAhead(int64_t startPos, int64_t nrBytes)
+{
+#ifdef Q_OS_UNIX
+  QMutexLocker locker(&this->readMutex);
+  if (this->mappedData == nullptr || startPos < 0 || nrBytes <= 0 || startPos >= this->mappedSize)
+    return;
+
+  // The address must be aligned to the page size
+  const auto pageSize     = int64_t(sysconf(_SC_PAGESIZE));
+  const auto alignedStart = startPos - startPos % pageSize;
+  const auto end          = std::min(startPos + nrBytes, this->mappedSize);
+  posix_madvise(const_cast<unsigned char *>(this->mappedData) + alignedStart,
+                size_t(end - alignedStart),
+                POSIX_MADV_WILLNEED);
+#else
+  (void)startPos;
+  (void)nrBytes;
+#endif
+}
+
 std::vector<InfoItem> FileSource::getFileInfoList() const
 {
   if (!this->isFileOpened)
@@ -44,6 +44,7 @@
 #include <common/Typedef.h>
 
 #include <filesystem>
+#include <memory>
 
 enum class InputFormat
 {
@@ -86,7 +87,8 @@ public:
   virtual bool atEnd() const { return !this->isFileOpened ? true : this->srcFile.atEnd(); }
   QByteArray   readLine() { return !this->isFileOpened ? QByteArray() : this->srcFile.readLine(); }
   virtual bool seek(int64_t pos) { return !this->isFileOpened ? false : this->srcFile.seek(pos); }
-  int64_t      pos() { return !this->isFileOpened ? 0 : this->srcFile.pos(); }
+
+  virtual int64_t pos() { return !this->isFileOpened ? 0 : this->srcFile.pos(); }
 
   // Get the file size in bytes
 
@@ -94,6 +96,20 @@ public:
   // Resize the QByteArray if necessary. Return how many bytes were read.
   int64_t readBytes(QByteArray &targetBuffer, int64_t startPos, int64_t nrBytes);
 
+  // Map the whole file into memory. If this succeeds, ranges of the file can be accessed using
+  // getMappedData without copying them and without locking. Reading with readBytes still works.
+  bool mapFile();
+  bool isMapped() const { return this->mappedData != nullptr; }
+
+  // Get a pointer to the given range of the mapped file. The mapping stays valid as long as a copy
+  // of the returned pointer exists (even if the file is reopened in the meantime). Returns nullptr
+  // if the file is not mapped or the range is not within the mapping.
+  std::shared_ptr<const unsigned char> getMappedData(int64_t startPos, int64_t nrBytes);
+
+  // Tell the operating system that the given range of the mapped file will be needed soon so that
+  // it can read it in the background. This is only supported on unix systems.
+  void adviseReadAhead(int64_t startPos, int64_t nrBytes);
+
   void updateFileWatchSetting();
   void clearFileCache();
 
@@ -110,4 +126,9 @@ private:
   bool               fileChanged{};
 
   QMutex readMutex;
+
+  // The mapping uses its own QFile because closing a QFile unmaps all of its mappings
+  std::shared_ptr<QFile> mappedFile;
+  const unsigned char   *mappedData{};
+  int64_t                mappedSize{};
 };
@@ -32,6 +32,12 @@
 
 #include "FileSourceAnnexBFile.h"
 
+#include "StartCodeSearch.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+
 #define ANNEXBFILE_DEBUG_OUTPUT 0
 #if ANNEXBFILE_DEBUG_OUTPUT && !NDEBUG
 #include <QDebug>
@@ -40,13 +46,13 @@
 #define DEBUG_ANNEXBFILE(f) ((void)0)
 #endif
 
-const auto BUFFERSIZE = 500000;
-const auto STARTCODE  = QByteArrayLiteral("\x00\x00\x01");
+// The size of the chunks that are read if the file is not mapped
+const auto BUFFERSIZE = int64_t(500000);
 
-FileSourceAnnexBFile::FileSourceAnnexBFile()
-{
-  this->fileBuffer.resize(BUFFERSIZE);
-}
+// If the file is mapped, the operating system is asked to read this far ahead
+const auto READAHEADSIZE = int64_t(8 * 1024 * 1024);
+
+FileSourceAnnexBFile::FileSourceAnnexBFile() = default;
 
 FileSourceAnnexBFile::FileSourceAnnexBFile(const std::filesystem::path &filePath)
     : FileSourceAnnexBFile()
@@ -54,17 +60,36 @@ FileSourceAnnexBFile::FileSourceAnnexBFile(const std::filesystem::path &filePath
   this->openFile(filePath);
 }
 
+FileSourceAnnexBFile::~FileSourceAnnexBFile()
+{
+  // The background read accesses the file
+  this->waitForNextChunk();
+}
+
 // Open the file and fill the read buffer.
 bool FileSourceAnnexBFile::openFile(const std::filesystem::path &fileName)
 {
   DEBUG_ANNEXBFILE("FileSourceAnnexBFile::openFile fileName " << fileName);
 
+  this->waitForNextChunk();
+  this->lastReturnArray.clear();
+  this->mappedData.reset();
+  this->windowBuffer.clear();
+  this->data     = nullptr;
+  this->dataSize = 0;
+
   // Open the input file (again)
-  FileSource::openFile(fileName);
+  if (!FileSource::openFile(fileName))
+    return false;
 
-  // Fill the buffer
-  this->fileBufferSize = srcFile.read(this->fileBuffer.data(), BUFFERSIZE);
-  if (this->fileBufferSize == 0)
+  this->fileSize = this->getFileSize().value_or(0);
+  if (this->useFileMapping && this->mapFile())
+  {
+    this->mappedData            = this->getMappedData(0, this->fileSize);
+    this->readAheadAdvisedUntil = 0;
+  }
+
+  if (!this->fillData(0))
     // The file is empty of there was an error reading from the file.
     return false;
 
@@ -75,27 +100,28 @@ bool FileSourceAnnexBFile::openFile(const std::filesystem::path &fileName)
 
 bool FileSourceAnnexBFile::atEnd() const
 {
-  return this->fileBufferSize < BUFFERSIZE && this->posInBuffer >= int64_t(this->fileBufferSize);
+  return this->posInData >= this->dataSize &&
+         this->dataStartPosInFile + this->dataSize >= this->fileSize;
+}
+
+int64_t FileSourceAnnexBFile::pos()
+{
+  return this->dataStartPosInFile + this->posInData;
 }
 
 void FileSourceAnnexBFile::seekToFirstNAL()
 {
-  auto nextStartCodePos = this->fileBuffer.indexOf(STARTCODE);
-  if (nextStartCodePos < 0)
-    // The first buffer does not contain a start code. This is very unusual. Use the normal
-    // getNextNALUnit to seek
-    this->getNextNALUnit();
+  const auto nextStartCodePos = this->findNextStartCode(this->pos());
+
+  // For 0001 or 001 point to the first 0 byte
+  if (nextStartCodePos < this->dataSize && nextStartCodePos > this->posInData &&
+      this->data[nextStartCodePos - 1] == 0)
+    this->posInData = nextStartCodePos - 1;
   else
-  {
-    // For 0001 or 001 point to the first 0 byte
-    if (nextStartCodePos > 0 && this->fileBuffer.at(nextStartCodePos - 1) == (char)0)
-      this->posInBuffer = nextStartCodePos - 1;
-    else
-      this->posInBuffer = nextStartCodePos;
-  }
+    this->posInData = nextStartCodePos;
 
-  assert(this->posInBuffer >= 0);
-  this->nrBytesBeforeFirstNAL = this->bufferStartPosInFile + uint64_t(this->posInBuffer);
+  assert(this->posInData >= 0);
+  this->nrBytesBeforeFirstNAL = uint64_t(this->pos());
 }
 
 QByteArray FileSourceAnnexBFile::getNextNALUnit(bool        getLastDataAgain,
@@ -104,101 +130,34 @@ QByteArray FileSourceAnnexBFile::getNextNALUnit(bool        getLastDataAgain,
   if (getLastDataAgain)
     return this->lastReturnArray;
 
-  this->lastReturnArray.clear();
+  this->adviseReadAheadIfNeeded();
 
   if (startEndPosInFile)
-    startEndPosInFile->first = this->bufferStartPosInFile + uint64_t(this->posInBuffer);
+    startEndPosInFile->first = uint64_t(this->pos());
 
-  int  nextStartCodePos = -1;
-  int  searchOffset     = 3;
-  bool startCodeFound   = false;
-  while (!startCodeFound)
+  // Reading more data may move the current position within the data
+  auto nextStartCodePos = this->findNextStartCode(this->pos() + 3);
+  if (nextStartCodePos < this->dataSize)
   {
-    if (this->posInBuffer < 0)
-    {
-      // Part of the start code was in the last buffer (see special boundary cases below). Add those
-      // parts.
-      const auto nrZeroBytesMissing = std::abs(this->posInBuffer);
-      this->lastReturnArray.append(nrZeroBytesMissing, char(0));
-    }
-    nextStartCodePos = this->fileBuffer.indexOf(STARTCODE, this->posInBuffer + searchOffset);
-
-    if (nextStartCodePos < 0 || (uint64_t)nextStartCodePos > this->fileBufferSize)
-    {
-      // No start code found ... append all data in the current buffer.
-      this->lastReturnArray +=
-          this->fileBuffer.mid(this->posInBuffer, this->fileBufferSize - this->posInBuffer);
-      DEBUG_ANNEXBFILE("FileSourceHEVCAnnexBFile::getNextNALUnit no start code found - ret size "
-                       << this->lastReturnArray.size());
-
-      if (this->fileBufferSize < BUFFERSIZE)
-      {
-        // We are out of file and could not find a next position
-        this->posInBuffer = BUFFERSIZE;
-        if (startEndPosInFile)
-          startEndPosInFile->second = this->bufferStartPosInFile + this->fileBufferSize - 1;
-        return this->lastReturnArray;
-      }
-
-      // Before we load the next bytes: The start code might be located at the boundary to the next
-      // buffer
-      const auto lastByteZero0 = this->fileBuffer.at(this->fileBufferSize - 3) == (char)0;
-      const auto lastByteZero1 = this->fileBuffer.at(this->fileBufferSize - 2) == (char)0;
-      const auto lastByteZero2 = this->fileBuffer.at(this->fileBufferSize - 1) == (char)0;
-
-      // We have to continue searching - get the next buffer
-      updateBuffer();
-
-      if (this->fileBufferSize > 2)
-      {
-        // Now look for the special boundary case:
-        if (this->fileBuffer.at(0) == (char)1 && lastByteZero2 && lastByteZero1)
-        {
-          // Found a start code - the 1 byte is here and the two (or three) 0 bytes were in the last
-          // buffer
-          startCodeFound   = true;
-          nextStartCodePos = lastByteZero0 ? -3 : -2;
-          this->lastReturnArray.chop(lastByteZero0 ? 3 : 2);
-        }
-        else if (this->fileBuffer.at(0) == (char)0 && this->fileBuffer.at(1) == (char)1 &&
-                 lastByteZero2)
-        {
-          // Found a start code - the 01 bytes are here and the one (or two) 0 bytes were in the
-          // last buffer
-          startCodeFound   = true;
-          nextStartCodePos = lastByteZero1 ? -2 : -1;
-          this->lastReturnArray.chop(lastByteZero0 ? 1 : 1);
-        }
-        else if (this->fileBuffer.at(0) == (char)0 && this->fileBuffer.at(1) == (char)0 &&
-                 this->fileBuffer.at(2) == (char)1)
-        {
-          // Found a start code - the 001 bytes are here. Check the last byte of the last buffer
-          startCodeFound   = true;
-          nextStartCodePos = lastByteZero2 ? -1 : 0;
-          if (lastByteZero2)
-            this->lastReturnArray.chop(1);
-        }
-      }
-
-      searchOffset = 0;
-    }
-    else
-    {
-      // Start code found. Check if the start code is 001 or 0001
-      startCodeFound = true;
-      if (this->fileBuffer.at(nextStartCodePos - 1) == (char)0)
-        nextStartCodePos--;
-    }
+    // Start code found. Check if the start code is 001 or 0001
+    if (this->data[nextStartCodePos - 1] == 0)
+      nextStartCodePos--;
+    if (startEndPosInFile)
+      startEndPosInFile->second = uint64_t(this->dataStartPosInFile + nextStartCodePos);
+  }
+  else
+  {
+    // We are out of file and could not find a next position. Return all remaining data.
+    if (startEndPosInFile)
+      startEndPosInFile->second = uint64_t(this->dataStartPosInFile + this->dataSize - 1);
   }
 
-  // Position found
-  if (startEndPosInFile)
-    startEndPosInFile->second = this->bufferStartPosInFile + nextStartCodePos;
-  if (nextStartCodePos > int(this->posInBuffer))
-    this->lastReturnArray +=
-        this->fileBuffer.mid(this->posInBuffer, nextStartCodePos - this->posInBuffer);
-  this->posInBuffer = nextStartCodePos;
-  DEBUG_ANNEXBFILE("FileSourceAnnexBFile::getNextNALUnit start code found - ret size "
+  // The data stays valid until the next call which may read more data
+  this->lastReturnArray =
+      QByteArray::fromRawData(reinterpret_cast<const char *>(this->data + this->posInData),
+                              int(nextStartCodePos - this->posInData));
+  this->posInData = nextStartCodePos;
+  DEBUG_ANNEXBFILE("FileSourceAnnexBFile::getNextNALUnit ret size "
                    << this->lastReturnArray.size());
   return this->lastReturnArray;
 }
@@ -216,16 +175,20 @@ QByteArray FileSourceAnnexBFile::getFrameData(pairUint64 startEndFilePos)
 
   // Seek the source file to the start position
   this->seek(start);
+  if (end > start)
+    retArray.reserve(int(end - start) + 16);
 
   // Retrieve NAL units (and repackage them) until we reached out end position
-  while (end > this->bufferStartPosInFile + this->posInBuffer)
+  while (end > uint64_t(this->pos()) && !this->atEnd())
   {
     auto nalData = getNextNALUnit();
+    if (nalData.size() < 3)
+      break;
 
     int headerOffset = 0;
     if (nalData.at(0) == (char)0 && nalData.at(1) == (char)0)
     {
-      if (nalData.at(2) == (char)0 && nalData.at(3) == (char)1)
+      if (nalData.size() > 3 && nalData.at(2) == (char)0 && nalData.at(3) == (char)1)
         headerOffset = 4;
       else if (nalData.at(2) == (char)1)
         headerOffset = 3;
@@ -241,17 +204,115 @@ QByteArray FileSourceAnnexBFile::getFrameData(pairUint64 startEndFilePos)
   return retArray;
 }
 
-bool FileSourceAnnexBFile::updateBuffer()
+bool FileSourceAnnexBFile::fillData(int64_t posInFile)
+{
+  if (this->mappedData)
+  {
+    this->data               = this->mappedData.get();
+    this->dataSize           = this->fileSize;
+    this->dataStartPosInFile = 0;
+    this->posInData          = std::min(posInFile, this->fileSize);
+    this->adviseReadAheadIfNeeded();
+    return this->posInData < this->dataSize;
+  }
+
+  // A chunk that is still being read is not needed anymore
+  this->waitForNextChunk();
+  const auto nrBytesRead = this->readBytes(this->windowBuffer, posInFile, BUFFERSIZE);
+  this->windowBuffer.resize(int(std::max(nrBytesRead, int64_t(0))));
+  this->data = reinterpret_cast<const unsigned char *>(this->windowBuffer.constData());
+
+  this->dataSize           = this->windowBuffer.size();
+  this->dataStartPosInFile = posInFile;
+  this->posInData          = 0;
+
+  this->startReadingNextChunk();
+  return this->dataSize > 0;
+}
+
+bool FileSourceAnnexBFile::appendNextChunk()
+{
+  // If no chunk is being read, the future is canceled
+  if (this->mappedData || this->nextChunk.isCanceled())
+    return false;
+
+  const auto chunk = this->nextChunk.result();
+  this->nextChunk  = {};
+  if (chunk.isEmpty())
+    return false;
+
+  // Previously returned NAL units may still point into the old buffer so we create a new one
+  QByteArray newWindow;
+  newWindow.reserve(int(this->dataSize - this->posInData) + chunk.size());
+  newWindow.append(reinterpret_cast<const char *>(this->data + this->posInData),
+                   int(this->dataSize - this->posInData));
+  newWindow.append(chunk);
+
+  this->dataStartPosInFile += this->posInData;
+  this->windowBuffer = newWindow;
+  this->data         = reinterpret_cast<const unsigned char *>(this->windowBuffer.constData());
+  this->dataSize     = this->windowBuffer.size();
+  this->posInData    = 0;
+
+  DEBUG_ANNEXBFILE("FileSourceAnnexBFile::appendNextChunk dataSize " << this->dataSize);
+  this->startReadingNextChunk();
+  return true;
+}
+
+void FileSourceAnnexBFile::startReadingNextChunk()
+{
+  const auto chunkStart = this->dataStartPosInFile + this->dataSize;
+  if (chunkStart >= this->fileSize)
+    return;
+
+  this->nextChunk = QtConcurrent::run([this, chunkStart]() {
+    QByteArray chunk;
+    const auto nrBytesRead = this->readBytes(chunk, chunkStart, BUFFERSIZE);
+    chunk.resize(int(std::max(nrBytesRead, int64_t(0))));
+    return chunk;
+  });
+}
+
+void FileSourceAnnexBFile::waitForNextChunk()
 {
-  // Save the position of the first byte in this new buffer
-  this->bufferStartPosInFile += this->fileBufferSize;
+  this->nextChunk.waitForFinished();
+  this->nextChunk = {};
+}
+
+void FileSourceAnnexBFile::adviseReadAheadIfNeeded()
+{
+  if (!this->mappedData)
+    return;
+
+  // Advise the next range when half of the last one was parsed
+  const auto position = this->pos();
+  if (position >= this->readAheadAdvisedUntil - READAHEADSIZE / 2 ||
+      position < this->readAheadAdvisedUntil - READAHEADSIZE)
+  {
+    this->adviseReadAhead(position, READAHEADSIZE);
+    this->readAheadAdvisedUntil = position + READAHEADSIZE;
+  }
+}
 
-  this->fileBufferSize = srcFile.read(this->fileBuffer.data(), BUFFERSIZE);
-  this->posInBuffer    = 0;
+int64_t FileSourceAnnexBFile::findNextStartCode(int64_t searchStartInFile)
+{
+  while (true)
+  {
+    const auto searchStart = searchStartInFile - this->dataStartPosInFile;
+    if (searchStart < this->dataSize)
+    {
+      const auto offset = filesource::findNextStartCode(
+          this->data + searchStart, std::size_t(this->dataSize - searchStart));
+      if (searchStart + int64_t(offset) < this->dataSize)
+        return searchStart + int64_t(offset);
+    }
 
-  DEBUG_ANNEXBFILE("FileSourceAnnexBFile::updateBuffer this->fileBufferSize "
-                   << this->fileBufferSize);
-  return (this->fileBufferSize > 0);
+    // A start code may begin in the last two bytes of the current data
+    const auto dataEndInFile = this->dataStartPosInFile + this->dataSize;
+    searchStartInFile        = std::max(searchStartInFile, dataEndInFile - 2);
+    if (!this->appendNextChunk())
+      return this->dataSize;
+  }
 }
 
 bool FileSourceAnnexBFile::seek(int64_t pos)
@@ -260,25 +321,20 @@ bool FileSourceAnnexBFile::seek(int64_t pos)
     return false;
 
   DEBUG_ANNEXBFILE("FileSourceAnnexBFile::seek to " << pos);
-  // Seek the file and update the buffer
-  srcFile.seek(pos);
-  this->fileBufferSize = srcFile.read(this->fileBuffer.data(), BUFFERSIZE);
-  if (this->fileBufferSize == 0)
+  if (!this->fillData(pos))
     // The file is empty of there was an error reading from the file.
     return false;
-  this->bufferStartPosInFile = pos;
-  this->posInBuffer          = 0;
 
   if (pos == 0)
     this->seekToFirstNAL();
   else
   {
     // Check if we are at a start code position (001 or 0001)
-    if (this->fileBuffer.at(0) == (char)0 && this->fileBuffer.at(1) == (char)0 &&
-        this->fileBuffer.at(2) == (char)0 && this->fileBuffer.at(3) == (char)1)
+    const auto remaining = this->dataSize - this->posInData;
+    const auto d         = this->data + this->posInData;
+    if (remaining >= 4 && d[0] == 0 && d[1] == 0 && d[2] == 0 && d[3] == 1)
       return true;
-    if (this->fileBuffer.at(0) == (char)0 && this->fileBuffer.at(1) == (char)0 &&
-        this->fileBuffer.at(2) == (char)1)
+    if (remaining >= 3 && d[0] == 0 && d[1] == 0 && d[2] == 1)
       return true;
 
     DEBUG_ANNEXBFILE("FileSourceAnnexBFile::seek could not find start code at seek position");
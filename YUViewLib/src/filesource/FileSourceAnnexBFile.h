@@ -35,11 +35,16 @@
 #include <common/Typedef.h>
 #include <filesource/FileSource.h>
 
+#include <QFuture>
+
+#include <memory>
+
 /* This class is a normal FileSource for opening of raw AnnexBFiles.
  * Basically it understands that this is a binary file where each unit starts with a start code
  * (0x0000001)
- * TODO: The reading / parsing could be performed in a background thread in order to increase the
- * performance
+ * If possible, the file is mapped into memory and the operating system is asked to read ahead.
+ * Otherwise, the file is read in chunks and the next chunk is always read in a background thread
+ * while the current one is parsed.
  */
 class FileSourceAnnexBFile : public FileSource
 {
@@ -48,12 +53,19 @@ class FileSourceAnnexBFile : public FileSource
 public:
   FileSourceAnnexBFile();
   FileSourceAnnexBFile(const std::filesystem::path &filePath);
+  ~FileSourceAnnexBFile();
 
   bool openFile(const std::filesystem::path &filePath) override;
 
   // Is the file at the end?
   bool atEnd() const override;
 
+  // The file position of the next NAL unit
+  int64_t pos() override;
+
+  // Map the file into memory when it is opened (default). If disabled, the file is read in chunks.
+  void setUseFileMapping(bool useMapping) { this->useFileMapping = useMapping; }
+
   // --- Retrieving of data from the file ---
   // You can either read a file NAL by NAL or frame by frame. Do not mix the two interfaces.
   // TODO: We could always use the second option, right? Also for the libde265 and HM decoder this
@@ -63,6 +75,8 @@ public:
   // Also return the start and end position of the NAL unit in the file so you can seek to it.
   // startEndPosInFile: The file positions of the first byte in the NAL header and the end position
   // of the last byte
+  // The returned array does not own its data. It is only valid until the next call to
+  // getNextNALUnit, seek or openFile. Copy it if it is needed longer.
   QByteArray getNextNALUnit(bool getLastDataAgain = false, pairUint64 *startEndPosInFile = nullptr);
 
   // Get all bytes that are needed to decode the next frame (from the given start to the given end
@@ -76,19 +90,39 @@ public:
   uint64_t getNrBytesBeforeFirstNAL() const { return this->nrBytesBeforeFirstNAL; }
 
 protected:
-  QByteArray fileBuffer;
-  uint64_t   fileBufferSize{0}; ///< How many of the bytes are used? We don't resize the fileBuffer
-  uint64_t   bufferStartPosInFile{
-      0}; ///< The byte position in the file of the start of the currently loaded buffer
-
-  // The current position in the input buffer in bytes. This always points to the first byte of a
-  // start code. So if the start code is 0001 it will point to the first byte (the first 0). If the
-  // start code is 001, it will point to the first 0 here. Note: The pos may be negative if we
-  // update the buffer and the start of the start code was in the previous buffer
-  int64_t posInBuffer{0};
-
-  // load the next buffer
-  bool updateBuffer();
+  // The data that is currently available. If the file is mapped, this is the whole file. Otherwise
+  // it is the windowBuffer which contains the data from posInData up to the last chunk read.
+  const unsigned char *data{};
+  int64_t              dataSize{};
+  int64_t              dataStartPosInFile{};
+  int64_t              fileSize{};
+
+  // The current position in the data in bytes. This always points to the first byte of a start
+  // code. So if the start code is 0001 it will point to the first byte (the first 0). If the start
+  // code is 001, it will point to the first 0 here.
+  int64_t posInData{};
+
+  bool                                 useFileMapping{true};
+  std::shared_ptr<const unsigned char> mappedData;
+  int64_t                              readAheadAdvisedUntil{};
+
+  QByteArray          windowBuffer;
+  QFuture<QByteArray> nextChunk;
+
+  // Fill the data starting at the given position in the file. Returns false if there is no data.
+  bool fillData(int64_t posInFile);
+  // Append the next chunk (which was read in the background) to the window buffer and drop all
+  // bytes before posInData. Returns false if the end of the file was reached.
+  bool appendNextChunk();
+  void startReadingNextChunk();
+  void waitForNextChunk();
+
+  // If the file is mapped, let the operating system read ahead of the current position.
+  void adviseReadAheadIfNeeded();
+
+  // Find the next start code at or after the given position in the file. More data is read if
+  // needed. Returns the position in the data or dataSize if there is no further start code.
+  int64_t findNextStartCode(int64_t searchStartInFile);
 
   // Seek to the first NAL header in the bitstream
   void seekToFirstNAL();
@@ -32,12 +32,14 @@
 
 #include "FileSourceFFmpegFile.h"
 
+#include <QDataStream>
 #include <QProgressDialog>
 #include <QSettings>
 #include <fstream>
 
 #include <common/Formatting.h>
 #include <ffmpeg/AVCodecContextWrapper.h>
+#include <filesource/StreamIndexCache.h>
 #include <parser/AV1/obu_header.h>
 #include <parser/common/SubByteReaderLogging.h>
 
@@ -57,6 +59,9 @@ namespace
 
 auto startCode = QByteArrayLiteral("\x00\x00\x01");
 
+// Increase the version whenever the content of the stream index changes
+const auto STREAM_INDEX_TYPE = QString("FFmpeg/1");
+
 uint64_t getBoxSize(ByteVector::const_iterator iterator)
 {
   uint64_t size = 0;
@@ -436,10 +441,21 @@ bool FileSourceFFmpegFile::openFile(const QString        &filePath,
   }
   else if (parseFile)
   {
+    auto streamIndexCache = filesource::StreamIndexCache::getDefault();
+    if (streamIndexCache)
+    {
+      const auto indexData = streamIndexCache->loadIndex(filePath, STREAM_INDEX_TYPE);
+      if (indexData && this->loadStreamIndex(*indexData))
+        return true;
+    }
+
     if (!this->scanBitstream(mainWindow))
       return false;
 
     this->seekFileToBeginning();
+
+    if (streamIndexCache)
+      streamIndexCache->storeIndex(filePath, STREAM_INDEX_TYPE, this->createStreamIndex());
   }
 
   return true;
@@ -479,6 +495,15 @@ std::pair<int64_t, size_t> FileSourceFFmpegFile::getClosestSeekableFrameBefore(i
   return {bestSeekDTS, seekToFrameIdx};
 }
 
+std::vector<size_t> FileSourceFFmpegFile::getKeyFrameIndices() const
+{
+  std::vector<size_t> indices;
+  indices.reserve(size_t(this->keyFrameList.size()));
+  for (const auto &pic : this->keyFrameList)
+    indices.push_back(pic.frame);
+  return indices;
+}
+
 bool FileSourceFFmpegFile::scanBitstream(QWidget *mainWindow)
 {
   if (!this->isFileOpened)
@@ -533,6 +558,42 @@ bool FileSourceFFmpegFile::scanBitstream(QWidget *mainWindow)
   return !progress->wasCanceled();
 }
 
+QByteArray FileSourceFFmpegFile::createStreamIndex() const
+{
+  QByteArray  indexData;
+  QDataStream stream(&indexData, QIODevice::WriteOnly);
+
+  stream << quint64(this->nrFrames) << quint32(this->keyFrameList.size());
+  for (const auto &pic : this->keyFrameList)
+    stream << quint64(pic.frame) << qint64(pic.dts);
+
+  return indexData;
+}
+
+bool FileSourceFFmpegFile::loadStreamIndex(const QByteArray &indexData)
+{
+  QDataStream stream(indexData);
+
+  quint64           nrFrames{};
+  quint32           nrKeyFrames{};
+  QList<pictureIdx> keyFrameList;
+  stream >> nrFrames >> nrKeyFrames;
+  for (quint32 i = 0; i < nrKeyFrames && stream.status() == QDataStream::Ok; i++)
+  {
+    quint64 frame{};
+    qint64  dts{};
+    stream >> frame >> dts;
+    keyFrameList.append(pictureIdx(size_t(frame), dts));
+  }
+
+  if (stream.status() != QDataStream::Ok || keyFrameList.isEmpty())
+    return false;
+
+  this->nrFrames     = size_t(nrFrames);
+  this->keyFrameList = keyFrameList;
+  return true;
+}
+
 void FileSourceFFmpegFile::openFileAndFindVideoStream(QString fileName)
 {
   this->isFileOpened = false;
@@ -123,6 +123,8 @@ public:
   // the given frameIdx where we can start decoding
   // Return: POC and frame index
   std::pair<int64_t, size_t> getClosestSeekableFrameBefore(int frameIdx) const;
+  // The frame indices of all keyframes in ascending order
+  std::vector<size_t> getKeyFrameIndices() const;
 
   QStringList getFFmpegLoadingLog() const { return ff.getLog(); }
 
@@ -182,6 +184,11 @@ protected:
   bool   scanBitstream(QWidget *mainWindow);
   size_t nrFrames{0};
 
+  // The number of frames and the keyframes are saved in the stream index so that the bitstream
+  // does not have to be scanned again when the file is opened the next time.
+  QByteArray createStreamIndex() const;
+  bool       loadStreamIndex(const QByteArray &indexData);
+
   // Private struct for navigation. We index frames by frame number and FFMpeg uses the pts.
   // This connects both values.
   struct pictureIdx
@@ -0,0 +1,160 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartCodeSearch.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define YUVIEW_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define YUVIEW_SIMD_X86 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// See ConversionYUVSIMD.cpp
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE4_1
+#define TARGET_AVX2
+#endif
+
+namespace filesource
+{
+
+using video::yuv::simd::InstructionSet;
+
+namespace
+{
+
+std::size_t findNextStartCodeScalar(const unsigned char *data, std::size_t start, std::size_t size)
+{
+  auto i = start;
+  while (i + 2 < size)
+  {
+    // If the third byte is neither 0 nor 1, no start code can begin at any of the three positions.
+    if (data[i + 2] > 1)
+      i += 3;
+    else if (data[i + 2] == 1 && data[i + 1] == 0 && data[i] == 0)
+      return i;
+    else
+      i++;
+  }
+  return size;
+}
+
+#if YUVIEW_SIMD_X86
+
+int getIndexOfLowestBit(unsigned mask)
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return int(index);
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+// Compare 16 (or 32) positions at once: A start code begins at every position where the byte is 0,
+// the next byte is 0 and the byte after that is 1.
+TARGET_SSE4_1 std::size_t findNextStartCodeSSE4_1(const unsigned char *data, std::size_t size)
+{
+  const auto zero = _mm_setzero_si128();
+  const auto one  = _mm_set1_epi8(1);
+
+  std::size_t i = 0;
+  for (; i + 18 <= size; i += 16)
+  {
+    const auto byte0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    const auto byte1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 1));
+    const auto byte2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + 2));
+    const auto isStartCode =
+        _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(byte0, zero), _mm_cmpeq_epi8(byte1, zero)),
+                      _mm_cmpeq_epi8(byte2, one));
+    const auto mask = unsigned(_mm_movemask_epi8(isStartCode));
+    if (mask != 0)
+      return i + getIndexOfLowestBit(mask);
+  }
+  return findNextStartCodeScalar(data, i, size);
+}
+
+TARGET_AVX2 std::size_t findNextStartCodeAVX2(const unsigned char *data, std::size_t size)
+{
+  const auto zero = _mm256_setzero_si256();
+  const auto one  = _mm256_set1_epi8(1);
+
+  std::size_t i = 0;
+  for (; i + 34 <= size; i += 32)
+  {
+    const auto byte0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    const auto byte1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 1));
+    const auto byte2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + 2));
+    const auto isStartCode = _mm256_and_si256(
+        _mm256_and_si256(_mm256_cmpeq_epi8(byte0, zero), _mm256_cmpeq_epi8(byte1, zero)),
+        _mm256_cmpeq_epi8(byte2, one));
+    const auto mask = unsigned(_mm256_movemask_epi8(isStartCode));
+    if (mask != 0)
+      return i + getIndexOfLowestBit(mask);
+  }
+  return findNextStartCodeScalar(data, i, size);
+}
+
+#endif
+
+} // namespace
+
+std::size_t findNextStartCode(const unsigned char *data, std::size_t size)
+{
+  static const auto instructionSet = video::yuv::simd::getSupportedInstructionSet();
+  return findNextStartCode(instructionSet, data, size);
+}
+
+std::size_t
+findNextStartCode(InstructionSet instructionSet, const unsigned char *data, std::size_t size)
+{
+#if YUVIEW_SIMD_X86
+  if (instructionSet == InstructionSet::AVX2)
+    return findNextStartCodeAVX2(data, size);
+  if (instructionSet == InstructionSet::SSE4_1)
+    return findNextStartCodeSSE4_1(data, size);
+#else
+  (void)instructionSet;
+#endif
+  return findNextStartCodeScalar(data, 0, size);
+}
+
+} // namespace filesource
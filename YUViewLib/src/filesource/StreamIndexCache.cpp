@@ -0,0 +1,125 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StreamIndexCache.h"
+
+#include <common/Functions.h>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+
+namespace filesource
+{
+
+namespace
+{
+
+const auto FILE_SUFFIX  = QString(".yuvindex");
+const auto FILE_MAGIC   = quint32(0x59564958); // "YVIX"
+const auto FILE_VERSION = quint32(1);
+
+} // namespace
+
+StreamIndexCache::StreamIndexCache(const QString &directory) : directory(directory)
+{
+}
+
+std::optional<StreamIndexCache> StreamIndexCache::getDefault()
+{
+  QSettings settings;
+  settings.beginGroup("VideoCache");
+  if (!settings.value("StreamIndexCacheEnabled", true).toBool())
+    return {};
+  return StreamIndexCache(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+                          "/streamindex");
+}
+
+bool StreamIndexCache::storeIndex(const QString    &filePath,
+                                  const QString    &indexType,
+                                  const QByteArray &indexData)
+{
+  if (!QDir().mkpath(this->directory))
+    return false;
+
+  QSaveFile file(this->directory + "/" + this->getFileName(filePath, indexType));
+  if (!file.open(QIODevice::WriteOnly))
+    return false;
+
+  QDataStream stream(&file);
+  stream << FILE_MAGIC << FILE_VERSION << functions::getFileKey(filePath) << indexType
+         << qCompress(indexData);
+  return stream.status() == QDataStream::Ok && file.commit();
+}
+
+std::optional<QByteArray> StreamIndexCache::loadIndex(const QString &filePath,
+                                                      const QString &indexType)
+{
+  QFile file(this->directory + "/" + this->getFileName(filePath, indexType));
+  if (!file.open(QIODevice::ReadOnly))
+    return {};
+
+  QDataStream stream(&file);
+  quint32     magic{};
+  quint32     version{};
+  QString     fileKey;
+  QString     storedIndexType;
+  QByteArray  compressedData;
+  stream >> magic >> version >> fileKey >> storedIndexType >> compressedData;
+
+  if (stream.status() == QDataStream::Ok && magic == FILE_MAGIC && version == FILE_VERSION &&
+      fileKey == functions::getFileKey(filePath) && storedIndexType == indexType)
+  {
+    auto indexData = qUncompress(compressedData);
+    if (!indexData.isEmpty())
+      return indexData;
+  }
+
+  // The file changed or the index is corrupt. It will be replaced when the file was indexed again.
+  file.remove();
+  return {};
+}
+
+QString StreamIndexCache::getFileName(const QString &filePath, const QString &indexType) const
+{
+  // The size and modification time are not part of the name so that the index of a file that
+  // changed is overwritten.
+  const auto name = QFileInfo(filePath).canonicalFilePath() + "|" + indexType;
+  return QCryptographicHash::hash(name.toUtf8(), QCryptographicHash::Sha1).toHex() + FILE_SUFFIX;
+}
+
+} // namespace filesource
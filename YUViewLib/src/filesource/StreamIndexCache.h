@@ -0,0 +1,71 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <optional>
+
+namespace filesource
+{
+
+/* A cache for the index of compressed files (the position of all frames, the random access points,
+ * ...). Building the index requires reading the whole file which takes long for large files. When
+ * the file is opened again, the index is read from here instead. An index is only used if the size
+ * and modification time of the file did not change. The content of the index is up to the caller.
+ * The index type identifies the kind of index and should contain a version number that is changed
+ * whenever the content changes. Each index is stored in its own file in the given directory.
+ */
+class StreamIndexCache
+{
+public:
+  StreamIndexCache(const QString &directory);
+
+  // The cache in the default location. Returns nothing if the cache is disabled in the settings.
+  static std::optional<StreamIndexCache> getDefault();
+
+  // Compress the index and write it to disk. Returns false if writing failed.
+  bool storeIndex(const QString &filePath, const QString &indexType, const QByteArray &indexData);
+
+  // Read the index of the file. Returns nothing if there is no index for the file or if the file
+  // changed since the index was stored.
+  std::optional<QByteArray> loadIndex(const QString &filePath, const QString &indexType);
+
+private:
+  QString getFileName(const QString &filePath, const QString &indexType) const;
+
+  QString directory;
+};
+
+} // namespace filesource
@@ -587,7 +587,8 @@ ParserAnnexBAVC::parseAndAddNALUnit(int
   return parseResult;
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBAVC::getSeekData(int iFrameNr)
+std::optional<ParserAnnexB::SeekData>
+ParserAnnexBAVC::getSeekDataFromNalUnits(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
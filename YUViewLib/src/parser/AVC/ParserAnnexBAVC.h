@@ -87,7 +87,7 @@ public:
                                  std::optional<pairUint64> nalStartEndPosFile = {},
                                  std::shared_ptr<TreeItem> parent             = nullptr) override;
 
-  std::optional<SeekData> getSeekData(int iFrameNr) override;
+  std::optional<SeekData> getSeekDataFromNalUnits(int iFrameNr) override;
   QByteArray              getExtradata() override;
   IntPair                 getProfileLevel() override;
   Ratio                   getSampleAspectRatio() override;
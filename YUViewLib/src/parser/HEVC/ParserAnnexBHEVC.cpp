@@ -157,7 +157,8 @@ video::yuv::PixelFormatYUV ParserAnnexBHEVC::getPixelFormat() const
   return {};
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBHEVC::getSeekData(int iFrameNr)
+std::optional<ParserAnnexB::SeekData>
+ParserAnnexBHEVC::getSeekDataFromNalUnits(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
@@ -396,8 +397,38 @@ ParserAnnexBHEVC::parseAndAddNALUnit(int
     }
     else if (nalHEVC->header.isSlice())
     {
+      // In the pipelined mode, the slice is parsed without logging here and the syntax is logged
+      // in a worker thread
+      std::optional<reader::SubByteReaderLogging> nonLoggingReader;
+      if (nalRoot && this->isLoggingDeferred())
+      {
+        this->deferLogging(
+            nalRoot,
+            [sliceStart                     = SubByteReader(reader),
+             firstAUInDecodingOrder         = this->firstAUInDecodingOrder,
+             prevTid0PicSlicePicOrderCntLsb = this->prevTid0PicSlicePicOrderCntLsb,
+             prevTid0PicPicOrderCntMsb      = this->prevTid0PicPicOrderCntMsb,
+             header                         = nalHEVC->header,
+             parameterSets                  = this->activeParameterSets,
+             lastFirstSliceSegmentInPic     = this->lastFirstSliceSegmentInPic](
+                std::shared_ptr<TreeItem> root) mutable {
+              reader::SubByteReaderLogging sliceReader(sliceStart, root);
+              slice_segment_layer_rbsp     slice;
+              slice.parse(sliceReader,
+                          firstAUInDecodingOrder,
+                          prevTid0PicSlicePicOrderCntLsb,
+                          prevTid0PicPicOrderCntMsb,
+                          header,
+                          parameterSets.spsMap,
+                          parameterSets.ppsMap,
+                          lastFirstSliceSegmentInPic);
+            });
+        nonLoggingReader.emplace(reader, nullptr);
+      }
+      auto &sliceReader = nonLoggingReader ? *nonLoggingReader : reader;
+
       auto newSlice = std::make_shared<slice_segment_layer_rbsp>();
-      newSlice->parse(reader,
+      newSlice->parse(sliceReader,
                       this->firstAUInDecodingOrder,
                       this->prevTid0PicSlicePicOrderCntLsb,
                       this->prevTid0PicPicOrderCntMsb,
@@ -65,7 +65,7 @@ public:
                                  std::shared_ptr<TreeItem> parent             = {}) override;
 
   // TODO: Reading from raw mpeg2 streams not supported (yet? Is this even defined / possible?)
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) override
+  virtual std::optional<SeekData> getSeekDataFromNalUnits(int iFrameNr) override
   {
     (void)iFrameNr;
     return {};
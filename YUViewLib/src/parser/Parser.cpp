@@ -80,7 +80,7 @@ void Parser::enableModel()
 {
   if (!this->packetModel->rootItem)
   {
-    this->packetModel->rootItem = std::make_shared<TreeItem>();
+    this->packetModel->rootItem = TreeItem::createRootItem();
     this->packetModel->rootItem->setProperties("Name", "Value", "Coding", "Code", "Meaning");
   }
 }
@@ -33,10 +33,17 @@
 #include "ParserAnnexB.h"
 
 #include <common/Formatting.h>
+#include <filesource/StreamIndexCache.h>
 #include <parser/common/SubByteReaderLogging.h>
 
+#include <QDataStream>
 #include <QElapsedTimer>
+#include <QMutex>
 #include <QProgressDialog>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtConcurrent>
 #include <assert.h>
 
 #define PARSERANNEXB_DEBUG_OUTPUT 0
@@ -50,6 +57,102 @@
 namespace parser
 {
 
+namespace
+{
+
+// The maximum number of NAL units that are read ahead of the parsing
+constexpr size_t MAX_QUEUED_NAL_UNITS = 512;
+
+// The maximum number of NAL units that are logged in worker threads at the same time
+constexpr size_t MAX_PENDING_LOGGING_JOBS = 256;
+
+// Increase this whenever the content of the stream index changes
+constexpr auto STREAM_INDEX_VERSION = 1;
+
+void writeByteVector(QDataStream &stream, const ByteVector &data)
+{
+  stream << QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size()));
+}
+
+ByteVector readByteVector(QDataStream &stream)
+{
+  QByteArray data;
+  stream >> data;
+  return ByteVector(data.begin(), data.end());
+}
+
+struct NalUnit
+{
+  ByteVector data;
+  pairUint64 startEndPosFile;
+};
+
+// Splits the file into NAL units in a background thread
+class NalUnitReader
+{
+public:
+  NalUnitReader(FileSourceAnnexBFile *file)
+  {
+    this->readFuture = QtConcurrent::run([this, file]() { this->readNalUnits(file); });
+  }
+  ~NalUnitReader()
+  {
+    {
+      QMutexLocker locker(&this->mutex);
+      this->abort = true;
+    }
+    this->queueChanged.wakeAll();
+    this->readFuture.waitForFinished();
+  }
+
+  // Get the next NAL unit. Blocks until it was read. Returns nothing if the file ended.
+  std::optional<NalUnit> takeNalUnit()
+  {
+    QMutexLocker locker(&this->mutex);
+    while (this->queue.empty() && !this->endOfFile)
+      this->queueChanged.wait(&this->mutex);
+    if (this->queue.empty())
+      return {};
+
+    auto nalUnit = std::move(this->queue.front());
+    this->queue.pop_front();
+    this->queueChanged.wakeAll();
+    return nalUnit;
+  }
+
+private:
+  void readNalUnits(FileSourceAnnexBFile *file)
+  {
+    while (!file->atEnd())
+    {
+      NalUnit    nalUnit;
+      const auto nalData = file->getNextNALUnit(false, &nalUnit.startEndPosFile);
+      nalUnit.data.assign(nalData.begin(), nalData.end());
+
+      QMutexLocker locker(&this->mutex);
+      while (this->queue.size() >= MAX_QUEUED_NAL_UNITS && !this->abort)
+        this->queueChanged.wait(&this->mutex);
+      if (this->abort)
+        return;
+      this->queue.push_back(std::move(nalUnit));
+      this->queueChanged.wakeAll();
+    }
+
+    QMutexLocker locker(&this->mutex);
+    this->endOfFile = true;
+    this->queueChanged.wakeAll();
+  }
+
+  QMutex              mutex;
+  QWaitCondition      queueChanged;
+  std::deque<NalUnit> queue;
+  bool                endOfFile{};
+  bool                abort{};
+  QFuture<void>       readFuture;
+};
+
+} // namespace
+
 std::string ParserAnnexB::getShortStreamDescription(const int) const
 {
   std::ostringstream info;
@@ -79,7 +182,7 @@ bool ParserAnnexB::addFrameToList(int                       poc,
     newFrame.randomAccessPoint = randomAccessPoint;
     newFrame.layerID           = layerID;
     this->frameListCodingOrder.push_back(newFrame);
-    this->frameListDisplayOder.clear();
+    this->clearFrameListDisplayOrder();
   }
   return true;
 }
@@ -141,6 +244,86 @@ auto ParserAnnexB::getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
   return seekPointInfo;
 }
 
+auto ParserAnnexB::getSeekPointsDisplayOrder() -> std::vector<FrameIndexDisplayOrder>
+{
+  this->updateFrameListDisplayOrder();
+
+  auto getDisplayIndex = [this](const AnnexBFrame &frame) {
+    auto it = std::lower_bound(
+        this->frameListDisplayOder.begin(), this->frameListDisplayOder.end(), frame);
+    return FrameIndexDisplayOrder(std::distance(this->frameListDisplayOder.begin(), it));
+  };
+
+  // Same rule as in getClosestSeekPoint: The seek point is the last random access point in coding
+  // order (before the frame) with a smaller POC. Fall back to the first frame.
+  std::vector<FrameIndexDisplayOrder> seekPoints(this->frameListDisplayOder.size());
+  std::vector<const AnnexBFrame *>    randomAccessPoints;
+  for (const auto &frame : this->frameListCodingOrder)
+  {
+    auto seekFrame = &this->frameListCodingOrder.front();
+    for (auto it = randomAccessPoints.rbegin(); it != randomAccessPoints.rend(); it++)
+    {
+      if ((*it)->poc < frame.poc)
+      {
+        seekFrame = *it;
+        break;
+      }
+    }
+    seekPoints[getDisplayIndex(frame)] = getDisplayIndex(*seekFrame);
+
+    if (frame.randomAccessPoint)
+      randomAccessPoints.push_back(&frame);
+  }
+
+  return seekPoints;
+}
+
+void ParserAnnexB::deferLogging(std::shared_ptr<TreeItem> nalRoot, LoggingJob job)
+{
+  assert(this->loggingThreadPool != nullptr);
+  auto loggedItems = QtConcurrent::run(this->loggingThreadPool, [job = std::move(job)]() {
+    auto root = TreeItem::createRootItem();
+    try
+    {
+      job(root);
+    }
+    catch (...)
+    {
+      // Reading errors are logged in the tree
+    }
+    return root;
+  });
+  this->deferredLogging.push_back({nalRoot, loggedItems});
+}
+
+void ParserAnnexB::mergeDeferredLogging(size_t maxNrPendingJobs)
+{
+  while (!this->deferredLogging.empty())
+  {
+    auto &oldestJob = this->deferredLogging.front();
+    if (!oldestJob.loggedItems.isFinished())
+    {
+      if (this->deferredLogging.size() <= maxNrPendingJobs)
+        return;
+      oldestJob.loggedItems.waitForFinished();
+    }
+
+    oldestJob.nalRoot->adoptChildItems(oldestJob.loggedItems.result());
+    this->deferredLogging.pop_front();
+  }
+}
+
+std::optional<ParserAnnexB::SeekData> ParserAnnexB::getSeekData(int iFrameNr)
+{
+  if (this->seekDataFromStreamIndex.empty())
+    return this->getSeekDataFromNalUnits(iFrameNr);
+
+  auto it = this->seekDataFromStreamIndex.find(FrameIndexDisplayOrder(iFrameNr));
+  if (it == this->seekDataFromStreamIndex.end())
+    return {};
+  return it->second;
+}
+
 std::optional<pairUint64> ParserAnnexB::getFrameStartEndPos(FrameIndexCodingOrder idx)
 {
   if (idx >= this->frameListCodingOrder.size())
@@ -153,6 +336,27 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
 {
   DEBUG_ANNEXB("ParserAnnexB::parseAnnexBFile");
 
+  this->streamInfo.file_size = file->getFileSize().value_or(0);
+  const auto filePath        = QString::fromStdString(file->getAbsoluteFilePath());
+
+  // The packet tree can only be created by parsing the file. Otherwise, the index of the file is
+  // all we need.
+  std::optional<filesource::StreamIndexCache> streamIndexCache;
+  if (!filePath.isEmpty() && !(packetModel && packetModel->rootItem))
+    streamIndexCache = filesource::StreamIndexCache::getDefault();
+  if (streamIndexCache)
+  {
+    const auto indexData = streamIndexCache->loadIndex(filePath, this->getStreamIndexType());
+    if (indexData && this->loadStreamIndex(*indexData))
+    {
+      DEBUG_ANNEXB("ParserAnnexB::parseAnnexBFile Loaded the stream index. Found "
+                   << this->frameListCodingOrder.size() << " POCs");
+      emit streamInfoUpdated();
+      emit backgroundParsingDone("");
+      return true;
+    }
+  }
+
   const auto                       fileSize = file->getFileSize();
   std::unique_ptr<QProgressDialog> progressDialog;
   int                              curPercentValue = 0;
@@ -170,29 +374,38 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     progressDialog->setWindowModality(Qt::WindowModal);
   }
 
-  this->streamInfo.file_size = file->getFileSize().value_or(0);
-  this->streamInfo.parsing   = true;
+  this->streamInfo.parsing = true;
   emit streamInfoUpdated();
 
+  // The syntax of the slices is logged in worker threads if the packet tree is created
+  QThreadPool loggingThreadPool;
+  loggingThreadPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 2, 1));
+  if (packetModel && packetModel->rootItem && this->deferredLoggingEnabled &&
+      QThread::idealThreadCount() > 1)
+    this->loggingThreadPool = &loggingThreadPool;
+
   // Just push all NAL units from the annexBFile into the annexBParser
-  int           nalID = 0;
-  pairUint64    nalStartEndPosFile;
-  bool          abortParsing = false;
+  NalUnitReader nalUnitReader(file.get());
+  int           nalID          = 0;
+  bool          abortParsing   = false;
+  bool          canceledByUser = false;
   QElapsedTimer signalEmitTimer;
   signalEmitTimer.start();
-  while (!file->atEnd() && !abortParsing)
+  while (!abortParsing)
   {
+    auto nalUnit = nalUnitReader.takeNalUnit();
+    if (!nalUnit)
+      break;
+
     // Update the progress dialog
-    int64_t pos = file->pos();
+    const auto pos = int64_t(nalUnit->startEndPosFile.second);
     if (this->streamInfo.file_size > 0)
       progressPercentValue = functions::clip((int)(pos * 100 / this->streamInfo.file_size), 0, 100);
 
     try
     {
-      auto nalData = reader::SubByteReaderLogging::convertToByteVector(
-          file->getNextNALUnit(false, &nalStartEndPosFile));
       auto parsingResult =
-          this->parseAndAddNALUnit(nalID, nalData, {}, nalStartEndPosFile, nullptr);
+          this->parseAndAddNALUnit(nalID, nalUnit->data, {}, nalUnit->startEndPosFile, nullptr);
       if (!parsingResult.success)
       {
         DEBUG_ANNEXB("ParserAnnexB::parseAndAddNALUnit Error parsing NAL " << nalID);
@@ -216,16 +429,20 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     }
 
     nalID++;
+    this->mergeDeferredLogging(MAX_PENDING_LOGGING_JOBS);
 
     if (progressDialog)
     {
       // Updating the dialog (setValue) is quite slow. Only do this if the percent value changes.
       if (progressDialog->wasCanceled())
-        return false;
+      {
+        canceledByUser = true;
+        break;
+      }
 
       int newPercentValue = 0;
-      if (fileSize)
-        newPercentValue = functions::clip(int((file->pos() - *fileSize) * 100 / *fileSize), 0, 100);
+      if (fileSize && *fileSize > 0)
+        newPercentValue = functions::clip(int(pos * 100 / *fileSize), 0, 100);
       if (newPercentValue != curPercentValue)
       {
         progressDialog->setValue(newPercentValue);
@@ -252,6 +469,11 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
     }
   }
 
+  this->mergeDeferredLogging(0);
+  this->loggingThreadPool = nullptr;
+  if (canceledByUser)
+    return false;
+
   try
   {
     auto parseResult = this->parseAndAddNALUnit(-1, {}, {}, {});
@@ -271,9 +493,15 @@ bool ParserAnnexB::parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file,
   if (packetModel)
     emit modelDataUpdated();
 
+  this->updateFrameListDisplayOrder();
+
   this->streamInfo.parsing    = false;
   this->streamInfo.nrNalUnits = nalID;
   this->streamInfo.nrFrames   = unsigned(this->frameListCodingOrder.size());
+
+  if (streamIndexCache && !abortParsing)
+    streamIndexCache->storeIndex(filePath, this->getStreamIndexType(), this->createStreamIndex());
+
   emit streamInfoUpdated();
   emit backgroundParsingDone("");
 
@@ -318,6 +546,7 @@ int ParserAnnexB::getFramePOC(FrameIndexDisplayOrder frameIdx)
 
 void ParserAnnexB::updateFrameListDisplayOrder()
 {
+  std::unique_lock<std::mutex> lock(this->frameListDisplayOrderMutex);
   if (this->frameListCodingOrder.size() == 0 || this->frameListDisplayOder.size() > 0)
     return;
 
@@ -325,4 +554,165 @@ void ParserAnnexB::updateFrameListDisplayOrder()
   std::sort(frameListDisplayOder.begin(), frameListDisplayOder.end());
 }
 
+void ParserAnnexB::clearFrameListDisplayOrder()
+{
+  std::unique_lock<std::mutex> lock(this->frameListDisplayOrderMutex);
+  this->frameListDisplayOder.clear();
+}
+
+QString ParserAnnexB::getStreamIndexType() const
+{
+  const auto parserName = QString::fromLatin1(this->metaObject()->className());
+  return QString("%1/%2").arg(parserName).arg(STREAM_INDEX_VERSION);
+}
+
+QByteArray ParserAnnexB::createStreamIndex()
+{
+  QByteArray  indexData;
+  QDataStream stream(&indexData, QIODevice::WriteOnly);
+
+  stream << quint32(this->frameListCodingOrder.size());
+  for (const auto &frame : this->frameListCodingOrder)
+  {
+    const auto startEndPos = frame.fileStartEndPos.value_or(pairUint64(0, 0));
+    stream << qint32(frame.poc) << frame.fileStartEndPos.has_value() << quint64(startEndPos.first)
+           << quint64(startEndPos.second) << frame.randomAccessPoint << quint32(frame.layerID);
+  }
+  stream << this->pocOfFirstRandomAccessFrame.has_value()
+         << qint32(this->pocOfFirstRandomAccessFrame.value_or(0))
+         << quint32(this->streamInfo.nrNalUnits);
+
+  std::set<FrameIndexDisplayOrder>           seekPoints;
+  std::map<FrameIndexDisplayOrder, SeekData> seekDataPerSeekPoint;
+  for (const auto frameIndex : this->getSeekPointsDisplayOrder())
+    seekPoints.insert(frameIndex);
+  for (const auto frameIndex : seekPoints)
+    if (auto seekData = this->getSeekDataFromNalUnits(int(frameIndex)))
+      seekDataPerSeekPoint[frameIndex] = *seekData;
+
+  stream << quint32(seekDataPerSeekPoint.size());
+  for (const auto &[frameIndex, seekData] : seekDataPerSeekPoint)
+  {
+    stream << quint32(frameIndex) << quint32(seekData.parameterSets.size());
+    for (const auto &parameterSet : seekData.parameterSets)
+      writeByteVector(stream, parameterSet);
+    stream << seekData.filePos.has_value() << quint64(seekData.filePos.value_or(0));
+  }
+
+  const auto bitrateEntries = this->bitratePlotModel->getBitrateEntries(0);
+  stream << quint32(bitrateEntries.size());
+  for (const auto &entry : bitrateEntries)
+    stream << qint32(entry.dts) << qint32(entry.pts) << qint32(entry.duration)
+           << quint64(entry.bitrate) << entry.keyframe << entry.frameType;
+
+  return indexData;
+}
+
+bool ParserAnnexB::loadStreamIndex(const QByteArray &indexData)
+{
+  QDataStream stream(indexData);
+
+  quint32             nrFrames{};
+  vector<AnnexBFrame> frames;
+  stream >> nrFrames;
+  for (quint32 i = 0; i < nrFrames && stream.status() == QDataStream::Ok; i++)
+  {
+    qint32      poc{};
+    bool        hasStartEndPos{};
+    quint64     startPos{};
+    quint64     endPos{};
+    quint32     layerID{};
+    AnnexBFrame frame;
+    stream >> poc >> hasStartEndPos >> startPos >> endPos >> frame.randomAccessPoint >> layerID;
+    frame.poc     = poc;
+    frame.layerID = layerID;
+    if (hasStartEndPos)
+      frame.fileStartEndPos = pairUint64(startPos, endPos);
+    frames.push_back(frame);
+  }
+
+  bool    hasPocOfFirstRandomAccessFrame{};
+  qint32  pocOfFirstRandomAccessFrame{};
+  quint32 nrNalUnits{};
+  stream >> hasPocOfFirstRandomAccessFrame >> pocOfFirstRandomAccessFrame >> nrNalUnits;
+
+  quint32                                    nrSeekPoints{};
+  std::map<FrameIndexDisplayOrder, SeekData> seekDataPerSeekPoint;
+  stream >> nrSeekPoints;
+  for (quint32 i = 0; i < nrSeekPoints && stream.status() == QDataStream::Ok; i++)
+  {
+    quint32 frameIndex{};
+    quint32 nrParameterSets{};
+    stream >> frameIndex >> nrParameterSets;
+
+    SeekData seekData;
+    for (quint32 j = 0; j < nrParameterSets && stream.status() == QDataStream::Ok; j++)
+      seekData.parameterSets.push_back(readByteVector(stream));
+
+    bool    hasFilePos{};
+    quint64 filePos{};
+    stream >> hasFilePos >> filePos;
+    if (hasFilePos)
+      seekData.filePos = filePos;
+    seekDataPerSeekPoint[frameIndex] = seekData;
+  }
+
+  quint32                                     nrBitrateEntries{};
+  std::vector<BitratePlotModel::BitrateEntry> bitrateEntries;
+  stream >> nrBitrateEntries;
+  for (quint32 i = 0; i < nrBitrateEntries && stream.status() == QDataStream::Ok; i++)
+  {
+    qint32                         dts{};
+    qint32                         pts{};
+    qint32                         duration{};
+    quint64                        bitrate{};
+    BitratePlotModel::BitrateEntry entry;
+    stream >> dts >> pts >> duration >> bitrate >> entry.keyframe >> entry.frameType;
+    entry.dts      = dts;
+    entry.pts      = pts;
+    entry.duration = duration;
+    entry.bitrate  = size_t(bitrate);
+    bitrateEntries.push_back(entry);
+  }
+
+  if (stream.status() != QDataStream::Ok || frames.empty())
+    return false;
+
+  // The properties of the stream (frame size, pixel format, ...) are taken from the parameter sets.
+  // Parse every parameter set once in the order in which they are needed for decoding.
+  std::vector<ByteVector> parameterSets;
+  for (const auto &[frameIndex, seekData] : seekDataPerSeekPoint)
+    for (const auto &parameterSet : seekData.parameterSets)
+      if (std::find(parameterSets.begin(), parameterSets.end(), parameterSet) ==
+          parameterSets.end())
+        parameterSets.push_back(parameterSet);
+
+  int nalID = 0;
+  for (const auto &parameterSet : parameterSets)
+  {
+    try
+    {
+      this->parseAndAddNALUnit(nalID++, parameterSet, {});
+    }
+    catch (...)
+    {
+      DEBUG_ANNEXB("ParserAnnexB::loadStreamIndex Exception thrown parsing parameter set");
+    }
+  }
+
+  this->frameListCodingOrder = std::move(frames);
+  this->clearFrameListDisplayOrder();
+  this->updateFrameListDisplayOrder();
+  if (hasPocOfFirstRandomAccessFrame)
+    this->pocOfFirstRandomAccessFrame = pocOfFirstRandomAccessFrame;
+  this->seekDataFromStreamIndex = std::move(seekDataPerSeekPoint);
+  for (auto &entry : bitrateEntries)
+    this->bitratePlotModel->addBitratePoint(0, entry);
+
+  this->streamInfo.parsing    = false;
+  this->streamInfo.nrNalUnits = nrNalUnits;
+  this->streamInfo.nrFrames   = unsigned(this->frameListCodingOrder.size());
+  return true;
+}
+
 } // namespace parser
\ No newline at end of file
@@ -32,9 +32,14 @@
 
 #pragma once
 
+#include <QFuture>
 #include <QList>
 #include <QTreeWidgetItem>
 
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <set>
 
@@ -44,6 +49,8 @@
 #include <parser/common/TreeItem.h>
 #include <video/yuv/videoHandlerYUV.h>
 
+class QThreadPool;
+
 namespace parser
 {
 
@@ -107,7 +114,7 @@ public:
     std::vector<ByteVector> parameterSets;
     std::optional<uint64_t> filePos;
   };
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) = 0;
+  std::optional<SeekData> getSeekData(int iFrameNr);
 
   // Look through the random access points and find the closest one before (or equal)
   // the given frameIdx where we can start decoding
@@ -120,6 +127,10 @@ public:
   auto getClosestSeekPoint(FrameIndexDisplayOrder targetFrame,
                            FrameIndexDisplayOrder currentFrame) -> SeekPointInfo;
 
+  // Get the seek point (as returned by getClosestSeekPoint) for every frame in display order.
+  // Frames that share a seek point can only be decoded one after another.
+  auto getSeekPointsDisplayOrder() -> std::vector<FrameIndexDisplayOrder>;
+
   // Get the parameters sets as extradata. The format of this depends on the underlying codec.
   virtual QByteArray getExtradata() = 0;
   // Get some other properties of the bitstream in order to configure the FFMpegDecoder
@@ -128,7 +139,13 @@ public:
 
   std::optional<pairUint64> getFrameStartEndPos(FrameIndexCodingOrder idx);
 
+  // Parse all NAL units of the file. This is pipelined: The file is split into NAL units in a
+  // background thread and, if the packet tree is created, the syntax of the slices is logged by a
+  // pool of worker threads (see deferLogging). If no packet tree is created, the index of the file
+  // is taken from the StreamIndexCache if the file was parsed before.
   bool parseAnnexBFile(std::unique_ptr<FileSourceAnnexBFile> &file, QWidget *mainWindow = nullptr);
+  // Log the syntax of the slices in the parsing thread instead (the result is the same).
+  void disableDeferredLogging() { this->deferredLoggingEnabled = false; }
 
   // Called from the bitstream analyzer. This function can run in a background process.
   bool runParsingOfFile(const std::filesystem::path &compressedFilePath) override;
@@ -152,6 +169,9 @@ protected:
                       bool                      randomAccessPoint,
                       unsigned                  layerID);
 
+  // Get the seek data (see getSeekData) from the NAL units that were parsed.
+  virtual std::optional<SeekData> getSeekDataFromNalUnits(int iFrameNr) = 0;
+
   static void logNALSize(const ByteVector         &data,
                          std::shared_ptr<TreeItem> root,
                          std::optional<pairUint64> nalStartEndPos);
@@ -171,15 +191,47 @@ protected:
 
   int getFramePOC(FrameIndexDisplayOrder frameIdx);
 
+  // While parseAnnexBFile runs, the codec parsers can hand the logging of the syntax of a NAL unit
+  // to a worker thread. The NAL unit must still be parsed (without logging) to update the state of
+  // the parser. The job logs into a new tree and must only use the state that it captured. When it
+  // is done, its items are appended to the child items of nalRoot (in the order of the NAL units).
+  using LoggingJob = std::function<void(std::shared_ptr<TreeItem> root)>;
+  bool isLoggingDeferred() const { return this->loggingThreadPool != nullptr; }
+  void deferLogging(std::shared_ptr<TreeItem> nalRoot, LoggingJob job);
+
 private:
+  struct DeferredLogging
+  {
+    std::shared_ptr<TreeItem>          nalRoot;
+    QFuture<std::shared_ptr<TreeItem>> loggedItems;
+  };
+  bool                        deferredLoggingEnabled{true};
+  QThreadPool                *loggingThreadPool{};
+  std::deque<DeferredLogging> deferredLogging;
+
+  // Move the items of the finished jobs into the packet tree. Wait for the oldest jobs until at
+  // most maxNrPendingJobs are left.
+  void mergeDeferredLogging(size_t maxNrPendingJobs);
+
   // A list of all frames in the sequence (in coding order) with POC and the file positions of all
   // slice NAL units associated with a frame. POC's don't have to be consecutive, so the only way to
   // know how many pictures are in a sequences is to keep a list of all POCs.
   vector<AnnexBFrame> frameListCodingOrder;
   // The same list of frames but sorted in display order. Generated from the list above whenever
-  // needed.
+  // needed and when parsing is done. The caching decoders access it from multiple threads.
   vector<AnnexBFrame> frameListDisplayOder;
+  std::mutex          frameListDisplayOrderMutex;
   void                updateFrameListDisplayOrder();
+  void                clearFrameListDisplayOrder();
+
+  // The frame list, the seek data and the bitrate entries are saved in the stream index. When the
+  // index is loaded, only the parameter sets are parsed again to get the properties of the stream.
+  // The seek data of all seek points is then taken from the index.
+  QString    getStreamIndexType() const;
+  QByteArray createStreamIndex();
+  bool       loadStreamIndex(const QByteArray &indexData);
+
+  std::map<FrameIndexDisplayOrder, SeekData> seekDataFromStreamIndex;
 };
 
 } // namespace parser
\ No newline at end of file
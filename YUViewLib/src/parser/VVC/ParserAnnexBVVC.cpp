@@ -152,7 +152,8 @@ video::yuv::PixelFormatYUV ParserAnnexBVVC::getPixelFormat() const
   return {};
 }
 
-std::optional<ParserAnnexB::SeekData> ParserAnnexBVVC::getSeekData(int iFrameNr)
+std::optional<ParserAnnexB::SeekData>
+ParserAnnexBVVC::getSeekDataFromNalUnits(int iFrameNr)
 {
   if (iFrameNr >= int(this->getNumberPOCs()) || iFrameNr < 0)
     return {};
@@ -418,8 +419,46 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
     else if (nalVVC->header.isSlice())
     {
       specificDescription << " (Slice Header)";
+
+      // In the pipelined mode, the slice is parsed without logging here and the syntax is logged
+      // in a worker thread
+      const auto layerID = nalVVC->header.nuh_layer_id;
+      std::optional<reader::SubByteReaderLogging> nonLoggingReader;
+      if (nalRoot && this->isLoggingDeferred())
+      {
+        this->deferLogging(
+            nalRoot,
+            [sliceStart                 = SubByteReader(reader),
+             nalType,
+             parameterSets              = this->activeParameterSets,
+             pictureHeader              = updatedParsingState.currentPictureHeaderStructure,
+             prevTid0Pic                = updatedParsingState.prevTid0Pic[layerID],
+             NoOutputBeforeRecoveryFlag = updatedParsingState.NoOutputBeforeRecoveryFlag[layerID]](
+                std::shared_ptr<TreeItem> root) mutable {
+              reader::SubByteReaderLogging sliceReader(sliceStart, root);
+              slice_layer_rbsp             sliceLayer;
+              sliceLayer.parse(sliceReader,
+                               nalType,
+                               parameterSets.vpsMap,
+                               parameterSets.spsMap,
+                               parameterSets.ppsMap,
+                               pictureHeader);
+              const auto &pictureHeaderInSlice =
+                  sliceLayer.slice_header_instance.picture_header_structure_instance;
+              if (pictureHeaderInSlice)
+                pictureHeaderInSlice->calculatePictureOrderCount(sliceReader,
+                                                                 nalType,
+                                                                 parameterSets.spsMap,
+                                                                 parameterSets.ppsMap,
+                                                                 prevTid0Pic,
+                                                                 NoOutputBeforeRecoveryFlag);
+            });
+        nonLoggingReader.emplace(reader, nullptr);
+      }
+      auto &sliceReader = nonLoggingReader ? *nonLoggingReader : reader;
+
       auto newSliceLayer = std::make_shared<slice_layer_rbsp>();
-      newSliceLayer->parse(reader,
+      newSliceLayer->parse(sliceReader,
                            nalType,
                            this->activeParameterSets.vpsMap,
                            this->activeParameterSets.spsMap,
@@ -431,7 +470,7 @@ ParserAnnexBVVC::parseAndAddNALUnit(int
       {
         newSliceLayer->slice_header_instance.picture_header_structure_instance
             ->calculatePictureOrderCount(
-                reader,
+                sliceReader,
                 nalType,
                 this->activeParameterSets.spsMap,
                 this->activeParameterSets.ppsMap,
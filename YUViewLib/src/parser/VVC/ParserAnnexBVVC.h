@@ -91,7 +91,7 @@ public:
   Size                       getSequenceSizeSamples() const override;
   video::yuv::PixelFormatYUV getPixelFormat() const override;
 
-  virtual std::optional<SeekData> getSeekData(int iFrameNr) override;
+  virtual std::optional<SeekData> getSeekDataFromNalUnits(int iFrameNr) override;
   QByteArray                      getExtradata() override;
   IntPair                         getProfileLevel() override;
   Ratio                           getSampleAspectRatio() override;
@@ -250,6 +250,13 @@ void BitratePlotModel::setBitrateSortingIndex(int index)
     std::sort(list.begin(), list.end(), compareFunctionLessThen);
 }
 
+QList<BitratePlotModel::BitrateEntry>
+BitratePlotModel::getBitrateEntries(unsigned streamIndex) const
+{
+  QMutexLocker locker(&this->dataMutex);
+  return this->dataPerStream.value(streamIndex);
+}
+
 unsigned int BitratePlotModel::calculateAverageValue(unsigned streamIndex,
                                                      unsigned pointIndex) const
 {
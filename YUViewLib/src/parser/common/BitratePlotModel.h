@@ -69,6 +69,8 @@ public:
   void addBitratePoint(int streamIndex, BitrateEntry &entry);
   void setBitrateSortingIndex(int index);
 
+  QList<BitrateEntry> getBitrateEntries(unsigned streamIndex) const;
+
 private:
   enum class SortMode
   {
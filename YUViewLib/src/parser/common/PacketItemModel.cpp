@@ -139,24 +139,23 @@ QModelIndex PacketItemModel::parent(const QModelIndex &index) const
     return {};
 
   auto childItem  = static_cast<TreeItem *>(index.internalPointer());
-  auto parentItem = childItem->getParentItem().lock();
+  auto parentItem = childItem->getParentItem();
 
-  if (parentItem == this->rootItem)
+  if (parentItem == this->rootItem.get())
     return {};
 
   // Get the row of the item in the list of children of the parent item
   int row = 0;
   if (parentItem)
   {
-    auto grandparent = parentItem->getParentItem().lock();
-    if (grandparent)
+    if (auto grandparent = parentItem->getParentItem())
     {
       if (auto rowIndex = grandparent->getIndexOfChildItem(parentItem))
         row = int(*rowIndex);
     }
   }
 
-  return createIndex(row, 0, parentItem.get());
+  return createIndex(row, 0, parentItem);
 }
 
 int PacketItemModel::rowCount(const QModelIndex &parent) const
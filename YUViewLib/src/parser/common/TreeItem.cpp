@@ -0,0 +1,248 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut f�r Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TreeItem.h"
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+std::shared_ptr<TreeItem> TreeItem::createRootItem()
+{
+  auto arena = std::make_shared<TreeItemArena>();
+  auto root  = arena->allocateItem();
+  return std::shared_ptr<TreeItem>(arena, root);
+}
+
+void TreeItem::setProperties(const std::string &name,
+                             const std::string &value,
+                             const std::string &coding,
+                             const std::string &code,
+                             const std::string &meaning)
+{
+  this->name    = this->arena->intern(name);
+  this->coding  = this->arena->intern(coding);
+  this->meaning = this->arena->intern(meaning);
+  this->setValue(value);
+  this->setCode(code);
+}
+
+std::string TreeItem::getName(bool showStreamIndex) const
+{
+  std::stringstream ss;
+  if (showStreamIndex && this->streamIndex >= 0)
+    ss << "Stream " << this->streamIndex << " - ";
+  if (this->name)
+    ss << *this->name;
+  return ss.str();
+}
+
+void TreeItem::setName(const std::string &name)
+{
+  this->name = this->arena->intern(name);
+}
+
+int TreeItem::getStreamIndex() const
+{
+  if (this->streamIndex >= 0)
+    return this->streamIndex;
+  if (this->parent)
+    return this->parent->getStreamIndex();
+  return -1;
+}
+
+std::string TreeItem::getData(unsigned idx) const
+{
+  auto toString = [](const std::string *str) { return str ? *str : std::string(); };
+
+  switch (idx)
+  {
+  case 0:
+    return toString(this->name);
+  case 1:
+    switch (this->valueType)
+    {
+    case ValueType::Signed:
+      return std::to_string(this->signedValue);
+    case ValueType::Unsigned:
+      return std::to_string(this->unsignedValue);
+    case ValueType::String:
+      return toString(this->stringValue);
+    default:
+      return {};
+    }
+  case 2:
+    return toString(this->coding);
+  case 3:
+  {
+    if (this->codeString)
+      return *this->codeString;
+    std::string code(this->nrCodeBits, '0');
+    for (unsigned i = 0; i < this->nrCodeBits; i++)
+      if ((this->codeBits >> (this->nrCodeBits - 1 - i)) & 1)
+        code[i] = '1';
+    return code;
+  }
+  case 4:
+    return toString(this->meaning);
+  default:
+    return {};
+  }
+}
+
+TreeItem *TreeItem::addChildItem(const std::string &name,
+                                 const std::string &coding,
+                                 const std::string &code,
+                                 const std::string &meaning,
+                                 bool               isError)
+{
+  auto newItem           = this->arena->allocateItem();
+  newItem->parent        = this;
+  newItem->indexInParent = uint32_t(this->childItems.size());
+  newItem->name          = this->arena->intern(name);
+  newItem->coding        = this->arena->intern(coding);
+  newItem->meaning       = this->arena->intern(meaning);
+  newItem->error         = isError;
+  newItem->setCode(code);
+  this->childItems.push_back(newItem);
+  return newItem;
+}
+
+void TreeItem::adoptChildItems(std::shared_ptr<TreeItem> otherRoot)
+{
+  assert(otherRoot->arena != this->arena);
+
+  InternedStringMap internedStrings;
+  this->copyChildItems(*otherRoot, internedStrings);
+}
+
+void TreeItem::copyChildItems(const TreeItem &other, InternedStringMap &internedStrings)
+{
+  // Every string is only interned once. All items of the other tree share its interned strings.
+  auto intern = [this, &internedStrings](const std::string *str) -> const std::string * {
+    if (str == nullptr)
+      return nullptr;
+    auto it = internedStrings.find(str);
+    if (it == internedStrings.end())
+      it = internedStrings.emplace(str, this->arena->intern(*str)).first;
+    return it->second;
+  };
+
+  this->childItems.reserve(this->childItems.size() + other.childItems.size());
+  for (const auto otherChild : other.childItems)
+  {
+    auto newItem           = this->arena->allocateItem();
+    newItem->parent        = this;
+    newItem->indexInParent = uint32_t(this->childItems.size());
+    newItem->name          = intern(otherChild->name);
+    newItem->coding        = intern(otherChild->coding);
+    newItem->meaning       = intern(otherChild->meaning);
+    newItem->valueType     = otherChild->valueType;
+    if (otherChild->valueType == ValueType::String)
+      newItem->stringValue = intern(otherChild->stringValue);
+    else
+      newItem->unsignedValue = otherChild->unsignedValue;
+    newItem->nrCodeBits  = otherChild->nrCodeBits;
+    newItem->codeBits    = otherChild->codeBits;
+    newItem->codeString  = intern(otherChild->codeString);
+    newItem->error       = otherChild->error;
+    newItem->streamIndex = otherChild->streamIndex;
+    this->childItems.push_back(newItem);
+
+    newItem->copyChildItems(*otherChild, internedStrings);
+  }
+}
+
+std::shared_ptr<TreeItem> TreeItem::toSharedPointer(TreeItem *item) const
+{
+  // The pointer shares the ownership of the arena which owns the item
+  return std::shared_ptr<TreeItem>(this->arena->shared_from_this(), item);
+}
+
+void TreeItem::setValue(int64_t value)
+{
+  this->signedValue = value;
+  this->valueType   = ValueType::Signed;
+}
+
+void TreeItem::setValue(uint64_t value)
+{
+  this->unsignedValue = value;
+  this->valueType     = ValueType::Unsigned;
+}
+
+void TreeItem::setValue(const std::string &value)
+{
+  this->stringValue = this->arena->intern(value);
+  this->valueType   = this->stringValue ? ValueType::String : ValueType::None;
+}
+
+void TreeItem::setCode(const std::string &code)
+{
+  this->nrCodeBits = 0;
+  this->codeBits   = 0;
+  this->codeString = nullptr;
+
+  const auto isBitString = code.find_first_not_of("01") == std::string::npos;
+  if (code.size() > 64 || !isBitString)
+  {
+    this->codeString = this->arena->intern(code);
+    return;
+  }
+
+  for (const auto c : code)
+    this->codeBits = (this->codeBits << 1) | (c == '1' ? 1 : 0);
+  this->nrCodeBits = uint8_t(code.size());
+}
+
+TreeItem *TreeItemArena::allocateItem()
+{
+  if (this->nrItemsInLastBlock == this->lastBlockSize)
+  {
+    this->lastBlockSize = std::clamp(this->lastBlockSize * 2, MIN_BLOCK_SIZE, MAX_BLOCK_SIZE);
+    this->blocks.emplace_back(new TreeItem[this->lastBlockSize]);
+    this->nrItemsInLastBlock = 0;
+  }
+
+  auto item   = &this->blocks.back()[this->nrItemsInLastBlock];
+  item->arena = this;
+  this->nrItemsInLastBlock++;
+  this->nrItems++;
+  return item;
+}
+
+const std::string *TreeItemArena::intern(const std::string &str)
+{
+  if (str.empty())
+    return nullptr;
+  return &(*this->internedStrings.insert(str).first);
+}
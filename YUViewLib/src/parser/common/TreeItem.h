@@ -32,138 +32,181 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
-#include <sstream>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
-// The tree item is used to feed the tree view.
-class TreeItem : public std::enable_shared_from_this<TreeItem>
+class TreeItemArena;
+
+// The tree item is used to feed the tree view. When parsing a bitstream, one item is created for
+// every syntax element so the items must be small. All items of one tree are allocated in blocks
+// from a common TreeItemArena, the names/codings/meanings are interned in the arena and numeric
+// values and codes are stored unformatted. They are only converted to strings when they are
+// requested for display (getData). The shared pointers to the items all share the ownership of the
+// arena, so the whole tree stays valid as long as a pointer to any item of it exists.
+// Items of one tree must only be created from one thread at a time.
+class TreeItem
 {
 public:
-  TreeItem()  = default;
   ~TreeItem() = default;
 
-  void setProperties(std::string name    = {},
-                     std::string value   = {},
-                     std::string coding  = {},
-                     std::string code    = {},
-                     std::string meaning = {})
-  {
-    this->name    = name;
-    this->value   = value;
-    this->coding  = coding;
-    this->code    = code;
-    this->meaning = meaning;
-  }
+  // Create the root item of a new tree
+  static std::shared_ptr<TreeItem> createRootItem();
+
+  void setProperties(const std::string &name    = {},
+                     const std::string &value   = {},
+                     const std::string &coding  = {},
+                     const std::string &code    = {},
+                     const std::string &meaning = {});
 
   void setError(bool isError = true) { this->error = isError; }
   bool isError() const { return this->error; }
 
-  std::string getName(bool showStreamIndex) const
-  {
-    std::stringstream ss;
-    if (showStreamIndex && this->streamIndex >= 0)
-      ss << "Stream " << this->streamIndex << " - ";
-    ss << this->name;
-    return ss.str();
-  }
+  std::string getName(bool showStreamIndex) const;
+  void        setName(const std::string &name);
 
-  void setName(const std::string &name) { this->name = name; }
-
-  int getStreamIndex() const
-  {
-    if (this->streamIndex >= 0)
-      return this->streamIndex;
-    if (auto p = this->parent.lock())
-      return p->getStreamIndex();
-    return -1;
-  }
+  int  getStreamIndex() const;
   void setStreamIndex(int idx) { this->streamIndex = idx; }
 
   template <typename T>
-  std::shared_ptr<TreeItem> createChildItem(std::string name    = {},
-                                            T           value   = {},
-                                            std::string coding  = {},
-                                            std::string code    = {},
-                                            std::string meaning = {},
-                                            bool        isError = false)
+  std::shared_ptr<TreeItem> createChildItem(const std::string &name    = {},
+                                            T                  value   = {},
+                                            const std::string &coding  = {},
+                                            const std::string &code    = {},
+                                            const std::string &meaning = {},
+                                            bool               isError = false)
   {
-    auto newItem    = std::make_shared<TreeItem>();
-    newItem->parent = this->weak_from_this();
-    newItem->setProperties(name, std::to_string(value), coding, code, meaning);
-    newItem->error = isError;
-    this->childItems.push_back(newItem);
-    return newItem;
+    static_assert(std::is_arithmetic_v<T>, "Only numeric values can be stored unformatted");
+    auto newItem = this->addChildItem(name, coding, code, meaning, isError);
+    if constexpr (std::is_floating_point_v<T>)
+      newItem->setValue(std::to_string(value));
+    else if constexpr (std::is_signed_v<T>)
+      newItem->setValue(int64_t(value));
+    else
+      newItem->setValue(uint64_t(value));
+    return this->toSharedPointer(newItem);
   }
 
-  std::shared_ptr<TreeItem> createChildItem(std::string name    = {},
-                                            std::string value   = {},
-                                            std::string coding  = {},
-                                            std::string code    = {},
-                                            std::string meaning = {},
-                                            bool        isError = false)
+  std::shared_ptr<TreeItem> createChildItem(const std::string &name    = {},
+                                            const std::string &value   = {},
+                                            const std::string &coding  = {},
+                                            const std::string &code    = {},
+                                            const std::string &meaning = {},
+                                            bool               isError = false)
   {
-    auto newItem    = std::make_shared<TreeItem>();
-    newItem->parent = this->weak_from_this();
-    newItem->setProperties(name, value, coding, code, meaning);
-    newItem->error = isError;
-    this->childItems.push_back(newItem);
-    return newItem;
+    auto newItem = this->addChildItem(name, coding, code, meaning, isError);
+    newItem->setValue(value);
+    return this->toSharedPointer(newItem);
   }
 
   size_t getNrChildItems() const { return this->childItems.size(); }
 
-  std::string getData(unsigned idx) const
-  {
-    switch (idx)
-    {
-    case 0:
-      return this->name;
-    case 1:
-      return this->value;
-    case 2:
-      return this->coding;
-    case 3:
-      return this->code;
-    case 4:
-      return this->meaning;
-    default:
-      return {};
-    }
-  }
+  // Get the data of the given column as a string. Numeric values are formatted here.
+  std::string getData(unsigned idx) const;
 
-  const std::shared_ptr<TreeItem> getChild(unsigned idx) const
+  std::shared_ptr<TreeItem> getChild(unsigned idx) const
   {
     if (idx < this->childItems.size())
-      return this->childItems[idx];
+      return this->toSharedPointer(this->childItems[idx]);
     return {};
   }
 
-  std::weak_ptr<TreeItem> getParentItem() const { return this->parent; }
+  TreeItem *getParentItem() const { return this->parent; }
 
-  std::optional<size_t> getIndexOfChildItem(std::shared_ptr<TreeItem> child) const
+  std::optional<size_t> getIndexOfChildItem(const TreeItem *child) const
   {
-    for (size_t i = 0; i < this->childItems.size(); i++)
-      if (this->childItems[i] == child)
-        return i;
-
-    std::optional<size_t> ret;
-    return ret;
+    if (child != nullptr && child->parent == this)
+      return child->indexInParent;
+    return {};
   }
 
+  // Append copies of all child items (and their children) of the root item of another tree to the
+  // child items of this item. The other tree may have been created in another thread. It is not
+  // needed anymore afterwards so that its arena can be freed.
+  void adoptChildItems(std::shared_ptr<TreeItem> otherRoot);
+
 private:
-  std::vector<std::shared_ptr<TreeItem>> childItems;
-  std::weak_ptr<TreeItem>                parent{};
+  friend class TreeItemArena;
+  TreeItem() = default;
+
+  TreeItem *addChildItem(const std::string &name,
+                         const std::string &coding,
+                         const std::string &code,
+                         const std::string &meaning,
+                         bool               isError);
 
-  std::string name;
-  std::string value;
-  std::string coding;
-  std::string code;
-  std::string meaning;
+  std::shared_ptr<TreeItem> toSharedPointer(TreeItem *item) const;
+
+  // Map the interned strings of another arena to the interned strings of this arena
+  using InternedStringMap = std::unordered_map<const std::string *, const std::string *>;
+  void copyChildItems(const TreeItem &other, InternedStringMap &internedStrings);
+
+  void setValue(int64_t value);
+  void setValue(uint64_t value);
+  void setValue(const std::string &value);
+  void setCode(const std::string &code);
+
+  enum class ValueType : uint8_t
+  {
+    None,
+    Signed,
+    Unsigned,
+    String
+  };
+
+  std::vector<TreeItem *> childItems;
+  TreeItem               *parent{};
+  TreeItemArena          *arena{};
+  uint32_t                indexInParent{};
+
+  const std::string *name{};
+  const std::string *coding{};
+  const std::string *meaning{};
+
+  union
+  {
+    int64_t            signedValue;
+    uint64_t           unsignedValue;
+    const std::string *stringValue{};
+  };
+  ValueType valueType{ValueType::None};
+
+  // Codes of up to 64 bits (strings of '0' and '1') are stored as bits. All others are interned.
+  uint8_t            nrCodeBits{};
+  uint64_t           codeBits{};
+  const std::string *codeString{};
 
   bool error{};
   // This is set for the first layer items in case of AVPackets
   int streamIndex{-1};
 };
+
+// Allocates the items of one tree in blocks and interns all strings of the tree. Most trees are
+// small (e.g. the syntax of one slice), so the blocks start small and grow with the tree.
+class TreeItemArena : public std::enable_shared_from_this<TreeItemArena>
+{
+public:
+  TreeItem *allocateItem();
+
+  // Get a pointer to an interned copy of the given string. The pointer stays valid as long as the
+  // arena exists. For an empty string, nullptr is returned.
+  const std::string *intern(const std::string &str);
+
+  size_t getNrItems() const { return this->nrItems; }
+
+private:
+  friend class TreeItem;
+  static constexpr size_t MIN_BLOCK_SIZE = 16;
+  static constexpr size_t MAX_BLOCK_SIZE = 4096;
+
+  std::vector<std::unique_ptr<TreeItem[]>> blocks;
+  size_t                                   lastBlockSize{};
+  size_t                                   nrItemsInLastBlock{};
+  size_t                                   nrItems{};
+  std::unordered_set<std::string>          internedStrings;
+};
@@ -43,6 +43,7 @@
 #include <QTreeWidgetItem>
 
 #include <memory>
+#include <vector>
 
 #include "ui_playlistItem.h"
 
@@ -214,6 +215,15 @@ public:
   // Is there a limit on the number of threads that can cache from this item at the same time? (-1 =
   // no limit)
   virtual int cachingThreadLimit() { return -1; }
+  // Can the frames of this item only be cached in order because caching one frame depends on the
+  // frame before it (e.g. decoding)? In this case, return the ranges within the given range that
+  // can be cached independently of each other (e.g. GOPs). Only one thread at a time will cache
+  // from each range. An empty list (the default) means all frames are independent.
+  virtual std::vector<indexRange> getSequentialCachingRanges(indexRange) { return {}; }
+  // The video cache announces which frames of this item it is going to cache next (in this order).
+  // An item can use this to prepare the data in the background (e.g. read the frames from file).
+  // The list is replaced every time the cache queue is updated.
+  virtual void setQueuedCachingRanges(const std::vector<indexRange> &) {}
   // Tag the item as "to be deleted"
   void tagItemForDeletion() { itemTaggedForDeletion = true; }
   // Cache the given frame. This function is thread save. So multiple instances of this function can
@@ -36,7 +36,9 @@
 #include <QPlainTextEdit>
 #include <QThread>
 
+#include <algorithm>
 #include <inttypes.h>
+#include <limits>
 
 #include <common/Formatting.h>
 #include <common/Functions.h>
@@ -55,6 +57,7 @@
 #include <statistics/StatisticsDataPainting.h>
 #include <ui/Mainwindow.h>
 #include <ui_playlistItemCompressedFile_logDialog.h>
+#include <video/DiskFrameCache.h>
 #include <video/rgb/videoHandlerRGB.h>
 #include <video/yuv/videoHandlerYUV.h>
 
@@ -115,7 +118,8 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
   this->prop.propertiesWidgetTitle = "Compressed File Properties";
 
   // An compressed file can be cached if nothing goes wrong
-  this->cachingEnabled = true;
+  this->cachingEnabled   = true;
+  this->diskCacheFileKey = functions::getFileKey(compressedFilePath);
 
   // Open the input file and get some properties (size, bit depth, subsampling) from the file
   if (input == InputFormat::Invalid)
@@ -143,10 +147,18 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
   {
     // Open file
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Open annexB file");
-    const auto filePath          = std::filesystem::path(compressedFilePath.toStdString());
-    this->inputFileAnnexBLoading = std::make_unique<FileSourceAnnexBFile>(filePath);
+    const auto filePath           = std::filesystem::path(compressedFilePath.toStdString());
+    this->loading.inputFileAnnexB = std::make_unique<FileSourceAnnexBFile>(filePath);
     if (this->cachingEnabled)
-      this->inputFileAnnexBCaching = std::make_unique<FileSourceAnnexBFile>(filePath);
+    {
+      const auto nrCachingDecoders = decoder::getNrCachingDecoders();
+      for (int i = 0; i < nrCachingDecoders; i++)
+      {
+        auto instance             = std::make_unique<DecoderInstance>();
+        instance->inputFileAnnexB = std::make_unique<FileSourceAnnexBFile>(filePath);
+        this->cachingInstances.push_back(std::move(instance));
+      }
+    }
     // inputFormatType a parser
     if (this->inputFormat == InputFormat::AnnexBHEVC)
     {
@@ -171,7 +183,7 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
 
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo Start parsing of file");
-    this->inputFileAnnexBParser->parseAnnexBFile(this->inputFileAnnexBLoading, mainWindow);
+    this->inputFileAnnexBParser->parseAnnexBFile(this->loading.inputFileAnnexB, mainWindow);
 
     // Get the frame size and the pixel format
     frameSize = this->inputFileAnnexBParser->getSequenceSizeSamples();
@@ -197,42 +209,42 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     // Try ffmpeg to open the file
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo Open file using ffmpeg");
-    this->inputFileFFmpegLoading = std::make_unique<FileSourceFFmpegFile>();
-    if (!this->inputFileFFmpegLoading->openFile(compressedFilePath, mainWindow))
+    this->loading.inputFileFFmpeg = std::make_unique<FileSourceFFmpegFile>();
+    if (!this->loading.inputFileFFmpeg->openFile(compressedFilePath, mainWindow))
     {
       this->setError("Error opening file using libavcodec.");
       return;
     }
     // Is this file RGB or YUV?
-    this->rawFormat = this->inputFileFFmpegLoading->getRawFormat();
+    this->rawFormat = this->loading.inputFileFFmpeg->getRawFormat();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Raw format "
                      << (this->rawFormat == video::RawFormat::YUV   ? "YUV"
                          : this->rawFormat == video::RawFormat::RGB ? "RGB"
                                                                     : "Unknown"));
     if (this->rawFormat == video::RawFormat::YUV)
-      formatYuv = this->inputFileFFmpegLoading->getPixelFormatYUV();
+      formatYuv = this->loading.inputFileFFmpeg->getPixelFormatYUV();
     else if (this->rawFormat == video::RawFormat::RGB)
-      formatRgb = this->inputFileFFmpegLoading->getPixelFormatRGB();
+      formatRgb = this->loading.inputFileFFmpeg->getPixelFormatRGB();
     else
     {
       this->setError("Unknown raw format.");
       return;
     }
-    frameSize = this->inputFileFFmpegLoading->getSequenceSizeSamples();
+    frameSize = this->loading.inputFileFFmpeg->getSequenceSizeSamples();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Frame size "
                      << frameSize.width << "x" << frameSize.height);
-    this->prop.frameRate = this->inputFileFFmpegLoading->getFramerate();
+    this->prop.frameRate = this->loading.inputFileFFmpeg->getFramerate();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo framerate "
                      << this->prop.frameRate);
-    this->prop.startEndRange = this->inputFileFFmpegLoading->getDecodableFrameLimits();
+    this->prop.startEndRange = this->loading.inputFileFFmpeg->getDecodableFrameLimits();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo startEndRange ("
                      << this->prop.startEndRange.first << "x" << this->prop.startEndRange.second
                      << ")");
-    this->ffmpegCodec = inputFileFFmpegLoading->getVideoStreamCodecID();
+    this->ffmpegCodec = this->loading.inputFileFFmpeg->getVideoStreamCodecID();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo ffmpeg codec "
                      << this->ffmpegCodec.getCodecName());
     this->prop.sampleAspectRatio =
-        this->inputFileFFmpegLoading->getVideoCodecPar().getSampleAspectRatio();
+        this->loading.inputFileFFmpeg->getVideoCodecPar().getSampleAspectRatio();
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::playlistItemCompressedVideo sample aspect ratio ("
         << this->prop.sampleAspectRatio.num << "x" << this->prop.sampleAspectRatio.den << ")");
@@ -245,13 +257,19 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
 
     if (this->cachingEnabled)
     {
-      // Open the file again for caching
-      this->inputFileFFmpegCaching = std::make_unique<FileSourceFFmpegFile>();
-      if (!this->inputFileFFmpegCaching->openFile(
-              compressedFilePath, mainWindow, this->inputFileFFmpegLoading.get()))
+      // Open the file again for every caching decoder
+      const auto nrCachingDecoders = decoder::getNrCachingDecoders();
+      for (int i = 0; i < nrCachingDecoders; i++)
       {
-        this->setError("Error opening file a second time using libavcodec for caching.");
-        return;
+        auto instance             = std::make_unique<DecoderInstance>();
+        instance->inputFileFFmpeg = std::make_unique<FileSourceFFmpegFile>();
+        if (!instance->inputFileFFmpeg->openFile(
+                compressedFilePath, mainWindow, this->loading.inputFileFFmpeg.get()))
+        {
+          this->setError("Error opening file a second time using libavcodec for caching.");
+          return;
+        }
+        this->cachingInstances.push_back(std::move(instance));
       }
     }
   }
@@ -353,7 +371,7 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
   {
     auto yuvVideo = this->getYUVVideo();
     yuvVideo->showPixelValuesAsDiff =
-        loadingDecoder->isSignalDifference(loadingDecoder->getDecodeSignal());
+        this->loading.decoder->isSignalDifference(this->loading.decoder->getDecodeSignal());
   }
 
   // Fill the list of statistics that we can provide
@@ -366,12 +384,12 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
     // No frames to decode
     return;
 
-  // Seek both decoders to the start of the bitstream (this will also push the parameter sets /
+  // Seek all decoders to the start of the bitstream (this will also push the parameter sets /
   // extradata to the decoder)
   DEBUG_COMPRESSED("playlistItemCompressedVideo::playlistItemCompressedVideo Seek decoders to 0");
-  this->seekToPosition(0, 0, false);
-  if (this->cachingEnabled)
-    this->seekToPosition(0, 0, true);
+  this->seekToPosition(this->loading, 0, 0);
+  for (auto &instance : this->cachingInstances)
+    this->seekToPosition(*instance, 0, 0);
 
   // Connect signals for requesting data and statistics
   this->connect(video.get(),
@@ -379,6 +397,11 @@ playlistItemCompressedVideo::playlistItemCompressedVideo(const QString &compress
                 this,
                 &playlistItemCompressedVideo::loadRawData,
                 Qt::DirectConnection);
+  this->connect(video.get(),
+                &video::videoHandler::signalRequestRawDataForCaching,
+                this,
+                &playlistItemCompressedVideo::loadRawDataForCaching,
+                Qt::DirectConnection);
   this->connect(&this->statisticsUIHandler,
                 &stats::StatisticUIHandler::updateItem,
                 this,
@@ -402,15 +425,16 @@ void playlistItemCompressedVideo::savePlaylist(QDomElement &root, const QDir &pl
   // Append all the properties of the HEVC file (the path to the file. Relative and absolute)
   d.appendProperiteChild("absolutePath", fileURL.toString());
   d.appendProperiteChild("relativePath", relativePath);
-  d.appendProperiteChild("displayComponent",
-                         QString::number(loadingDecoder ? loadingDecoder->getDecodeSignal() : -1));
+  d.appendProperiteChild(
+      "displayComponent",
+      QString::number(this->loading.decoder ? this->loading.decoder->getDecodeSignal() : -1));
 
   d.appendProperiteChild("inputFormat", InputFormatMapper.getName(this->inputFormat));
   d.appendProperiteChild("decoder", DecoderEngineMapper.getName(this->decoderEngine));
 
   if (this->video)
     this->video->savePlaylist(d);
-  if (this->loadingDecoder && loadingDecoder->statisticsSupported())
+  if (this->loading.decoder && this->loading.decoder->statisticsSupported())
   {
     auto newChild = YUViewDomElement(d.ownerDocument().createElement("StatisticsData"));
     this->statisticsData.savePlaylist(newChild);
@@ -458,6 +482,7 @@ playlistItemCompressedVideo::newPlaylistItemCompressedVideo(const YUViewDomEleme
     }
     n = n.nextSibling();
   }
+  newFile->updateStatisticsRendered();
   playlistItem::loadPropertiesFromPlaylist(root, newFile);
 
   return newFile;
@@ -468,12 +493,12 @@ InfoData playlistItemCompressedVideo::getInfo() const
   InfoData info("HEVC File Info");
 
   // At first append the file information part (path, date created, file size...)
-  // info.items.append(loadingDecoder->getFileInfoList());
+  // info.items.append(this->loading.decoder->getFileInfoList());
 
   info.items.append(InfoItem("Reader", InputFormatMapper.getName(this->inputFormat)));
-  if (this->inputFileFFmpegLoading)
+  if (this->loading.inputFileFFmpeg)
   {
-    auto libraryPaths = this->inputFileFFmpegLoading->getLibraryPaths();
+    auto libraryPaths = this->loading.inputFileFFmpeg->getLibraryPaths();
     if (libraryPaths.length() % 3 == 0)
     {
       for (int i = 0; i < libraryPaths.length() / 3; i++)
@@ -493,21 +518,21 @@ InfoData playlistItemCompressedVideo::getInfo() const
         InfoItem("Num POCs", std::to_string(nrFrames), "The number of pictures in the stream."));
     if (this->decodingEnabled)
     {
-      auto l = loadingDecoder->getLibraryPaths();
+      auto l = this->loading.decoder->getLibraryPaths();
       if (l.length() % 3 == 0)
       {
         for (int i = 0; i < l.length() / 3; i++)
           info.items.append(InfoItem(
               l[i * 3].toStdString(), l[i * 3 + 1].toStdString(), l[i * 3 + 2].toStdString()));
       }
-      info.items.append(InfoItem("Decoder", this->loadingDecoder->getDecoderName().toStdString()));
-      info.items.append(InfoItem("Decoder", this->loadingDecoder->getCodecName().toStdString()));
+      info.items.append(InfoItem("Decoder", this->loading.decoder->getDecoderName().toStdString()));
+      info.items.append(InfoItem("Decoder", this->loading.decoder->getCodecName().toStdString()));
       info.items.append(InfoItem("Statistics"sv,
-                                 this->loadingDecoder->statisticsSupported() ? "Yes" : "No",
+                                 this->loading.decoder->statisticsSupported() ? "Yes" : "No",
                                  "Is the decoder able to provide internals (statistics)?"));
       info.items.append(
           InfoItem("Stat Parsing"sv,
-                   this->loadingDecoder->statisticsEnabled() ? "Yes" : "No",
+                   this->loading.decoder->statisticsEnabled() ? "Yes" : "No",
                    "Are the statistics of the sequence currently extracted from the stream?"));
     }
   }
@@ -536,9 +561,9 @@ void playlistItemCompressedVideo::infoListButtonPressed(int buttonID)
     uiDialog.ffmpegLogEdit->setPlainText(logFFmpegString);
 
     // Get the loading log
-    if (this->inputFileFFmpegLoading)
+    if (this->loading.inputFileFFmpeg)
     {
-      auto    logLoading = this->inputFileFFmpegLoading->getFFmpegLoadingLog();
+      auto    logLoading = this->loading.inputFileFFmpeg->getFFmpegLoadingLog();
       QString logLoadingString;
       for (const auto &l : logLoading)
         logLoadingString.append(l + "\n");
@@ -556,7 +581,7 @@ ItemLoadingState playlistItemCompressedVideo::needsLoading(int frameIdx, bool lo
 
   auto videoState = this->video->needsLoading(frameIdx, loadRawData);
   if (videoState == ItemLoadingState::LoadingNeeded && this->decodingNotPossibleAfter >= 0 &&
-      frameIdx >= this->decodingNotPossibleAfter && frameIdx >= this->currentFrameIdx[0])
+      frameIdx >= this->decodingNotPossibleAfter && frameIdx >= this->loading.currentFrameIdx)
     // The decoder can not decode this frame.
     return ItemLoadingState::LoadingNotNeeded;
   if (videoState == ItemLoadingState::LoadingNeeded ||
@@ -583,7 +608,7 @@ void playlistItemCompressedVideo::drawItem(QPainter *painter,
   {
     playlistItem::drawItem(painter, -1, zoomFactor, drawRawData);
   }
-  else if (!this->loadingDecoder)
+  else if (!this->loading.decoder)
   {
     this->infoText = "No decoder allocated.\n";
     playlistItem::drawItem(painter, -1, zoomFactor, drawRawData);
@@ -597,40 +622,292 @@ void playlistItemCompressedVideo::drawItem(QPainter *painter,
 
 void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
 {
-  if (caching && !this->cachingEnabled)
+  // Requests from the caching threads are handled by loadRawDataForCaching
+  if (caching)
     return;
-  if (!caching && this->loadingDecoder->state() == decoder::DecoderState::Error)
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData " << frameIdx);
+
+  // Frames from the disk cache have no statistics. If the decoder can just continue with the next
+  // frame, decoding is preferred so that it can also continue with the frames after that.
+  const auto statisticsEnabled =
+      this->loading.decoder && this->loading.decoder->statisticsEnabled();
+  if (!statisticsEnabled && this->loading.currentFrameIdx != frameIdx &&
+      this->loading.currentFrameIdx != frameIdx - 1)
   {
-    if (frameIdx < this->currentFrameIdx[0])
+    if (auto frameData = this->loadFrameFromDiskCache(frameIdx))
     {
-      // There was an error in the loading decoder but we will seek backwards so maybe this will
-      // work again
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData " << frameIdx << " from disk");
+      this->video->rawData            = *frameData;
+      this->video->rawData_frameIndex = frameIdx;
+      return;
     }
-    else
+  }
+
+  const auto isNewFrame = this->loading.currentFrameIdx != frameIdx;
+  if (this->decodeFrame(this->loading, frameIdx))
+  {
+    if (this->loading.decoder->statisticsEnabled())
+    {
+      // The decoder adds the statistics of a newly decoded frame. Statistics of the same frame that
+      // were taken from the statistics cache must be replaced.
+      if (isNewFrame)
+        this->statisticsData.setFrameTypeData(frameIdx, {});
+      else
+        this->statisticsData.setFrameIndex(frameIdx);
+    }
+    this->video->rawData            = this->loading.decoder->getRawFrameData();
+    this->video->rawData_frameIndex = frameIdx;
+    if (isNewFrame)
+      this->storeFrameInDiskCache(frameIdx, video::RawFrameBuffer(this->video->rawData));
+  }
+  else if (this->decodingNotPossibleAfter >= 0 && frameIdx >= this->decodingNotPossibleAfter)
+  {
+    // Just set the frame number of the buffer to the current frame so that it will trigger a
+    // reload when the frame number changes.
+    this->video->rawData_frameIndex = frameIdx;
+  }
+  else if (this->loading.decoder && this->loading.decoder->state() == decoder::DecoderState::Error)
+  {
+    this->infoText = "There was an error in the decoder: \n";
+    this->infoText += this->loading.decoder->decoderErrorString();
+    this->infoText += "\n";
+
+    this->decodingEnabled = false;
+  }
+}
+
+void playlistItemCompressedVideo::loadRawDataForCaching(int                    frameIdx,
+                                                        video::RawFrameBuffer &frameOut,
+                                                        bool                  &success)
+{
+  success = false;
+  if (!this->cachingEnabled || this->cachingInstances.empty())
+    return;
+
+  DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawDataForCaching " << frameIdx);
+
+  auto instance = this->acquireCachingDecoder(frameIdx);
+
+  // If statistics are shown, also collect them for every cached frame. Otherwise, the frame would
+  // have to be decoded again by the loading decoder when the statistics are drawn.
+  const auto cacheStatistics = this->statisticsRendered && this->loading.decoder &&
+                               this->loading.decoder->statisticsEnabled();
+  if (cacheStatistics != instance->decoder->statisticsEnabled())
+  {
+    // Switching the collection of statistics on or off requires a reset of the decoder. This is
+    // done when seeking.
+    instance->decoder->enableStatisticsRetrieval(cacheStatistics ? &instance->statisticsData
+                                                                 : nullptr);
+    instance->currentFrameIdx = -1;
+  }
+  if (cacheStatistics)
+    instance->statisticsData.setFrameIndex(frameIdx);
+
+  // Read the frame from the disk cache unless the decoder can just continue with the next frame
+  if (!cacheStatistics && instance->currentFrameIdx != frameIdx - 1)
+  {
+    if (auto frameData = this->loadFrameFromDiskCache(frameIdx))
+    {
+      instance->available.release();
+      frameOut = video::RawFrameBuffer(*frameData);
+      success  = true;
       return;
+    }
   }
-  if (caching && this->cachingDecoder->state() == decoder::DecoderState::Error)
+
+  if (!this->decodeFrame(*instance, frameIdx))
+  {
+    instance->available.release();
     return;
+  }
 
-  DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData " << frameIdx
-                                                               << (caching ? " caching" : ""));
+  frameOut = instance->decoder->getRawFrameBuffer();
+  success  = !frameOut.isNull();
+  if (success)
+    this->storeFrameInDiskCache(frameIdx, frameOut);
 
-  if (frameIdx > this->properties().startEndRange.second || frameIdx < 0)
+  // The decoder adds the statistics when the frame is retrieved. Frames without any statistics are
+  // cached as well. Otherwise, they would be decoded again when the statistics are drawn.
+  if (success && cacheStatistics)
+  {
+    auto frameStatistics = instance->statisticsData.takeFrameTypeData();
+
+    std::unique_lock<std::mutex> lock(this->renderedStatisticsMutex);
+    const auto                  &typeIDs = this->renderedStatisticsTypeIDs;
+    for (auto it = frameStatistics.begin(); it != frameStatistics.end();)
+    {
+      if (std::find(typeIDs.begin(), typeIDs.end(), it->first) == typeIDs.end())
+        it = frameStatistics.erase(it);
+      else
+        it++;
+    }
+    this->statisticsCache.add(frameIdx, std::move(frameStatistics));
+  }
+
+  // The frame buffer may point directly to the output picture of the decoder. In this case, the
+  // decoder is not released before the caching thread has converted the frame.
+  if (success && frameOut.isView())
+    frameOut.addReleaseFunction([instance]() { instance->available.release(); });
+  else
+    instance->available.release();
+}
+
+playlistItemCompressedVideo::DecoderInstance *
+playlistItemCompressedVideo::acquireCachingDecoder(int frameIdx)
+{
+  std::vector<DecoderInstance *> freeInstances;
+  for (auto &instance : this->cachingInstances)
+    if (instance->available.tryAcquire())
+      freeInstances.push_back(instance.get());
+
+  if (freeInstances.empty())
+  {
+    // This should not happen because the number of caching threads for this item is limited to the
+    // number of caching decoders. Wait for the first one.
+    this->cachingInstances[0]->available.acquire();
+    return this->cachingInstances[0].get();
+  }
+
+  // Use the decoder that is closest before the frame (so that it can continue decoding without
+  // seeking). Otherwise use the first free decoder.
+  auto bestInstance = freeInstances[0];
+  auto bestDistance = std::numeric_limits<int>::max();
+  for (auto instance : freeInstances)
   {
-    DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData Invalid frame index");
+    if (instance->currentFrameIdx < 0 || instance->currentFrameIdx > frameIdx)
+      continue;
+    if (frameIdx - instance->currentFrameIdx < bestDistance)
+    {
+      bestInstance = instance;
+      bestDistance = frameIdx - instance->currentFrameIdx;
+    }
+  }
+
+  for (auto instance : freeInstances)
+    if (instance != bestInstance)
+      instance->available.release();
+  return bestInstance;
+}
+
+QString playlistItemCompressedVideo::getDiskCacheSourceKey() const
+{
+  // Everything that changes the decoded frames
+  const auto decoderName = DecoderEngineMapper.getName(this->decoderEngine);
+  const auto signal      = this->loading.decoder ? this->loading.decoder->getDecodeSignal() : 0;
+  return QString("%1|%2|%3")
+      .arg(this->diskCacheFileKey)
+      .arg(QString::fromStdString(std::string(decoderName)))
+      .arg(signal);
+}
+
+std::optional<QByteArray> playlistItemCompressedVideo::loadFrameFromDiskCache(int frameIdx) const
+{
+  const auto diskCache = video::getGlobalDiskFrameCache();
+  if (!diskCache)
+    return {};
+
+  auto frameData = diskCache->loadFrame(this->getDiskCacheSourceKey(), frameIdx);
+  if (frameData && frameData->size() != this->video->getBytesPerFrame())
+    return {};
+  return frameData;
+}
+
+void playlistItemCompressedVideo::storeFrameInDiskCache(int                          frameIdx,
+                                                        const video::RawFrameBuffer &frame) const
+{
+  const auto diskCache = video::getGlobalDiskFrameCache();
+  if (!diskCache)
     return;
+
+  const auto sourceKey = this->getDiskCacheSourceKey();
+  if (!diskCache->containsFrame(sourceKey, frameIdx))
+    diskCache->storeFrameInBackground(sourceKey, frameIdx, frame.toByteArray());
+}
+
+std::vector<indexRange> playlistItemCompressedVideo::getSequentialCachingRanges(indexRange range)
+{
+  QMutexLocker lock(&this->seekPointOfFrameMutex);
+  if (this->seekPointOfFrame.empty())
+  {
+    if (this->inputFileAnnexBParser)
+    {
+      for (auto seekPoint : this->inputFileAnnexBParser->getSeekPointsDisplayOrder())
+        this->seekPointOfFrame.push_back(int(seekPoint));
+    }
+    else if (this->loading.inputFileFFmpeg)
+    {
+      // Same rule as in getClosestSeekableFrameBefore but in one pass over the sorted keyframes
+      const auto keyFrames = this->loading.inputFileFFmpeg->getKeyFrameIndices();
+      if (!keyFrames.empty())
+      {
+        auto   seekPoint    = keyFrames.front();
+        size_t nextKeyFrame = 0;
+        for (int i = 0; i <= this->properties().startEndRange.second; i++)
+        {
+          while (nextKeyFrame < keyFrames.size() && keyFrames[nextKeyFrame] <= size_t(i))
+            seekPoint = keyFrames[nextKeyFrame++];
+          this->seekPointOfFrame.push_back(int(seekPoint));
+        }
+      }
+    }
+  }
+
+  // Start a new range whenever the seek point changes
+  std::vector<indexRange> ranges;
+  int                     lastSeekPoint = -1;
+  for (int frameIdx = range.first; frameIdx <= range.second; frameIdx++)
+  {
+    auto seekPoint = -1;
+    if (frameIdx >= 0 && frameIdx < int(this->seekPointOfFrame.size()))
+      seekPoint = this->seekPointOfFrame[frameIdx];
+
+    if (ranges.empty() || seekPoint != lastSeekPoint)
+      ranges.push_back(indexRange(frameIdx, frameIdx));
+    else
+      ranges.back().second = frameIdx;
+    lastSeekPoint = seekPoint;
+  }
+  return ranges;
+}
+
+void playlistItemCompressedVideo::setDecodingNotPossibleAfter(int frameIdx)
+{
+  // Several decoders may fail at the same time. Keep the smallest frame index.
+  auto current = this->decodingNotPossibleAfter.load();
+  while ((current < 0 || frameIdx < current) &&
+         !this->decodingNotPossibleAfter.compare_exchange_weak(current, frameIdx))
+  {
+  }
+}
+
+bool playlistItemCompressedVideo::decodeFrame(DecoderInstance &instance, int frameIdx)
+{
+  const auto dec = instance.decoder.get();
+  if (dec == nullptr)
+    return false;
+  if (dec->state() == decoder::DecoderState::Error && frameIdx >= instance.currentFrameIdx)
+    // There was an error in the decoder. If we seek backwards, maybe this will work again.
+    return false;
+
+  if (frameIdx > this->properties().startEndRange.second || frameIdx < 0)
+  {
+    DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame Invalid frame index");
+    return false;
   }
 
-  // Get the right decoder
-  const auto dec         = caching ? this->cachingDecoder.get() : this->loadingDecoder.get();
-  const auto curFrameIdx = caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0];
+  // The decoder may still hold the requested frame
+  const auto curFrameIdx = instance.currentFrameIdx;
+  if (curFrameIdx == frameIdx && instance.decodedFrameIdx == frameIdx)
+    return true;
+  instance.decodedFrameIdx = -1;
 
   // Should we seek?
-  if (curFrameIdx == -1 || frameIdx < curFrameIdx ||
+  if (curFrameIdx == -1 || frameIdx <= curFrameIdx ||
       frameIdx > curFrameIdx + FORWARD_SEEK_THRESHOLD)
   {
     // Definitely seek when we have to go backwards
-    bool seek = curFrameIdx == -1 || (frameIdx < curFrameIdx);
+    bool seek = curFrameIdx == -1 || (frameIdx <= curFrameIdx);
 
     // Get the closest possible seek position
     size_t  seekToFrame = 0;
@@ -645,12 +922,8 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     }
     else
     {
-      if (caching)
-        std::tie(seekToDTS, seekToFrame) =
-            this->inputFileFFmpegCaching->getClosestSeekableFrameBefore(frameIdx);
-      else
-        std::tie(seekToDTS, seekToFrame) =
-            this->inputFileFFmpegLoading->getClosestSeekableFrameBefore(frameIdx);
+      std::tie(seekToDTS, seekToFrame) =
+          instance.inputFileFFmpeg->getClosestSeekableFrameBefore(frameIdx);
 
       // The distance in the display order unfortunately does not tell us
       // too much about the number of frames that must be decoded to seek
@@ -662,45 +935,41 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     if (seek)
     {
       // Seek and update the frame counters. The seekToPosition function will update the
-      // currentFrameIdx[] indices
-      this->readAnnexBFrameCounterCodingOrder = int(seekToFrame);
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData seeking to frame "
+      // currentFrameIdx of the instance.
+      instance.readAnnexBFrameCounterCodingOrder = int(seekToFrame);
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame seeking to frame "
                        << seekToFrame << " PTS " << seekToDTS << " AnnexBCnt "
-                       << this->readAnnexBFrameCounterCodingOrder);
-      this->seekToPosition(this->readAnnexBFrameCounterCodingOrder, seekToDTS, caching);
+                       << instance.readAnnexBFrameCounterCodingOrder);
+      this->seekToPosition(instance, instance.readAnnexBFrameCounterCodingOrder, seekToDTS);
     }
   }
 
   // Decode until we get the right frame from the decoder
-  bool rightFrame =
-      caching ? this->currentFrameIdx[1] == frameIdx : this->currentFrameIdx[0] == frameIdx;
+  auto rightFrame = false;
   while (!rightFrame)
   {
     while (dec->state() == decoder::DecoderState::NeedsMoreData)
     {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoder needs more data");
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoder needs more data");
       if (isInputFormatTypeFFmpeg(this->inputFormat) &&
           this->decoderEngine == DecoderEngine::FFMpeg)
       {
         // In this scenario, we can read and push AVPackets
         // from the FFmpeg file and pass them to the FFmpeg decoder directly.
-        auto pkt   = caching ? this->inputFileFFmpegCaching->getNextPacket(repushData)
-                             : this->inputFileFFmpegLoading->getNextPacket(repushData);
-        repushData = false;
+        auto pkt            = instance.inputFileFFmpeg->getNextPacket(instance.repushData);
+        instance.repushData = false;
         if (pkt)
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData retrieved packet PTS "
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame retrieved packet PTS "
                            << pkt.getPTS());
         else
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData retrieved empty packet");
-        auto ffmpegDec =
-            (caching ? dynamic_cast<decoder::decoderFFmpeg *>(this->cachingDecoder.get())
-                     : dynamic_cast<decoder::decoderFFmpeg *>(this->loadingDecoder.get()));
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame retrieved empty packet");
+        auto ffmpegDec = dynamic_cast<decoder::decoderFFmpeg *>(dec);
         if (!ffmpegDec->pushAVPacket(pkt))
         {
           if (ffmpegDec->state() != decoder::DecoderState::RetrieveFrames)
             // The decoder did not switch to decoding frame mode. Error.
-            return;
-          this->repushData = true;
+            return false;
+          instance.repushData = true;
         }
       }
       else if (isInputFormatTypeAnnexB(this->inputFormat) &&
@@ -708,28 +977,27 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
       {
         // We are reading from a raw annexB file and use ffmpeg for decoding
         QByteArray data;
-        if (this->readAnnexBFrameCounterCodingOrder >= 0 &&
-            unsigned(this->readAnnexBFrameCounterCodingOrder) >=
+        if (instance.readAnnexBFrameCounterCodingOrder >= 0 &&
+            unsigned(instance.readAnnexBFrameCounterCodingOrder) >=
                 this->inputFileAnnexBParser->getNumberPOCs())
         {
-          DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData EOF");
+          DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame EOF");
         }
         else
         {
           // Get the data of the next frame (which might be multiple NAL units)
           auto frameStartEndFilePos = this->inputFileAnnexBParser->getFrameStartEndPos(
-              this->readAnnexBFrameCounterCodingOrder);
+              instance.readAnnexBFrameCounterCodingOrder);
           Q_ASSERT_X(frameStartEndFilePos,
-                     "playlistItemCompressedVideo::loadRawData",
+                     "playlistItemCompressedVideo::decodeFrame",
                      "frameStartEndFilePos could not be retrieved. This should always work for a "
                      "raw AnnexB file.");
 
-          data = caching ? this->inputFileAnnexBCaching->getFrameData(*frameStartEndFilePos)
-                         : this->inputFileAnnexBLoading->getFrameData(*frameStartEndFilePos);
+          data = instance.inputFileAnnexB->getFrameData(*frameStartEndFilePos);
           DEBUG_COMPRESSED(
-              "playlistItemCompressedVideo::loadRawData retrieved frame data from file "
+              "playlistItemCompressedVideo::decodeFrame retrieved frame data from file "
               "- AnnexBCnt "
-              << this->readAnnexBFrameCounterCodingOrder << " startEnd "
+              << instance.readAnnexBFrameCounterCodingOrder << " startEnd "
               << frameStartEndFilePos->first << "-" << frameStartEndFilePos->second << " - size "
               << data.size());
         }
@@ -738,9 +1006,9 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
         {
           if (dec->state() != decoder::DecoderState::RetrieveFrames)
           {
-            DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData The decoder did not switch "
+            DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame The decoder did not switch "
                              "to decoding frame mode. Error.");
-            this->decodingNotPossibleAfter = frameIdx;
+            this->setDecodingNotPossibleAfter(frameIdx);
             break;
           }
           // Pushing the data failed because the ffmpeg decoder wants us to read frames first.
@@ -748,28 +1016,26 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
           // again.
         }
         else
-          this->readAnnexBFrameCounterCodingOrder++;
+          instance.readAnnexBFrameCounterCodingOrder++;
       }
       else if (isInputFormatTypeAnnexB(this->inputFormat) &&
                this->decoderEngine != DecoderEngine::FFMpeg)
       {
-        auto data = caching ? this->inputFileAnnexBCaching->getNextNALUnit(repushData)
-                            : this->inputFileAnnexBLoading->getNextNALUnit(repushData);
+        auto data = instance.inputFileAnnexB->getNextNALUnit(instance.repushData);
         DEBUG_COMPRESSED(
-            "playlistItemCompressedVideo::loadRawData retrieved nal unit from file - size "
+            "playlistItemCompressedVideo::decodeFrame retrieved nal unit from file - size "
             << data.size());
-        this->repushData = !dec->pushData(data);
+        instance.repushData = !dec->pushData(data);
       }
       else if (isInputFormatTypeFFmpeg(this->inputFormat) &&
                this->decoderEngine != DecoderEngine::FFMpeg)
       {
         // Get the next unit (NAL or OBU) form ffmepg and push it to the decoder
-        auto data = caching ? this->inputFileFFmpegCaching->getNextUnit(repushData)
-                            : this->inputFileFFmpegLoading->getNextUnit(repushData);
+        auto data = instance.inputFileFFmpeg->getNextUnit(instance.repushData);
         DEBUG_COMPRESSED(
-            "playlistItemCompressedVideo::loadRawData retrieved nal unit from file - size "
+            "playlistItemCompressedVideo::decodeFrame retrieved nal unit from file - size "
             << data.size());
-        this->repushData = !dec->pushData(data);
+        instance.repushData = !dec->pushData(data);
       }
       else
         assert(false);
@@ -779,64 +1045,49 @@ void playlistItemCompressedVideo::loadRawData(int frameIdx, bool caching)
     {
       if (dec->decodeNextFrame())
       {
-        if (caching)
-          this->currentFrameIdx[1]++;
-        else
-          this->currentFrameIdx[0]++;
-
-        DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoded frame "
-                         << (caching ? this->currentFrameIdx[1] : this->currentFrameIdx[0]));
-        rightFrame =
-            caching ? this->currentFrameIdx[1] == frameIdx : this->currentFrameIdx[0] == frameIdx;
+        instance.currentFrameIdx++;
+        DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoded frame "
+                         << instance.currentFrameIdx);
+        rightFrame = instance.currentFrameIdx == frameIdx;
         if (rightFrame)
-        {
-          if (dec->statisticsEnabled())
-            this->statisticsData.setFrameIndex(frameIdx);
-          this->video->rawData            = dec->getRawFrameData();
-          this->video->rawData_frameIndex = frameIdx;
-        }
+          instance.decodedFrameIdx = frameIdx;
       }
     }
 
-    if (dec->state() != decoder::DecoderState::NeedsMoreData &&
+    if (!rightFrame && dec->state() != decoder::DecoderState::NeedsMoreData &&
         dec->state() != decoder::DecoderState::RetrieveFrames)
     {
-      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadRawData decoder neither needs more data "
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::decodeFrame decoder neither needs more data "
                        "nor can decode frames");
-      this->decodingNotPossibleAfter = frameIdx;
+      this->setDecodingNotPossibleAfter(frameIdx);
       break;
     }
   }
 
-  if (this->decodingNotPossibleAfter >= 0 && frameIdx >= this->decodingNotPossibleAfter)
+  if (!rightFrame && this->decodingNotPossibleAfter >= 0 &&
+      frameIdx >= this->decodingNotPossibleAfter)
   {
     // The specified frame (which is thoretically in the bitstream) can not be decoded.
     // Maybe the bitstream was cut at a position that it was not supposed to be cut at.
-    if (caching)
-      this->currentFrameIdx[1] = frameIdx;
-    else
-      this->currentFrameIdx[0] = frameIdx;
-    // Just set the frame number of the buffer to the current frame so that it will trigger a
-    // reload when the frame number changes.
-    this->video->rawData_frameIndex = frameIdx;
+    instance.currentFrameIdx = frameIdx;
   }
-  else if (this->loadingDecoder->state() == decoder::DecoderState::Error)
-  {
-    this->infoText = "There was an error in the decoder: \n";
-    this->infoText += this->loadingDecoder->decoderErrorString();
-    this->infoText += "\n";
 
-    this->decodingEnabled = false;
-  }
+  return rightFrame;
 }
 
-void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekToDTS, bool caching)
+void playlistItemCompressedVideo::seekToPosition(DecoderInstance &instance,
+                                                 int              seekToFrame,
+                                                 int64_t          seekToDTS)
 {
   // Do the seek
-  auto dec = caching ? this->cachingDecoder.get() : this->loadingDecoder.get();
+  auto dec = instance.decoder.get();
   dec->resetDecoder();
-  this->repushData               = false;
-  this->decodingNotPossibleAfter = -1;
+  instance.repushData = false;
+  // Only forget that decoding stopped at a frame if this decoder seeks past it. Other decoders may
+  // be decoding frames before that point in parallel.
+  auto notPossibleAfter = this->decodingNotPossibleAfter.load();
+  if (notPossibleAfter >= 0 && seekToFrame >= notPossibleAfter)
+    this->decodingNotPossibleAfter.compare_exchange_strong(notPossibleAfter, -1);
 
   // Retrieval of the raw metadata is only required if the the reader or the decoder is not ffmpeg
   const bool bothFFmpeg =
@@ -865,22 +1116,15 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
     }
     DEBUG_COMPRESSED("playlistItemCompressedVideo::seekToPosition seeking annexB file to filePos "
                      << filePos);
-    if (caching)
-      this->inputFileAnnexBCaching->seek(filePos);
-    else
-      this->inputFileAnnexBLoading->seek(filePos);
+    instance.inputFileAnnexB->seek(filePos);
   }
   else
   {
     if (!bothFFmpeg)
-      parametersets = caching ? this->inputFileFFmpegCaching->getParameterSets()
-                              : this->inputFileFFmpegLoading->getParameterSets();
+      parametersets = instance.inputFileFFmpeg->getParameterSets();
     DEBUG_COMPRESSED("playlistItemCompressedVideo::seekToPosition seeking ffmpeg file to pts "
                      << seekToDTS);
-    if (caching)
-      this->inputFileFFmpegCaching->seekToDTS(seekToDTS);
-    else
-      this->inputFileFFmpegLoading->seekToDTS(seekToDTS);
+    instance.inputFileFFmpeg->seekToDTS(seekToDTS);
   }
 
   // In case of using ffmpeg for decoding, we don't need to push the parameter sets (the
@@ -898,10 +1142,7 @@ void playlistItemCompressedVideo::seekToPosition(int seekToFrame, int64_t seekTo
         return;
       }
   }
-  if (caching)
-    this->currentFrameIdx[1] = seekToFrame - 1;
-  else
-    this->currentFrameIdx[0] = seekToFrame - 1;
+  instance.currentFrameIdx = seekToFrame - 1;
 }
 
 void playlistItemCompressedVideo::createPropertiesWidget()
@@ -937,10 +1178,10 @@ void playlistItemCompressedVideo::createPropertiesWidget()
       6, this->statisticsUIHandler.createStatisticsHandlerControls(), 1);
 
   // Set the components that we can display
-  if (loadingDecoder)
+  if (this->loading.decoder)
   {
-    ui.comboBoxDisplaySignal->addItems(loadingDecoder->getSignalNames());
-    ui.comboBoxDisplaySignal->setCurrentIndex(loadingDecoder->getDecodeSignal());
+    ui.comboBoxDisplaySignal->addItems(this->loading.decoder->getSignalNames());
+    ui.comboBoxDisplaySignal->setCurrentIndex(this->loading.decoder->getDecodeSignal());
   }
   // Add decoders we can use
   for (auto e : possibleDecoders)
@@ -963,67 +1204,74 @@ void playlistItemCompressedVideo::createPropertiesWidget()
 bool playlistItemCompressedVideo::allocateDecoder(int displayComponent)
 {
   // Reset (existing) decoders
-  this->loadingDecoder.reset();
-  this->cachingDecoder.reset();
+  this->loading.decoder.reset();
+  for (auto &instance : this->cachingInstances)
+    instance->decoder.reset();
+  this->statisticsCache.clear();
 
   if (this->decoderEngine == DecoderEngine::Libde265)
   {
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::allocateDecoder Initializing interactive libde265 decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderLibde265>(displayComponent);
+    this->loading.decoder = std::make_unique<decoder::decoderLibde265>(displayComponent);
     if (this->cachingEnabled)
     {
       DEBUG_COMPRESSED(
           "playlistItemCompressedVideo::allocateDecoder Initializing caching libde265 decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderLibde265>(displayComponent, true);
+      for (auto &instance : this->cachingInstances)
+        instance->decoder = std::make_unique<decoder::decoderLibde265>(displayComponent, true);
     }
   }
   else if (this->decoderEngine == DecoderEngine::HM)
   {
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::allocateDecoder Initializing interactive HM decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderHM>(displayComponent);
+    this->loading.decoder = std::make_unique<decoder::decoderHM>(displayComponent);
     if (this->cachingEnabled)
     {
       DEBUG_COMPRESSED(
           "playlistItemCompressedVideo::allocateDecoder caching interactive HM decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderHM>(displayComponent, true);
+      for (auto &instance : this->cachingInstances)
+        instance->decoder = std::make_unique<decoder::decoderHM>(displayComponent, true);
     }
   }
   else if (this->decoderEngine == DecoderEngine::VTM)
   {
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::allocateDecoder Initializing interactive VTM decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderVTM>(displayComponent);
+    this->loading.decoder = std::make_unique<decoder::decoderVTM>(displayComponent);
     if (this->cachingEnabled)
     {
       DEBUG_COMPRESSED(
           "playlistItemCompressedVideo::allocateDecoder caching interactive VTM decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderVTM>(displayComponent, true);
+      for (auto &instance : this->cachingInstances)
+        instance->decoder = std::make_unique<decoder::decoderVTM>(displayComponent, true);
     }
   }
   else if (this->decoderEngine == DecoderEngine::VVDec)
   {
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::allocateDecoder Initializing interactive VVDec decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderVVDec>(displayComponent);
+    this->loading.decoder = std::make_unique<decoder::decoderVVDec>(displayComponent);
     if (this->cachingEnabled)
     {
       DEBUG_COMPRESSED(
           "playlistItemCompressedVideo::allocateDecoder caching interactive VVDec decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderVVDec>(displayComponent, true);
+      for (auto &instance : this->cachingInstances)
+        instance->decoder = std::make_unique<decoder::decoderVVDec>(displayComponent, true);
     }
   }
   else if (this->decoderEngine == DecoderEngine::Dav1d)
   {
     DEBUG_COMPRESSED(
         "playlistItemCompressedVideo::allocateDecoder Initializing interactive dav1d decoder");
-    this->loadingDecoder = std::make_unique<decoder::decoderDav1d>(displayComponent);
+    this->loading.decoder = std::make_unique<decoder::decoderDav1d>(displayComponent);
     if (this->cachingEnabled)
     {
       DEBUG_COMPRESSED(
           "playlistItemCompressedVideo::allocateDecoder caching interactive dav1d decoder");
-      this->cachingDecoder = std::make_unique<decoder::decoderDav1d>(displayComponent, true);
+      for (auto &instance : this->cachingInstances)
+        instance->decoder = std::make_unique<decoder::decoderDav1d>(displayComponent, true);
     }
   }
   else if (this->decoderEngine == DecoderEngine::FFMpeg)
@@ -1043,28 +1291,30 @@ bool playlistItemCompressedVideo::allocateDecoder(int displayComponent)
                        << QString::fromStdString(fmt.getName()) << " profile/level "
                        << profileLevel.first << "/" << profileLevel.second << ", aspect raio "
                        << ratio.num << "/" << ratio.den);
-      this->loadingDecoder = std::make_unique<decoder::decoderFFmpeg>(
+      this->loading.decoder = std::make_unique<decoder::decoderFFmpeg>(
           ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio);
       if (this->cachingEnabled)
       {
         DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing caching ffmpeg "
                          "decoder from raw anexB stream. Same settings.");
-        this->cachingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-            ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, true);
+        for (auto &instance : this->cachingInstances)
+          instance->decoder = std::make_unique<decoder::decoderFFmpeg>(
+              ffmpegCodec, frameSize, extradata, fmt, profileLevel, ratio, true);
       }
     }
     else
     {
       DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing interactive "
                        "ffmpeg decoder using ffmpeg as parser");
-      this->loadingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-          this->inputFileFFmpegLoading->getVideoCodecPar());
+      this->loading.decoder = std::make_unique<decoder::decoderFFmpeg>(
+          this->loading.inputFileFFmpeg->getVideoCodecPar());
       if (this->cachingEnabled)
       {
         DEBUG_COMPRESSED("playlistItemCompressedVideo::allocateDecoder Initializing caching ffmpeg "
                          "decoder using ffmpeg as parser");
-        this->cachingDecoder = std::make_unique<decoder::decoderFFmpeg>(
-            this->inputFileFFmpegCaching->getVideoCodecPar());
+        for (auto &instance : this->cachingInstances)
+          instance->decoder = std::make_unique<decoder::decoderFFmpeg>(
+              instance->inputFileFFmpeg->getVideoCodecPar());
       }
     }
   }
@@ -1075,11 +1325,11 @@ bool playlistItemCompressedVideo::allocateDecoder(int displayComponent)
     return false;
   }
 
-  this->decodingEnabled = this->loadingDecoder->state() != decoder::DecoderState::Error;
+  this->decodingEnabled = this->loading.decoder->state() != decoder::DecoderState::Error;
   if (!decodingEnabled)
   {
     this->infoText = "There was an error allocating the new decoder: \n";
-    this->infoText += loadingDecoder->decoderErrorString();
+    this->infoText += this->loading.decoder->decoderErrorString();
     this->infoText += "\n";
     return false;
   }
@@ -1089,10 +1339,35 @@ bool playlistItemCompressedVideo::allocateDecoder(int displayComponent)
 
 void playlistItemCompressedVideo::fillStatisticList()
 {
-  if (!this->loadingDecoder || !this->loadingDecoder->statisticsSupported())
+  if (!this->loading.decoder || !this->loading.decoder->statisticsSupported())
     return;
 
-  this->loadingDecoder->fillStatisticList(this->statisticsData);
+  this->loading.decoder->fillStatisticList(this->statisticsData);
+}
+
+void playlistItemCompressedVideo::updateStatSource(bool bRedraw)
+{
+  this->updateStatisticsRendered();
+  emit SignalItemChanged(bRedraw, RECACHE_NONE);
+}
+
+void playlistItemCompressedVideo::updateStatisticsRendered()
+{
+  std::vector<int> renderedTypeIDs;
+  {
+    std::unique_lock<std::mutex> lock(this->statisticsData.accessMutex);
+    for (const auto &type : this->statisticsData.getStatisticsTypes())
+      if (type.render)
+        renderedTypeIDs.push_back(type.typeID);
+  }
+
+  // The cache only contains the statistics of the types that were rendered when the frames were
+  // cached. If no type is rendered, the caching decoders stop collecting statistics.
+  std::unique_lock<std::mutex> lock(this->renderedStatisticsMutex);
+  if (renderedTypeIDs != this->renderedStatisticsTypeIDs)
+    this->statisticsCache.clear();
+  this->renderedStatisticsTypeIDs = std::move(renderedTypeIDs);
+  this->statisticsRendered        = !this->renderedStatisticsTypeIDs.empty();
 }
 
 void playlistItemCompressedVideo::loadStatistics(int frameIdx)
@@ -1100,26 +1375,35 @@ void playlistItemCompressedVideo::loadStatistics(int frameIdx)
   DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatisticToCache Request statistics for frame "
                    << frameIdx);
 
-  if (!this->loadingDecoder->statisticsSupported())
+  if (!this->loading.decoder->statisticsSupported())
     return;
-  if (!this->loadingDecoder->statisticsEnabled())
+  if (!this->loading.decoder->statisticsEnabled())
   {
     // We have to enable collecting of statistics in the decoder. By default (for speed reasons)
     // this is off. Enabeling works like this: Enable collection, reset the decoder and decode the
     // current frame again. Statisitcs are always retrieved for the loading decoder.
-    this->loadingDecoder->enableStatisticsRetrieval(&this->statisticsData);
+    this->loading.decoder->enableStatisticsRetrieval(&this->statisticsData);
     DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatistics Enable loading of stats frame "
                      << frameIdx);
 
     // Reload the current frame (force a seek and decode operation)
-    int frameToLoad          = this->currentFrameIdx[0];
-    this->currentFrameIdx[0] = -1;
+    int frameToLoad               = this->loading.currentFrameIdx;
+    this->loading.currentFrameIdx = -1;
     this->loadRawData(frameToLoad, false);
 
     // The statistics should now be loaded
   }
-  else if (frameIdx != this->currentFrameIdx[0])
+  else if (frameIdx != this->loading.currentFrameIdx)
   {
+    // The statistics of frames that were decoded by a caching decoder are in the statistics cache
+    if (auto cachedStatistics = this->statisticsCache.get(frameIdx))
+    {
+      DEBUG_COMPRESSED("playlistItemCompressedVideo::loadStatistics Statistics of frame "
+                       << frameIdx << " taken from the cache");
+      this->statisticsData.setFrameTypeData(frameIdx, std::move(*cachedStatistics));
+      return;
+    }
+
     // If the requested frame is not currently decoded, decode it.
     // This can happen if the picture was gotten from the cache.
     DEBUG_COMPRESSED(
@@ -1134,7 +1418,7 @@ ValuePairListSets playlistItemCompressedVideo::getPixelValues(const QPoint &pixe
   ValuePairListSets newSet;
 
   newSet.append("YUV", this->video->getPixelValues(pixelPos, frameIdx));
-  if (this->loadingDecoder->statisticsSupported() && this->loadingDecoder->statisticsEnabled())
+  if (this->loading.decoder->statisticsSupported() && this->loading.decoder->statisticsEnabled())
     newSet.append("Stats", this->statisticsData.getValuesAt(pixelPos));
 
   return newSet;
@@ -1208,27 +1492,59 @@ void playlistItemCompressedVideo::reloadItemSource()
   // TODO: The caching decoder must also be reloaded
   //       All items in the cache are also now invalid
 
-  // loadingDecoder->reloadItemSource();
+  // this->loading.decoder->reloadItemSource();
   // Reset the decoder somehow
 
   // Reset the videoHandlerYUV source. With the next draw event, the videoHandlerYUV will request to
   // decode the frame again.
   this->video->invalidateAllBuffers();
+  this->statisticsCache.clear();
+
+  // The seek points are recalculated from the current keyframe list on the next use
+  {
+    QMutexLocker lock(&this->seekPointOfFrameMutex);
+    this->seekPointOfFrame.clear();
+  }
+  this->decodingNotPossibleAfter = -1;
 
   // Load frame 0. This will decode the first frame in the sequence and set the
   // correct frame size/YUV format.
   loadRawData(0, false);
 }
 
+unsigned int playlistItemCompressedVideo::getCachingFrameSize() const
+{
+  const auto frameSize = playlistItemWithVideo::getCachingFrameSize();
+  if (frameSize == 0 || !this->statisticsRendered || !this->loading.decoder ||
+      !this->loading.decoder->statisticsEnabled())
+    return frameSize;
+
+  // Only the statistics of the rendered types are cached
+  std::unique_lock<std::mutex> lock(this->renderedStatisticsMutex);
+  return frameSize + stats::StatisticsFrameCache::estimateFrameSize(
+                         this->video->getFrameSize(), this->renderedStatisticsTypeIDs.size());
+}
+
+void playlistItemCompressedVideo::removeFrameFromCache(int frameIdx)
+{
+  playlistItemWithVideo::removeFrameFromCache(frameIdx);
+  this->statisticsCache.remove(frameIdx);
+}
+
+void playlistItemCompressedVideo::removeAllFramesFromCache()
+{
+  playlistItemWithVideo::removeAllFramesFromCache();
+  this->statisticsCache.clear();
+}
+
 void playlistItemCompressedVideo::cacheFrame(int frameIdx, bool testMode)
 {
   if (!this->cachingEnabled)
     return;
 
-  // Cache a certain frame. This is always called in a separate thread.
-  this->cachingMutex.lock();
+  // Cache a certain frame. This is always called in a separate thread. The caching decoders are
+  // locked in loadRawDataForCaching so that multiple frames can be cached at the same time.
   this->video->cacheFrame(frameIdx, testMode);
-  this->cachingMutex.unlock();
 }
 
 void playlistItemCompressedVideo::loadFrame(int  frameIdx,
@@ -1285,26 +1601,29 @@ void playlistItemCompressedVideo::loadFrame(int  frameIdx,
 
 void playlistItemCompressedVideo::displaySignalComboBoxChanged(int idx)
 {
-  if (this->loadingDecoder && idx != this->loadingDecoder->getDecodeSignal())
+  if (this->loading.decoder && idx != this->loading.decoder->getDecodeSignal())
   {
     bool resetDecoder = false;
-    this->loadingDecoder->setDecodeSignal(idx, resetDecoder);
-    this->cachingDecoder->setDecodeSignal(idx, resetDecoder);
+    this->loading.decoder->setDecodeSignal(idx, resetDecoder);
+    for (auto &instance : this->cachingInstances)
+      instance->decoder->setDecodeSignal(idx, resetDecoder);
 
     if (resetDecoder)
     {
-      this->loadingDecoder->resetDecoder();
-      this->cachingDecoder->resetDecoder();
-
       // Reset the decoded frame indices so that decoding of the current frame is triggered
-      this->currentFrameIdx[0] = -1;
-      this->currentFrameIdx[1] = -1;
+      this->loading.decoder->resetDecoder();
+      this->loading.currentFrameIdx = -1;
+      for (auto &instance : this->cachingInstances)
+      {
+        instance->decoder->resetDecoder();
+        instance->currentFrameIdx = -1;
+      }
     }
 
     // A different display signal was chosen. Invalidate the cache and signal that we will need a
     // redraw.
     auto yuvVideo = dynamic_cast<video::yuv::videoHandlerYUV *>(this->video.get());
-    yuvVideo->showPixelValuesAsDiff = this->loadingDecoder->isSignalDifference(idx);
+    yuvVideo->showPixelValuesAsDiff = this->loading.decoder->isSignalDifference(idx);
     yuvVideo->invalidateAllBuffers();
 
     emit SignalItemChanged(true, RECACHE_CLEAR);
@@ -1323,23 +1642,24 @@ void playlistItemCompressedVideo::decoderComboxBoxChanged(int idx)
     // A different display signal was chosen. Invalidate the cache and signal that we will need a
     // redraw.
     auto yuvVideo = dynamic_cast<video::yuv::videoHandlerYUV *>(this->video.get());
-    if (this->loadingDecoder)
-      yuvVideo->showPixelValuesAsDiff = this->loadingDecoder->isSignalDifference(idx);
+    if (this->loading.decoder)
+      yuvVideo->showPixelValuesAsDiff = this->loading.decoder->isSignalDifference(idx);
     yuvVideo->invalidateAllBuffers();
 
     // Reset the decoded frame indices so that decoding of the current frame is triggered
-    this->currentFrameIdx[0] = -1;
-    this->currentFrameIdx[1] = -1;
+    this->loading.currentFrameIdx = -1;
+    for (auto &instance : this->cachingInstances)
+      instance->currentFrameIdx = -1;
 
     this->decodingNotPossibleAfter = -1;
 
     // Update the list of display signals
-    if (this->loadingDecoder)
+    if (this->loading.decoder)
     {
       QSignalBlocker block(ui.comboBoxDisplaySignal);
       ui.comboBoxDisplaySignal->clear();
-      ui.comboBoxDisplaySignal->addItems(this->loadingDecoder->getSignalNames());
-      ui.comboBoxDisplaySignal->setCurrentIndex(this->loadingDecoder->getDecodeSignal());
+      ui.comboBoxDisplaySignal->addItems(this->loading.decoder->getSignalNames());
+      ui.comboBoxDisplaySignal->setCurrentIndex(this->loading.decoder->getDecodeSignal());
     }
 
     // Update the statistics list with what the new decoder can provide
@@ -38,8 +38,15 @@
 #include <parser/ParserAnnexB.h>
 #include <statistics/StatisticUIHandler.h>
 #include <statistics/StatisticsData.h>
+#include <statistics/StatisticsFrameCache.h>
 #include <ui_playlistItemCompressedFile.h>
 
+#include <QSemaphore>
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+
 #include "playlistItemWithVideo.h"
 
 class videoHandler;
@@ -93,7 +100,7 @@ public:
   }
   virtual void reloadItemSource() override;
   virtual void updateSettings() override
-  { /* TODO loadingDecoder->updateFileWatchSetting(); statSource.updateSettings(); */
+  { /* TODO loading.decoder->updateFileWatchSetting(); statSource.updateSettings(); */
   }
 
   // Do we need to load the given frame first?
@@ -105,26 +112,66 @@ public:
   virtual bool isLoading() const override { return isFrameLoading; }
   virtual bool isLoadingDoubleBuffer() const override { return isFrameLoadingDoubleBuffer; }
 
-  // Cache the frame with the given index.
-  // For all compressed items, a mutex must be locked when caching a frame (only one frame can be
-  // cached at a time because we only have one decoder).
+  // Cache the frame with the given index. Each caching decoder can only cache one frame at a time.
   void cacheFrame(int idx, bool testMode) override;
 
-  // We only have one caching decoder so it is better if only one thread caches frames from this
-  // item. This way, the frames will always be cached in the right order and no unnecessary decoding
-  // is performed.
-  virtual int cachingThreadLimit() override { return 1; }
+  // We have one caching decoder per caching thread. Each decoder should work through its own GOPs
+  // (see getSequentialCachingRanges) so that no unnecessary decoding is performed.
+  virtual int cachingThreadLimit() override { return int(this->cachingInstances.size()); }
+
+  // The statistics that the caching decoders collect are counted as part of the cached frames.
+  unsigned int getCachingFrameSize() const override;
+  void         removeFrameFromCache(int frameIdx) override;
+  void         removeAllFramesFromCache() override;
+
+  // Split the range at the seek points of the bitstream. Each of the returned ranges can be decoded
+  // independently by a different caching decoder.
+  std::vector<indexRange> getSequentialCachingRanges(indexRange range) override;
 
   InputFormat getInputFormat() const { return this->inputFormat; }
 
 protected:
   virtual void createPropertiesWidget() override;
 
-  // We allocate two decoder: One for loading images in the foreground and one for caching in the
+  // Everything that is needed to decode from a certain position in the bitstream: A decoder, the
+  // file opened for reading and the current position of the two.
+  struct DecoderInstance
+  {
+    std::unique_ptr<decoder::decoderBase> decoder;
+    std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexB;
+    std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpeg;
+
+    // The index of the last decoded frame (display order)
+    int currentFrameIdx{-1};
+    // When reading annex B data using the FileSourceAnnexBFile::getFrameData function, we need to
+    // count how many frames we already read.
+    int readAnnexBFrameCounterCodingOrder{-1};
+    // For certain decoders (FFmpeg or HM), pushing data may fail. The decoder may or may not switch
+    // to retrieveing mode. In this case, we must re-push the packet for which pushing failed.
+    bool repushData{};
+
+    // If statistics are shown, the caching decoders collect the statistics of each decoded frame
+    // in here. From here, they are moved to the statisticsCache.
+    stats::StatisticsData statisticsData;
+
+    // The index of the frame that the decoder currently holds (or -1). Unlike currentFrameIdx, this
+    // is only set if the frame was actually decoded.
+    int decodedFrameIdx{-1};
+
+    // Acquired while a caching thread is using this instance. If the cached frame points into the
+    // memory of the decoder, it is released when the last copy of the frame is destroyed. This may
+    // happen in another thread, which is why this is not a mutex.
+    QSemaphore available{1};
+  };
+
+  // We allocate one decoder for loading images in the foreground and one or more for caching in the
   // background. This is better if random access and linear decoding (caching) is performed at the
-  // same time.
-  std::unique_ptr<decoder::decoderBase> loadingDecoder;
-  std::unique_ptr<decoder::decoderBase> cachingDecoder;
+  // same time. Multiple caching decoders can decode different GOPs in parallel.
+  DecoderInstance                               loading;
+  std::vector<std::unique_ptr<DecoderInstance>> cachingInstances;
+  // Acquire a caching decoder that is not in use. Prefer the one that can continue decoding to the
+  // given frame without seeking.
+  DecoderInstance *acquireCachingDecoder(int frameIdx);
 
   // When opening the file, we will fill this list with the possible decoders
   std::vector<decoder::DecoderEngine> possibleDecoders;
@@ -134,52 +181,49 @@ protected:
   bool allocateDecoder(int displayComponent = 0);
 
   // In order to parse raw annexB files, we need a file reader (that can read NAL units)
-  // and a parser that can understand what the NAL units mean. We open the file source twice (once
-  // for interactive loading, once for the background caching). The parser is only needed once and
-  // can be used for both loading and caching tasks.
-  std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexBLoading;
-  std::unique_ptr<FileSourceAnnexBFile> inputFileAnnexBCaching;
+  // and a parser that can understand what the NAL units mean. We open the file source once per
+  // decoder instance. The parser is only needed once and can be used for both loading and caching
+  // tasks.
   std::unique_ptr<parser::ParserAnnexB> inputFileAnnexBParser;
-  // When reading annex B data using the FileSourceAnnexBFile::getFrameData function, we need to
-  // count how many frames we already read.
-  int readAnnexBFrameCounterCodingOrder{-1};
+  // The seek point of each frame (display order). Frames with the same seek point are in the same
+  // GOP. Filled on first use and cleared in reloadItemSource.
+  std::vector<int> seekPointOfFrame;
+  QMutex           seekPointOfFrameMutex;
 
   // Which type is the input?
   InputFormat              inputFormat;
   FFmpeg::AVCodecIDWrapper ffmpegCodec;
 
-  // For FFMpeg files we don't need a reader to parse them. But if the container contains a
-  // supported format, we can read the NAL units from the compressed file.
-  std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpegLoading;
-  std::unique_ptr<FileSourceFFmpegFile> inputFileFFmpegCaching;
-
   // Is the loadFrame function currently loading?
   bool isFrameLoading{};
   bool isFrameLoadingDoubleBuffer{};
 
-  // Only cache one frame at a time. Caching should also always be done in display order of the
-  // frames.
-  // TODO: Could we somehow make shure that caching is always performed in display order?
-  QMutex cachingMutex;
-
   stats::StatisticUIHandler statisticsUIHandler;
   stats::StatisticsData     statisticsData;
 
+  // The statistics of the frames that were decoded by the caching decoders. The statistics of a
+  // frame are removed when the frame is removed from the cache.
+  stats::StatisticsFrameCache statisticsCache;
+  // Is any statistics type rendered? Only then, the caching decoders collect statistics. Only the
+  // statistics of the rendered types are cached. Updated in the GUI thread by
+  // updateStatisticsRendered.
+  std::atomic_bool   statisticsRendered{};
+  std::vector<int>   renderedStatisticsTypeIDs;
+  mutable std::mutex renderedStatisticsMutex;
+  void               updateStatisticsRendered();
+
   void fillStatisticList();
   void loadStatistics(int frameIdx);
 
   SafeUi<Ui::playlistItemCompressedFile_Widget> ui;
 
-  // The current frame index of the decoders (interactive/caching)
-  int currentFrameIdx[2]{-1, -1};
-
   // Seek the input file to the given position, reset the decoder and prepare it to start decoding
   // from the given position.
-  void seekToPosition(int seekToFrame, int64_t seekToDTS, bool caching);
+  void seekToPosition(DecoderInstance &instance, int seekToFrame, int64_t seekToDTS);
 
-  // For certain decoders (FFmpeg or HM), pushing data may fail. The decoder may or may not switch
-  // to retrieveing mode. In this case, we must re-push the packet for which pushing failed.
-  bool repushData{};
+  // Decode until the decoder of the given instance returns the requested frame. Seek if necessary.
+  // Returns true if the frame was decoded. The raw data can then be retrieved from the decoder.
+  bool decodeFrame(DecoderInstance &instance, int frameIdx);
 
   // Besides the normal stats (error / no error) this item might be able to parse the file but not
   // to decode it.
@@ -192,14 +236,28 @@ protected:
 
   // If the bitstream is invalid (for example it was cut at a position that it should not be cut
   // at), we might be unable to decode some of the frames at the end of the sequence.
-  int decodingNotPossibleAfter{-1};
+  // It is written by all decoders, so only lower it with setDecodingNotPossibleAfter.
+  std::atomic_int decodingNotPossibleAfter{-1};
+  void            setDecodingNotPossibleAfter(int frameIdx);
+
+  // The decoded frames are written to the disk cache (if it is enabled, see video::DiskFrameCache)
+  // and read from there instead of decoding them again. The key identifies the file and the
+  // decoder settings.
+  QString                   diskCacheFileKey;
+  QString                   getDiskCacheSourceKey() const;
+  std::optional<QByteArray> loadFrameFromDiskCache(int frameIdx) const;
+  void                      storeFrameInDiskCache(int                          frameIdx,
+                                                  const video::RawFrameBuffer &frame) const;
 
 private slots:
   // Load the raw (YUV or RGN) data for the given frame index from file. This slot is called by the
   // videoHandler if the frame that is requested to be drawn has not been loaded yet.
   virtual void loadRawData(int frameIdx, bool forceDecodingNow);
+  // Decode the given frame using one of the caching decoders. This can be called from multiple
+  // caching threads at the same time.
+  void loadRawDataForCaching(int frameIdx, video::RawFrameBuffer &frameOut, bool &success);
 
-  void updateStatSource(bool bRedraw) { emit SignalItemChanged(bRedraw, RECACHE_NONE); }
+  void updateStatSource(bool bRedraw);
   void displaySignalComboBoxChanged(int idx);
   void decoderComboxBoxChanged(int idx);
 };
@@ -33,6 +33,7 @@
 #include "playlistItemRawFile.h"
 
 #include <QPainter>
+#include <QSettings>
 #include <QUrl>
 #include <QVBoxLayout>
 
@@ -58,6 +59,13 @@ constexpr auto RGBA_EXTENSIONS = {"rgba", "gbra", "bgra", "brga", "argb", "agbr"
 constexpr auto RAW_BAYER_EXTENSIONS = {"raw"};
 constexpr auto CMYK_EXTENSIONS      = {"cmyk"};
 
+// The number of frames that are read ahead of the playback direction from a mapped file
+constexpr auto READ_AHEAD_FRAMES = 8;
+
+// Limits for reading the queued frames from a file which is not mapped
+constexpr int64_t READ_AHEAD_MAX_BUFFERED_BYTES = 128 * 1024 * 1024;
+constexpr int64_t READ_AHEAD_MAX_CHUNK_BYTES    = 16 * 1024 * 1024;
+
 bool isInExtensions(const QString &testValue, const std::initializer_list<const char *> &extensions)
 {
   const auto it =
@@ -73,7 +81,8 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
                                          const QSize    qFrameSize,
                                          const QString &sourcePixelFormat,
                                          const QString &fmt)
-    : playlistItemWithVideo(rawFilePath)
+    : playlistItemWithVideo(rawFilePath),
+      readAhead(&this->dataSource, READ_AHEAD_MAX_BUFFERED_BYTES, READ_AHEAD_MAX_CHUNK_BYTES)
 {
   this->setIcon(0, functionsGui::convertIcon(":img_video.png"));
   this->setFlags(flags() | Qt::ItemIsDropEnabled);
@@ -89,6 +98,7 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
     this->setError("Error opening the input file.");
     return;
   }
+  this->mapFileIfEnabled();
 
   Size frameSize;
   if (qFrameSize.width() > 0 && qFrameSize.height() > 0)
@@ -156,6 +166,11 @@ playlistItemRawFile::playlistItemRawFile(const QString &rawFilePath,
           this,
           &playlistItemRawFile::loadRawData,
           Qt::DirectConnection);
+  connect(this->video.get(),
+          &video::videoHandler::signalRequestRawDataForCaching,
+          this,
+          &playlistItemRawFile::loadRawDataForCaching,
+          Qt::DirectConnection);
 
   // Connect the basic signals from the video
   playlistItemWithVideo::connectVideo();
@@ -542,21 +557,119 @@ void playlistItemRawFile::loadRawData(int frameIdx)
   auto nrBytes = this->video->getBytesPerFrame();
 
   // Load the raw data for the given frameIdx from file and set it in the video
-  int64_t fileStartPos;
-  if (this->isY4MFile)
-    fileStartPos = this->y4mFrameIndices.at(frameIdx);
-  else
-    fileStartPos = frameIdx * nrBytes;
+  const auto fileStartPos = this->getFileStartPos(frameIdx, nrBytes);
+  this->adviseReadAhead(frameIdx, nrBytes);
 
   DEBUG_RAWFILE("playlistItemRawFile::loadRawData Start loading frame " << frameIdx << " bytes "
                                                                         << int(nrBytes));
-  if (this->dataSource.readBytes(this->video->rawData, fileStartPos, nrBytes) < nrBytes)
+  if (auto mappedData = this->dataSource.getMappedData(fileStartPos, nrBytes))
+    this->video->rawData = QByteArray(reinterpret_cast<const char *>(mappedData.get()), nrBytes);
+  else if (this->dataSource.readBytes(this->video->rawData, fileStartPos, nrBytes) < nrBytes)
     return; // Error
   this->video->rawData_frameIndex = frameIdx;
 
   DEBUG_RAWFILE("playlistItemRawFile::loadRawData Frame " << frameIdx << " loaded");
 }
 
+void playlistItemRawFile::loadRawDataForCaching(int                    frameIdx,
+                                                video::RawFrameBuffer &frameOut,
+                                                bool                  &success)
+{
+  success = false;
+  if (!this->video->isFormatValid())
+    return;
+
+  const auto nrBytes      = this->video->getBytesPerFrame();
+  const auto fileStartPos = this->getFileStartPos(frameIdx, nrBytes);
+  this->adviseReadAhead(frameIdx, nrBytes);
+
+  DEBUG_RAWFILE("playlistItemRawFile::loadRawDataForCaching frame " << frameIdx);
+  if (auto mappedData = this->dataSource.getMappedData(fileStartPos, nrBytes))
+  {
+    // No copy. The frame keeps the mapping alive.
+    const auto view =
+        QByteArray::fromRawData(reinterpret_cast<const char *>(mappedData.get()), nrBytes);
+    frameOut = video::RawFrameBuffer(view, mappedData);
+    success  = true;
+    return;
+  }
+
+  if (auto readAheadData = this->readAhead.takeRange({fileStartPos, nrBytes}))
+  {
+    const auto view = QByteArray::fromRawData(readAheadData.get(), nrBytes);
+    frameOut        = video::RawFrameBuffer(view, readAheadData);
+    success         = true;
+    return;
+  }
+
+  QByteArray rawData;
+  if (this->dataSource.readBytes(rawData, fileStartPos, nrBytes) < nrBytes)
+    return;
+  frameOut = video::RawFrameBuffer(rawData);
+  success  = true;
+}
+
+void playlistItemRawFile::setQueuedCachingRanges(const std::vector<indexRange> &queuedRanges)
+{
+  // A mapped file is read ahead by the operating system (see adviseReadAhead)
+  if (this->dataSource.isMapped() || !this->video->isFormatValid())
+    return;
+
+  const auto nrBytes      = this->video->getBytesPerFrame();
+  const auto lastFrameIdx = this->properties().startEndRange.second;
+
+  std::vector<FileReadAhead::Range> plannedRanges;
+  for (const auto &range : queuedRanges)
+  {
+    const auto lastQueuedFrameIdx = std::min(range.second, lastFrameIdx);
+    for (auto frameIdx = std::max(range.first, 0); frameIdx <= lastQueuedFrameIdx; frameIdx++)
+      if (!this->video->isInCache(frameIdx))
+        plannedRanges.push_back({this->getFileStartPos(frameIdx, nrBytes), nrBytes});
+  }
+
+  DEBUG_RAWFILE("playlistItemRawFile::setQueuedCachingRanges " << plannedRanges.size()
+                                                               << " frames");
+  this->readAhead.setPlannedRanges(plannedRanges);
+}
+
+void playlistItemRawFile::mapFileIfEnabled()
+{
+  // A mapped file must not be truncated by another process while it is mapped (accessing the
+  // removed part would crash). So this is not enabled by default.
+  QSettings settings;
+  if (settings.value("MemoryMapRawFiles", false).toBool() && !this->dataSource.mapFile())
+    DEBUG_RAWFILE("playlistItemRawFile::mapFileIfEnabled Mapping the file failed");
+}
+
+int64_t playlistItemRawFile::getFileStartPos(int frameIdx, int64_t nrBytesPerFrame) const
+{
+  if (this->isY4MFile)
+    return this->y4mFrameIndices.at(frameIdx);
+  return frameIdx * nrBytesPerFrame;
+}
+
+void playlistItemRawFile::adviseReadAhead(int frameIdx, int64_t nrBytesPerFrame)
+{
+  const auto lastFrameIdx = this->lastRequestedFrameIdx.exchange(frameIdx);
+  if (!this->dataSource.isMapped() || lastFrameIdx < 0 || frameIdx == lastFrameIdx ||
+      std::abs(frameIdx - lastFrameIdx) > READ_AHEAD_FRAMES)
+    return;
+
+  // Multiple caching threads may request frames slightly out of order. The direction is still
+  // clear from the distance to the last request.
+  const auto maxFrameIdx = this->properties().startEndRange.second;
+  const auto forward     = frameIdx > lastFrameIdx;
+  const auto firstFrame  = forward ? frameIdx + 1 : std::max(frameIdx - READ_AHEAD_FRAMES, 0);
+  const auto lastFrame =
+      forward ? std::min(frameIdx + READ_AHEAD_FRAMES, maxFrameIdx) : frameIdx - 1;
+  if (firstFrame > lastFrame)
+    return;
+
+  const auto startPos = this->getFileStartPos(firstFrame, nrBytesPerFrame);
+  const auto endPos   = this->getFileStartPos(lastFrame, nrBytesPerFrame) + nrBytesPerFrame;
+  this->dataSource.adviseReadAhead(startPos, endPos - startPos);
+}
+
 void playlistItemRawFile::slotVideoPropertiesChanged()
 {
   DEBUG_RAWFILE("playlistItemRawFile::slotVideoPropertiesChanged");
@@ -596,6 +709,8 @@ void playlistItemRawFile::reloadItemSource()
   if (!this->dataSource.isOk())
     // Opening the file failed.
     return;
+  this->readAhead.clear();
+  this->mapFileIfEnabled();
 
   this->video->invalidateAllBuffers();
   this->updateStartEndRange();
@@ -33,11 +33,14 @@
 #pragma once
 
 #include <common/Typedef.h>
+#include <filesource/FileReadAhead.h>
 #include <filesource/FileSource.h>
 
 #include <QFuture>
 #include <QString>
 
+#include <atomic>
+
 #include "playlistItemWithVideo.h"
 
 class playlistItemRawFile : public playlistItemWithVideo
@@ -86,11 +89,18 @@ public:
     playlistItemWithVideo::cacheFrame(idx, testMode);
   }
 
+  // Read the queued frames from file in the background (if the file is not memory mapped)
+  virtual void setQueuedCachingRanges(const std::vector<indexRange> &queuedRanges) override;
+
 private slots:
   // Load the raw data for the given frame index from file. This slot is called by the videoHandler
   // if the frame that is requested to be drawn has not been loaded yet.
   void loadRawData(int frameIdx);
 
+  // Load the raw data for caching. This is called from multiple caching threads at the same time.
+  // If the file is memory mapped, the frame points directly into the mapping.
+  void loadRawDataForCaching(int frameIdx, video::RawFrameBuffer &frameOut, bool &success);
+
   void slotVideoPropertiesChanged();
 
 protected:
@@ -107,6 +117,20 @@ private:
 
   FileSource dataSource;
 
+  // Reads the frames that will be cached next in large chunks. Must be destroyed before the
+  // dataSource.
+  FileReadAhead readAhead;
+
+  // Map the file into memory if this is enabled in the settings
+  void mapFileIfEnabled();
+
+  int64_t getFileStartPos(int frameIdx, int64_t nrBytesPerFrame) const;
+
+  // If frames are requested in (forward or backward) order, let the operating system read the next
+  // frames of the mapped file in the background.
+  void            adviseReadAhead(int frameIdx, int64_t nrBytesPerFrame);
+  std::atomic_int lastRequestedFrameIdx{-1};
+
   void updateStartEndRange() override;
 
   // A y4m file is a raw YUV file but it adds a header (which has information about the YUV format)
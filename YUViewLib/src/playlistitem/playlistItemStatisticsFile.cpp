@@ -36,6 +36,7 @@
 #include <QTime>
 #include <QUrl>
 #include <QtConcurrent>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -69,15 +70,28 @@ playlistItemStatisticsFile::playlistItemStatisticsFile(const QString &itemNameOr
   this->prop.propertiesWidgetTitle = "Statistics File Properties";
   this->prop.providesStatistics    = true;
 
+  this->cachingEnabled = true;
+
   // Set statistics icon
   setIcon(0, functionsGui::convertIcon(":img_stats.png"));
 
   this->openStatisticsFile();
   this->statisticsUIHandler.setStatisticsData(&this->statisticsData);
+  this->updateTypesToCache();
 
   connect(&this->statisticsUIHandler,
           &stats::StatisticUIHandler::updateItem,
-          [this](bool redraw) { emit SignalItemChanged(redraw, RECACHE_NONE); });
+          [this](bool redraw)
+          {
+            // The cached frames only contain the types that were rendered when they were cached
+            if (this->updateTypesToCache())
+            {
+              this->clearStatisticsCache();
+              emit SignalItemChanged(redraw, RECACHE_CLEAR);
+            }
+            else
+              emit SignalItemChanged(redraw, RECACHE_NONE);
+          });
 }
 
 playlistItemStatisticsFile::~playlistItemStatisticsFile()
@@ -121,6 +135,7 @@ playlistItemStatisticsFile *playlistItemStatisticsFile::newplaylistItemStatistic
 
   // Load the status of the statistics (which are shown, transparency ...)
   newStat->statisticsData.loadPlaylist(root);
+  newStat->updateTypesToCache();
 
   return newStat;
 }
@@ -128,11 +143,17 @@ playlistItemStatisticsFile *playlistItemStatisticsFile::newplaylistItemStatistic
 void playlistItemStatisticsFile::reloadItemSource()
 {
   this->currentDrawnFrameIdx = -1;
+  this->clearStatisticsCache();
 
-  this->statisticsData.clear();
+  {
+    // A caching thread may be loading statistics from the file
+    std::unique_lock<std::mutex> lock(this->fileAccessMutex);
+    this->statisticsData.clear();
+  }
   this->statisticsUIHandler.updateStatisticsHandlerControls();
 
   this->openStatisticsFile();
+  this->updateTypesToCache();
 }
 
 ItemLoadingState playlistItemStatisticsFile::needsLoading(int frameIdx, bool)
@@ -141,12 +162,17 @@ ItemLoadingState playlistItemStatisticsFile::needsLoading(int frameIdx, bool)
     return ItemLoadingState::LoadingNotNeeded;
 
   auto ret = this->statisticsData.needsLoading(frameIdx);
+  if (ret == ItemLoadingState::LoadingNeeded && frameIdx != this->statisticsData.getFrameIndex() &&
+      this->statisticsCache.contains(frameIdx))
+    // The statistics are taken from the cache when the frame is drawn
+    ret = ItemLoadingState::LoadingNotNeeded;
   DEBUG_STAT("playlistItemStatisticsFile::needsLoading frameIdx %d - %d", frameIdx, ret);
   return ret;
 }
 
 void playlistItemStatisticsFile::drawItem(QPainter *painter, int frameIdx, double zoomFactor, bool)
 {
+  this->loadStatisticsFromCache(frameIdx);
   stats::paintStatisticsData(painter, this->statisticsData, frameIdx, zoomFactor);
   this->currentDrawnFrameIdx = frameIdx;
 }
@@ -184,10 +210,12 @@ void playlistItemStatisticsFile::loadFrame(int frameIdx, bool, bool, bool emitSi
 {
   DEBUG_STAT("playlistItemStatisticsFile::loadFrame frameIdx %d", frameIdx);
 
+  this->loadStatisticsFromCache(frameIdx);
   if (this->statisticsData.needsLoading(frameIdx) == ItemLoadingState::LoadingNeeded)
   {
     this->isStatisticsLoading = true;
     {
+      std::unique_lock<std::mutex> lock(this->fileAccessMutex);
       auto typesToLoad = this->statisticsData.getTypesThatNeedLoading(frameIdx);
       for (auto typeID : typesToLoad)
         this->file->loadStatisticData(this->statisticsData, frameIdx, typeID);
@@ -204,6 +232,93 @@ ValuePairListSets playlistItemStatisticsFile::getPixelValues(const QPoint &pixel
   return ValuePairListSets("Stats", this->statisticsData.getValuesAt(pixelPos));
 }
 
+bool playlistItemStatisticsFile::isCachable() const
+{
+  // While the file is indexed, the statistics of a frame may still be incomplete
+  if (!playlistItem::isCachable() || !this->file || this->backgroundParserFuture.isRunning())
+    return false;
+  std::unique_lock<std::mutex> lock(this->cachedTypeIDsMutex);
+  return !this->renderedTypeIDs.empty();
+}
+
+void playlistItemStatisticsFile::cacheFrame(int frameIdx, bool testMode)
+{
+  if (!this->cachingEnabled)
+    return;
+  if (!testMode && this->statisticsCache.contains(frameIdx))
+    return;
+
+  stats::StatisticsTypesVec types;
+  std::vector<int>          typeIDs;
+  Size                      frameSize;
+  {
+    std::unique_lock<std::mutex> lock(this->cachedTypeIDsMutex);
+    types     = this->typesToCache;
+    typeIDs   = this->renderedTypeIDs;
+    frameSize = this->frameSizeToCache;
+    if (typeIDs.empty())
+      return;
+    if (this->statisticsCache.getNrFrames() == 0)
+      this->cachedTypeIDs = typeIDs;
+    else if (typeIDs != this->cachedTypeIDs)
+      return;
+  }
+
+  // Load the statistics into a separate data object so that the statistics of the frame that is
+  // currently shown are not touched.
+  stats::StatisticsData frameData;
+  frameData.setFrameSize(frameSize);
+  for (const auto &type : types)
+    frameData.addStatType(type);
+
+  {
+    // The GUI thread may replace the file (reload) while the frame is cached
+    std::unique_lock<std::mutex> lock(this->fileAccessMutex);
+    if (!this->file)
+      return;
+    for (const auto typeID : typeIDs)
+      this->file->loadStatisticData(frameData, frameIdx, typeID);
+  }
+
+  if (testMode)
+    return;
+
+  // The cache may have been cleared (or the rendered types changed) while loading
+  std::unique_lock<std::mutex> lock(this->cachedTypeIDsMutex);
+  if (typeIDs == this->cachedTypeIDs)
+    this->statisticsCache.add(frameIdx, frameData.takeFrameTypeData());
+}
+
+QList<int> playlistItemStatisticsFile::getCachedFrames() const
+{
+  QList<int> frames;
+  for (const auto frameIdx : this->statisticsCache.getFrameIndices())
+    frames.append(frameIdx);
+  return frames;
+}
+
+int playlistItemStatisticsFile::getNumberCachedFrames() const
+{
+  return int(this->statisticsCache.getNrFrames());
+}
+
+unsigned int playlistItemStatisticsFile::getCachingFrameSize() const
+{
+  std::unique_lock<std::mutex> lock(this->cachedTypeIDsMutex);
+  return stats::StatisticsFrameCache::estimateFrameSize(this->frameSizeToCache,
+                                                        this->renderedTypeIDs.size());
+}
+
+void playlistItemStatisticsFile::removeFrameFromCache(int frameIdx)
+{
+  this->statisticsCache.remove(frameIdx);
+}
+
+void playlistItemStatisticsFile::removeAllFramesFromCache()
+{
+  this->clearStatisticsCache();
+}
+
 bool playlistItemStatisticsFile::isSourceChanged()
 {
   return this->file && this->file->isFileChanged();
@@ -274,16 +389,23 @@ void playlistItemStatisticsFile::openStatisticsFile()
     this->backgroundParserFuture.waitForFinished();
   }
 
-  auto suffix = QFileInfo(this->prop.name).suffix();
+  std::unique_ptr<stats::StatisticsFileBase> newFile;
+  auto                                       suffix = QFileInfo(this->prop.name).suffix();
   if (this->openMode == OpenMode::CSVFile ||
       (this->openMode == OpenMode::Extension && suffix == "csv"))
-    this->file.reset(new stats::StatisticsFileCSV(this->prop.name, this->statisticsData));
+    newFile.reset(new stats::StatisticsFileCSV(this->prop.name, this->statisticsData));
   else if (this->openMode == OpenMode::VTMBMSFile ||
            (this->openMode == OpenMode::Extension && suffix == "vtmbmsstats"))
-    this->file.reset(new stats::StatisticsFileVTMBMS(this->prop.name, this->statisticsData));
+    newFile.reset(new stats::StatisticsFileVTMBMS(this->prop.name, this->statisticsData));
   else
     assert(false);
 
+  {
+    // A caching thread may be loading statistics from the old file
+    std::unique_lock<std::mutex> lock(this->fileAccessMutex);
+    this->file = std::move(newFile);
+  }
+
   connect(this->file.get(),
           &stats::StatisticsFileBase::readPOC,
           this,
@@ -311,13 +433,57 @@ void playlistItemStatisticsFile::timerEvent(QTimerEvent *event)
   if (event->timerId() != timer.timerId())
     return playlistItem::timerEvent(event);
 
-  if (!backgroundParserFuture.isRunning())
+  auto parsingDone = !backgroundParserFuture.isRunning();
+  if (parsingDone)
   {
     timer.stop();
+    this->updateTypesToCache();
     DEBUG_STAT("playlistItemStatisticsFile::timerEvent Background parsing done.");
   }
 
   if (this->file)
     this->prop.startEndRange = indexRange(0, this->file->getMaxPoc());
-  emit SignalItemChanged(false, RECACHE_NONE);
+  // Once the file is indexed, the frames can be cached
+  emit SignalItemChanged(false, parsingDone ? RECACHE_UPDATE : RECACHE_NONE);
+}
+
+void playlistItemStatisticsFile::loadStatisticsFromCache(int frameIdx)
+{
+  if (this->statisticsData.getFrameIndex() == frameIdx)
+    return;
+  if (auto cachedStatistics = this->statisticsCache.get(frameIdx))
+  {
+    DEBUG_STAT("playlistItemStatisticsFile::loadStatisticsFromCache frameIdx %d", frameIdx);
+    this->statisticsData.setFrameTypeData(frameIdx, std::move(*cachedStatistics));
+  }
+}
+
+void playlistItemStatisticsFile::clearStatisticsCache()
+{
+  std::unique_lock<std::mutex> lock(this->cachedTypeIDsMutex);
+  this->statisticsCache.clear();
+  this->cachedTypeIDs.clear();
+}
+
+bool playlistItemStatisticsFile::updateTypesToCache()
+{
+  stats::StatisticsTypesVec types;
+  Size                      frameSize;
+  {
+    std::unique_lock<std::mutex> lock(this->statisticsData.accessMutex);
+    types     = this->statisticsData.getStatisticsTypes();
+    frameSize = this->statisticsData.getFrameSize();
+  }
+
+  std::vector<int> typeIDs;
+  for (const auto &type : types)
+    if (type.render)
+      typeIDs.push_back(type.typeID);
+
+  std::unique_lock<std::mutex> lock(this->cachedTypeIDsMutex);
+  const auto renderedTypesChanged = (typeIDs != this->renderedTypeIDs);
+  this->typesToCache              = std::move(types);
+  this->renderedTypeIDs           = std::move(typeIDs);
+  this->frameSizeToCache          = frameSize;
+  return renderedTypesChanged;
 }
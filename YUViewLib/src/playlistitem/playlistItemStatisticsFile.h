@@ -35,9 +35,12 @@
 #include <QBasicTimer>
 #include <QFuture>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "playlistItem.h"
 #include "statistics/StatisticsFileBase.h"
+#include "statistics/StatisticsFrameCache.h"
 
 class playlistItemStatisticsFile : public playlistItem
 {
@@ -93,6 +96,18 @@ public:
     return &this->statisticsUIHandler;
   }
 
+  // ----- Caching -----
+  // The statistics of the frames ahead of the playhead are loaded by the video cache in the
+  // background. Only one thread can read from the file at a time.
+  virtual bool         isCachable() const override;
+  virtual int          cachingThreadLimit() override { return 1; }
+  virtual void         cacheFrame(int frameIdx, bool testMode) override;
+  virtual QList<int>   getCachedFrames() const override;
+  virtual int          getNumberCachedFrames() const override;
+  virtual unsigned int getCachingFrameSize() const override;
+  virtual void         removeFrameFromCache(int frameIdx) override;
+  virtual void         removeAllFramesFromCache() override;
+
   // ----- Detection of source/file change events -----
   virtual bool isSourceChanged() override;
   virtual void updateSettings() override;
@@ -128,4 +143,26 @@ protected:
   timerEvent(QTimerEvent *event) override; // Overloaded from QObject. Called when the timer fires.
 
   int currentDrawnFrameIdx;
+
+  // The file can not be read from multiple threads at the same time
+  std::mutex fileAccessMutex;
+
+  // Take the statistics of the frame from the cache if they are not loaded yet
+  void loadStatisticsFromCache(int frameIdx);
+  void clearStatisticsCache();
+
+  // The caching threads must not access the types of the statisticsData while the user changes
+  // them. Take a snapshot of the types, the IDs of the rendered types and the frame size (in the
+  // GUI thread).
+  // Returns true if the rendered types changed.
+  bool updateTypesToCache();
+
+  // The statistics of the cached frames and the IDs of the types that they contain. If the user
+  // changes which types are rendered, the cache is cleared.
+  stats::StatisticsFrameCache statisticsCache;
+  std::vector<int>            cachedTypeIDs;
+  stats::StatisticsTypesVec   typesToCache;
+  std::vector<int>            renderedTypeIDs;
+  Size                        frameSizeToCache;
+  mutable std::mutex          cachedTypeIDsMutex;
 };
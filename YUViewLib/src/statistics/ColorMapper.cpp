@@ -68,6 +68,26 @@ RGBA applyIMapping(int i, double k, double n)
   return {};
 }
 
+// Tables with more entries are not created. The colors are calculated on request instead.
+constexpr int64_t MAX_LOOKUP_TABLE_SIZE = 1 << 14;
+
+// Randomly remap the values of the range, but always with the same random seed
+std::vector<int> createShuffleMap(double rangeWidth)
+{
+  unsigned         seed = 42;
+  std::vector<int> shuffleMap;
+  for (int val = 0; val <= rangeWidth; ++val)
+    shuffleMap.push_back(val);
+  std::shuffle(shuffleMap.begin(), shuffleMap.end(), std::default_random_engine(seed));
+  return shuffleMap;
+}
+
+bool usesShuffleMap(const ColorMapper &colorMapper)
+{
+  return colorMapper.mappingType == MappingType::Predefined &&
+         colorMapper.predefinedType == PredefinedType::Shuffle;
+}
+
 std::string rangeToString(const Range<int> range)
 {
   return std::to_string(range.min) + "|" + std::to_string(range.max);
@@ -144,6 +164,14 @@ Color ColorMapper::getColor(double value) const
   if (this->mappingType == MappingType::Map)
     return this->getColor(int(value + 0.5));
 
+  std::vector<int> shuffleMap;
+  if (usesShuffleMap(*this))
+    shuffleMap = createShuffleMap(double(this->valueRange.max) - double(this->valueRange.min));
+  return this->mapValue(value, shuffleMap);
+}
+
+Color ColorMapper::mapValue(double value, const std::vector<int> &shuffleMap) const
+{
   value           = functions::clip(value, this->valueRange);
   auto rangeWidth = double(this->valueRange.max) - double(this->valueRange.min);
 
@@ -215,16 +243,10 @@ Color ColorMapper::getColor(double value) const
     }
     else if (this->predefinedType == PredefinedType::Shuffle)
     {
-      // randomly remap the x value, but always with the same random seed
-      unsigned         seed = 42;
-      std::vector<int> randomMap;
-      for (int val = 0; val <= rangeWidth; ++val)
-        randomMap.push_back(val);
-      std::shuffle(randomMap.begin(), randomMap.end(), std::default_random_engine(seed));
-
+      // randomly remap the x value
       auto valueInt    = functions::clip(int(value) - this->valueRange.min, this->valueRange);
       auto remainder   = value - valueInt;
-      auto valueMapped = randomMap[valueInt] + remainder;
+      auto valueMapped = shuffleMap[valueInt] + remainder;
       auto x           = valueMapped / rangeWidth;
 
       // h = x, s = 1, v = 1
@@ -457,10 +479,103 @@ bool ColorMapper::operator!=(const ColorMapper &other) const
            this->gradientColorStart != other.gradientColorStart ||
            this->gradientColorEnd != other.gradientColorEnd;
   if (this->mappingType == MappingType::Map)
-    return this->colorMap != other.colorMap;
+    return this->colorMap != other.colorMap || this->colorMapOther != other.colorMapOther;
   if (this->mappingType == MappingType::Predefined)
     return this->valueRange != other.valueRange || this->predefinedType != other.predefinedType;
   return false;
 }
 
+ColorLookupTable::ColorLookupTable(const ColorMapper &colorMapper) : colorMapper(colorMapper)
+{
+  const auto isMap = colorMapper.mappingType == MappingType::Map;
+  if (usesShuffleMap(colorMapper))
+    this->shuffleMap = createShuffleMap(double(colorMapper.valueRange.max) -
+                                        double(colorMapper.valueRange.min));
+
+  auto tableRange = colorMapper.valueRange;
+  if (isMap)
+  {
+    if (colorMapper.colorMap.empty())
+      return;
+    tableRange = {colorMapper.colorMap.begin()->first, colorMapper.colorMap.rbegin()->first};
+  }
+
+  const auto tableSize = int64_t(tableRange.max) - int64_t(tableRange.min) + 1;
+  if (tableSize <= 0 || tableSize > MAX_LOOKUP_TABLE_SIZE)
+    return;
+
+  this->firstValue = tableRange.min;
+  this->table.reserve(size_t(tableSize));
+  for (int64_t value = tableRange.min; value <= tableRange.max; value++)
+  {
+    if (isMap)
+      this->table.push_back(colorMapper.getColor(int(value)));
+    else
+      this->table.push_back(colorMapper.mapValue(double(value), this->shuffleMap));
+  }
+
+  // Values outside of the range are clipped. Values that are not in the map get the other color.
+  this->colorBelow = isMap ? colorMapper.colorMapOther : this->table.front();
+  this->colorAbove = isMap ? colorMapper.colorMapOther : this->table.back();
+}
+
+bool ColorLookupTable::isBuiltFrom(const ColorMapper &colorMapper) const
+{
+  return !(this->colorMapper != colorMapper);
+}
+
+Color ColorLookupTable::getColor(int value) const
+{
+  if (this->table.empty())
+  {
+    if (this->colorMapper.mappingType == MappingType::Map)
+      return this->colorMapper.getColor(value);
+    return this->colorMapper.mapValue(double(value), this->shuffleMap);
+  }
+
+  const auto index = int64_t(value) - int64_t(this->firstValue);
+  if (index < 0)
+    return this->colorBelow;
+  if (index >= int64_t(this->table.size()))
+    return this->colorAbove;
+  return this->table[size_t(index)];
+}
+
+Color ColorLookupTable::getColor(double value) const
+{
+  if (this->colorMapper.mappingType == MappingType::Map)
+    return this->getColor(int(value + 0.5));
+
+  if (!this->table.empty())
+  {
+    // Values outside of the range are clipped. Only integer values are in the table.
+    const auto lastValue = double(this->firstValue) + double(this->table.size() - 1);
+    if (value <= double(this->firstValue))
+      return this->colorBelow;
+    if (value >= lastValue)
+      return this->colorAbove;
+    if (value == std::floor(value))
+      return this->table[size_t(value - double(this->firstValue))];
+  }
+  return this->colorMapper.mapValue(value, this->shuffleMap);
+}
+
+std::vector<Color> ColorLookupTable::getColors(const std::vector<int> &values) const
+{
+  std::vector<Color> colors;
+  colors.reserve(values.size());
+  for (const auto value : values)
+    colors.push_back(this->getColor(value));
+  return colors;
+}
+
+std::vector<Color> ColorLookupTable::getColors(const std::vector<double> &values) const
+{
+  std::vector<Color> colors;
+  colors.reserve(values.size());
+  for (const auto value : values)
+    colors.push_back(this->getColor(value));
+  return colors;
+}
+
 } // namespace stats::color
@@ -38,6 +38,7 @@
 #include <common/YUViewDomElement.h>
 
 #include <map>
+#include <vector>
 
 namespace stats::color
 {
@@ -140,6 +141,44 @@ public:
   ColorMap       colorMap;
   Color          colorMapOther{};
   PredefinedType predefinedType{PredefinedType::Jet};
+
+private:
+  friend class ColorLookupTable;
+
+  // Map a value with the gradient or the predefined color map. The shuffle map (the randomly
+  // remapped values of the range) is only needed for the Shuffle type.
+  Color mapValue(double value, const std::vector<int> &shuffleMap) const;
+};
+
+/* A compiled form of a ColorMapper. The colors of all integer values in the value range (or of
+ * all keys of a color map) are calculated once and kept in a table, so that getting a color is a
+ * single array access. If the range is too big for a table, the colors are calculated (or looked
+ * up in the color map) on request. Build a new table whenever the ColorMapper changes.
+ */
+class ColorLookupTable
+{
+public:
+  ColorLookupTable() = default;
+  explicit ColorLookupTable(const ColorMapper &colorMapper);
+
+  // Was the table built from a mapper that returns the same colors as this one?
+  bool isBuiltFrom(const ColorMapper &colorMapper) const;
+
+  Color getColor(int value) const;
+  Color getColor(double value) const;
+
+  std::vector<Color> getColors(const std::vector<int> &values) const;
+  std::vector<Color> getColors(const std::vector<double> &values) const;
+
+private:
+  ColorMapper      colorMapper;
+  std::vector<int> shuffleMap;
+
+  // The color of value firstValue + i is table[i]
+  int                firstValue{};
+  std::vector<Color> table;
+  Color              colorBelow;
+  Color              colorAbove;
 };
 
 } // namespace stats::color
@@ -131,4 +131,17 @@ void FrameTypeData::addPolygonVector(const Polygon &points, int vecX, int vecY)
   polygonVectorData.push_back(vec);
 }
 
+size_t FrameTypeData::getMemoryUsage() const
+{
+  auto nrBytes = sizeof(FrameTypeData);
+  nrBytes += this->valueData.capacity() * sizeof(StatsItemValue);
+  nrBytes += this->vectorData.capacity() * sizeof(StatsItemVector);
+  nrBytes += this->affineTFData.capacity() * sizeof(StatsItemAffineTF);
+  for (const auto &value : this->polygonValueData)
+    nrBytes += sizeof(StatsItemPolygonValue) + value.corners.capacity() * sizeof(Point);
+  for (const auto &vector : this->polygonVectorData)
+    nrBytes += sizeof(StatsItemPolygonVector) + vector.corners.capacity() * sizeof(Point);
+  return nrBytes;
+}
+
 } // namespace stats
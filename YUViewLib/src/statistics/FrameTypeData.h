@@ -144,6 +144,9 @@ public:
   void addPolygonVector(const Polygon &points, int vecX, int vecY);
   void addPolygonValue(const Polygon &points, int val);
 
+  // Get the approximate number of bytes that the data uses in memory
+  size_t getMemoryUsage() const;
+
   std::vector<StatsItemValue>         valueData;
   std::vector<StatsItemVector>        vectorData;
   std::vector<StatsItemAffineTF>      affineTFData;
@@ -155,4 +158,7 @@ public:
   unsigned maxBlockSize;
 };
 
+// The data of all types of one frame [typeID]
+using FrameTypeDataMap = std::map<int, FrameTypeData>;
+
 } // namespace stats
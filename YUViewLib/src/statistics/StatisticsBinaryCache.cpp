@@ -0,0 +1,495 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StatisticsBinaryCache.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace stats
+{
+
+namespace
+{
+
+constexpr auto     CACHE_FILE_SUFFIX   = ".yuviewstatscache";
+constexpr char     CACHE_FILE_MAGIC[8] = {'Y', 'U', 'V', 'S', 'T', 'A', 'T', 'S'};
+constexpr uint32_t CACHE_FILE_VERSION  = 1;
+
+struct FileHeader
+{
+  char     magic[8]{};
+  uint32_t version{};
+  uint32_t fileSortedByPOC{};
+  int64_t  statisticsFileSize{};
+  int64_t  statisticsFileModified{};
+  int64_t  indexOffset{};
+  uint32_t nrIndexEntries{};
+  int32_t  maxPOC{};
+};
+
+struct FileIndexEntry
+{
+  int32_t  poc{};
+  int32_t  typeID{};
+  int64_t  offset{};
+  int64_t  nrBytes{};
+  uint32_t nrValues{};
+  uint32_t nrVectors{};
+  uint32_t nrAffineTFs{};
+  uint32_t nrPolygonValues{};
+  uint32_t nrPolygonVectors{};
+  uint32_t nrPolygonCorners{};
+};
+
+std::pair<int64_t, int64_t> getFileSizeAndModificationTime(const std::filesystem::path &path)
+{
+  QFileInfo fileInfo(QString::fromStdString(path.string()));
+  return {fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch()};
+}
+
+template <typename T, typename Items, typename Getter>
+void appendColumn(QByteArray &data, const Items &items, Getter getValue)
+{
+  for (const auto &item : items)
+  {
+    const T value = getValue(item);
+    data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+}
+
+// The columns in the file are not aligned so all values are copied out.
+template <typename T> class Column
+{
+public:
+  Column(const char *data) : data(data) {}
+  T operator[](size_t i) const
+  {
+    T value;
+    std::memcpy(&value, this->data + i * sizeof(T), sizeof(T));
+    return value;
+  }
+
+private:
+  const char *data{};
+};
+
+class BlockReader
+{
+public:
+  BlockReader(const char *data, int64_t nrBytes) : data(data), nrBytes(nrBytes) {}
+
+  template <typename T> Column<T> nextColumn(size_t nrItems)
+  {
+    const auto nrColumnBytes = int64_t(nrItems * sizeof(T));
+    if (this->pos + nrColumnBytes > this->nrBytes)
+      throw std::out_of_range("Column exceeds the cached block");
+    Column<T> column(this->data + this->pos);
+    this->pos += nrColumnBytes;
+    return column;
+  }
+
+private:
+  const char   *data{};
+  const int64_t nrBytes{};
+  int64_t       pos{};
+};
+
+void readBlock(BlockReader &reader, const FileIndexEntry &entry, FrameTypeData &data)
+{
+  {
+    const auto n      = entry.nrValues;
+    const auto x      = reader.nextColumn<uint16_t>(n);
+    const auto y      = reader.nextColumn<uint16_t>(n);
+    const auto width  = reader.nextColumn<uint16_t>(n);
+    const auto height = reader.nextColumn<uint16_t>(n);
+    const auto value  = reader.nextColumn<int32_t>(n);
+    data.valueData.reserve(n);
+    for (size_t i = 0; i < n; i++)
+      data.addBlockValue(x[i], y[i], width[i], height[i], value[i]);
+  }
+  {
+    const auto n      = entry.nrVectors;
+    const auto x      = reader.nextColumn<uint16_t>(n);
+    const auto y      = reader.nextColumn<uint16_t>(n);
+    const auto width  = reader.nextColumn<uint16_t>(n);
+    const auto height = reader.nextColumn<uint16_t>(n);
+    const auto isLine = reader.nextColumn<uint8_t>(n);
+    const auto x0     = reader.nextColumn<int32_t>(n);
+    const auto y0     = reader.nextColumn<int32_t>(n);
+    const auto x1     = reader.nextColumn<int32_t>(n);
+    const auto y1     = reader.nextColumn<int32_t>(n);
+    data.vectorData.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+      if (isLine[i])
+        data.addLine(x[i], y[i], width[i], height[i], x0[i], y0[i], x1[i], y1[i]);
+      else
+        data.addBlockVector(x[i], y[i], width[i], height[i], x0[i], y0[i]);
+    }
+  }
+  {
+    const auto n      = entry.nrAffineTFs;
+    const auto x      = reader.nextColumn<uint16_t>(n);
+    const auto y      = reader.nextColumn<uint16_t>(n);
+    const auto width  = reader.nextColumn<uint16_t>(n);
+    const auto height = reader.nextColumn<uint16_t>(n);
+    std::array<Column<int32_t>, 6> points{reader.nextColumn<int32_t>(n),
+                                          reader.nextColumn<int32_t>(n),
+                                          reader.nextColumn<int32_t>(n),
+                                          reader.nextColumn<int32_t>(n),
+                                          reader.nextColumn<int32_t>(n),
+                                          reader.nextColumn<int32_t>(n)};
+    data.affineTFData.reserve(n);
+    for (size_t i = 0; i < n; i++)
+      data.addBlockAffineTF(x[i],
+                            y[i],
+                            width[i],
+                            height[i],
+                            points[0][i],
+                            points[1][i],
+                            points[2][i],
+                            points[3][i],
+                            points[4][i],
+                            points[5][i]);
+  }
+
+  const auto polygonValueCorners  = reader.nextColumn<uint32_t>(entry.nrPolygonValues);
+  const auto polygonValue         = reader.nextColumn<int32_t>(entry.nrPolygonValues);
+  const auto polygonVectorCorners = reader.nextColumn<uint32_t>(entry.nrPolygonVectors);
+  const auto polygonVectorX       = reader.nextColumn<int32_t>(entry.nrPolygonVectors);
+  const auto polygonVectorY       = reader.nextColumn<int32_t>(entry.nrPolygonVectors);
+  const auto cornerX              = reader.nextColumn<int32_t>(entry.nrPolygonCorners);
+  const auto cornerY              = reader.nextColumn<int32_t>(entry.nrPolygonCorners);
+
+  size_t cornerIdx  = 0;
+  auto   getPolygon = [&](uint32_t nrCorners)
+  {
+    if (cornerIdx + nrCorners > entry.nrPolygonCorners)
+      throw std::out_of_range("Polygon corners exceed the cached block");
+    Polygon polygon;
+    for (uint32_t i = 0; i < nrCorners; i++, cornerIdx++)
+      polygon.push_back(Point(cornerX[cornerIdx], cornerY[cornerIdx]));
+    return polygon;
+  };
+  for (size_t i = 0; i < entry.nrPolygonValues; i++)
+    data.addPolygonValue(getPolygon(polygonValueCorners[i]), polygonValue[i]);
+  for (size_t i = 0; i < entry.nrPolygonVectors; i++)
+    data.addPolygonVector(
+        getPolygon(polygonVectorCorners[i]), polygonVectorX[i], polygonVectorY[i]);
+}
+
+} // namespace
+
+std::filesystem::path
+StatisticsBinaryCache::getCacheFilePath(const std::filesystem::path &statisticsFilePath)
+{
+  auto cacheFilePath = statisticsFilePath;
+  cacheFilePath += CACHE_FILE_SUFFIX;
+  return cacheFilePath;
+}
+
+bool StatisticsBinaryCache::open(const std::filesystem::path &statisticsFilePath)
+{
+  this->opened = false;
+  this->index.clear();
+
+  const auto cacheFilePath = getCacheFilePath(statisticsFilePath);
+  if (!std::filesystem::exists(cacheFilePath) || !this->cacheFile.openFile(cacheFilePath))
+    return false;
+
+  QByteArray headerData;
+  if (this->cacheFile.readBytes(headerData, 0, sizeof(FileHeader)) < int64_t(sizeof(FileHeader)))
+    return false;
+  FileHeader header;
+  std::memcpy(&header, headerData.constData(), sizeof(FileHeader));
+
+  const auto [fileSize, fileModified] = getFileSizeAndModificationTime(statisticsFilePath);
+  if (std::memcmp(header.magic, CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC)) != 0 ||
+      header.version != CACHE_FILE_VERSION || header.statisticsFileSize != fileSize ||
+      header.statisticsFileModified != fileModified)
+    return false;
+
+  const auto indexSize = int64_t(header.nrIndexEntries) * int64_t(sizeof(FileIndexEntry));
+  QByteArray indexData;
+  if (this->cacheFile.readBytes(indexData, header.indexOffset, indexSize) < indexSize)
+    return false;
+  for (uint32_t i = 0; i < header.nrIndexEntries; i++)
+  {
+    FileIndexEntry fileEntry;
+    std::memcpy(&fileEntry, indexData.constData() + i * sizeof(FileIndexEntry), sizeof(fileEntry));
+
+    IndexEntry entry;
+    entry.offset           = fileEntry.offset;
+    entry.nrBytes          = fileEntry.nrBytes;
+    entry.nrValues         = fileEntry.nrValues;
+    entry.nrVectors        = fileEntry.nrVectors;
+    entry.nrAffineTFs      = fileEntry.nrAffineTFs;
+    entry.nrPolygonValues  = fileEntry.nrPolygonValues;
+    entry.nrPolygonVectors = fileEntry.nrPolygonVectors;
+    entry.nrPolygonCorners = fileEntry.nrPolygonCorners;
+    this->index[{fileEntry.poc, fileEntry.typeID}] = entry;
+  }
+
+  this->fileSortedByPOC = (header.fileSortedByPOC != 0);
+  this->maxPOC          = header.maxPOC;
+
+  // If mapping fails, the blocks are read from the file
+  this->cacheFile.mapFile();
+  this->opened = true;
+  return true;
+}
+
+std::vector<int> StatisticsBinaryCache::getPOCs() const
+{
+  std::vector<int> pocs;
+  for (const auto &entry : this->index)
+    if (pocs.empty() || pocs.back() != entry.first.first)
+      pocs.push_back(entry.first.first);
+  return pocs;
+}
+
+bool StatisticsBinaryCache::loadFrameTypeData(int poc, int typeID, FrameTypeData &data)
+{
+  if (!this->opened)
+    return false;
+
+  const auto it = this->index.find({poc, typeID});
+  if (it == this->index.end())
+    return false;
+  const auto &entry = it->second;
+
+  FileIndexEntry fileEntry;
+  fileEntry.nrValues         = entry.nrValues;
+  fileEntry.nrVectors        = entry.nrVectors;
+  fileEntry.nrAffineTFs      = entry.nrAffineTFs;
+  fileEntry.nrPolygonValues  = entry.nrPolygonValues;
+  fileEntry.nrPolygonVectors = entry.nrPolygonVectors;
+  fileEntry.nrPolygonCorners = entry.nrPolygonCorners;
+
+  QByteArray  readData;
+  const char *blockData  = nullptr;
+  auto        mappedData = this->cacheFile.getMappedData(entry.offset, entry.nrBytes);
+  if (mappedData)
+    blockData = reinterpret_cast<const char *>(mappedData.get());
+  else
+  {
+    if (this->cacheFile.readBytes(readData, entry.offset, entry.nrBytes) < entry.nrBytes)
+      return false;
+    blockData = readData.constData();
+  }
+
+  try
+  {
+    FrameTypeData blockFrameTypeData;
+    BlockReader   reader(blockData, entry.nrBytes);
+    readBlock(reader, fileEntry, blockFrameTypeData);
+    data = std::move(blockFrameTypeData);
+  }
+  catch (const std::out_of_range &)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool StatisticsBinaryCache::startWriting(const std::filesystem::path &statisticsFilePath)
+{
+  this->abortWriting();
+  this->opened = false;
+
+  this->statisticsFilePath = statisticsFilePath;
+  std::tie(this->statisticsFileSize, this->statisticsFileModified) =
+      getFileSizeAndModificationTime(statisticsFilePath);
+
+  auto temporaryFilePath = getCacheFilePath(statisticsFilePath);
+  temporaryFilePath += ".tmp";
+  this->writeFile.setFileName(QString::fromStdString(temporaryFilePath.string()));
+  if (!this->writeFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return false;
+
+  // The header is written again when writing is finished
+  const FileHeader header;
+  this->writeError = this->writeFile.write(reinterpret_cast<const char *>(&header),
+                                           sizeof(header)) != int64_t(sizeof(header));
+  this->index.clear();
+  return !this->writeError;
+}
+
+void StatisticsBinaryCache::addFrameTypeData(int poc, int typeID, const FrameTypeData &data)
+{
+  if (!this->writeFile.isOpen() || this->writeError)
+    return;
+
+  QByteArray block;
+
+  const auto &values = data.valueData;
+  appendColumn<uint16_t>(block, values, [](const StatsItemValue &v) { return v.pos[0]; });
+  appendColumn<uint16_t>(block, values, [](const StatsItemValue &v) { return v.pos[1]; });
+  appendColumn<uint16_t>(block, values, [](const StatsItemValue &v) { return v.size[0]; });
+  appendColumn<uint16_t>(block, values, [](const StatsItemValue &v) { return v.size[1]; });
+  appendColumn<int32_t>(block, values, [](const StatsItemValue &v) { return v.value; });
+
+  // The second point of a vector is only set for lines
+  const auto &vectors = data.vectorData;
+  appendColumn<uint16_t>(block, vectors, [](const StatsItemVector &v) { return v.pos[0]; });
+  appendColumn<uint16_t>(block, vectors, [](const StatsItemVector &v) { return v.pos[1]; });
+  appendColumn<uint16_t>(block, vectors, [](const StatsItemVector &v) { return v.size[0]; });
+  appendColumn<uint16_t>(block, vectors, [](const StatsItemVector &v) { return v.size[1]; });
+  appendColumn<uint8_t>(block, vectors, [](const StatsItemVector &v) { return v.isLine; });
+  appendColumn<int32_t>(block, vectors, [](const StatsItemVector &v) { return v.point[0].x; });
+  appendColumn<int32_t>(block, vectors, [](const StatsItemVector &v) { return v.point[0].y; });
+  appendColumn<int32_t>(
+      block, vectors, [](const StatsItemVector &v) { return v.isLine ? v.point[1].x : 0; });
+  appendColumn<int32_t>(
+      block, vectors, [](const StatsItemVector &v) { return v.isLine ? v.point[1].y : 0; });
+
+  const auto &affineTFs = data.affineTFData;
+  appendColumn<uint16_t>(block, affineTFs, [](const StatsItemAffineTF &v) { return v.pos[0]; });
+  appendColumn<uint16_t>(block, affineTFs, [](const StatsItemAffineTF &v) { return v.pos[1]; });
+  appendColumn<uint16_t>(block, affineTFs, [](const StatsItemAffineTF &v) { return v.size[0]; });
+  appendColumn<uint16_t>(block, affineTFs, [](const StatsItemAffineTF &v) { return v.size[1]; });
+  for (int i = 0; i < 3; i++)
+  {
+    appendColumn<int32_t>(
+        block, affineTFs, [i](const StatsItemAffineTF &v) { return v.point[i].x; });
+    appendColumn<int32_t>(
+        block, affineTFs, [i](const StatsItemAffineTF &v) { return v.point[i].y; });
+  }
+
+  const auto &polygonValues  = data.polygonValueData;
+  const auto &polygonVectors = data.polygonVectorData;
+  const auto  getNrCorners   = [](const auto &p) { return uint32_t(p.corners.size()); };
+  appendColumn<uint32_t>(block, polygonValues, getNrCorners);
+  appendColumn<int32_t>(
+      block, polygonValues, [](const StatsItemPolygonValue &v) { return v.value; });
+  appendColumn<uint32_t>(block, polygonVectors, getNrCorners);
+  appendColumn<int32_t>(
+      block, polygonVectors, [](const StatsItemPolygonVector &v) { return v.point.x; });
+  appendColumn<int32_t>(
+      block, polygonVectors, [](const StatsItemPolygonVector &v) { return v.point.y; });
+
+  Polygon corners;
+  for (const auto &polygon : polygonValues)
+    corners.insert(corners.end(), polygon.corners.begin(), polygon.corners.end());
+  for (const auto &polygon : polygonVectors)
+    corners.insert(corners.end(), polygon.corners.begin(), polygon.corners.end());
+  appendColumn<int32_t>(block, corners, [](const Point &p) { return p.x; });
+  appendColumn<int32_t>(block, corners, [](const Point &p) { return p.y; });
+
+  IndexEntry entry;
+  entry.offset           = this->writeFile.pos();
+  entry.nrBytes          = block.size();
+  entry.nrValues         = uint32_t(values.size());
+  entry.nrVectors        = uint32_t(vectors.size());
+  entry.nrAffineTFs      = uint32_t(affineTFs.size());
+  entry.nrPolygonValues  = uint32_t(polygonValues.size());
+  entry.nrPolygonVectors = uint32_t(polygonVectors.size());
+  entry.nrPolygonCorners = uint32_t(corners.size());
+  this->index[{poc, typeID}] = entry;
+
+  if (this->writeFile.write(block) != block.size())
+    this->writeError = true;
+}
+
+bool StatisticsBinaryCache::finishWriting(bool fileSortedByPOC, int maxPOC)
+{
+  if (!this->writeFile.isOpen())
+    return false;
+
+  FileHeader header;
+  std::memcpy(header.magic, CACHE_FILE_MAGIC, sizeof(CACHE_FILE_MAGIC));
+  header.version                = CACHE_FILE_VERSION;
+  header.fileSortedByPOC        = fileSortedByPOC ? 1 : 0;
+  header.statisticsFileSize     = this->statisticsFileSize;
+  header.statisticsFileModified = this->statisticsFileModified;
+  header.indexOffset            = this->writeFile.pos();
+  header.nrIndexEntries         = uint32_t(this->index.size());
+  header.maxPOC                 = maxPOC;
+
+  for (const auto &[pocAndType, entry] : this->index)
+  {
+    FileIndexEntry fileEntry;
+    fileEntry.poc              = pocAndType.first;
+    fileEntry.typeID           = pocAndType.second;
+    fileEntry.offset           = entry.offset;
+    fileEntry.nrBytes          = entry.nrBytes;
+    fileEntry.nrValues         = entry.nrValues;
+    fileEntry.nrVectors        = entry.nrVectors;
+    fileEntry.nrAffineTFs      = entry.nrAffineTFs;
+    fileEntry.nrPolygonValues  = entry.nrPolygonValues;
+    fileEntry.nrPolygonVectors = entry.nrPolygonVectors;
+    fileEntry.nrPolygonCorners = entry.nrPolygonCorners;
+    if (this->writeFile.write(reinterpret_cast<const char *>(&fileEntry), sizeof(fileEntry)) !=
+        int64_t(sizeof(fileEntry)))
+      this->writeError = true;
+  }
+
+  if (!this->writeFile.seek(0) ||
+      this->writeFile.write(reinterpret_cast<const char *>(&header), sizeof(header)) !=
+          int64_t(sizeof(header)))
+    this->writeError = true;
+
+  if (this->writeError)
+  {
+    this->abortWriting();
+    return false;
+  }
+
+  this->writeFile.close();
+  const auto cacheFilePath =
+      QString::fromStdString(getCacheFilePath(this->statisticsFilePath).string());
+  QFile::remove(cacheFilePath);
+  if (!this->writeFile.rename(cacheFilePath))
+  {
+    this->writeFile.remove();
+    return false;
+  }
+
+  return this->open(this->statisticsFilePath);
+}
+
+void StatisticsBinaryCache::abortWriting()
+{
+  if (this->writeFile.isOpen())
+  {
+    this->writeFile.close();
+    this->writeFile.remove();
+  }
+  this->writeError = false;
+}
+
+} // namespace stats
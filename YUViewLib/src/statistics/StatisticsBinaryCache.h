@@ -0,0 +1,111 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FrameTypeData.h"
+
+#include <filesource/FileSource.h>
+
+#include <QFile>
+
+#include <filesystem>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace stats
+{
+
+/* A binary cache file for text based statistics files. It contains the statistics of every
+ * POC/type in a packed columnar layout (all x positions, then all y positions, ...). The cache file
+ * is written next to the statistics file while it is parsed for the first time. When the
+ * statistics file is opened again, the statistics can be read directly from the (memory mapped)
+ * cache file without parsing any text. A cache file is only used if the size and modification time
+ * of the statistics file did not change since the cache was written.
+ */
+class StatisticsBinaryCache
+{
+public:
+  StatisticsBinaryCache() = default;
+
+  static std::filesystem::path getCacheFilePath(const std::filesystem::path &statisticsFilePath);
+
+  // Open the cache file of the given statistics file. Returns false if there is no valid cache.
+  bool open(const std::filesystem::path &statisticsFilePath);
+  bool isOpen() const { return this->opened; }
+
+  bool             isFileSortedByPOC() const { return this->fileSortedByPOC; }
+  int              getMaxPOC() const { return this->maxPOC; }
+  std::vector<int> getPOCs() const;
+
+  // Load the statistics of the given POC and type into data. Returns false if the cache has no data
+  // for this POC/type.
+  bool loadFrameTypeData(int poc, int typeID, FrameTypeData &data);
+
+  // Write a new cache for the given statistics file. The data must be added while the statistics
+  // file is parsed. The cache is written to a temporary file which is only renamed to the real
+  // cache file by finishWriting. If writing fails at any point, no cache file is created.
+  bool startWriting(const std::filesystem::path &statisticsFilePath);
+  void addFrameTypeData(int poc, int typeID, const FrameTypeData &data);
+  bool finishWriting(bool fileSortedByPOC, int maxPOC);
+  void abortWriting();
+
+private:
+  struct IndexEntry
+  {
+    int64_t  offset{};
+    int64_t  nrBytes{};
+    uint32_t nrValues{};
+    uint32_t nrVectors{};
+    uint32_t nrAffineTFs{};
+    uint32_t nrPolygonValues{};
+    uint32_t nrPolygonVectors{};
+    uint32_t nrPolygonCorners{};
+  };
+
+  // The index is sorted by [poc, typeID]
+  std::map<std::pair<int, int>, IndexEntry> index;
+  bool                                       fileSortedByPOC{};
+  int                                        maxPOC{};
+
+  FileSource cacheFile;
+  bool       opened{};
+
+  std::filesystem::path statisticsFilePath;
+  int64_t               statisticsFileSize{};
+  int64_t               statisticsFileModified{};
+  QFile                 writeFile;
+  bool                  writeError{};
+};
+
+} // namespace stats
@@ -209,10 +209,17 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       // no active statistics data
       continue;
 
+    // Only the blocks in the grid cell of the position are checked
+    const auto &frameTypeData = this->frameCache.at(it->typeID);
+    const auto &spatialIndex  = this->getSpatialIndex(it->typeID);
+    const auto  posArea       = QRect(pos, QSize(1, 1));
+
     // Get all value data entries
     bool foundStats = false;
-    for (const auto &valueItem : this->frameCache.at(it->typeID).valueData)
+    for (const auto i : spatialIndex.getValuesIn(posArea))
     {
+      const auto &valueItem = frameTypeData.valueData[i];
+
       auto rect = QRect(valueItem.pos[0], valueItem.pos[1], valueItem.size[0], valueItem.size[1]);
       if (rect.contains(pos))
       {
@@ -226,8 +233,10 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       }
     }
 
-    for (const auto &vectorItem : this->frameCache.at(it->typeID).vectorData)
+    for (const auto i : spatialIndex.getVectorsIn(posArea))
     {
+      const auto &vectorItem = frameTypeData.vectorData[i];
+
       auto rect =
           QRect(vectorItem.pos[0], vectorItem.pos[1], vectorItem.size[0], vectorItem.size[1]);
       if (rect.contains(pos))
@@ -250,8 +259,10 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       }
     }
 
-    for (const auto &affineTFItem : this->frameCache.at(it->typeID).affineTFData)
+    for (const auto i : spatialIndex.getAffineTFsIn(posArea))
     {
+      const auto &affineTFItem = frameTypeData.affineTFData[i];
+
       const auto rect = QRect(
           affineTFItem.pos[0], affineTFItem.pos[1], affineTFItem.size[0], affineTFItem.size[1]);
       if (rect.contains(pos))
@@ -269,7 +280,7 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       }
     }
 
-    for (const auto &valueItem : this->frameCache.at(it->typeID).polygonValueData)
+    for (const auto &valueItem : frameTypeData.polygonValueData)
     {
       if (valueItem.corners.size() < 3)
         continue; // need at least triangle -- or more corners
@@ -282,7 +293,7 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
       }
     }
 
-    for (const auto &polygonVectorItem : this->frameCache.at(it->typeID).polygonVectorData)
+    for (const auto &polygonVectorItem : frameTypeData.polygonVectorData)
     {
       if (polygonVectorItem.corners.size() < 3)
         continue; // need at least triangle -- or more corners
@@ -309,9 +320,36 @@ QStringPairList StatisticsData::getValuesAt(const QPoint &pos) const
   return valueList;
 }
 
+const StatisticsSpatialIndex &StatisticsData::getSpatialIndex(int typeID) const
+{
+  const auto &data  = this->frameCache.at(typeID);
+  auto       &index = this->spatialIndices[typeID];
+  if (!index.isUpToDate(data))
+    index = StatisticsSpatialIndex(data);
+  return index;
+}
+
+const color::ColorLookupTable &StatisticsData::getColorLookupTable(const StatisticsType &type)
+{
+  auto &colorLookupTable = this->colorLookupTables[type.typeID];
+  if (!colorLookupTable.isBuiltFrom(type.colorMapper))
+    colorLookupTable = color::ColorLookupTable(type.colorMapper);
+  return colorLookupTable;
+}
+
+void StatisticsData::eraseDataForTypeID(int typeID)
+{
+  this->frameCache.erase(typeID);
+  this->rasterizedValues.erase(typeID);
+  this->spatialIndices.erase(typeID);
+}
+
 void StatisticsData::clear()
 {
   this->frameCache.clear();
+  this->rasterizedValues.clear();
+  this->spatialIndices.clear();
+  this->colorLookupTables.clear();
   this->frameIdx  = -1;
   this->frameSize = {};
   this->statsTypes.clear();
@@ -325,10 +363,32 @@ void StatisticsData::setFrameIndex(int frameIndex)
     DEBUG_STATDATA("StatisticsData::getTypesThatNeedLoading New frame index set "
                    << this->frameIdx << "->" << frameIndex);
     this->frameCache.clear();
+    this->rasterizedValues.clear();
+    this->spatialIndices.clear();
     this->frameIdx = frameIndex;
   }
 }
 
+void StatisticsData::setFrameTypeData(int frameIndex, FrameTypeDataMap &&data)
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  this->frameCache = std::move(data);
+  this->frameIdx   = frameIndex;
+  this->rasterizedValues.clear();
+  this->spatialIndices.clear();
+}
+
+FrameTypeDataMap StatisticsData::takeFrameTypeData()
+{
+  std::unique_lock<std::mutex> lock(this->accessMutex);
+  auto data = std::move(this->frameCache);
+  this->frameCache.clear();
+  this->rasterizedValues.clear();
+  this->spatialIndices.clear();
+  this->frameIdx = -1;
+  return data;
+}
+
 void StatisticsData::addStatType(const StatisticsType &type)
 {
   if (type.typeID == -1)
@@ -33,8 +33,11 @@
 #pragma once
 
 #include "FrameTypeData.h"
+#include "StatisticsSpatialIndex.h"
 #include "StatisticsType.h"
 
+#include <QImage>
+
 #include <map>
 #include <mutex>
 #include <vector>
@@ -44,6 +47,20 @@ namespace stats
 
 using StatisticsTypesVec = std::vector<StatisticsType>;
 
+// The block values of one statistics type of the current frame rasterized with one pixel per cell
+// of cellSize x cellSize samples. The cells are as large as the blocks and the frame size allow.
+// It is created by paintStatisticsData and reused as long as the data and the settings that the
+// colors depend on do not change. Only the rasters of the rendered types are kept.
+struct RasterizedValues
+{
+  size_t             nrValues{};
+  int                cellSize{1};
+  color::ColorMapper colorMapper;
+  int                alphaFactor{};
+  bool               scaleValueToBlockSize{};
+  QImage             image;
+};
+
 class StatisticsData
 {
 public:
@@ -57,11 +74,25 @@ public:
   QStringPairList     getValuesAt(const QPoint &pos) const;
   StatisticsTypesVec &getStatisticsTypes() { return this->statsTypes; }
   bool                hasDataForTypeID(int typeID) { return this->frameCache.count(typeID) > 0; }
-  void                eraseDataForTypeID(int typeID) { this->frameCache.erase(typeID); }
+  void                eraseDataForTypeID(int typeID);
+
+  const StatisticsTypesVec &getStatisticsTypes() const { return this->statsTypes; }
+
+  // Only for painting. Must be accessed with the accessMutex locked.
+  std::map<int, RasterizedValues> &getRasterizedValues() { return this->rasterizedValues; }
+  // Get the spatial index of the data of the type. It is (re)built if the data changed. Must be
+  // accessed with the accessMutex locked.
+  const StatisticsSpatialIndex &getSpatialIndex(int typeID) const;
+  // Get the color lookup table for the color mapper of the type. It is rebuilt if the mapper
+  // changed. Must be accessed with the accessMutex locked.
+  const color::ColorLookupTable &getColorLookupTable(const StatisticsType &type);
 
   void clear();
   void setFrameSize(Size size) { this->frameSize = size; }
   void setFrameIndex(int frameIndex);
+  void setFrameTypeData(int frameIndex, FrameTypeDataMap &&data);
+  // Move the data of the current frame out. This resets the frame index.
+  FrameTypeDataMap takeFrameTypeData();
   void addStatType(const StatisticsType &type);
 
   void savePlaylist(YUViewDomElement &root) const;
@@ -74,8 +105,15 @@ public:
 
 private:
   // cache of the statistics for the current POC [statsTypeID]
-  std::map<int, FrameTypeData> frameCache;
-  int                          frameIdx{-1};
+  FrameTypeDataMap frameCache;
+  int              frameIdx{-1};
+
+  // Rasterized value data of the current frame [statsTypeID]
+  std::map<int, RasterizedValues> rasterizedValues;
+  // Spatial index over the blocks of the current frame [statsTypeID]
+  mutable std::map<int, StatisticsSpatialIndex> spatialIndices;
+  // Color lookup tables of the types. They are kept when the frame changes. [statsTypeID]
+  std::map<int, color::ColorLookupTable> colorLookupTables;
 
   Size frameSize;
 
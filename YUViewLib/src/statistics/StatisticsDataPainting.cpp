@@ -39,7 +39,10 @@
 #include <QPainterPath>
 #include <QtGui/QPolygon>
 #include <QtMath>
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <set>
 
 namespace
 {
@@ -253,6 +256,141 @@ void paintVector(QPainter *                   painter,
   }
 }
 
+QRgb blendSourceOver(QRgb source, QRgb destination)
+{
+  const auto inverseAlpha = 255 - qAlpha(source);
+  return qRgba(qRed(source) + qRed(destination) * inverseAlpha / 255,
+               qGreen(source) + qGreen(destination) * inverseAlpha / 255,
+               qBlue(source) + qBlue(destination) * inverseAlpha / 255,
+               qAlpha(source) + qAlpha(destination) * inverseAlpha / 255);
+}
+
+// A full resolution raster of an 8K frame needs 132 MB. The blocks of most statistics are
+// multiples of 4x4 or 8x8 samples, so one pixel per block of that size is enough.
+constexpr auto MAX_RASTER_CELL_SIZE = 64;
+
+// The largest power of two (up to MAX_RASTER_CELL_SIZE) that all block positions and sizes and the
+// frame size are a multiple of.
+int getRasterCellSize(const stats::FrameTypeData &frameTypeData, const Size frameSize)
+{
+  unsigned combinedBits = MAX_RASTER_CELL_SIZE | frameSize.width | frameSize.height;
+  for (const auto &valueItem : frameTypeData.valueData)
+    combinedBits |= unsigned(valueItem.pos[0]) | unsigned(valueItem.pos[1]) |
+                    unsigned(valueItem.size[0]) | unsigned(valueItem.size[1]);
+  return int(combinedBits & (~combinedBits + 1));
+}
+
+// Draw the block values of the given type into an image with one pixel per cell of cellSize x
+// cellSize samples
+QImage rasterizeValues(const stats::StatisticsType         &statisticsType,
+                       const stats::color::ColorLookupTable &colorLookupTable,
+                       const stats::FrameTypeData           &frameTypeData,
+                       const Size                            frameSize,
+                       const int                             cellSize)
+{
+  QImage image(int(frameSize.width) / cellSize,
+               int(frameSize.height) / cellSize,
+               QImage::Format_ARGB32_Premultiplied);
+  if (image.isNull())
+    return {};
+  image.fill(Qt::transparent);
+
+  const auto bits         = image.bits();
+  const auto bytesPerLine = image.bytesPerLine();
+  for (const auto &valueItem : frameTypeData.valueData)
+  {
+    Color color;
+    if (statisticsType.scaleValueToBlockSize)
+      color = colorLookupTable.getColor(
+          double(float(valueItem.value) / (valueItem.size[0] * valueItem.size[1])));
+    else
+      color = colorLookupTable.getColor(valueItem.value);
+    color.setAlpha(color.alpha() * ((float)statisticsType.alphaFactor / 100.0));
+    const auto pixel = qPremultiply(qRgba(color.R(), color.G(), color.B(), color.alpha()));
+
+    const auto xStart = std::min(int(valueItem.pos[0]) / cellSize, image.width());
+    const auto yStart = std::min(int(valueItem.pos[1]) / cellSize, image.height());
+    const auto xEnd =
+        std::min((int(valueItem.pos[0]) + valueItem.size[0]) / cellSize, image.width());
+    const auto yEnd =
+        std::min((int(valueItem.pos[1]) + valueItem.size[1]) / cellSize, image.height());
+    for (int y = yStart; y < yEnd; y++)
+    {
+      auto line = reinterpret_cast<QRgb *>(bits + y * bytesPerLine);
+      if (qAlpha(pixel) == 255)
+        std::fill(line + xStart, line + xEnd, pixel);
+      else
+        for (int x = xStart; x < xEnd; x++)
+          line[x] = blendSourceOver(pixel, line[x]);
+    }
+  }
+  return image;
+}
+
+// Get the rasterized block values of the type. They are only drawn again if the data or the
+// settings changed.
+const stats::RasterizedValues &getRasterizedValues(stats::StatisticsData       &statisticsData,
+                                                   const stats::StatisticsType &statisticsType)
+{
+  const auto &frameTypeData = statisticsData[statisticsType.typeID];
+  auto       &rasterized    = statisticsData.getRasterizedValues()[statisticsType.typeID];
+  if (rasterized.image.isNull() || rasterized.nrValues != frameTypeData.valueData.size() ||
+      rasterized.colorMapper != statisticsType.colorMapper ||
+      rasterized.alphaFactor != statisticsType.alphaFactor ||
+      rasterized.scaleValueToBlockSize != statisticsType.scaleValueToBlockSize)
+  {
+    DEBUG_PAINT("paintStatisticsData Rasterize values of type %d", statisticsType.typeID);
+    rasterized.nrValues              = frameTypeData.valueData.size();
+    rasterized.colorMapper           = statisticsType.colorMapper;
+    rasterized.alphaFactor           = statisticsType.alphaFactor;
+    rasterized.scaleValueToBlockSize = statisticsType.scaleValueToBlockSize;
+
+    const auto frameSize = statisticsData.getFrameSize();
+    rasterized.cellSize  = getRasterCellSize(frameTypeData, frameSize);
+    rasterized.image     = rasterizeValues(statisticsType,
+                                           statisticsData.getColorLookupTable(statisticsType),
+                                           frameTypeData,
+                                           frameSize,
+                                           rasterized.cellSize);
+  }
+  return rasterized;
+}
+
+// Draw the visible part of the rasterized values scaled to the zoom factor
+void drawRasterizedValues(QPainter                      *painter,
+                          const stats::RasterizedValues &rasterized,
+                          double                         zoomFactor,
+                          const QRectF                  &visibleRect)
+{
+  const auto scale      = zoomFactor * rasterized.cellSize;
+  const auto sourceRect = QRectF(visibleRect.left() / scale,
+                                 visibleRect.top() / scale,
+                                 visibleRect.width() / scale,
+                                 visibleRect.height() / scale)
+                              .toAlignedRect()
+                              .adjusted(-1, -1, 1, 1) &
+                          rasterized.image.rect();
+  if (sourceRect.isEmpty())
+    return;
+
+  const auto targetRect = QRectF(sourceRect.left() * scale,
+                                 sourceRect.top() * scale,
+                                 sourceRect.width() * scale,
+                                 sourceRect.height() * scale);
+  // Zoomed in, every sample is a block of pixels. Zoomed out, the samples are averaged.
+  const auto smoothPixmapTransform = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+  painter->setRenderHint(QPainter::SmoothPixmapTransform, scale < 1.0);
+  painter->drawImage(targetRect, rasterized.image, sourceRect);
+  painter->setRenderHint(QPainter::SmoothPixmapTransform, smoothPixmapTransform);
+}
+
+// The arrows of one color. They are drawn with one call for the lines and one for the heads.
+struct VectorBatch
+{
+  QVector<QLineF> lines;
+  QPainterPath    heads;
+};
+
 } // namespace
 
 void stats::paintStatisticsData(QPainter *             painter,
@@ -315,13 +453,41 @@ void stats::paintStatisticsData(QPainter *             painter,
   double             maxLineWidth =
       0.0; // The maximum width of the lines that is drawn. This will be used as an offset.
 
+  const auto visibleRect = QRectF(QPointF(xMin, yMin), QPointF(xMax, yMax));
+  // The rasters of the types that are not drawn anymore are dropped after drawing
+  std::set<int> rasterizedTypeIDs;
+  // The visible area in frame coordinates. Only the blocks in there are looked at.
+  const auto visibleFrameArea = QRect(QPoint(int(std::floor(xMin / zoomFactor)),
+                                             int(std::floor(yMin / zoomFactor))),
+                                      QPoint(int(std::ceil(xMax / zoomFactor)),
+                                             int(std::ceil(yMax / zoomFactor))));
   for (auto it = statsTypes.rbegin(); it != statsTypes.rend(); it++)
   {
     if (!it->render || !statisticsData.hasDataForTypeID(it->typeID))
       continue;
 
-    for (const auto &valueItem : statisticsData[it->typeID].valueData)
+    const auto &valueData = statisticsData[it->typeID].valueData;
+    if (valueData.empty())
+      continue;
+
+    // The colors of the blocks are drawn into an image once. Only the image is drawn here.
+    if (it->renderValueData)
+    {
+      drawRasterizedValues(
+          painter, getRasterizedValues(statisticsData, *it), zoomFactor, visibleRect);
+      rasterizedTypeIDs.insert(it->typeID);
+    }
+
+    const auto drawValues = zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM;
+    if (!it->renderGrid && !drawValues)
+      continue;
+
+    QVector<QRect> gridRects;
+    const auto    &spatialIndex = statisticsData.getSpatialIndex(it->typeID);
+    for (const auto i : spatialIndex.getValuesIn(visibleFrameArea))
     {
+      const auto &valueItem = valueData[i];
+
       // Calculate the size and position of the rectangle to draw (zoomed in)
       auto rect = QRect(valueItem.pos[0], valueItem.pos[1], valueItem.size[0], valueItem.size[1]);
       auto displayRect = QRect(rect.left() * zoomFactor,
@@ -335,44 +501,14 @@ void stats::paintStatisticsData(QPainter *             painter,
       if (!rectVisible)
         continue;
 
-      int value = valueItem.value; // This value determines the color for this item
-      if (it->renderValueData)
-      {
-        // Get the right color for the item and draw it.
-        Color rectColor;
-        if (it->scaleValueToBlockSize)
-          rectColor =
-              it->colorMapper.getColor(float(value) / (valueItem.size[0] * valueItem.size[1]));
-        else
-          rectColor = it->colorMapper.getColor(value);
-        rectColor.setAlpha(rectColor.alpha() * ((float)it->alphaFactor / 100.0));
-
-        auto rectQColor = functionsGui::toQColor(rectColor);
-        painter->setBrush(rectQColor);
-        painter->fillRect(displayRect, rectQColor);
-      }
-
       // optionally, draw a grid around the region
       if (it->renderGrid)
-      {
-        // Set the grid color (no fill)
-        auto gridStyle = it->gridStyle;
-        if (it->scaleGridToZoom)
-          gridStyle.width = gridStyle.width * zoomFactor;
-
-        painter->setPen(styleToPen(gridStyle));
-        painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
-
-        // Save the line width (if thicker)
-        if (gridStyle.width > maxLineWidth)
-          maxLineWidth = gridStyle.width;
-
-        painter->drawRect(displayRect);
-      }
+        gridRects.append(displayRect);
 
       // Save the position/text in order to draw the values later
-      if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM)
+      if (drawValues)
       {
+        int  value  = valueItem.value;
         auto valTxt = it->getValueTxt(value);
         if (valTxt.isEmpty() && it->scaleValueToBlockSize)
           valTxt = QString("%1").arg(float(value) / (valueItem.size[0] * valueItem.size[1]));
@@ -392,6 +528,32 @@ void stats::paintStatisticsData(QPainter *             painter,
           drawStatTexts[i].append(statTxt);
       }
     }
+
+    if (!gridRects.isEmpty())
+    {
+      // Set the grid color (no fill)
+      auto gridStyle = it->gridStyle;
+      if (it->scaleGridToZoom)
+        gridStyle.width = gridStyle.width * zoomFactor;
+
+      painter->setPen(styleToPen(gridStyle));
+      painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
+
+      // Save the line width (if thicker)
+      if (gridStyle.width > maxLineWidth)
+        maxLineWidth = gridStyle.width;
+
+      painter->drawRects(gridRects);
+    }
+  }
+
+  auto &rasterizedValues = statisticsData.getRasterizedValues();
+  for (auto it = rasterizedValues.begin(); it != rasterizedValues.end();)
+  {
+    if (rasterizedTypeIDs.count(it->first) == 0)
+      it = rasterizedValues.erase(it);
+    else
+      it++;
   }
 
   // Draw all the polygon value types. Also, if the zoom factor is larger than
@@ -406,6 +568,8 @@ void stats::paintStatisticsData(QPainter *             painter,
       // This statistics type is not rendered or could not be loaded.
       continue;
 
+    const auto &colorLookupTable = statisticsData.getColorLookupTable(*it);
+
     // Go through all the value data
     for (const auto &valueItem : statisticsData[it->typeID].polygonValueData)
     {
@@ -428,10 +592,10 @@ void stats::paintStatisticsData(QPainter *             painter,
           // Get the right color for the item and draw it.
           Color color;
           if (it->scaleValueToBlockSize)
-            color = it->colorMapper.getColor(
-                float(value) / (boundingRect.size().width() * boundingRect.size().height()));
+            color = colorLookupTable.getColor(double(
+                float(value) / (boundingRect.size().width() * boundingRect.size().height())));
           else
-            color = it->colorMapper.getColor(value);
+            color = colorLookupTable.getColor(value);
           color.setAlpha(color.alpha() * ((float)it->alphaFactor / 100.0));
 
           // Fill polygon
@@ -506,9 +670,31 @@ void stats::paintStatisticsData(QPainter *             painter,
       // This statistics type is not rendered or could not be loaded.
       continue;
 
+    // The pen width and the size of the arrow heads are the same for all vectors of the type
+    auto vectorStyle = it->vectorStyle;
+    if (it->scaleVectorToZoom)
+      vectorStyle.width = vectorStyle.width * zoomFactor / 8;
+    const int headSize =
+        (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && !it->scaleVectorToZoom) ? 8 : zoomFactor / 2;
+
+    // The arrows are collected per color [rgba] and drawn after all vectors of the type
+    std::map<QRgb, VectorBatch> vectorBatches;
+    QVector<QRect>              gridRects;
+
+    // The arrows can reach out of their blocks. The blocks next to the visible area are also
+    // looked at.
+    const auto &frameTypeData = statisticsData[it->typeID];
+    const auto &spatialIndex  = statisticsData.getSpatialIndex(it->typeID);
+    const auto  vectorReach   = spatialIndex.getVectorReach(it->vectorScale);
+
+    const auto vectorArea =
+        visibleFrameArea.adjusted(-vectorReach, -vectorReach, vectorReach, vectorReach);
+
     // Go through all the vector data
-    for (const auto &vectorItem : statisticsData[it->typeID].vectorData)
+    for (const auto i : spatialIndex.getVectorsIn(vectorArea))
     {
+      const auto &vectorItem = frameTypeData.vectorData[i];
+
       // Calculate the size and position of the rectangle to draw (zoomed in)
       const auto rect =
           QRect(vectorItem.pos[0], vectorItem.pos[1], vectorItem.size[0], vectorItem.size[1]);
@@ -551,19 +737,12 @@ void stats::paintStatisticsData(QPainter *             painter,
                                   !(y1 < yMin && y2 < yMin) && !(y1 > yMax && y2 > yMax);
         if (arrowVisible)
         {
-          // Set the pen for drawing
-          auto vectorStyle = it->vectorStyle;
-          auto arrowColor  = functionsGui::toQColor(vectorStyle.color);
+          auto arrowColor = functionsGui::toQColor(vectorStyle.color);
           if (it->mapVectorToColor)
             arrowColor.setHsvF(
                 functions::clip((std::atan2(vy, vx) + M_PI) / (2 * M_PI), 0.0, 1.0), 1.0, 1.0);
           arrowColor.setAlpha(arrowColor.alpha() * ((float)it->alphaFactor / 100.0));
-          if (it->scaleVectorToZoom)
-            vectorStyle.width = vectorStyle.width * zoomFactor / 8;
-
-          painter->setPen(
-              QPen(arrowColor, vectorStyle.width, patternToQPenStyle(vectorStyle.pattern)));
-          painter->setBrush(arrowColor);
+          auto &batch = vectorBatches[arrowColor.rgba()];
 
           // Draw the arrow tip, or a circle if the vector is (0,0) if the zoom factor is not 1 or
           // smaller.
@@ -577,12 +756,6 @@ void stats::paintStatisticsData(QPainter *             painter,
             // Draw the vector head if the vector is not 0,0
             if ((vx != 0 || vy != 0))
             {
-              // The size of the arrow head
-              const int headSize =
-                  (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && !it->scaleVectorToZoom)
-                      ? 8
-                      : zoomFactor / 2;
-
               if (it->arrowHead != StatisticsType::ArrowHead::none)
               {
                 // We draw an arrow head. This means that we will have to draw a shortened line
@@ -593,40 +766,35 @@ void stats::paintStatisticsData(QPainter *             painter,
                               vy * vy * zoomFactor * zoomFactor) > shorten)
                 {
                   // Shorten the line and draw it
-                  QLineF vectorLine = QLineF(x1,
-                                             y1,
-                                             double(x2) - std::cos(angle) * shorten,
-                                             double(y2) - std::sin(angle) * shorten);
-                  painter->drawLine(vectorLine);
+                  batch.lines.append(QLineF(x1,
+                                            y1,
+                                            double(x2) - std::cos(angle) * shorten,
+                                            double(y2) - std::sin(angle) * shorten));
                 }
               }
               else
                 // Draw the not shortened line
-                painter->drawLine(x1, y1, x2, y2);
+                batch.lines.append(QLineF(x1, y1, x2, y2));
 
               if (it->arrowHead == StatisticsType::ArrowHead::arrow)
               {
-                // Save the painter state, translate to the arrow tip, rotate the painter and draw
-                // the normal triangle.
-                painter->save();
-
-                // Draw the arrow tip with fixed size
-                painter->translate(QPoint(x2, y2));
-                painter->rotate(qRadiansToDegrees(angle));
-                const QPoint points[3] = {QPoint(0, 0),
-                                          QPoint(-headSize * 2, -headSize),
-                                          QPoint(-headSize * 2, headSize)};
-                painter->drawPolygon(points, 3);
-
-                // Restore. Revert translation/rotation of the painter.
-                painter->restore();
+                // The normal triangle rotated to the direction of the vector and moved to the
+                // arrow tip
+                QPolygonF triangle;
+                triangle << QPointF(0, 0) << QPointF(-headSize * 2, -headSize)
+                         << QPointF(-headSize * 2, headSize);
+                const auto transform = QTransform().translate(x2, y2).rotateRadians(angle);
+                batch.heads.addPolygon(transform.map(triangle));
+                batch.heads.closeSubpath();
               }
               else if (it->arrowHead == StatisticsType::ArrowHead::circle)
-                painter->drawEllipse(x2 - headSize / 2, y2 - headSize / 2, headSize, headSize);
+                batch.heads.addEllipse(x2 - headSize / 2, y2 - headSize / 2, headSize, headSize);
             }
 
             if (zoomFactor >= STATISTICS_DRAW_VALUES_ZOOM && it->renderVectorDataValues)
             {
+              // The text is drawn in the color of the arrow
+              painter->setPen(arrowColor);
               if (vectorItem.isLine)
               {
                 // if we just draw a line, we want to simply see the coordinate pairs
@@ -688,7 +856,7 @@ void stats::paintStatisticsData(QPainter *             painter,
           else
           {
             // No arrow head is drawn. Only draw a line.
-            painter->drawLine(x1, y1, x2, y2);
+            batch.lines.append(QLineF(x1, y1, x2, y2));
           }
         }
       }
@@ -696,26 +864,40 @@ void stats::paintStatisticsData(QPainter *             painter,
       // Check if the rectangle of the statistics item is even visible
       const bool rectVisible = (!(displayRect.left() > xMax || displayRect.right() < xMin ||
                                   displayRect.top() > yMax || displayRect.bottom() < yMin));
-      if (rectVisible)
-      {
-        // optionally, draw a grid around the region that the arrow is defined for
-        if (it->renderGrid && rectVisible)
-        {
-          auto gridStyle = it->gridStyle;
-          if (it->scaleGridToZoom)
-            gridStyle.width = gridStyle.width * zoomFactor;
+      // optionally, draw a grid around the region that the arrow is defined for
+      if (it->renderGrid && rectVisible)
+        gridRects.append(displayRect);
+    }
 
-          painter->setPen(styleToPen(gridStyle));
-          painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
+    for (auto &[rgba, batch] : vectorBatches)
+    {
+      // Overlapping arrow heads must not cancel each other out
+      batch.heads.setFillRule(Qt::WindingFill);
+      const auto arrowColor = QColor::fromRgba(rgba);
+      painter->setPen(QPen(arrowColor, vectorStyle.width, patternToQPenStyle(vectorStyle.pattern)));
+      painter->setBrush(arrowColor);
+      painter->drawLines(batch.lines);
+      if (!batch.heads.isEmpty())
+        painter->drawPath(batch.heads);
+    }
 
-          painter->drawRect(displayRect);
-        }
-      }
+    if (!gridRects.isEmpty())
+    {
+      auto gridStyle = it->gridStyle;
+      if (it->scaleGridToZoom)
+        gridStyle.width = gridStyle.width * zoomFactor;
+
+      painter->setPen(styleToPen(gridStyle));
+      painter->setBrush(QBrush(QColor(Qt::color0), Qt::NoBrush)); // no fill color
+
+      painter->drawRects(gridRects);
     }
 
     // Go through all the affine transform data
-    for (const auto &affineTFItem : statisticsData[it->typeID].affineTFData)
+    for (const auto i : spatialIndex.getAffineTFsIn(visibleFrameArea))
     {
+      const auto &affineTFItem = frameTypeData.affineTFData[i];
+
       // Calculate the size and position of the rectangle to draw (zoomed in)
       const auto rect = QRect(
           affineTFItem.pos[0], affineTFItem.pos[1], affineTFItem.size[0], affineTFItem.size[1]);
@@ -32,9 +32,29 @@
 
 #include "StatisticsFileBase.h"
 
+#include <common/Functions.h>
+
+#include <QSettings>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+
 namespace stats
 {
 
+namespace
+{
+
+// The internal buffer for parsing the starting positions. The buffer must not be larger than 2GB
+// so that we can address all the positions in it with int (using such a large buffer is not a good
+// idea anyways)
+constexpr int64_t STAT_PARSING_BUFFER_SIZE = 1048576;
+constexpr int     STAT_MAX_STRING_SIZE     = 1 << 28;
+
+} // namespace
+
 StatisticsFileBase::StatisticsFileBase(const QString &filename)
 {
   this->file.openFile(filename.toStdString());
@@ -50,6 +70,259 @@ StatisticsFileBase::~StatisticsFileBase()
   this->abortParsingDestroy = true;
 }
 
+void StatisticsFileBase::setParallelIndexingLimits(int64_t minRangeSize, unsigned maxNrRanges)
+{
+  this->parallelIndexingMinRangeSize = std::max(minRangeSize, int64_t(1));
+  this->parallelIndexingMaxNrRanges  = maxNrRanges;
+}
+
+std::vector<Range<int64_t>> StatisticsFileBase::splitFileIntoLineRanges() const
+{
+  auto maxNrRanges = this->parallelIndexingMaxNrRanges;
+  if (maxNrRanges == 0)
+    maxNrRanges = functions::getOptimalThreadCount();
+  if (this->isWritingBinaryCache())
+    maxNrRanges = 1;
+
+  const auto fileSize = this->file.getFileSize().value_or(0);
+  const auto nrRanges = std::clamp(
+      fileSize / this->parallelIndexingMinRangeSize, int64_t(1), int64_t(maxNrRanges));
+
+  FileSource inputFile;
+  if (nrRanges == 1 || !inputFile.openFile(this->file.getAbsoluteFilePath()))
+    return {{0, fileSize}};
+
+  // Move each split position to the start of the next line
+  std::vector<Range<int64_t>> ranges;
+  int64_t                     rangeStart = 0;
+  QByteArray                  buffer;
+  for (int64_t i = 1; i < nrRanges; i++)
+  {
+    auto splitPos = std::max(fileSize * i / nrRanges, rangeStart);
+    while (splitPos < fileSize)
+    {
+      const auto bufferSize = inputFile.readBytes(buffer, splitPos, 4096);
+      if (bufferSize <= 0)
+      {
+        splitPos = fileSize;
+        break;
+      }
+      if (auto newline = std::memchr(buffer.constData(), '\n', size_t(bufferSize)))
+      {
+        splitPos += static_cast<const char *>(newline) - buffer.constData() + 1;
+        break;
+      }
+      splitPos += bufferSize;
+    }
+    if (splitPos > rangeStart)
+      ranges.push_back({rangeStart, splitPos});
+    rangeStart = splitPos;
+  }
+  if (rangeStart < fileSize)
+    ranges.push_back({rangeStart, fileSize});
+  return ranges;
+}
+
+bool StatisticsFileBase::forEachLineInRange(
+    Range<int64_t>                                       range,
+    std::atomic_bool                                    &breakFunction,
+    const std::function<void(const QString &, int64_t)> &parseLine,
+    const BufferParsedFunction                          &bufferParsed)
+{
+  // Open the file (again). Since this is a background process, we open the file again to
+  // not disturb any reading from not background code.
+  FileSource inputFile;
+  if (!inputFile.openFile(this->file.getAbsoluteFilePath()))
+    return false;
+
+  QByteArray inputBuffer;
+  QByteArray lineBuffer;
+  auto       lineStartPos   = range.min;
+  auto       bufferStartPos = range.min;
+  while (bufferStartPos < range.max)
+  {
+    if (breakFunction.load() || this->abortParsingDestroy)
+      return false;
+
+    const auto nrBytesToRead = std::min(STAT_PARSING_BUFFER_SIZE, range.max - bufferStartPos);
+    const auto bufferSize    = inputFile.readBytes(inputBuffer, bufferStartPos, nrBytesToRead);
+    if (bufferSize <= 0)
+      return false;
+
+    // a corrupted file may contain an arbitrary amount of non-\n symbols
+    // prevent lineBuffer overflow by dumping it for such cases
+    if (lineBuffer.size() > STAT_MAX_STRING_SIZE)
+      lineBuffer.clear();
+
+    const auto data      = inputBuffer.constData();
+    auto       lineStart = int64_t(0);
+    while (auto newline = static_cast<const char *>(
+               std::memchr(data + lineStart, '\n', size_t(bufferSize - lineStart))))
+    {
+      const auto lineEnd = newline - data;
+      lineBuffer.append(data + lineStart, int(lineEnd - lineStart));
+      if (!lineBuffer.isEmpty())
+        parseLine(QString::fromUtf8(lineBuffer), lineStartPos);
+
+      lineBuffer.clear();
+      lineStart    = lineEnd + 1;
+      lineStartPos = bufferStartPos + lineStart;
+    }
+    lineBuffer.append(data + lineStart, int(bufferSize - lineStart));
+
+    bufferStartPos += bufferSize;
+    if (bufferParsed)
+      bufferParsed(bufferStartPos);
+  }
+
+  return true;
+}
+
+void StatisticsFileBase::indexRangesInParallel(
+    const std::vector<Range<int64_t>>       &ranges,
+    const IndexRangeFunction                &indexRange,
+    const std::function<void(size_t, bool)> &mergeRange)
+{
+  const auto fileSize       = this->file.getFileSize().value_or(0);
+  auto       updateProgress = [this, fileSize](int64_t parsedPos) {
+    if (fileSize > 0)
+      this->parsingProgress = static_cast<double>(parsedPos) * 100 / static_cast<double>(fileSize);
+  };
+
+  // Use an own thread pool for all but the first range. This function already runs in the global
+  // pool and waits for the results.
+  QThreadPool threadPool;
+  threadPool.setMaxThreadCount(std::max(int(ranges.size()) - 1, 1));
+
+  std::vector<QFuture<void>> futures;
+  for (size_t i = 1; i < ranges.size(); i++)
+    futures.push_back(QtConcurrent::run(&threadPool, [&indexRange, i]() { indexRange(i, {}); }));
+
+  // Merge what was found in the first range after every read buffer. Otherwise, no POC would be
+  // available until the whole range is indexed.
+  indexRange(0,
+             [&](int64_t parsedPos)
+             {
+               mergeRange(0, false);
+               updateProgress(parsedPos);
+             });
+  mergeRange(0, true);
+  updateProgress(ranges[0].max);
+
+  for (size_t i = 1; i < ranges.size(); i++)
+  {
+    futures[i - 1].waitForFinished();
+    mergeRange(i, true);
+    updateProgress(ranges[i].max);
+  }
+}
+
+void StatisticsFileBase::checkBlocksInsideOfFrame(int                  poc,
+                                                  const FrameTypeData &data,
+                                                  Size                 frameSize)
+{
+  if (this->blockOutsideOfFramePOC != -1)
+    return;
+
+  auto isBlockOutside = [frameSize](const auto &item) {
+    return unsigned(item.pos[0] + item.size[0]) > frameSize.width ||
+           unsigned(item.pos[1] + item.size[1]) > frameSize.height;
+  };
+  auto isPolygonOutside = [frameSize](const auto &item) {
+    return std::any_of(item.corners.begin(),
+                       item.corners.end(),
+                       [frameSize](const Point &p)
+                       { return p.x > int(frameSize.width) || p.y > int(frameSize.height); });
+  };
+
+  if (std::any_of(data.valueData.begin(), data.valueData.end(), isBlockOutside) ||
+      std::any_of(data.vectorData.begin(), data.vectorData.end(), isBlockOutside) ||
+      std::any_of(data.affineTFData.begin(), data.affineTFData.end(), isBlockOutside) ||
+      std::any_of(data.polygonValueData.begin(), data.polygonValueData.end(), isPolygonOutside) ||
+      std::any_of(data.polygonVectorData.begin(), data.polygonVectorData.end(), isPolygonOutside))
+    this->blockOutsideOfFramePOC = poc;
+}
+
+bool StatisticsFileBase::openBinaryCache()
+{
+  QSettings settings;
+  if (!settings.value("StatisticsBinaryCache", false).toBool() ||
+      !this->binaryCache.open(this->file.getAbsoluteFilePath()))
+    return false;
+
+  this->fileSortedByPOC = this->binaryCache.isFileSortedByPOC();
+  this->maxPOC          = this->binaryCache.getMaxPOC();
+  this->binaryCacheReady.store(true);
+
+  for (const auto poc : this->binaryCache.getPOCs())
+    emit readPOC(poc);
+  this->parsingProgress = 100.0;
+  return true;
+}
+
+bool StatisticsFileBase::loadStatisticDataFromBinaryCache(StatisticsData &statisticsData,
+                                                          int             poc,
+                                                          int             typeID)
+{
+  if (!this->binaryCacheReady.load())
+    return false;
+
+  statisticsData.setFrameIndex(poc);
+
+  // No data in the cache means that there are no statistics for this poc/type in the file
+  FrameTypeData data;
+  if (this->binaryCache.loadFrameTypeData(poc, typeID, data))
+    this->checkBlocksInsideOfFrame(poc, data, statisticsData.getFrameSize());
+
+  std::unique_lock<std::mutex> lock(statisticsData.accessMutex);
+  statisticsData[typeID] = std::move(data);
+  return true;
+}
+
+void StatisticsFileBase::startWritingBinaryCache()
+{
+  QSettings settings;
+  this->writingBinaryCache = settings.value("StatisticsBinaryCache", false).toBool() &&
+                             this->binaryCache.startWriting(this->file.getAbsoluteFilePath());
+  this->binaryCachePendingPOC = -1;
+  this->binaryCachePendingData.clear();
+}
+
+FrameTypeData &StatisticsFileBase::getBinaryCacheFrameTypeData(int poc, int typeID)
+{
+  if (poc != this->binaryCachePendingPOC)
+  {
+    this->writePendingBinaryCacheData();
+    this->binaryCachePendingPOC = poc;
+  }
+  return this->binaryCachePendingData[typeID];
+}
+
+void StatisticsFileBase::finishWritingBinaryCache(bool parsingComplete)
+{
+  if (!this->writingBinaryCache)
+    return;
+  this->writingBinaryCache = false;
+
+  if (!parsingComplete)
+  {
+    this->binaryCachePendingData.clear();
+    this->binaryCache.abortWriting();
+    return;
+  }
+
+  this->writePendingBinaryCacheData();
+  if (this->binaryCache.finishWriting(this->fileSortedByPOC, this->maxPOC))
+    this->binaryCacheReady.store(true);
+}
+
+void StatisticsFileBase::writePendingBinaryCacheData()
+{
+  for (const auto &[typeID, data] : this->binaryCachePendingData)
+    this->binaryCache.addFrameTypeData(this->binaryCachePendingPOC, typeID, data);
+  this->binaryCachePendingData.clear();
+}
+
 InfoData StatisticsFileBase::getInfo() const
 {
   InfoData info("Statistics File info");
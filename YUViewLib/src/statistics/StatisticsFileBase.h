@@ -33,10 +33,14 @@
 #pragma once
 
 #include "filesource/FileSource.h"
+#include "statistics/StatisticsBinaryCache.h"
 #include "statistics/StatisticsData.h"
 
 #include <QObject>
 
+#include <atomic>
+#include <functional>
+
 namespace stats
 {
 
@@ -58,6 +62,7 @@ public:
   virtual void loadStatisticData(StatisticsData &statisticsData, int poc, int typeID) = 0;
 
   operator bool() const { return !this->error; };
+  QString getErrorMessage() const { return this->errorMessage; }
 
   // -1 if it could not be parser from the file
   virtual double getFramerate() const { return -1; }
@@ -69,6 +74,10 @@ public:
 
   InfoData getInfo() const;
 
+  // By default, files are indexed in parallel ranges of at least 32 MB with at most one range per
+  // core. A maxNrRanges of 0 selects the default number of ranges.
+  void setParallelIndexingLimits(int64_t minRangeSize, unsigned maxNrRanges);
+
 signals:
   // When readFrameAndTypePositionsFromFile is running it will emit whenever new data for this POC
   // is available. If this POC is currently drawn we can then update the view and show the
@@ -93,6 +102,71 @@ protected:
 
   double parsingProgress{};
   bool   abortParsingDestroy{};
+
+  // The statistics types as read from the header of the file. The background parser must use these
+  // instead of the types in the StatisticsData which may be changed at any time.
+  StatisticsTypesVec fileStatisticsTypes;
+
+  // --- Parallel indexing
+  // Split the file into ranges which all start at the beginning of a line so that the ranges can
+  // be indexed independently of each other. Small files are not split. While the binary cache is
+  // written, the file is not split either because the cache must be written in file order.
+  std::vector<Range<int64_t>> splitFileIntoLineRanges() const;
+  int64_t                     parallelIndexingMinRangeSize{32 * 1024 * 1024};
+  unsigned                    parallelIndexingMaxNrRanges{};
+  // Call parseLine(line, lineStartPos) for every line in the range (which must start at the
+  // beginning of a line). A last line without a newline at the end is ignored. If set,
+  // bufferParsed(pos) is called after every read buffer with the file position parsed so far.
+  // Returns false if reading failed or parsing was aborted.
+  using BufferParsedFunction = std::function<void(int64_t)>;
+  bool forEachLineInRange(Range<int64_t>                                       range,
+                          std::atomic_bool                                    &breakFunction,
+                          const std::function<void(const QString &, int64_t)> &parseLine,
+                          const BufferParsedFunction                          &bufferParsed = {});
+  // Call indexRange(i, bufferParsed) for all ranges in parallel and update the parsing progress.
+  // mergeRange(i, true) is called in the calling thread in the order of the ranges as soon as the
+  // range and all ranges before it are indexed. The first range is indexed in the calling thread
+  // and mergeRange(0, false) is called after every read buffer of it (if indexRange passes
+  // bufferParsed to forEachLineInRange). So the first POCs are available before the whole range is
+  // indexed. mergeRange must only merge what it did not merge before.
+  using IndexRangeFunction = std::function<void(size_t, const BufferParsedFunction &)>;
+  void indexRangesInParallel(const std::vector<Range<int64_t>>       &ranges,
+                             const IndexRangeFunction                &indexRange,
+                             const std::function<void(size_t, bool)> &mergeRange);
+
+  // Set the blockOutsideOfFramePOC if any block in the data is not within the frame.
+  void checkBlocksInsideOfFrame(int poc, const FrameTypeData &data, Size frameSize);
+
+  // --- Binary cache
+  // If enabled in the settings, all statistics are also written to a binary cache file (see
+  // StatisticsBinaryCache) while readFrameAndTypePositionsFromFile parses the file. If a valid
+  // cache file already exists, the text file does not have to be parsed at all and all statistics
+  // are loaded from the cache.
+
+  // Use the existing cache file if it is valid. Returns true if the cache is used. In this case,
+  // the text file does not have to be parsed.
+  bool openBinaryCache();
+  // Load the statistics from the cache (if it is ready). Returns false if the cache can not be used
+  // and the statistics must be parsed from the text file.
+  bool loadStatisticDataFromBinaryCache(StatisticsData &statisticsData, int poc, int typeID);
+
+  void startWritingBinaryCache();
+  bool isWritingBinaryCache() const { return this->writingBinaryCache; }
+  // Get the data that is written to the cache for the given poc/type. All data of the previous POC
+  // is written to the cache when a new POC starts. So the data of one POC/type must be continuous.
+  FrameTypeData &getBinaryCacheFrameTypeData(int poc, int typeID);
+  // Write the remaining data and finish the cache file. If parsing did not complete, the cache file
+  // is discarded.
+  void finishWritingBinaryCache(bool parsingComplete);
+
+private:
+  void writePendingBinaryCacheData();
+
+  StatisticsBinaryCache        binaryCache;
+  std::atomic_bool             binaryCacheReady{};
+  bool                         writingBinaryCache{};
+  int                          binaryCachePendingPOC{-1};
+  std::map<int, FrameTypeData> binaryCachePendingData;
 };
 
 } // namespace stats
\ No newline at end of file
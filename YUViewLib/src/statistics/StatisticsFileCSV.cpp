@@ -33,7 +33,9 @@
 #include "StatisticsFileCSV.h"
 
 #include <QTextStream>
+
 #include <iostream>
+#include <set>
 
 namespace stats
 {
@@ -41,11 +43,13 @@ namespace stats
 namespace
 {
 
-// The internal buffer for parsing the starting positions. The buffer must not be larger than 2GB
-// so that we can address all the positions in it with int (using such a large buffer is not a good
-// idea anyways)
-constexpr unsigned STAT_PARSING_BUFFER_SIZE = 1048576u;
-constexpr unsigned STAT_MAX_STRING_SIZE     = 1u << 28;
+// The position in the file where the data of a POC/type starts
+struct POCTypeStart
+{
+  int     poc{};
+  int     typeID{};
+  int64_t filePos{};
+};
 
 QStringList parseCSVLine(const QString &srcLine, char delimiter)
 {
@@ -55,12 +59,58 @@ QStringList parseCSVLine(const QString &srcLine, char delimiter)
   return line.split(delimiter);
 }
 
+bool typeHasVectorData(const StatisticsTypesVec &types, int typeID)
+{
+  auto it = std::find_if(
+      types.begin(), types.end(), [typeID](const StatisticsType &t) { return t.typeID == typeID; });
+  return it != types.end() && it->hasVectorData;
+}
+
+// Add the block value/vector/line from the given line of the file to the data.
+void addCSVLineToFrameTypeData(const QStringList &rowItemList,
+                               bool               hasVectorData,
+                               FrameTypeData     &data)
+{
+  int values[4] = {0};
+
+  values[0] = rowItemList[6].toInt();
+
+  bool vectorData = false;
+  bool lineData   = false; // or a vector specified by 2 points
+
+  if (rowItemList.count() > 7)
+  {
+    values[1]  = rowItemList[7].toInt();
+    vectorData = true;
+  }
+  if (rowItemList.count() > 8)
+  {
+    values[2]  = rowItemList[8].toInt();
+    values[3]  = rowItemList[9].toInt();
+    lineData   = true;
+    vectorData = false;
+  }
+
+  auto posX   = rowItemList[1].toInt();
+  auto posY   = rowItemList[2].toInt();
+  auto width  = rowItemList[3].toUInt();
+  auto height = rowItemList[4].toUInt();
+
+  if (vectorData && hasVectorData)
+    data.addBlockVector(posX, posY, width, height, values[0], values[1]);
+  else if (lineData && hasVectorData)
+    data.addLine(posX, posY, width, height, values[0], values[1], values[2], values[3]);
+  else
+    data.addBlockValue(posX, posY, width, height, values[0]);
+}
+
 } // namespace
 
 StatisticsFileCSV::StatisticsFileCSV(const QString &filename, StatisticsData &statisticsData)
     : StatisticsFileBase(filename)
 {
   this->readHeaderFromFile(statisticsData);
+  this->fileStatisticsTypes = statisticsData.getStatisticsTypes();
 }
 
 /** The background task that parses the file and extracts the exact file positions
@@ -75,145 +125,138 @@ void StatisticsFileCSV::readFrameAndTypePositionsFromFile(std::atomic_bool &brea
 {
   try
   {
-    // Open the file (again). Since this is a background process, we open the file again to
-    // not disturb any reading from not background code.
-    FileSource inputFile;
-    if (!inputFile.openFile(this->file.getAbsoluteFilePath()))
+    if (this->openBinaryCache())
       return;
 
-    // We perform reading using an input buffer
-    QByteArray inputBuffer;
-    bool       fileAtEnd      = false;
-    uint64_t   bufferStartPos = 0;
+    // The binary cache must be written in the order of the file. Otherwise, ranges of the file are
+    // indexed in parallel.
+    this->startWritingBinaryCache();
+    const auto ranges = this->splitFileIntoLineRanges();
+
+    // For each range, get the positions where a new POC/type starts
+    std::vector<std::vector<POCTypeStart>> rangeStarts(ranges.size());
+    std::vector<size_t>                    nrMergedStarts(ranges.size());
+    std::vector<char>                      rangeComplete(ranges.size());
+
+    auto indexRange = [&](size_t rangeIdx, const BufferParsedFunction &bufferParsed)
+    {
+      auto &starts    = rangeStarts[rangeIdx];
+      auto  parseLine = [&](const QString &line, int64_t lineStartPos)
+      {
+        // get components of this line
+        auto rowItemList = parseCSVLine(line, ';');
+
+        // ignore empty entries and headers
+        if (rowItemList[0].isEmpty() || rowItemList[0][0] == '%')
+          return;
+
+        // check for POC/type information
+        auto poc    = rowItemList[0].toInt();
+        auto typeID = rowItemList[5].toInt();
+
+        if (this->isWritingBinaryCache() && rowItemList.count() > 6)
+          addCSVLineToFrameTypeData(rowItemList,
+                                    typeHasVectorData(this->fileStatisticsTypes, typeID),
+                                    this->getBinaryCacheFrameTypeData(poc, typeID));
+
+        if (starts.empty() || starts.back().poc != poc || starts.back().typeID != typeID)
+          starts.push_back({poc, typeID, lineStartPos});
+      };
+      rangeComplete[rangeIdx] =
+          this->forEachLineInRange(ranges[rangeIdx], breakFunction, parseLine, bufferParsed);
+    };
 
-    QString  lineBuffer;
-    uint64_t lineBufferStartPos = 0;
-    int      lastPOC            = INT_INVALID;
-    int      lastType           = INT_INVALID;
-    bool     sortingFixed       = false;
+    int  lastPOC      = INT_INVALID;
+    int  lastType     = INT_INVALID;
+    bool sortingFixed = false;
+    bool complete     = true;
 
     this->parsingProgress = 0;
 
-    while (!fileAtEnd && !breakFunction.load() && !this->abortParsingDestroy)
+    auto mergeRange = [&](size_t rangeIdx, bool rangeIndexed)
     {
-      // Fill the buffer
-      auto bufferSize = inputFile.readBytes(inputBuffer, bufferStartPos, STAT_PARSING_BUFFER_SIZE);
-      if (bufferSize < 0)
-        return; // Error reading bytes from file
-      if (bufferSize < STAT_PARSING_BUFFER_SIZE)
-        // Less bytes than the maximum buffer size were read. The file is at the end.
-        // This is the last run of the loop.
-        fileAtEnd = true;
-      // a corrupted file may contain an arbitrary amount of non-\n symbols
-      // prevent lineBuffer overflow by dumping it for such cases
-      if (unsigned(lineBuffer.size()) > STAT_MAX_STRING_SIZE)
-        lineBuffer.clear(); // prevent an overflow here
-      for (size_t i = 0; i < size_t(bufferSize); i++)
+      if (rangeIndexed)
+        complete = complete && rangeComplete[rangeIdx];
+      if (!complete)
+        return;
+
+      const auto &starts = rangeStarts[rangeIdx];
+      for (auto i = nrMergedStarts[rangeIdx]; i < starts.size(); i++)
       {
-        // Search for '\n' newline characters
-        if (inputBuffer.at(int(i)) == 10)
+        const auto &[poc, typeID, lineStartPos] = starts[i];
+        if (lastType == -1 && lastPOC == -1)
+        {
+          // First POC/type line
+          this->pocTypeFileposMap[poc][typeID] = lineStartPos;
+          emit readPOCType(poc, typeID);
+
+          lastType = typeID;
+          lastPOC  = poc;
+
+          // update number of frames
+          if (poc > this->maxPOC)
+            this->maxPOC = poc;
+        }
+        else if (typeID != lastType && poc == lastPOC)
         {
-          // We found a newline character
-          if (lineBuffer.size() > 0)
+          // we found a new type but the POC stayed the same.
+          // This seems to be an interleaved file
+          // Check if we already collected a start position for this type
+          if (!sortingFixed)
           {
-            // Parse the previous line
-            // get components of this line
-            auto rowItemList = parseCSVLine(lineBuffer, ';');
-
-            // ignore empty entries and headers
-            if (!rowItemList[0].isEmpty() && rowItemList[0][0] != '%')
-            {
-              // check for POC/type information
-              auto poc    = rowItemList[0].toInt();
-              auto typeID = rowItemList[5].toInt();
-
-              if (lastType == -1 && lastPOC == -1)
-              {
-                // First POC/type line
-                this->pocTypeFileposMap[poc][typeID] = lineBufferStartPos;
-                emit readPOCType(poc, typeID);
-
-                lastType = typeID;
-                lastPOC  = poc;
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-              }
-              else if (typeID != lastType && poc == lastPOC)
-              {
-                // we found a new type but the POC stayed the same.
-                // This seems to be an interleaved file
-                // Check if we already collected a start position for this type
-                if (!sortingFixed)
-                {
-                  // we only check the first occurence of this, in a non-interleaved file
-                  // the above condition can be met and will reset fileSortedByPOC
-
-                  this->fileSortedByPOC = true;
-                  sortingFixed          = true;
-                }
-                lastType = typeID;
-                if (this->pocTypeFileposMap[poc].count(typeID) == 0)
-                {
-                  this->pocTypeFileposMap[poc][typeID] = lineBufferStartPos;
-                  emit readPOCType(poc, typeID);
-                }
-              }
-              else if (poc != lastPOC)
-              {
-                // this is apparently not sorted by POCs and we will not check it further
-                if (!sortingFixed)
-                  sortingFixed = true;
-
-                // We found a new POC
-                if (this->fileSortedByPOC)
-                {
-                  // There must not be a start position for any type with this POC already.
-                  if (this->pocTypeFileposMap.count(poc) > 0)
-                    throw "The data for each POC must be continuous in an interleaved statistics "
-                          "file";
-                }
-                else
-                {
-                  // There must not be a start position for this POC/type already.
-                  if (this->pocTypeFileposMap.count(poc) > 0 &&
-                      this->pocTypeFileposMap[poc].count(typeID) > 0)
-                    throw "The data for each typeID must be continuous in an non interleaved "
-                          "statistics file";
-                }
-
-                lastPOC  = poc;
-                lastType = typeID;
-
-                this->pocTypeFileposMap[poc][typeID] = lineBufferStartPos;
-                emit readPOCType(poc, typeID);
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-
-                // Update percent of file parsed
-                if (const auto fileSize = inputFile.getFileSize())
-                  this->parsingProgress = (static_cast<double>(lineBufferStartPos) * 100 /
-                                           static_cast<double>(*fileSize));
-              }
-            }
-          }
+            // we only check the first occurence of this, in a non-interleaved file
+            // the above condition can be met and will reset fileSortedByPOC
 
-          lineBuffer.clear();
-          lineBufferStartPos = bufferStartPos + i + 1;
+            this->fileSortedByPOC = true;
+            sortingFixed          = true;
+          }
+          lastType = typeID;
+          if (this->pocTypeFileposMap[poc].count(typeID) == 0)
+          {
+            this->pocTypeFileposMap[poc][typeID] = lineStartPos;
+            emit readPOCType(poc, typeID);
+          }
         }
-        else
+        else if (poc != lastPOC)
         {
-          // No newline character found
-          lineBuffer.append(inputBuffer.at(int(i)));
+          // this is apparently not sorted by POCs and we will not check it further
+          if (!sortingFixed)
+            sortingFixed = true;
+
+          // We found a new POC
+          if (this->fileSortedByPOC)
+          {
+            // There must not be a start position for any type with this POC already.
+            if (this->pocTypeFileposMap.count(poc) > 0)
+              throw "The data for each POC must be continuous in an interleaved statistics "
+                    "file";
+          }
+          else
+          {
+            // There must not be a start position for this POC/type already.
+            if (this->pocTypeFileposMap.count(poc) > 0 &&
+                this->pocTypeFileposMap[poc].count(typeID) > 0)
+              throw "The data for each typeID must be continuous in an non interleaved "
+                    "statistics file";
+          }
+
+          lastPOC  = poc;
+          lastType = typeID;
+
+          this->pocTypeFileposMap[poc][typeID] = lineStartPos;
+          emit readPOCType(poc, typeID);
+
+          // update number of frames
+          if (poc > this->maxPOC)
+            this->maxPOC = poc;
         }
       }
+      nrMergedStarts[rangeIdx] = starts.size();
+    };
 
-      bufferStartPos += bufferSize;
-    }
+    this->indexRangesInParallel(ranges, indexRange, mergeRange);
 
+    this->finishWritingBinaryCache(complete);
     this->parsingProgress = 100.0;
   }
   catch (const char *str)
@@ -221,12 +264,14 @@ void StatisticsFileCSV::readFrameAndTypePositionsFromFile(std::atomic_bool &brea
     std::cerr << "Error while parsing meta data: " << str << "\n";
     this->errorMessage = QString("Error while parsing meta data: ") + QString(str);
     this->error        = true;
+    this->finishWritingBinaryCache(false);
   }
   catch (const std::exception &ex)
   {
     std::cerr << "Error while parsing:" << ex.what() << "\n";
     this->errorMessage = QString("Error while parsing: ") + QString(ex.what());
     this->error        = true;
+    this->finishWritingBinaryCache(false);
   }
 }
 
@@ -235,6 +280,9 @@ void StatisticsFileCSV::loadStatisticData(StatisticsData &statisticsData, int po
   if (!this->file.isOk())
     return;
 
+  if (this->loadStatisticDataFromBinaryCache(statisticsData, poc, typeID))
+    return;
+
   try
   {
     statisticsData.setFrameIndex(poc);
@@ -263,6 +311,7 @@ void StatisticsFileCSV::loadStatisticData(StatisticsData &statisticsData, int po
     QTextStream in(this->file.getQFile());
     in.seek(startPos);
 
+    std::set<int> loadedTypeIDs;
     while (!in.atEnd())
     {
       // read one line
@@ -282,52 +331,19 @@ void StatisticsFileCSV::loadStatisticData(StatisticsData &statisticsData, int po
       if (!this->fileSortedByPOC && type != typeID)
         break;
 
-      int values[4] = {0};
-
-      values[0] = rowItemList[6].toInt();
-
-      bool vectorData = false;
-      bool lineData   = false; // or a vector specified by 2 points
-
-      if (rowItemList.count() > 7)
-      {
-        values[1]  = rowItemList[7].toInt();
-        vectorData = true;
-      }
-      if (rowItemList.count() > 8)
-      {
-        values[2]  = rowItemList[8].toInt();
-        values[3]  = rowItemList[9].toInt();
-        lineData   = true;
-        vectorData = false;
-      }
-
-      auto posX   = rowItemList[1].toInt();
-      auto posY   = rowItemList[2].toInt();
-      auto width  = rowItemList[3].toUInt();
-      auto height = rowItemList[4].toUInt();
-
-      // Check if block is within the image range
-      if (this->blockOutsideOfFramePOC == -1 &&
-          (posX + int(width) > int(statisticsData.getFrameSize().width) ||
-           posY + int(height) > int(statisticsData.getFrameSize().height)))
-        // Block not in image. Warn about this.
-        this->blockOutsideOfFramePOC = poc;
-
       auto &statTypes = statisticsData.getStatisticsTypes();
       auto  statIt    = std::find_if(statTypes.begin(),
                                  statTypes.end(),
                                  [type](StatisticsType &t) { return t.typeID == type; });
       Q_ASSERT_X(statIt != statTypes.end(), Q_FUNC_INFO, "Stat type not found.");
 
-      if (vectorData && statIt->hasVectorData)
-        statisticsData[type].addBlockVector(posX, posY, width, height, values[0], values[1]);
-      else if (lineData && statIt->hasVectorData)
-        statisticsData[type].addLine(
-            posX, posY, width, height, values[0], values[1], values[2], values[3]);
-      else
-        statisticsData[type].addBlockValue(posX, posY, width, height, values[0]);
+      addCSVLineToFrameTypeData(rowItemList, statIt->hasVectorData, statisticsData[type]);
+      loadedTypeIDs.insert(type);
     }
+
+    for (const auto loadedTypeID : loadedTypeIDs)
+      this->checkBlocksInsideOfFrame(
+          poc, statisticsData[loadedTypeID], statisticsData.getFrameSize());
   }
   catch (const char *str)
   {
@@ -36,20 +36,182 @@
 #include <QTextStream>
 
 #include <iostream>
+#include <map>
 
 namespace stats
 {
 
-// The internal buffer for parsing the starting positions. The buffer must not be larger than 2GB
-// so that we can address all the positions in it with int (using such a large buffer is not a good
-// idea anyways)
-constexpr unsigned STAT_PARSING_BUFFER_SIZE = 1048576u;
-constexpr unsigned STAT_MAX_STRING_SIZE     = 1u << 28;
+namespace
+{
+
+// The position in the file where the data of a POC starts
+struct POCStart
+{
+  int     poc{};
+  int64_t filePos{};
+};
+
+// Parses the statistic from a "BlockStat" line of a known type.
+class BlockStatParser
+{
+public:
+  BlockStatParser()
+      // for extracting scalar value statistics, need to match:
+      // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
+      : scalarRegex("POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] "
+                    "*\\w+=([0-9\\-]+)"),
+        // for extracting vector value statistics, need to match:
+        // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
+        vectorRegex("POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x "
+                    "*([0-9]+)\\] *\\w+={ *([0-9\\-]+), *([0-9\\-]+)}"),
+        // for extracting affine transform value statistics, need to match:
+        // BlockStat: POC 2 @( 192,  96) [64x32] AffineMVL0={-324,-116,-276,-116,-324, -92}
+        affineTFRegex("POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] "
+                      "*\\w+={ *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), "
+                      "*([0-9\\-]+), *([0-9\\-]+)}"),
+        // for extracting scalar polygon  statistics, need to match:
+        // BlockStat: POC 2 @[(505, 384)--(511, 384)--(511, 415)--] GeoPUInterIntraFlag=0
+        // BlockStat: POC 2 @[(416, 448)--(447, 448)--(447, 478)--(416, 463)--] GeoPUFlag=0
+        // will capture 3-5 points. other polygons are not supported
+        scalarPolygonRegex(
+            "POC ([0-9]+) @\\[((?:\\( *[0-9]+, *[0-9]+\\)--){3,5})\\] *\\w+=([0-9\\-]+)"),
+        // for extracting vector polygon statistics:
+        vectorPolygonRegex("POC ([0-9]+) @\\[((?:\\( *[0-9]+, *[0-9]+\\)--){3,5})\\] "
+                           "*\\w+={ *([0-9\\-]+), *([0-9\\-]+)}"),
+        // for extracting the partitioning line, we extract
+        // BlockStat: POC 2 @( 192,  96) [64x32] Line={0,0,31,31}
+        lineRegex("POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] "
+                  "*\\w+={ *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+)}"),
+        cornerRegex("\\( *([0-9]+), *([0-9]+)\\)")
+  {
+  }
+
+  // Add the statistic from the line to the data. Returns false if the line could not be parsed.
+  bool parseLine(const QString &line, const StatisticsType &type, FrameTypeData &data) const;
+
+private:
+  const QRegularExpression scalarRegex;
+  const QRegularExpression vectorRegex;
+  const QRegularExpression affineTFRegex;
+  const QRegularExpression scalarPolygonRegex;
+  const QRegularExpression vectorPolygonRegex;
+  const QRegularExpression lineRegex;
+  const QRegularExpression cornerRegex;
+};
+
+bool BlockStatParser::parseLine(const QString        &line,
+                                const StatisticsType &type,
+                                FrameTypeData        &data) const
+{
+  QRegularExpressionMatch statisitcMatch;
+  // extract statistics info
+  // try block types
+  if (type.isPolygon == false)
+  {
+    if (type.hasValueData)
+      statisitcMatch = scalarRegex.match(line);
+    else if (type.hasVectorData)
+    {
+      statisitcMatch = vectorRegex.match(line);
+      if (!statisitcMatch.hasMatch())
+        statisitcMatch = lineRegex.match(line);
+    }
+    else if (type.hasAffineTFData)
+      statisitcMatch = affineTFRegex.match(line);
+  }
+  else
+  // try polygons
+  {
+    if (type.hasValueData)
+      statisitcMatch = scalarPolygonRegex.match(line);
+    else if (type.hasVectorData)
+      statisitcMatch = vectorPolygonRegex.match(line);
+  }
+  if (!statisitcMatch.hasMatch())
+    return false;
+
+  // useful for debugging:
+  //        QStringList all_captured = statisitcMatch.capturedTexts();
+
+  // process block statistics
+  if (type.isPolygon == false)
+  {
+    auto posX   = statisitcMatch.captured(2).toInt();
+    auto posY   = statisitcMatch.captured(3).toInt();
+    auto width  = statisitcMatch.captured(4).toUInt();
+    auto height = statisitcMatch.captured(5).toUInt();
+
+    if (type.hasVectorData)
+    {
+      auto vecX = statisitcMatch.captured(6).toInt();
+      auto vecY = statisitcMatch.captured(7).toInt();
+      if (statisitcMatch.lastCapturedIndex() > 7)
+      {
+        auto vecX1 = statisitcMatch.captured(8).toInt();
+        auto vecY1 = statisitcMatch.captured(9).toInt();
+        data.addLine(posX, posY, width, height, vecX, vecY, vecX1, vecY1);
+      }
+      else
+      {
+        data.addBlockVector(posX, posY, width, height, vecX, vecY);
+      }
+    }
+    else if (type.hasAffineTFData)
+    {
+      auto vecX0 = statisitcMatch.captured(6).toInt();
+      auto vecY0 = statisitcMatch.captured(7).toInt();
+      auto vecX1 = statisitcMatch.captured(8).toInt();
+      auto vecY1 = statisitcMatch.captured(9).toInt();
+      auto vecX2 = statisitcMatch.captured(10).toInt();
+      auto vecY2 = statisitcMatch.captured(11).toInt();
+      data.addBlockAffineTF(posX, posY, width, height, vecX0, vecY0, vecX1, vecY1, vecX2, vecY2);
+    }
+    else
+    {
+      auto scalar = statisitcMatch.captured(6).toInt();
+      data.addBlockValue(posX, posY, width, height, scalar);
+    }
+  }
+  else
+  // process polygon statistics
+  {
+    auto           corners    = statisitcMatch.captured(2);
+    auto           cornerList = corners.split("--");
+    stats::Polygon points;
+    for (const auto &corner : cornerList)
+    {
+      auto cornerMatch = cornerRegex.match(corner);
+      if (cornerMatch.hasMatch())
+      {
+        auto x = cornerMatch.captured(1).toInt();
+        auto y = cornerMatch.captured(2).toInt();
+        points.push_back({x, y});
+      }
+    }
+
+    if (type.hasVectorData)
+    {
+      auto vecX = statisitcMatch.captured(3).toInt();
+      auto vecY = statisitcMatch.captured(4).toInt();
+      data.addPolygonVector(points, vecX, vecY);
+    }
+    else if (type.hasValueData)
+    {
+      auto scalar = statisitcMatch.captured(3).toInt();
+      data.addPolygonValue(points, scalar);
+    }
+  }
+
+  return true;
+}
+
+} // namespace
 
 StatisticsFileVTMBMS::StatisticsFileVTMBMS(const QString &filename, StatisticsData &statisticsData)
     : StatisticsFileBase(filename)
 {
   this->readHeaderFromFile(statisticsData);
+  this->fileStatisticsTypes = statisticsData.getStatisticsTypes();
 }
 
 /** The background task that parses the file and extracts the exact file positions
@@ -64,105 +226,94 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
 {
   try
   {
-    // Open the file (again). Since this is a background process, we open the file again to
-    // not disturb any reading from not background code.
-    FileSource inputFile;
-    if (!inputFile.openFile(this->file.getAbsoluteFilePath()))
+    if (this->openBinaryCache())
       return;
 
-    // We perform reading using an input buffer
-    QByteArray inputBuffer;
-    bool       fileAtEnd      = false;
-    uint64_t   bufferStartPos = 0;
+    // The binary cache must be written in the order of the file. Otherwise, ranges of the file are
+    // indexed in parallel.
+    this->startWritingBinaryCache();
+    const auto ranges = this->splitFileIntoLineRanges();
+
+    // If the binary cache is written, all statistics are parsed right away
+    std::map<QString, const StatisticsType *> typesByName;
+    for (const auto &type : this->fileStatisticsTypes)
+      typesByName[type.typeName] = &type;
 
-    QString  lineBuffer;
-    uint64_t lineBufferStartPos = 0;
-    int      lastPOC            = INT_INVALID;
-    bool     sortingFixed       = false;
+    // For each range, get the positions where a new POC starts
+    std::vector<std::vector<POCStart>> rangeStarts(ranges.size());
+    std::vector<size_t>                nrMergedStarts(ranges.size());
+    std::vector<char>                  rangeComplete(ranges.size());
 
-    while (!fileAtEnd && !breakFunction.load() && !this->abortParsingDestroy)
+    auto indexRange = [&](size_t rangeIdx, const BufferParsedFunction &bufferParsed)
     {
-      // Fill the buffer
-      auto bufferSize = inputFile.readBytes(inputBuffer, bufferStartPos, STAT_PARSING_BUFFER_SIZE);
-      if (bufferSize < 0)
-        throw "Error reading bytes";
-      if (bufferSize < STAT_PARSING_BUFFER_SIZE)
-        // Less bytes than the maximum buffer size were read. The file is at the end.
-        // This is the last run of the loop.
-        fileAtEnd = true;
-      // a corrupted file may contain an arbitrary amount of non-\n symbols
-      // prevent lineBuffer overflow by dumping it for such cases
-      if (unsigned(lineBuffer.size()) > STAT_MAX_STRING_SIZE)
-        lineBuffer.clear(); // prevent an overflow here
-      for (size_t i = 0; i < size_t(bufferSize); i++)
-      {
-        // Search for '\n' newline characters
-        if (inputBuffer.at(int(i)) == 10)
-        {
-          // We found a newline character
-          if (lineBuffer.size() > 0)
-          {
-            // Parse the previous line
-            // get components of this line
-            // get poc using regular expression
-            // need to match this:
-            // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
-            // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
-            QRegularExpression pocRegex("BlockStat: POC ([0-9]+)");
-            auto               match = pocRegex.match(lineBuffer);
-            // ignore not matching lines
-            if (match.hasMatch())
-            {
-              auto poc = match.captured(1).toInt();
-
-              if (lastPOC == -1)
-              {
-                // First POC
-                this->pocStartList[poc] = lineBufferStartPos;
-                emit readPOC(poc);
-
-                lastPOC = poc;
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-              }
-              else if (poc != lastPOC)
-              {
-                // this is apparently not sorted by POCs and we will not check it further
-                if (!sortingFixed)
-                  sortingFixed = true;
-
-                lastPOC                 = poc;
-                this->pocStartList[poc] = lineBufferStartPos;
-                emit readPOC(poc);
-
-                // update number of frames
-                if (poc > this->maxPOC)
-                  this->maxPOC = poc;
-
-                // Update percent of file parsed
-                if (const auto fileSize = inputFile.getFileSize())
-                  this->parsingProgress = (static_cast<double>(lineBufferStartPos) * 100 /
-                                           static_cast<double>(*fileSize));
-              }
-            }
-          }
+      BlockStatParser    parser;
+      QRegularExpression pocRegex("BlockStat: POC ([0-9]+)");
+      QRegularExpression typeNameRegex(" (\\w+)=");
 
-          lineBuffer.clear();
-          lineBufferStartPos = bufferStartPos + i + 1;
-        }
-        else
+      auto &starts    = rangeStarts[rangeIdx];
+      auto  parseLine = [&](const QString &line, int64_t lineStartPos)
+      {
+        // get poc using regular expression
+        // need to match this:
+        // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
+        // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
+        auto match = pocRegex.match(line);
+        // ignore not matching lines
+        if (!match.hasMatch())
+          return;
+
+        auto poc = match.captured(1).toInt();
+
+        if (this->isWritingBinaryCache())
         {
-          // No newline character found
-          lineBuffer.append(inputBuffer.at(int(i)));
+          auto typeNameMatch = typeNameRegex.match(line);
+          auto type          = typesByName.find(typeNameMatch.captured(1));
+          if (typeNameMatch.hasMatch() && type != typesByName.end())
+            parser.parseLine(
+                line, *type->second, this->getBinaryCacheFrameTypeData(poc, type->second->typeID));
         }
+
+        if (starts.empty() || starts.back().poc != poc)
+          starts.push_back({poc, lineStartPos});
+      };
+      rangeComplete[rangeIdx] =
+          this->forEachLineInRange(ranges[rangeIdx], breakFunction, parseLine, bufferParsed);
+    };
+
+    bool complete = true;
+    // The last POC of the previous range. If a POC continues in the next range, it does not start
+    // again there.
+    int lastPOC = -1;
+
+    auto mergeRange = [&](size_t rangeIdx, bool rangeIndexed)
+    {
+      if (rangeIndexed)
+        complete = complete && rangeComplete[rangeIdx];
+      if (!complete)
+        return;
+
+      const auto &starts = rangeStarts[rangeIdx];
+      for (auto i = nrMergedStarts[rangeIdx]; i < starts.size(); i++)
+      {
+        const auto &[poc, lineStartPos] = starts[i];
+        if (poc == lastPOC)
+          continue;
+        lastPOC = poc;
+
+        this->pocStartList[poc] = lineStartPos;
+        emit readPOC(poc);
+
+        // update number of frames
+        if (poc > this->maxPOC)
+          this->maxPOC = poc;
       }
+      nrMergedStarts[rangeIdx] = starts.size();
+    };
 
-      bufferStartPos += bufferSize;
-    }
+    this->indexRangesInParallel(ranges, indexRange, mergeRange);
 
     // Parsing complete
+    this->finishWritingBinaryCache(complete);
     this->parsingProgress = 100.0;
   }
   catch (const char *str)
@@ -170,6 +321,7 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
     std::cerr << "Error while parsing meta data: " << str << "\n";
     this->errorMessage = QString("Error while parsing meta data: ") + QString(str);
     this->error        = true;
+    this->finishWritingBinaryCache(false);
     return;
   }
   catch (const std::exception &ex)
@@ -177,6 +329,7 @@ void StatisticsFileVTMBMS::readFrameAndTypePositionsFromFile(std::atomic_bool &b
     std::cerr << "Error while parsing:" << ex.what() << "\n";
     this->errorMessage = QString("Error while parsing: ") + QString(ex.what());
     this->error        = true;
+    this->finishWritingBinaryCache(false);
     return;
   }
 
@@ -188,6 +341,9 @@ void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int
   if (!this->file.isOk())
     return;
 
+  if (this->loadStatisticDataFromBinaryCache(statisticsData, poc, typeID))
+    return;
+
   try
   {
     statisticsData.setFrameIndex(poc);
@@ -216,35 +372,7 @@ void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int
     Q_ASSERT_X(statIt != statTypes.end(), Q_FUNC_INFO, "Stat type not found.");
     QRegularExpression typeRegex(" " + statIt->typeName + "="); // for catching lines of the type
 
-    // for extracting scalar value statistics, need to match:
-    // BlockStat: POC 1 @( 112,  88) [ 8x 8] PredMode=0
-    QRegularExpression scalarRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+=([0-9\\-]+)");
-    // for extracting vector value statistics, need to match:
-    // BlockStat: POC 1 @( 120,  80) [ 8x 8] MVL0={ -24,  -2}
-    QRegularExpression vectorRegex("POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x "
-                                   "*([0-9]+)\\] *\\w+={ *([0-9\\-]+), *([0-9\\-]+)}");
-    // for extracting affine transform value statistics, need to match:
-    // BlockStat: POC 2 @( 192,  96) [64x32] AffineMVL0={-324,-116,-276,-116,-324, -92}
-    QRegularExpression affineTFRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+={ "
-        "*([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+)}");
-    // for extracting scalar polygon  statistics, need to match:
-    // BlockStat: POC 2 @[(505, 384)--(511, 384)--(511, 415)--] GeoPUInterIntraFlag=0
-    // BlockStat: POC 2 @[(416, 448)--(447, 448)--(447, 478)--(416, 463)--] GeoPUInterIntraFlag=0
-    // will capture 3-5 points. other polygons are not supported
-    QRegularExpression scalarPolygonRegex(
-        "POC ([0-9]+) @\\[((?:\\( *[0-9]+, *[0-9]+\\)--){3,5})\\] *\\w+=([0-9\\-]+)");
-    // for extracting vector polygon statistics:
-    QRegularExpression vectorPolygonRegex(
-        "POC ([0-9]+) @\\[((?:\\( *[0-9]+, *[0-9]+\\)--){3,5})\\] *\\w+={ *([0-9\\-]+), "
-        "*([0-9\\-]+)}");
-    // for extracting the partitioning line, we extract
-    // BlockStat: POC 2 @( 192,  96) [64x32] Line={0,0,31,31}
-    QRegularExpression lineRegex(
-        "POC ([0-9]+) @\\( *([0-9]+), *([0-9]+)\\) *\\[ *([0-9]+)x *([0-9]+)\\] *\\w+={ "
-        "*([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+), *([0-9\\-]+)}");
-
+    BlockStatParser parser;
     while (!in.atEnd())
     {
       // read one line
@@ -259,134 +387,8 @@ void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int
 
         // filter lines of different types
         auto typeMatch = typeRegex.match(aLine);
-        if (typeMatch.hasMatch())
-        {
-          int      posX, posY, scalar, vecX, vecY;
-          unsigned width, height;
-
-          QRegularExpressionMatch statisitcMatch;
-          // extract statistics info
-          // try block types
-          if (statIt->isPolygon == false)
-          {
-            if (statIt->hasValueData)
-              statisitcMatch = scalarRegex.match(aLine);
-            else if (statIt->hasVectorData)
-            {
-              statisitcMatch = vectorRegex.match(aLine);
-              if (!statisitcMatch.hasMatch())
-                statisitcMatch = lineRegex.match(aLine);
-            }
-            else if (statIt->hasAffineTFData)
-              statisitcMatch = affineTFRegex.match(aLine);
-          }
-          else
-          // try polygons
-          {
-            if (statIt->hasValueData)
-              statisitcMatch = scalarPolygonRegex.match(aLine);
-            else if (statIt->hasVectorData)
-              statisitcMatch = vectorPolygonRegex.match(aLine);
-          }
-          if (!statisitcMatch.hasMatch())
-          {
-            this->errorMessage = QString("Error while parsing statistic: ") + QString(aLine);
-            continue;
-          }
-
-          // useful for debugging:
-          //        QStringList all_captured = statisitcMatch.capturedTexts();
-
-          pocRow = statisitcMatch.captured(1).toInt();
-          width  = statisitcMatch.captured(4).toUInt();
-          height = statisitcMatch.captured(5).toUInt();
-          // if there is a new POC, we are done here!
-          if (poc != pocRow)
-            break;
-
-          // process block statistics
-          if (statIt->isPolygon == false)
-          {
-            posX = statisitcMatch.captured(2).toInt();
-            posY = statisitcMatch.captured(3).toInt();
-
-            // Check if block is within the image range
-            if (blockOutsideOfFramePOC == -1 &&
-                (posX + int(width) > int(statisticsData.getFrameSize().width) ||
-                 posY + int(height) > int(statisticsData.getFrameSize().height)))
-              // Block not in image. Warn about this.
-              blockOutsideOfFramePOC = poc;
-
-            if (statIt->hasVectorData)
-            {
-              vecX = statisitcMatch.captured(6).toInt();
-              vecY = statisitcMatch.captured(7).toInt();
-              if (statisitcMatch.lastCapturedIndex() > 7)
-              {
-                auto vecX1 = statisitcMatch.captured(8).toInt();
-                auto vecY1 = statisitcMatch.captured(9).toInt();
-                statisticsData[typeID].addLine(posX, posY, width, height, vecX, vecY, vecX1, vecY1);
-              }
-              else
-              {
-                statisticsData[typeID].addBlockVector(posX, posY, width, height, vecX, vecY);
-              }
-            }
-            else if (statIt->hasAffineTFData)
-            {
-              auto vecX0 = statisitcMatch.captured(6).toInt();
-              auto vecY0 = statisitcMatch.captured(7).toInt();
-              auto vecX1 = statisitcMatch.captured(8).toInt();
-              auto vecY1 = statisitcMatch.captured(9).toInt();
-              auto vecX2 = statisitcMatch.captured(10).toInt();
-              auto vecY2 = statisitcMatch.captured(11).toInt();
-              statisticsData[typeID].addBlockAffineTF(
-                  posX, posY, width, height, vecX0, vecY0, vecX1, vecY1, vecX2, vecY2);
-            }
-            else
-            {
-              scalar = statisitcMatch.captured(6).toInt();
-              statisticsData[typeID].addBlockValue(posX, posY, width, height, scalar);
-            }
-          }
-          else
-          // process polygon statistics
-          {
-            auto               corners    = statisitcMatch.captured(2);
-            auto               cornerList = corners.split("--");
-            QRegularExpression cornerRegex("\\( *([0-9]+), *([0-9]+)\\)");
-            stats::Polygon     points;
-            for (const auto &corner : cornerList)
-            {
-              auto cornerMatch = cornerRegex.match(corner);
-              if (cornerMatch.hasMatch())
-              {
-                auto x = cornerMatch.captured(1).toInt();
-                auto y = cornerMatch.captured(2).toInt();
-                points.push_back({x, y});
-
-                // Check if polygon is within the image range
-                if (this->blockOutsideOfFramePOC == -1 &&
-                    (x + width > statisticsData.getFrameSize().width ||
-                     y + height > statisticsData.getFrameSize().height))
-                  // Block not in image. Warn about this.
-                  this->blockOutsideOfFramePOC = poc;
-              }
-            }
-
-            if (statIt->hasVectorData)
-            {
-              vecX = statisitcMatch.captured(3).toInt();
-              vecY = statisitcMatch.captured(4).toInt();
-              statisticsData[typeID].addPolygonVector(points, vecX, vecY);
-            }
-            else if (statIt->hasValueData)
-            {
-              scalar = statisitcMatch.captured(3).toInt();
-              statisticsData[typeID].addPolygonValue(points, scalar);
-            }
-          }
-        }
+        if (typeMatch.hasMatch() && !parser.parseLine(aLine, *statIt, statisticsData[typeID]))
+          this->errorMessage = QString("Error while parsing statistic: ") + QString(aLine);
       }
     }
 
@@ -397,6 +399,8 @@ void StatisticsFileVTMBMS::loadStatisticData(StatisticsData &statisticsData, int
       return;
     }
 
+    this->checkBlocksInsideOfFrame(poc, statisticsData[typeID], statisticsData.getFrameSize());
+
   } // try
   catch (const char *str)
   {
@@ -0,0 +1,117 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StatisticsFrameCache.h"
+
+#include <algorithm>
+
+namespace stats
+{
+
+void StatisticsFrameCache::add(int frameIndex, FrameTypeDataMap &&data)
+{
+  int64_t frameBytes = 0;
+  for (const auto &typeData : data)
+    frameBytes += int64_t(typeData.second.getMemoryUsage());
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  auto                         it = this->frames.find(frameIndex);
+  if (it != this->frames.end())
+  {
+    this->nrBytes -= it->second.nrBytes;
+    this->frames.erase(it);
+  }
+  this->frames[frameIndex] = {std::move(data), frameBytes};
+  this->nrBytes += frameBytes;
+}
+
+std::optional<FrameTypeDataMap> StatisticsFrameCache::get(int frameIndex) const
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  auto                         it = this->frames.find(frameIndex);
+  if (it == this->frames.end())
+    return {};
+  return it->second.data;
+}
+
+bool StatisticsFrameCache::contains(int frameIndex) const
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  return this->frames.count(frameIndex) > 0;
+}
+
+void StatisticsFrameCache::remove(int frameIndex)
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  auto                         it = this->frames.find(frameIndex);
+  if (it == this->frames.end())
+    return;
+  this->nrBytes -= it->second.nrBytes;
+  this->frames.erase(it);
+}
+
+void StatisticsFrameCache::clear()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->frames.clear();
+  this->nrBytes = 0;
+}
+
+size_t StatisticsFrameCache::getNrFrames() const
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  return this->frames.size();
+}
+
+std::vector<int> StatisticsFrameCache::getFrameIndices() const
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  std::vector<int>             frameIndices;
+  frameIndices.reserve(this->frames.size());
+  for (const auto &frame : this->frames)
+    frameIndices.push_back(frame.first);
+  return frameIndices;
+}
+
+int64_t StatisticsFrameCache::getNrBytes() const
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  return this->nrBytes;
+}
+
+unsigned StatisticsFrameCache::estimateFrameSize(Size frameSize, size_t nrTypes)
+{
+  const auto nrBlocks = std::max(size_t(frameSize.width) * frameSize.height / 64, size_t(1));
+  return unsigned(nrBlocks * nrTypes * sizeof(StatsItemVector));
+}
+
+} // namespace stats
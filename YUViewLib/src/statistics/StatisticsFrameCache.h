@@ -0,0 +1,82 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FrameTypeData.h"
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace stats
+{
+
+// A cache for the statistics of multiple frames. Decoders that decode frames in the background
+// (for caching) can put the statistics of the frames in here so that the frames don't have to be
+// decoded again when the statistics are drawn. Statistics files use it to load the statistics of
+// the frames ahead of the playhead in the background. All functions are thread-safe.
+class StatisticsFrameCache
+{
+public:
+  StatisticsFrameCache() = default;
+
+  void                            add(int frameIndex, FrameTypeDataMap &&data);
+  std::optional<FrameTypeDataMap> get(int frameIndex) const;
+  bool                            contains(int frameIndex) const;
+  void                            remove(int frameIndex);
+  void                            clear();
+
+  size_t           getNrFrames() const;
+  std::vector<int> getFrameIndices() const;
+  int64_t          getNrBytes() const;
+
+  // A fixed estimate of the number of bytes that the statistics of one frame use. It assumes one
+  // vector for every 8x8 block for every cached type, so only the types that are actually cached
+  // (rendered) should be counted. This does not change while frames are cached, so it can be used
+  // for the memory limit of the cache.
+  static unsigned estimateFrameSize(Size frameSize, size_t nrTypes);
+
+private:
+  struct CachedFrame
+  {
+    FrameTypeDataMap data;
+    int64_t          nrBytes{};
+  };
+
+  mutable std::mutex         mutex;
+  std::map<int, CachedFrame> frames;
+  int64_t                    nrBytes{};
+};
+
+} // namespace stats
@@ -0,0 +1,198 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StatisticsSpatialIndex.h"
+
+#include <common/Functions.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace stats
+{
+
+namespace
+{
+
+// The cells are squares with a side of a few (average) blocks
+constexpr int BLOCKS_PER_CELL_SIDE = 4;
+constexpr int MIN_CELL_SIZE        = 16;
+constexpr int MAX_CELL_SIZE        = 256;
+
+// Blocks without a size still occupy the pixel at their position
+template <typename Item> int getBlockWidth(const Item &item)
+{
+  return std::max(int(item.size[0]), 1);
+}
+
+template <typename Item> int getBlockHeight(const Item &item)
+{
+  return std::max(int(item.size[1]), 1);
+}
+
+} // namespace
+
+template <typename Item> void BlockGrid::build(const std::vector<Item> &items)
+{
+  *this          = {};
+  this->nrBlocks = items.size();
+  if (items.empty())
+    return;
+
+  int64_t sumArea{};
+  int     width{};
+  int     height{};
+  for (const auto &item : items)
+  {
+    sumArea += int64_t(getBlockWidth(item)) * getBlockHeight(item);
+    width  = std::max(width, item.pos[0] + getBlockWidth(item));
+    height = std::max(height, item.pos[1] + getBlockHeight(item));
+  }
+
+  const auto averageBlockSide = int(std::sqrt(double(sumArea) / double(items.size())));
+  this->cellSize =
+      functions::clip(averageBlockSide * BLOCKS_PER_CELL_SIDE, MIN_CELL_SIZE, MAX_CELL_SIZE);
+  this->nrCellsX = (width + this->cellSize - 1) / this->cellSize;
+  this->nrCellsY = (height + this->cellSize - 1) / this->cellSize;
+
+  auto forEachCellOfBlock = [this](const Item &item, auto function) {
+    const auto cellXStart = item.pos[0] / this->cellSize;
+    const auto cellXEnd   = (item.pos[0] + getBlockWidth(item) - 1) / this->cellSize;
+    const auto cellYStart = item.pos[1] / this->cellSize;
+    const auto cellYEnd   = (item.pos[1] + getBlockHeight(item) - 1) / this->cellSize;
+    for (int cellY = cellYStart; cellY <= cellYEnd; cellY++)
+      for (int cellX = cellXStart; cellX <= cellXEnd; cellX++)
+        function(cellY * this->nrCellsX + cellX);
+  };
+
+  // First count the blocks of every cell. Then the block indices are written to their place. This
+  // keeps the indices of every cell in ascending order.
+  this->cellStart.assign(size_t(this->nrCellsX) * this->nrCellsY + 1, 0);
+  for (const auto &item : items)
+    forEachCellOfBlock(item, [this](int cell) { this->cellStart[cell + 1]++; });
+  for (size_t i = 1; i < this->cellStart.size(); i++)
+    this->cellStart[i] += this->cellStart[i - 1];
+
+  this->blockIndices.resize(this->cellStart.back());
+  auto writePosition = std::vector<unsigned>(this->cellStart.begin(), this->cellStart.end() - 1);
+  for (unsigned i = 0; i < unsigned(items.size()); i++)
+    forEachCellOfBlock(items[i], [this, &writePosition, i](int cell) {
+      this->blockIndices[writePosition[cell]++] = i;
+    });
+}
+
+template void BlockGrid::build(const std::vector<StatsItemValue> &items);
+template void BlockGrid::build(const std::vector<StatsItemVector> &items);
+template void BlockGrid::build(const std::vector<StatsItemAffineTF> &items);
+
+std::vector<unsigned> BlockGrid::getBlocksIn(const QRect &area) const
+{
+  if (this->nrBlocks == 0 || area.isEmpty() || area.right() < 0 || area.bottom() < 0)
+    return {};
+
+  const auto cellXStart = std::max(area.left(), 0) / this->cellSize;
+  const auto cellXEnd   = std::min(area.right() / this->cellSize, this->nrCellsX - 1);
+  const auto cellYStart = std::max(area.top(), 0) / this->cellSize;
+  const auto cellYEnd   = std::min(area.bottom() / this->cellSize, this->nrCellsY - 1);
+
+  std::vector<unsigned> blocks;
+  for (int cellY = cellYStart; cellY <= cellYEnd; cellY++)
+  {
+    for (int cellX = cellXStart; cellX <= cellXEnd; cellX++)
+    {
+      const auto cell = cellY * this->nrCellsX + cellX;
+      blocks.insert(blocks.end(),
+                    this->blockIndices.begin() + this->cellStart[cell],
+                    this->blockIndices.begin() + this->cellStart[cell + 1]);
+    }
+  }
+
+  // Blocks that span multiple cells are found more than once
+  if (cellXStart != cellXEnd || cellYStart != cellYEnd)
+  {
+    std::sort(blocks.begin(), blocks.end());
+    blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+  }
+  return blocks;
+}
+
+StatisticsSpatialIndex::StatisticsSpatialIndex(const FrameTypeData &data)
+{
+  this->values.build(data.valueData);
+  this->vectors.build(data.vectorData);
+  this->affineTFs.build(data.affineTFData);
+
+  for (const auto &vectorItem : data.vectorData)
+  {
+    if (vectorItem.isLine)
+    {
+      for (const auto &point : vectorItem.point)
+        this->maxLineReach = std::max({this->maxLineReach, std::abs(point.x), std::abs(point.y)});
+    }
+    else
+    {
+      const auto &vector = vectorItem.point[0];
+      this->maxVectorLength =
+          std::max({this->maxVectorLength, std::abs(vector.x), std::abs(vector.y)});
+    }
+  }
+}
+
+bool StatisticsSpatialIndex::isUpToDate(const FrameTypeData &data) const
+{
+  return this->values.getNrBlocks() == data.valueData.size() &&
+         this->vectors.getNrBlocks() == data.vectorData.size() &&
+         this->affineTFs.getNrBlocks() == data.affineTFData.size();
+}
+
+std::vector<unsigned> StatisticsSpatialIndex::getValuesIn(const QRect &area) const
+{
+  return this->values.getBlocksIn(area);
+}
+
+std::vector<unsigned> StatisticsSpatialIndex::getVectorsIn(const QRect &area) const
+{
+  return this->vectors.getBlocksIn(area);
+}
+
+std::vector<unsigned> StatisticsSpatialIndex::getAffineTFsIn(const QRect &area) const
+{
+  return this->affineTFs.getBlocksIn(area);
+}
+
+int StatisticsSpatialIndex::getVectorReach(int vectorScale) const
+{
+  const auto scaledVectorLength = this->maxVectorLength / std::max(std::abs(vectorScale), 1) + 1;
+  return std::max(this->maxLineReach, scaledVectorLength);
+}
+
+} // namespace stats
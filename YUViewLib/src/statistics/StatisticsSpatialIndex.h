@@ -0,0 +1,103 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "FrameTypeData.h"
+
+#include <QRect>
+
+#include <vector>
+
+namespace stats
+{
+
+// The rectangular blocks of one kind of statistics data sorted into a uniform grid over the frame.
+// For every cell, the indices of the blocks that overlap the cell are stored.
+class BlockGrid
+{
+public:
+  BlockGrid() = default;
+
+  // Sort the blocks (StatsItemValue, StatsItemVector or StatsItemAffineTF) into the grid
+  template <typename Item> void build(const std::vector<Item> &items);
+
+  // The indices (ascending) of all blocks that may overlap the area. These are only candidates.
+  // The caller still has to check if the block really overlaps the area.
+  std::vector<unsigned> getBlocksIn(const QRect &area) const;
+
+  size_t getNrBlocks() const { return this->nrBlocks; }
+
+private:
+  int    cellSize{};
+  int    nrCellsX{};
+  int    nrCellsY{};
+  size_t nrBlocks{};
+
+  // The indices of the blocks of cell i are blockIndices[cellStart[i]] ...
+  // blockIndices[cellStart[i + 1] - 1]
+  std::vector<unsigned> cellStart;
+  std::vector<unsigned> blockIndices;
+};
+
+// A spatial index over the blocks of the statistics of one type in one frame. Finding the blocks
+// under the mouse or in the visible part of the frame only touches the blocks in the grid cells
+// that cover the position or area instead of all blocks of the frame.
+class StatisticsSpatialIndex
+{
+public:
+  StatisticsSpatialIndex() = default;
+  explicit StatisticsSpatialIndex(const FrameTypeData &data);
+
+  // Data is only ever added to a FrameTypeData. If the number of items did not change, the index
+  // is still valid.
+  bool isUpToDate(const FrameTypeData &data) const;
+
+  std::vector<unsigned> getValuesIn(const QRect &area) const;
+  std::vector<unsigned> getVectorsIn(const QRect &area) const;
+  std::vector<unsigned> getAffineTFsIn(const QRect &area) const;
+
+  // How far (in pixels) the vectors can reach out of their blocks for the given vector scale
+  int getVectorReach(int vectorScale) const;
+
+private:
+  BlockGrid values;
+  BlockGrid vectors;
+  BlockGrid affineTFs;
+
+  // The largest offset of a line point from the top left of its block
+  int maxLineReach{};
+  // The largest component of a vector (not scaled)
+  int maxVectorLength{};
+};
+
+} // namespace stats
@@ -98,15 +98,21 @@ void ShowColorWidget::paintEvent(QPaintEvent *event)
     // Split the rect into lines with width of 1 pixel
     const auto y0 = drawRect.bottom();
     const auto y1 = drawRect.top();
+
+    // Get the colors of all lines at once
+    std::vector<double> lineValues;
+    for (auto x = drawRect.left(); x <= drawRect.right(); x++)
+    {
+      auto xRel = double(x) / (drawRect.right() - drawRect.left()); // 0...1
+      lineValues.push_back(minVal + (double(maxVal - minVal)) * xRel);
+    }
+    const auto lineColors = this->colorLookupTable.getColors(lineValues);
+
     for (auto x = drawRect.left(); x <= drawRect.right(); x++)
     {
       // For every line (1px width), draw a line.
       // Set the right color
-
-      auto xRel   = double(x) / (drawRect.right() - drawRect.left()); // 0...1
-      auto xRange = minVal + (double(maxVal - minVal)) * xRel;
-
-      auto c = this->colMapper.getColor(xRange);
+      const auto &c = lineColors[x - drawRect.left()];
       if (this->isEnabled())
         painter.setPen(functionsGui::toQColor(c));
       else
@@ -132,8 +138,9 @@ void ShowColorWidget::paintEvent(QPaintEvent *event)
 
 void ShowColorWidget::setColorMapper(const stats::color::ColorMapper &mapper)
 {
-  this->renderRange = true;
-  this->colMapper   = mapper;
+  this->renderRange      = true;
+  this->colMapper        = mapper;
+  this->colorLookupTable = stats::color::ColorLookupTable(mapper);
   this->update();
 }
 
@@ -52,9 +52,10 @@ signals:
   void clicked();
 
 protected:
-  virtual void              mouseReleaseEvent(QMouseEvent *event) override;
-  bool                      renderRange{};
-  bool                      renderRangeValues{};
-  stats::color::ColorMapper colMapper;
-  QColor                    plainColor;
+  virtual void                   mouseReleaseEvent(QMouseEvent *event) override;
+  bool                           renderRange{};
+  bool                           renderRangeValues{};
+  stats::color::ColorMapper      colMapper;
+  stats::color::ColorLookupTable colorLookupTable;
+  QColor                         plainColor;
 };
@@ -62,8 +62,10 @@ ColorMap convertNonMapTypeToColorMap(const stats::color::ColorMapper &colorMappe
   ColorMap colorMap;
   auto     lower  = std::min(colorMapper.valueRange.min, colorMapper.valueRange.max);
   auto     higher = std::max(colorMapper.valueRange.min, colorMapper.valueRange.max);
+
+  const stats::color::ColorLookupTable colorLookupTable(colorMapper);
   for (int i = lower; i <= higher; i++)
-    colorMap[i] = colorMapper.getColor(i);
+    colorMap[i] = colorLookupTable.getColor(i);
   return colorMap;
 }
 
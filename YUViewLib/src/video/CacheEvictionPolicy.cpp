@@ -0,0 +1,133 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CacheEvictionPolicy.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace video
+{
+
+namespace
+{
+
+// Frames of items which are much cheaper to reload than the most expensive ones are still weighted
+// a bit so that the recency and the playlist priority can break the ties between them.
+constexpr auto MIN_RELATIVE_COST = 0.01;
+
+std::vector<std::size_t> getIdentityOrder(const std::size_t size)
+{
+  std::vector<std::size_t> order(size);
+  std::iota(order.begin(), order.end(), 0);
+  return order;
+}
+
+// Map the access times to [0, 1] by their rank. Frames that were never accessed get 0 and the most
+// recently accessed frame gets 1.
+std::vector<double> getRecencyRanks(const std::vector<EvictionCandidate> &candidates)
+{
+  std::vector<int64_t> accessTimes;
+  for (const auto &candidate : candidates)
+    if (candidate.lastAccess > 0)
+      accessTimes.push_back(candidate.lastAccess);
+  std::sort(accessTimes.begin(), accessTimes.end());
+  accessTimes.erase(std::unique(accessTimes.begin(), accessTimes.end()), accessTimes.end());
+
+  std::vector<double> ranks;
+  ranks.reserve(candidates.size());
+  for (const auto &candidate : candidates)
+  {
+    if (candidate.lastAccess <= 0)
+    {
+      ranks.push_back(0.0);
+      continue;
+    }
+    const auto it = std::lower_bound(accessTimes.begin(), accessTimes.end(), candidate.lastAccess);
+    ranks.push_back(double(std::distance(accessTimes.begin(), it) + 1) / accessTimes.size());
+  }
+  return ranks;
+}
+
+} // namespace
+
+std::vector<std::size_t> PlaylistOrderEvictionPolicy::getEvictionOrder(
+    const std::vector<EvictionCandidate> &candidates) const
+{
+  return getIdentityOrder(candidates.size());
+}
+
+std::vector<std::size_t>
+CostAwareEvictionPolicy::getEvictionOrder(const std::vector<EvictionCandidate> &candidates) const
+{
+  const auto nrCandidates = candidates.size();
+  if (nrCandidates < 2)
+    return getIdentityOrder(nrCandidates);
+
+  std::vector<double> costPerByte;
+  costPerByte.reserve(nrCandidates);
+  for (const auto &candidate : candidates)
+    costPerByte.push_back(std::max(candidate.reloadCost, 0.0) /
+                          double(std::max(candidate.frameSize, int64_t(1))));
+  const auto maxCostPerByte = *std::max_element(costPerByte.begin(), costPerByte.end());
+
+  const auto recencyRanks = getRecencyRanks(candidates);
+
+  // The value of keeping a frame in the cache. The recency can at most double the value. The
+  // playlist priority has less influence because the candidates are already ordered by it.
+  std::vector<double> retentionValue(nrCandidates);
+  for (std::size_t i = 0; i < nrCandidates; i++)
+  {
+    const auto relativeCost =
+        (maxCostPerByte > 0.0) ? std::max(costPerByte[i] / maxCostPerByte, MIN_RELATIVE_COST)
+                               : 1.0;
+    const auto playlistPriority = double(i) / double(nrCandidates - 1);
+
+    retentionValue[i] =
+        relativeCost * (1.0 + recencyRanks[i]) * (1.0 + 0.5 * playlistPriority);
+  }
+
+  auto order = getIdentityOrder(nrCandidates);
+  std::stable_sort(order.begin(), order.end(), [&retentionValue](std::size_t a, std::size_t b) {
+    return retentionValue[a] < retentionValue[b];
+  });
+  return order;
+}
+
+std::unique_ptr<CacheEvictionPolicy> createCacheEvictionPolicy(const EvictionPolicy policy)
+{
+  if (policy == EvictionPolicy::PlaylistOrder)
+    return std::make_unique<PlaylistOrderEvictionPolicy>();
+  return std::make_unique<CostAwareEvictionPolicy>();
+}
+
+} // namespace video
@@ -0,0 +1,100 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/EnumMapper.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace video
+{
+
+// A cached frame that the video cache may remove from the cache to make space for other frames.
+struct EvictionCandidate
+{
+  // The number of bytes that are freed when the frame is removed (getCachingFrameSize())
+  int64_t frameSize{};
+  // The estimated time (in seconds) that it takes to get the frame back into the cache. For items
+  // that decode sequentially, this includes decoding all frames from the last random access point.
+  // 0 if nothing is known about the item yet.
+  double reloadCost{};
+  // When the frame was accessed the last time. Higher values are more recent. 0 means never.
+  int64_t lastAccess{};
+};
+
+enum class EvictionPolicy
+{
+  PlaylistOrder,
+  CostAware
+};
+
+constexpr EnumMapper<EvictionPolicy, 2>
+    EvictionPolicyMapper(std::make_pair(EvictionPolicy::PlaylistOrder, "PlaylistOrder"sv),
+                         std::make_pair(EvictionPolicy::CostAware, "CostAware"sv));
+
+// Decides in which order the video cache removes frames when it runs out of space.
+class CacheEvictionPolicy
+{
+public:
+  virtual ~CacheEvictionPolicy() = default;
+
+  // The candidates are given in the order of the playlist based priorities of the video cache (the
+  // first candidate has the lowest priority). Return the indices of all candidates in the order in
+  // which they should be removed.
+  virtual std::vector<std::size_t>
+  getEvictionOrder(const std::vector<EvictionCandidate> &candidates) const = 0;
+};
+
+// Remove the frames strictly in the order of the playlist based priorities.
+class PlaylistOrderEvictionPolicy : public CacheEvictionPolicy
+{
+public:
+  std::vector<std::size_t>
+  getEvictionOrder(const std::vector<EvictionCandidate> &candidates) const override;
+};
+
+// Weigh the cost of getting a frame back into the cache against the memory that removing it frees.
+// Frames that are cheap to reload per byte, were not accessed recently and have a low playlist
+// priority are removed first. Without any measurements, this is identical to the playlist order.
+class CostAwareEvictionPolicy : public CacheEvictionPolicy
+{
+public:
+  std::vector<std::size_t>
+  getEvictionOrder(const std::vector<EvictionCandidate> &candidates) const override;
+};
+
+std::unique_ptr<CacheEvictionPolicy> createCacheEvictionPolicy(EvictionPolicy policy);
+
+} // namespace video
@@ -0,0 +1,274 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DiskFrameCache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+#include <limits>
+#include <utility>
+
+namespace video
+{
+
+namespace
+{
+
+const auto FILE_SUFFIX      = QString(".yuvframe");
+const auto FILE_MAGIC       = quint32(0x59564643); // "YVFC"
+const auto FILE_VERSION     = quint32(1);
+const auto FILE_HEADER_SIZE = 16;
+
+// zlib at the lowest level is fast and still removes most of the redundancy of (mostly smooth)
+// decoded frames.
+constexpr auto COMPRESSION_LEVEL = 1;
+
+// Writing is slower than decoding for some codecs. Drop frames instead of using more and more
+// memory for frames that wait to be written.
+constexpr auto MAX_PENDING_WRITES = 8;
+
+QMutex                          globalCacheMutex;
+std::shared_ptr<DiskFrameCache> globalCache;
+
+} // namespace
+
+DiskFrameCache::DiskFrameCache(const QString &directory, int64_t maxSizeInBytes)
+    : directory(directory), maxSize(maxSizeInBytes)
+{
+  QDir().mkpath(this->directory);
+
+  // Scanning a large cache directory takes a while. Do not block the thread that creates the cache
+  // (the settings are applied in the GUI thread). The pool has only one thread so all writes run
+  // after the scan.
+  this->writePool.setMaxThreadCount(1);
+  this->writePool.start([this]() { this->scanDirectory(); });
+}
+
+DiskFrameCache::~DiskFrameCache()
+{
+  this->waitForBackgroundTasks();
+}
+
+void DiskFrameCache::setMaxSize(int64_t maxSizeInBytes)
+{
+  QMutexLocker lock(&this->mutex);
+  this->maxSize = maxSizeInBytes;
+  this->trimToMaxSize();
+}
+
+bool DiskFrameCache::storeFrame(const QString    &sourceKey,
+                                int               frameIndex,
+                                const QByteArray &frameData)
+{
+  if (frameData.isEmpty())
+    return false;
+
+  const auto fileName = this->getFileName(sourceKey, frameIndex);
+
+  QSaveFile file(this->directory + "/" + fileName);
+  if (!file.open(QIODevice::WriteOnly))
+    return false;
+  {
+    QDataStream stream(&file);
+    stream << FILE_MAGIC << FILE_VERSION << quint64(frameData.size());
+  }
+  const auto compressedData = qCompress(frameData, COMPRESSION_LEVEL);
+  if (file.write(compressedData) != compressedData.size() || !file.commit())
+    return false;
+
+  QMutexLocker lock(&this->mutex);
+  const auto   fileSize = int64_t(FILE_HEADER_SIZE + compressedData.size());
+  if (this->entries.contains(fileName))
+    this->sizeOnDisk -= this->entries[fileName].fileSize;
+  this->entries[fileName].fileSize = fileSize;
+  this->setLastAccess(fileName, ++this->accessCounter);
+  this->sizeOnDisk += fileSize;
+  this->trimToMaxSize();
+  return true;
+}
+
+void DiskFrameCache::storeFrameInBackground(const QString    &sourceKey,
+                                            int               frameIndex,
+                                            const QByteArray &frameData)
+{
+  if (++this->nrPendingWrites > MAX_PENDING_WRITES)
+  {
+    this->nrPendingWrites--;
+    return;
+  }
+
+  this->writePool.start([this, sourceKey, frameIndex, frameData]() {
+    this->storeFrame(sourceKey, frameIndex, frameData);
+    this->nrPendingWrites--;
+  });
+}
+
+void DiskFrameCache::waitForBackgroundTasks()
+{
+  this->writePool.waitForDone();
+}
+
+std::optional<QByteArray> DiskFrameCache::loadFrame(const QString &sourceKey, int frameIndex)
+{
+  const auto fileName = this->getFileName(sourceKey, frameIndex);
+  {
+    QMutexLocker lock(&this->mutex);
+    if (!this->entries.contains(fileName))
+      return {};
+    this->setLastAccess(fileName, ++this->accessCounter);
+  }
+
+  QFile file(this->directory + "/" + fileName);
+  if (file.open(QIODevice::ReadOnly))
+  {
+    QDataStream stream(&file);
+    quint32     magic{};
+    quint32     version{};
+    quint64     frameSize{};
+    stream >> magic >> version >> frameSize;
+    if (stream.status() == QDataStream::Ok && magic == FILE_MAGIC && version == FILE_VERSION)
+    {
+      const auto frameData = qUncompress(file.readAll());
+      if (uint64_t(frameData.size()) == frameSize && !frameData.isEmpty())
+        return frameData;
+    }
+  }
+
+  // The file was deleted or is corrupt
+  QMutexLocker lock(&this->mutex);
+  this->removeFile(fileName);
+  return {};
+}
+
+bool DiskFrameCache::containsFrame(const QString &sourceKey, int frameIndex) const
+{
+  QMutexLocker lock(&this->mutex);
+  return this->entries.contains(this->getFileName(sourceKey, frameIndex));
+}
+
+int DiskFrameCache::getNrFrames() const
+{
+  QMutexLocker lock(&this->mutex);
+  return this->entries.size();
+}
+
+int64_t DiskFrameCache::getSizeOnDisk() const
+{
+  QMutexLocker lock(&this->mutex);
+  return this->sizeOnDisk;
+}
+
+QString DiskFrameCache::getFileName(const QString &sourceKey, int frameIndex) const
+{
+  const auto sourceHash = QCryptographicHash::hash(sourceKey.toUtf8(), QCryptographicHash::Sha1);
+  return QString("%1_%2%3")
+      .arg(QString::fromLatin1(sourceHash.toHex()))
+      .arg(frameIndex)
+      .arg(FILE_SUFFIX);
+}
+
+void DiskFrameCache::scanDirectory()
+{
+  // Pick up the frames of earlier sessions. The oldest files are the first ones to be deleted.
+  const auto files = QDir(this->directory)
+                         .entryInfoList(QStringList() << ("*" + FILE_SUFFIX),
+                                        QDir::Files,
+                                        QDir::Time | QDir::Reversed);
+
+  QMutexLocker lock(&this->mutex);
+  // The files are older than all frames that were stored or loaded in this session so far.
+  auto lastAccess = -int64_t(files.size()) - 1;
+  for (const auto &file : files)
+  {
+    lastAccess++;
+    if (this->entries.contains(file.fileName()))
+      continue;
+    this->entries[file.fileName()].fileSize = file.size();
+    this->setLastAccess(file.fileName(), lastAccess);
+    this->sizeOnDisk += file.size();
+  }
+  this->trimToMaxSize();
+}
+
+void DiskFrameCache::setLastAccess(const QString &fileName, int64_t lastAccess)
+{
+  auto &entry = this->entries[fileName];
+  auto  it    = this->fileNameByLastAccess.find(entry.lastAccess);
+  if (it != this->fileNameByLastAccess.end() && it->second == fileName)
+    this->fileNameByLastAccess.erase(it);
+  entry.lastAccess                       = lastAccess;
+  this->fileNameByLastAccess[lastAccess] = fileName;
+}
+
+void DiskFrameCache::removeFile(const QString &fileName)
+{
+  if (!this->entries.contains(fileName))
+    return;
+  const auto entry = this->entries.take(fileName);
+  this->fileNameByLastAccess.erase(entry.lastAccess);
+  this->sizeOnDisk -= entry.fileSize;
+  QFile::remove(this->directory + "/" + fileName);
+}
+
+void DiskFrameCache::trimToMaxSize()
+{
+  while (this->sizeOnDisk > this->maxSize && !this->fileNameByLastAccess.empty())
+    this->removeFile(this->fileNameByLastAccess.begin()->second);
+}
+
+std::shared_ptr<DiskFrameCache> getGlobalDiskFrameCache()
+{
+  QMutexLocker lock(&globalCacheMutex);
+  return globalCache;
+}
+
+void setGlobalDiskFrameCache(std::shared_ptr<DiskFrameCache> cache)
+{
+  std::shared_ptr<DiskFrameCache> oldCache;
+  {
+    QMutexLocker lock(&globalCacheMutex);
+    oldCache = std::exchange(globalCache, std::move(cache));
+  }
+
+  // Destroying the cache waits for its background tasks (the scan of the directory and the writes).
+  // The settings are applied in the GUI thread, so release the old cache in another thread.
+  if (oldCache)
+    QThreadPool::globalInstance()->start(
+        [oldCache = std::move(oldCache)]() mutable { oldCache.reset(); });
+}
+
+} // namespace video
@@ -0,0 +1,119 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+
+namespace video
+{
+
+/* A second level cache for decoded frames on disk. When frames are removed from the cache in
+ * memory (or the playlist is opened again), they can be read from here instead of decoding them
+ * again. The frames are compressed losslessly. Each frame is stored in its own file in the given
+ * directory. The files of a source are identified by a key that must contain everything that
+ * changes the decoded frames (the file, its modification time and the decoder settings). When the
+ * maximum size is exceeded, the least recently used frames are deleted.
+ */
+class DiskFrameCache
+{
+public:
+  // The frames of earlier sessions in the directory are picked up in a background thread (see
+  // waitForBackgroundTasks()).
+  DiskFrameCache(const QString &directory, int64_t maxSizeInBytes);
+  ~DiskFrameCache();
+
+  QString getDirectory() const { return this->directory; }
+  void    setMaxSize(int64_t maxSizeInBytes);
+
+  // Compress the frame and write it to disk. Returns false if writing failed.
+  bool storeFrame(const QString &sourceKey, int frameIndex, const QByteArray &frameData);
+  // The same as storeFrame but the frame is compressed and written in a background thread. If too
+  // many frames are waiting to be written, the frame is not stored.
+  void storeFrameInBackground(const QString    &sourceKey,
+                              int               frameIndex,
+                              const QByteArray &frameData);
+  // Wait until the directory was scanned and all frames were written
+  void waitForBackgroundTasks();
+
+  // Read the frame from disk. Returns nothing if the frame is not in the cache or reading failed.
+  std::optional<QByteArray> loadFrame(const QString &sourceKey, int frameIndex);
+
+  bool    containsFrame(const QString &sourceKey, int frameIndex) const;
+  int     getNrFrames() const;
+  int64_t getSizeOnDisk() const;
+
+private:
+  QString getFileName(const QString &sourceKey, int frameIndex) const;
+  void    scanDirectory();
+  void    setLastAccess(const QString &fileName, int64_t lastAccess);
+  void    removeFile(const QString &fileName);
+  // Delete the least recently used files until the size is below the maximum size. The mutex must
+  // be locked.
+  void trimToMaxSize();
+
+  const QString directory;
+  int64_t       maxSize{};
+
+  struct Entry
+  {
+    int64_t fileSize{};
+    int64_t lastAccess{};
+  };
+  mutable QMutex       mutex;
+  QMap<QString, Entry> entries;
+  // The file names of all entries by their last access. The first one is the least recently used.
+  std::map<int64_t, QString> fileNameByLastAccess;
+  int64_t                    sizeOnDisk{};
+  int64_t                    accessCounter{};
+
+  QThreadPool     writePool;
+  std::atomic_int nrPendingWrites{0};
+};
+
+// The disk cache that the playlist items use. This is nullptr if the disk cache is disabled (the
+// default). The video cache sets this according to the settings. The previous cache is released
+// in a background thread.
+std::shared_ptr<DiskFrameCache> getGlobalDiskFrameCache();
+void                            setGlobalDiskFrameCache(std::shared_ptr<DiskFrameCache> cache);
+
+} // namespace video
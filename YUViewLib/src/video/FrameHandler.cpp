@@ -31,6 +31,7 @@
  */
 
 #include "FrameHandler.h"
+#include "ImagePyramid.h"
 
 #include <QPainter>
 
@@ -268,7 +269,7 @@ void FrameHandler::drawFrame(QPainter *painter, double zoomFactor, bool drawRawV
   videoRect.moveCenter(QPoint(0, 0));
 
   // Draw the current image (currentFrame)
-  painter->drawImage(videoRect, this->currentImage);
+  drawImageClipped(painter, videoRect, this->currentImage);
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
   {
@@ -0,0 +1,187 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImagePyramid.h"
+
+#include <QPainter>
+
+#include <algorithm>
+#include <cmath>
+
+namespace video
+{
+
+namespace
+{
+
+// Images with less pixels are drawn without a pyramid
+constexpr int64_t MIN_PIXELS_FOR_PYRAMID = 3840 * 2160 / 2;
+// No levels smaller than this (in both directions) are created
+constexpr int MIN_LEVEL_SIZE = 64;
+
+// Average 2x2 pixels of a 32 bit (premultiplied) image. The two bytes of each 16 bit lane can hold
+// the sum of 4 values.
+QImage downscale(const QImage &image)
+{
+  const auto width  = image.width() / 2;
+  const auto height = image.height() / 2;
+  QImage     downscaled(width, height, image.format());
+
+  for (int y = 0; y < height; y++)
+  {
+    auto line0 = reinterpret_cast<const uint32_t *>(image.constScanLine(2 * y));
+    auto line1 = reinterpret_cast<const uint32_t *>(image.constScanLine(2 * y + 1));
+    auto dst   = reinterpret_cast<uint32_t *>(downscaled.scanLine(y));
+    for (int x = 0; x < width; x++)
+    {
+      const uint32_t pixels[4] = {line0[2 * x], line0[2 * x + 1], line1[2 * x], line1[2 * x + 1]};
+      uint32_t       sumEven   = 0x00020002; // Rounding
+      uint32_t       sumOdd    = 0x00020002;
+      for (const auto pixel : pixels)
+      {
+        sumEven += pixel & 0x00ff00ff;
+        sumOdd += (pixel >> 8) & 0x00ff00ff;
+      }
+      dst[x] = ((sumEven >> 2) & 0x00ff00ff) | (((sumOdd >> 2) & 0x00ff00ff) << 8);
+    }
+  }
+  return downscaled;
+}
+
+bool isLevelSizeValid(const int width, const int height)
+{
+  return width >= MIN_LEVEL_SIZE || height >= MIN_LEVEL_SIZE;
+}
+
+} // namespace
+
+ImagePyramid::ImagePyramid(const QImage &image) : sourceCacheKey(image.cacheKey())
+{
+  if (image.isNull())
+    return;
+
+  // The pixels are averaged in a premultiplied format (or without alpha)
+  auto level = image;
+  if (level.format() != QImage::Format_RGB32 &&
+      level.format() != QImage::Format_ARGB32_Premultiplied)
+    level = level.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+  while (isLevelSizeValid(level.width() / 2, level.height() / 2) && level.width() >= 2 &&
+         level.height() >= 2)
+  {
+    level = downscale(level);
+    this->levels.push_back(level);
+  }
+}
+
+bool ImagePyramid::isUseful(const QSize imageSize)
+{
+  return int64_t(imageSize.width()) * imageSize.height() >= MIN_PIXELS_FOR_PYRAMID;
+}
+
+int64_t ImagePyramid::getMemoryUsage(QSize imageSize, const int bytesPerPixel)
+{
+  if (!isUseful(imageSize))
+    return 0;
+
+  int64_t bytes = 0;
+  while (isLevelSizeValid(imageSize.width() / 2, imageSize.height() / 2) &&
+         imageSize.width() >= 2 && imageSize.height() >= 2)
+  {
+    imageSize /= 2;
+    bytes += int64_t(imageSize.width()) * imageSize.height() * bytesPerPixel;
+  }
+  return bytes;
+}
+
+bool ImagePyramid::isBuiltFrom(const QImage &image) const
+{
+  return !image.isNull() && image.cacheKey() == this->sourceCacheKey;
+}
+
+const QImage &ImagePyramid::getImageForScale(const QImage &fullImage, const double scale) const
+{
+  if (scale <= 0 || scale >= 0.5 || this->levels.empty())
+    return fullImage;
+
+  // Level n has 1 / 2^(n+1) of the full resolution
+  const auto level = int(std::floor(std::log2(1.0 / scale))) - 1;
+  return this->levels.at(std::clamp(level, 0, int(this->levels.size()) - 1));
+}
+
+void drawImageClipped(QPainter           *painter,
+                      const QRect        &videoRect,
+                      const QImage       &image,
+                      const ImagePyramid *pyramid)
+{
+  if (image.isNull() || videoRect.isEmpty())
+    return;
+
+  const auto transform = painter->combinedTransform();
+  if (transform.type() > QTransform::TxScale)
+  {
+    painter->drawImage(videoRect, image);
+    return;
+  }
+
+  // The part of the video rect that is visible (in item coordinates)
+  auto visibleRect = transform.inverted().mapRect(QRectF(painter->viewport()));
+  if (painter->hasClipping())
+    visibleRect &= painter->clipBoundingRect();
+  const auto targetRect = QRectF(videoRect) & visibleRect;
+  if (targetRect.isEmpty())
+    return;
+
+  const auto  scale     = videoRect.width() * std::abs(transform.m11()) / image.width();
+  const auto &drawImage = pyramid ? pyramid->getImageForScale(image, scale) : image;
+
+  // Draw whole pixels of the image only so that the pixels end up at exactly the same position as
+  // if the whole image was drawn.
+  const auto pixelsPerUnitX = double(drawImage.width()) / videoRect.width();
+  const auto pixelsPerUnitY = double(drawImage.height()) / videoRect.height();
+
+  const auto left   = std::floor((targetRect.left() - videoRect.x()) * pixelsPerUnitX);
+  const auto top    = std::floor((targetRect.top() - videoRect.y()) * pixelsPerUnitY);
+  const auto right  = std::min(std::ceil((targetRect.right() - videoRect.x()) * pixelsPerUnitX),
+                              double(drawImage.width()));
+  const auto bottom = std::min(std::ceil((targetRect.bottom() - videoRect.y()) * pixelsPerUnitY),
+                               double(drawImage.height()));
+
+  const QRectF sourceRect(left, top, right - left, bottom - top);
+  const QRectF alignedTargetRect(videoRect.x() + left / pixelsPerUnitX,
+                                 videoRect.y() + top / pixelsPerUnitY,
+                                 (right - left) / pixelsPerUnitX,
+                                 (bottom - top) / pixelsPerUnitY);
+  painter->drawImage(alignedTargetRect, drawImage, sourceRect);
+}
+
+} // namespace video
@@ -0,0 +1,83 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QImage>
+#include <QRect>
+
+#include <cstdint>
+#include <vector>
+
+class QPainter;
+
+namespace video
+{
+
+/* Downscaled versions of an image which are used when the image is drawn zoomed out. Every level
+ * has half the width and height of the level before (averaging 2x2 pixels). The full resolution
+ * image itself is not part of the pyramid. Without the pyramid, every repaint has to sample the
+ * full resolution image which is slow for very large frames.
+ */
+class ImagePyramid
+{
+public:
+  ImagePyramid() = default;
+  explicit ImagePyramid(const QImage &image);
+
+  // Only large images profit from a pyramid. For all others, the memory is not worth it.
+  static bool    isUseful(QSize imageSize);
+  static int64_t getMemoryUsage(QSize imageSize, int bytesPerPixel);
+
+  // Was the pyramid built from this image (and the image was not modified since)?
+  bool isBuiltFrom(const QImage &image) const;
+
+  // Get the image to draw at the given scale (drawn size / image size). This is the smallest level
+  // that still has at least the drawn resolution or the full resolution image itself.
+  const QImage &getImageForScale(const QImage &fullImage, double scale) const;
+
+  int getNrLevels() const { return int(this->levels.size()); }
+
+private:
+  std::vector<QImage> levels;
+  qint64              sourceCacheKey{};
+};
+
+// Draw the image into the videoRect like QPainter::drawImage does. However, only the part of the
+// image that is visible (in the viewport and the clip region of the painter) is processed. If a
+// pyramid is given, a downscaled level is used if the image is drawn zoomed out.
+void drawImageClipped(QPainter           *painter,
+                      const QRect        &videoRect,
+                      const QImage       &image,
+                      const ImagePyramid *pyramid = nullptr);
+
+} // namespace video
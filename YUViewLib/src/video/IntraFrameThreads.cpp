@@ -0,0 +1,139 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IntraFrameThreads.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+namespace video::intraFrameThreads
+{
+
+namespace
+{
+
+// Splitting small frames is not worth the overhead of the thread synchronization.
+constexpr auto MIN_PIXELS_PER_BAND = 256 * 1024;
+
+std::atomic_int nrSpareThreads{0};
+// The spare threads that are currently used by a conversion. Multiple conversions can run at the
+// same time (e.g. in the caching threads). Together they must not use more than the spare threads.
+std::atomic_int nrClaimedThreads{0};
+
+QThreadPool &getThreadPool()
+{
+  // A separate pool so that the conversion does not compete with other users of the global pool
+  // (e.g. the background parsing of bitstreams).
+  static QThreadPool pool;
+  return pool;
+}
+
+// Claim up to maxThreads of the spare threads that are not used by other conversions
+int claimSpareThreads(int maxThreads)
+{
+  auto claimed = nrClaimedThreads.load();
+  while (true)
+  {
+    const auto nrThreads = std::min(maxThreads, nrSpareThreads.load() - claimed);
+    if (nrThreads <= 0)
+      return 0;
+    if (nrClaimedThreads.compare_exchange_weak(claimed, claimed + nrThreads))
+      return nrThreads;
+  }
+}
+
+void releaseSpareThreads(int nrThreads)
+{
+  nrClaimedThreads -= nrThreads;
+}
+
+} // namespace
+
+void setNrSpareThreads(int nrThreads)
+{
+  nrThreads = std::max(nrThreads, 0);
+  if (nrSpareThreads.exchange(nrThreads) != nrThreads && nrThreads > 0)
+    getThreadPool().setMaxThreadCount(nrThreads);
+}
+
+int getNrSpareThreads()
+{
+  return std::max(nrSpareThreads.load() - nrClaimedThreads.load(), 0);
+}
+
+void processRowBands(const int                            frameWidth,
+                     const int                            frameHeight,
+                     const int                            rowAlignment,
+                     const std::function<void(int, int)> &processRows)
+{
+  const auto alignment     = std::max(rowAlignment, 1);
+  const auto nrAlignedRows = (frameHeight + alignment - 1) / alignment;
+  const auto maxBandsBySize =
+      std::max(int(int64_t(frameWidth) * frameHeight / MIN_PIXELS_PER_BAND), 1);
+  const auto maxBands      = std::min(maxBandsBySize, nrAlignedRows);
+  const auto nrThreadsUsed = maxBands > 1 ? claimSpareThreads(maxBands - 1) : 0;
+  const auto nrBands       = nrThreadsUsed + 1;
+
+  if (nrBands <= 1)
+  {
+    processRows(0, frameHeight);
+    return;
+  }
+
+  auto getBandStart = [&](const int band) {
+    return std::min(int(int64_t(nrAlignedRows) * band / nrBands) * alignment, frameHeight);
+  };
+
+  // The first band is processed in this thread while the others are processed in the pool
+  std::vector<QFuture<void>> futures;
+  futures.reserve(nrBands - 1);
+  for (int band = 1; band < nrBands; band++)
+  {
+    const auto rowStart = getBandStart(band);
+    const auto rowEnd   = getBandStart(band + 1);
+    futures.push_back(QtConcurrent::run(
+        &getThreadPool(), [&processRows, rowStart, rowEnd]() { processRows(rowStart, rowEnd); }));
+  }
+
+  processRows(0, getBandStart(1));
+
+  for (auto &future : futures)
+    future.waitForFinished();
+  releaseSpareThreads(nrThreadsUsed);
+}
+
+} // namespace video::intraFrameThreads
@@ -0,0 +1,56 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+
+namespace video::intraFrameThreads
+{
+
+// The VideoCache sets the number of threads that are currently idle (not caching or loading). These
+// threads can be used to convert a single frame in bands of rows in parallel. If this is 0, all
+// conversions run in the calling thread only. Conversions that run at the same time share the
+// spare threads. getNrSpareThreads returns the spare threads that are not used by a conversion.
+void setNrSpareThreads(int nrThreads);
+int  getNrSpareThreads();
+
+// Split the frame into bands of rows and call processRows(rowStart, rowEnd) for each band (rowEnd
+// is exclusive). The bands are processed in parallel using the spare threads (and the calling
+// thread) if the frame is big enough to make this worth it. Each band starts at a multiple of
+// rowAlignment. This function returns when all bands are done.
+void processRowBands(int                                   frameWidth,
+                     int                                   frameHeight,
+                     int                                   rowAlignment,
+                     const std::function<void(int, int)> &processRows);
+
+} // namespace video::intraFrameThreads
@@ -0,0 +1,102 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RawFrameBuffer.h"
+
+#include <cstring>
+
+namespace video
+{
+
+RawFrameBuffer::RawFrameBuffer(const QByteArray &packedData) : packedData(packedData)
+{
+}
+
+RawFrameBuffer::RawFrameBuffer(const QByteArray &packedData, std::shared_ptr<const void> owner)
+    : packedData(packedData), packedDataIsView(true), owner(std::move(owner))
+{
+}
+
+RawFrameBuffer::RawFrameBuffer(std::vector<Plane> planes, std::shared_ptr<const void> owner)
+    : planes(std::move(planes)), owner(std::move(owner))
+{
+}
+
+bool RawFrameBuffer::isNull() const
+{
+  if (this->isPacked())
+    return this->packedData.isEmpty();
+  for (const auto &plane : this->planes)
+    if (plane.data == nullptr)
+      return true;
+  return false;
+}
+
+QByteArray RawFrameBuffer::toByteArray() const
+{
+  if (this->isPacked() && this->packedDataIsView)
+    // A deep copy is needed because the data is only valid as long as the owner exists
+    return QByteArray(this->packedData.constData(), this->packedData.size());
+  if (this->isPacked() || this->isNull())
+    return this->packedData;
+
+  int64_t nrBytes = 0;
+  for (const auto &plane : this->planes)
+    nrBytes += int64_t(plane.widthInBytes) * plane.height;
+
+  QByteArray data;
+  data.resize(int(nrBytes));
+  auto dst = reinterpret_cast<unsigned char *>(data.data());
+  for (const auto &plane : this->planes)
+  {
+    auto src = plane.data;
+    for (int y = 0; y < plane.height; y++)
+    {
+      std::memcpy(dst, src, plane.widthInBytes);
+      src += plane.stride;
+      dst += plane.widthInBytes;
+    }
+  }
+  return data;
+}
+
+void RawFrameBuffer::addReleaseFunction(std::function<void()> releaseFunction)
+{
+  // The previous owner is captured in the deleter and released after the function was called
+  this->owner = std::shared_ptr<const void>(
+      nullptr,
+      [previousOwner = this->owner, releaseFunction = std::move(releaseFunction)](const void *) {
+        releaseFunction();
+      });
+}
+
+} // namespace video
@@ -0,0 +1,92 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace video
+{
+
+/* A reference counted raw frame. The frame is either one consecutive buffer (all planes one after
+ * the other without padding, which is the format that all videoHandlers work with) or a list of
+ * planes that each have their own stride. The latter can wrap the output picture of a decoder
+ * without copying it. The memory is owned by someone else (e.g. the decoder or a memory mapped
+ * file) and is kept alive until the last copy of the frame buffer is destroyed.
+ */
+class RawFrameBuffer
+{
+public:
+  struct Plane
+  {
+    const unsigned char *data{};
+    int64_t              stride{};
+    int                  widthInBytes{};
+    int                  height{};
+  };
+
+  RawFrameBuffer() = default;
+  explicit RawFrameBuffer(const QByteArray &packedData);
+  // The packed data does not own its memory (QByteArray::fromRawData) but the owner does
+  RawFrameBuffer(const QByteArray &packedData, std::shared_ptr<const void> owner);
+  RawFrameBuffer(std::vector<Plane> planes, std::shared_ptr<const void> owner);
+
+  bool isNull() const;
+  bool isPacked() const { return this->planes.empty(); }
+  // True if the data is owned by someone else. Such a buffer should not be kept for long because it
+  // may block the owner (e.g. a decoder) until it is destroyed.
+  bool isView() const { return !this->isPacked() || this->packedDataIsView; }
+
+  const QByteArray         &getPackedData() const { return this->packedData; }
+  const std::vector<Plane> &getPlanes() const { return this->planes; }
+
+  // Get all planes in one consecutive buffer. For a packed buffer that owns its data, this does not
+  // copy the data.
+  QByteArray toByteArray() const;
+
+  // The given function is called when the last copy of this frame buffer is destroyed (e.g. to
+  // unlock the decoder that owns the planes).
+  void addReleaseFunction(std::function<void()> releaseFunction);
+
+private:
+  QByteArray                  packedData;
+  bool                        packedDataIsView{};
+  std::vector<Plane>          planes;
+  std::shared_ptr<const void> owner;
+};
+
+} // namespace video
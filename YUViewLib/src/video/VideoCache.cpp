@@ -36,12 +36,16 @@
 #include <QPainter>
 #include <QScrollArea>
 #include <QSettings>
+#include <QStandardPaths>
 #include <QThread>
 #include <algorithm>
+#include <iterator>
 
 #include <common/Functions.h>
 #include <playlistitem/playlistItem.h>
 #include <ui/PlaybackController.h>
+#include <video/DiskFrameCache.h>
+#include <video/IntraFrameThreads.h>
 
 namespace video
 {
@@ -87,6 +91,10 @@ public:
   }
   playlistItem *getCacheItem() { return currentCacheItem; }
   int           getCacheFrame() { return currentFrame; }
+  // The item of the last finished caching job and how long caching the frame took (in seconds).
+  // The duration is negative if nothing was measured (the frame was already cached or test mode).
+  playlistItem *getLastCachedItem() { return lastCachedItem; }
+  double        getLastCachingDuration() { return lastCachingDuration; }
   void          setJob(playlistItem *item, int frame, bool test = false);
   void          setWorking(bool state) { working = state; }
   bool          isWorking() { return working; }
@@ -107,6 +115,8 @@ private slots:
 private:
   playlistItem *currentCacheItem;
   int           currentFrame;
+  playlistItem *lastCachedItem{};
+  double        lastCachingDuration{-1.0};
   bool          working;
   bool          testMode;
   int           id; // A static ID of the thread. Only used in getStatus().
@@ -148,11 +158,19 @@ void loadingWorker::processCacheJobInternal()
              "Given frame index invalid");
   DEBUG_JOBS("loadingWorker::processCacheJobInternal");
 
+  // Frames that are already cached return immediately. Don't count these as measurements.
+  const auto measureDuration =
+      !testMode && !currentCacheItem->getCachedFrames().contains(currentFrame);
+  QElapsedTimer timer;
+  timer.start();
+
   // Just cache the frame that was given to us.
   // This is performed in the thread that this worker is currently placed in.
   currentCacheItem->cacheFrame(currentFrame, testMode);
 
-  currentCacheItem = nullptr;
+  lastCachedItem      = currentCacheItem;
+  lastCachingDuration = measureDuration ? double(timer.nsecsElapsed()) / 1e9 : -1.0;
+  currentCacheItem    = nullptr;
   DEBUG_JOBS("loadingWorker::processCacheJobInternal emit loadingFinished");
   emit loadingFinished();
 }
@@ -339,6 +357,8 @@ void VideoCache::updateSettings()
     targetNrThreads = settings.value("NrThreads", targetNrThreads).toInt();
   if (targetNrThreads <= 0)
     targetNrThreads = 1;
+  nrThreadsTotal             = targetNrThreads;
+  intraFrameThreadingEnabled = settings.value("IntraFrameThreading", true).toBool();
   if (!cachingEnabled)
     targetNrThreads = 0;
 
@@ -380,9 +400,33 @@ void VideoCache::updateSettings()
     }
   }
 
+  // In which order should frames be removed from the cache if it is full?
+  const auto policyName = settings.value("EvictionPolicy", "CostAware").toString().toStdString();
+  this->evictionPolicy  = createCacheEvictionPolicy(
+      EvictionPolicyMapper.getValue(policyName).value_or(EvictionPolicy::CostAware));
+
+  // The optional second level cache on disk for decoded frames
+  if (settings.value("DiskCacheEnabled", false).toBool())
+  {
+    const auto defaultDirectory =
+        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/frames";
+
+    const auto directory = settings.value("DiskCacheDirectory", defaultDirectory).toString();
+    const auto maxSize   = int64_t(settings.value("DiskCacheSizeMB", 4000).toUInt()) * 1000 * 1000;
+
+    auto diskCache = getGlobalDiskFrameCache();
+    if (diskCache && diskCache->getDirectory() == directory)
+      diskCache->setMaxSize(maxSize);
+    else
+      setGlobalDiskFrameCache(std::make_shared<DiskFrameCache>(directory, maxSize));
+  }
+  else
+    setGlobalDiskFrameCache({});
+
   // Also update the cache status and schedule an update of the caching.
   emit updateCacheStatus();
   scheduleCachingListUpdate();
+  updateIntraFrameThreads();
 
   settings.endGroup();
 }
@@ -394,6 +438,8 @@ void VideoCache::loadFrame(playlistItem *item, int frameIndex, int loadingSlot)
     // The item is not loadable (invalid, tagged for deletion, and invalid frame index was given)
     return;
 
+  this->recordFrameAccess(item, frameIndex);
+
   assert(loadingSlot == 0 || loadingSlot == 1);
   if (interactiveThread[loadingSlot]->worker()->isWorking())
   {
@@ -415,6 +461,7 @@ void VideoCache::loadFrame(playlistItem *item, int frameIndex, int loadingSlot)
     bool loadRawData = splitView->showRawData() && !playback->playing();
     interactiveThread[loadingSlot]->worker()->setJob(item, frameIndex);
     interactiveThread[loadingSlot]->worker()->setWorking(true);
+    updateIntraFrameThreads();
     interactiveThread[loadingSlot]->worker()->processLoadingJob(playback->playing(), loadRawData);
     DEBUG_CACHING_DETAIL("VideoCache::loadFrame %d started - slot %d", frameIndex, loadingSlot);
 
@@ -485,6 +532,7 @@ void VideoCache::interactiveLoaderFinished()
     // No scheduled job waiting
     interactiveThread[threadID]->worker()->setWorking(false);
 
+  updateIntraFrameThreads();
   emit updateCacheStatus();
 }
 
@@ -570,6 +618,9 @@ void VideoCache::updateCacheQueue()
   // Let's start with the currently selected item (if no item is selected, the first item in the
   // playlist is considered as being selected)
   auto selection = playlist->getSelectedItems();
+  for (const auto item : selection)
+    if (item != nullptr)
+      this->recordFrameAccess(item, playback->getCurrentFrame());
   if (selection[0] == nullptr)
     selection[0] = allItems[0];
   // Get the position of the curretnly selected item
@@ -712,21 +763,18 @@ void VideoCache::updateCacheQueue()
       // All frames of the currently selected item will not fit into the cache
       // Delete all frames from all other items in the playlist from the cache and cache all frames
       // from this item that fit
-      for (playlistItem *item : allItems)
-      {
-        if (item != selection[0])
-        {
-          // Mark all frames of this item as "can be removed if required"
-          QList<int> cachedFrames = item->getCachedFrames();
-          for (int f : cachedFrames)
-            cacheDeQueue.enqueue(plItemFrame(item, f));
-        }
-      }
+      this->enqueueOtherItemsForEviction(allItems, itemPos);
 
       // Adjust the range so that only the number of frames are cached that will fit
       int64_t nrFramesCachable = cacheLevelMax / selection[0]->getCachingFrameSize();
       range.second             = range.first + nrFramesCachable - 1;
 
+      // The cached frames of this item after the range may also be removed. They have the highest
+      // priority of all candidates.
+      for (int f : selection[0]->getCachedFrames())
+        if (f > range.second)
+          cacheDeQueue.enqueue(plItemFrame(selection[0], f));
+
       enqueueCacheJob(selection[0], range);
     }
     else if (selection[0]->isCachable() &&
@@ -737,99 +785,9 @@ void VideoCache::updateCacheQueue()
       // There is currently not enough space in the cache to cache all remaining frames but in
       // general the cache can hold all frames. Delete frames from the cache until it fits.
 
-      // We go through all other items and get the frames that we will delete.
-      // We start with the item before the one before the currently selected one and go back through
-      // the list, wrap around and keep going until we are at the current selected item. Then (as
-      // the last resort) we go to the item before the currently selected one.
-      int i = itemPos - 1;
-      // Go back in the list to the previous item that is indexed
-      while (true)
-      {
-        if (i < 0)
-          i = allItems.count() - 1;
-        if (allItems[i]->properties().isIndexedByFrame())
-          break;
-        i--;
-      }
-      // Go back one item further to the one before the one before the currently selected one.
-      i--;
-      while (true)
-      {
-        if (i < 0)
-          i = allItems.count() - 1;
-        if (allItems[i]->properties().isIndexedByFrame())
-          break;
-        i--;
-      }
-
-      // Get the cache level without the current item (frames from the current item do not really
-      // occupy space in the cache. We want to cache them anyways)
-      int64_t cacheLevelWithoutCurrent =
-          cacheLevel -
-          selection[0]->getNumberCachedFrames() * int64_t(selection[0]->getCachingFrameSize());
-      while ((itemSpaceNeeded + cacheLevelWithoutCurrent) > cacheLevelMax)
-      {
-        if (i == itemPos)
-          // We went through the whole list and arrived back at the beginning.
-          // If playback is running, we go to the previous item at last.
-          i--;
-        if (i < 0)
-        {
-          // There is no previous item or the previous item is the first one in the list
-          i = allItems.count() - 1;
-        }
-        if (allItems[i]->getNumberCachedFrames() == 0)
-        {
-          i--;
-          continue; // Nothing to delete for this item
-        }
-
-        // Which frames are cached for the item at position i?
-        QList<int> cachedFrames = allItems[i]->getCachedFrames();
-        int64_t    cachedFramesSize =
-            cachedFrames.count() * int64_t(allItems[i]->getCachingFrameSize());
-
-        if (additionalItemSpaceNeeded < cachedFramesSize)
-        {
-          // If we delete all frames from item i, there is more than enough space. So we only delete
-          // as many frames as needed.
-          int64_t nrFrames = additionalItemSpaceNeeded / allItems[i]->getCachingFrameSize() + 1;
-
-          // Delete nrFrames frames from the back
-          for (int f = cachedFrames.count() - 1; f >= 0 && nrFrames > 0; f--)
-          {
-            cacheDeQueue.enqueue(plItemFrame(allItems[i], cachedFrames[f]));
-            cacheLevelWithoutCurrent -= allItems[i]->getCachingFrameSize();
-            if ((cacheLevelWithoutCurrent + itemSpaceNeeded) <= cacheLevelMax)
-              // Now there is enough space
-              break;
-          }
-        }
-        else
-        {
-          // Deleting all frames from this item will not be enough.
-          // Mark all frames of this item as "can be removed if required"
-          QList<int> cachedFrames = allItems[i]->getCachedFrames();
-          for (int f : cachedFrames)
-          {
-            cacheDeQueue.enqueue(plItemFrame(allItems[i], f));
-          }
-          cacheLevelWithoutCurrent -= cachedFramesSize;
-        }
-
-        if (i == itemPos - 1)
-        {
-          // We went through all items and tried to delete frames but there is still not enough
-          // space. That is not possible because we determined that the curretn item should fit if
-          // we just delete enough frames.
-          DEBUG_CACHING("VideoCache::updateCacheQueue ERROR! Deleting loop processed all frames "
-                        "but still not enough space in the cache.");
-          break;
-        }
-
-        // Go to the next (previous) item
-        i--;
-      }
+      // Mark the frames of all other items as "can be removed if required". The eviction policy
+      // ranks them right before space is needed and only as many frames as needed are removed.
+      this->enqueueOtherItemsForEviction(allItems, itemPos);
 
       // Enqueue the job. This is the only job.
       // We will not delete any frames from any other items to cache frames from other items.
@@ -953,17 +911,133 @@ void VideoCache::updateCacheQueue()
     qDebug() << itemStr;
   }
 #endif
+
+  this->announceCacheQueueToItems(allItemsTop);
 }
 
 void VideoCache::enqueueCacheJob(playlistItem *item, indexRange range)
 {
   // Only schedule frames for caching that were not yet cached.
   QList<int> cachedFrames = item->getCachedFrames();
-  int        i            = range.first;
-  while (cachedFrames.contains(i) && i < range.second)
-    range.first = ++i;
-  if (range.first != range.second)
-    cacheQueue.append(cacheJob(item, range));
+
+  auto sequentialRanges = item->getSequentialCachingRanges(range);
+  if (sequentialRanges.empty())
+  {
+    int i = range.first;
+    while (cachedFrames.contains(i) && i < range.second)
+      range.first = ++i;
+    if (range.first != range.second)
+      cacheQueue.append(cacheJob(item, range));
+    return;
+  }
+
+  for (auto subRange : sequentialRanges)
+  {
+    while (cachedFrames.contains(subRange.first) && subRange.first <= subRange.second)
+      subRange.first++;
+    if (subRange.first <= subRange.second)
+      cacheQueue.append(cacheJob(item, subRange, true));
+  }
+}
+
+void VideoCache::announceCacheQueueToItems(const QList<playlistItem *> &items)
+{
+  for (auto item : items)
+  {
+    std::vector<indexRange> queuedRanges;
+    for (const auto &job : this->cacheQueue)
+      if (job.plItem == item)
+        queuedRanges.push_back(job.frameRange);
+    item->setQueuedCachingRanges(queuedRanges);
+  }
+}
+
+void VideoCache::recordFrameAccess(const playlistItem *item, int frameIndex)
+{
+  this->itemEvictionInfo[item].lastAccessOfFrame[frameIndex] = ++this->accessCounter;
+}
+
+void VideoCache::recordCachingDuration(const playlistItem *item, double seconds)
+{
+  // Average over the last measurements so that the estimate follows changes of the item (e.g. a
+  // different decoder or conversion settings).
+  constexpr auto MAX_AVERAGED_MEASUREMENTS = 16;
+
+  auto &info          = this->itemEvictionInfo[item];
+  info.nrMeasurements = std::min(info.nrMeasurements + 1, MAX_AVERAGED_MEASUREMENTS);
+  info.averageCachingDuration += (seconds - info.averageCachingDuration) / info.nrMeasurements;
+}
+
+int VideoCache::getReloadDistance(playlistItem *item, int frameIndex)
+{
+  // Items that can only be cached sequentially have to cache all frames from the start of the
+  // independent range (e.g. the last random access point) to get a removed frame back. The ranges
+  // only change with the start/end range of the item (or when the item needs a recache, which
+  // drops the eviction info).
+  auto &     info          = this->itemEvictionInfo[item];
+  const auto startEndRange = item->properties().startEndRange;
+  if (!info.sequentialRangesValid || info.sequentialRangesOf != startEndRange)
+  {
+    info.sequentialRanges      = item->getSequentialCachingRanges(startEndRange);
+    info.sequentialRangesOf    = startEndRange;
+    info.sequentialRangesValid = true;
+  }
+
+  // The ranges are sorted and do not overlap
+  const auto &ranges = info.sequentialRanges;
+  auto        it     = std::upper_bound(
+      ranges.begin(), ranges.end(), frameIndex, [](int frameIndex, indexRange range) {
+        return frameIndex < range.first;
+      });
+  if (it == ranges.begin() || frameIndex > std::prev(it)->second)
+    return 1;
+  return frameIndex - std::prev(it)->first + 1;
+}
+
+void VideoCache::enqueueOtherItemsForEviction(const QList<playlistItem *> &allItems, int itemPos)
+{
+  // Start with the item before the one before the currently selected one and go back through the
+  // list, wrap around and keep going until we are at the currently selected item. Then (as the
+  // last resort) go to the item before the currently selected one. Within an item, the frames at
+  // the back are removed first.
+  const auto nrItems = int(allItems.count());
+  for (int distance = 2; distance <= nrItems; distance++)
+  {
+    // The item at a distance of nrItems is the selected item itself. Take the previous one instead.
+    const auto pos          = (itemPos + nrItems - (distance < nrItems ? distance : 1)) % nrItems;
+    const auto cachedFrames = allItems[pos]->getCachedFrames();
+    for (int f = int(cachedFrames.count()) - 1; f >= 0; f--)
+      this->cacheDeQueue.enqueue(plItemFrame(allItems[pos], cachedFrames[f]));
+  }
+}
+
+void VideoCache::sortCacheDeQueueForEviction()
+{
+  if (!this->evictionPolicy || this->cacheDeQueue.count() < 2)
+    return;
+
+  QMap<const playlistItem *, int64_t> frameSizeOfItem;
+  std::vector<EvictionCandidate>      candidates;
+  candidates.reserve(this->cacheDeQueue.count());
+  for (const auto &itemFrame : this->cacheDeQueue)
+  {
+    auto       item       = itemFrame.first.data();
+    const auto frameIndex = itemFrame.second;
+    if (!frameSizeOfItem.contains(item))
+      frameSizeOfItem[item] = int64_t(item->getCachingFrameSize());
+
+    EvictionCandidate candidate;
+    candidate.frameSize  = frameSizeOfItem[item];
+    candidate.reloadCost = this->itemEvictionInfo.value(item).averageCachingDuration *
+                           this->getReloadDistance(item, frameIndex);
+    candidate.lastAccess = this->itemEvictionInfo[item].lastAccessOfFrame.value(frameIndex, 0);
+    candidates.push_back(candidate);
+  }
+
+  QQueue<plItemFrame> sortedDeQueue;
+  for (const auto index : this->evictionPolicy->getEvictionOrder(candidates))
+    sortedDeQueue.enqueue(this->cacheDeQueue.at(int(index)));
+  this->cacheDeQueue = sortedDeQueue;
 }
 
 void VideoCache::startCaching()
@@ -983,6 +1057,30 @@ void VideoCache::startCaching()
 
     workersState = jobStarted ? workersRunning : workersIdle;
   }
+
+  updateIntraFrameThreads();
+}
+
+void VideoCache::updateIntraFrameThreads()
+{
+  if (!intraFrameThreadingEnabled)
+  {
+    intraFrameThreads::setNrSpareThreads(0);
+    return;
+  }
+
+  // The interactive threads are not counted in nrThreadsTotal but they use a core when working.
+  int threadsWorking = 0;
+  for (loadingThread *t : cachingThreadList)
+    if (t->worker()->isWorking())
+      threadsWorking++;
+  for (int i = 0; i < 2; i++)
+    if (interactiveThread[i]->worker()->isWorking())
+      threadsWorking++;
+
+  intraFrameThreads::setNrSpareThreads(nrThreadsTotal - threadsWorking);
+  DEBUG_CACHING_DETAIL("VideoCache::updateIntraFrameThreads %d threads working",
+                       threadsWorking);
 }
 
 void VideoCache::watchItemForCachingFinished(playlistItem *item)
@@ -1026,6 +1124,10 @@ void VideoCache::threadCachingFinished()
   DEBUG_CACHING_DETAIL(
       "VideoCache::threadCachingFinished - state %d - worker %p", workersState, worker);
 
+  if (worker->getLastCachingDuration() >= 0.0 &&
+      !itemsToDelete.contains(worker->getLastCachedItem()))
+    this->recordCachingDuration(worker->getLastCachedItem(), worker->getLastCachingDuration());
+
   // Check if all threads have stopped.
   bool jobsRunning = false;
   for (loadingThread *t : cachingThreadList)
@@ -1200,6 +1302,8 @@ void VideoCache::threadCachingFinished()
     }
   }
 
+  updateIntraFrameThreads();
+
   // Start/stop the timer that will update the caching status widget and the debug stuff
   if (statusUpdateTimer.isActive() && workersState == workersIdle)
     // Stop the timer and update one last time
@@ -1304,6 +1408,23 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
           continue;
       }
 
+      if (job.sequential)
+      {
+        // The frames of a sequential range are cached in order. While another thread is still
+        // caching the frame right before the next frame of the range, the range can not be
+        // continued. Look for a different range. Once that frame is done, any thread may continue.
+        bool rangeIsBusy = false;
+        for (loadingThread *t : cachingThreadList)
+        {
+          auto worker = t->worker();
+          if (t != thread && worker->isWorking() && worker->getCacheItem() == job.plItem &&
+              worker->getCacheFrame() == job.frameRange.first - 1)
+            rangeIsBusy = true;
+        }
+        if (rangeIsBusy)
+          continue;
+      }
+
       // We can start another thread for this item
       plItem = job.plItem;
       range  = job.frameRange;
@@ -1328,7 +1449,12 @@ bool VideoCache::pushNextJobToCachingThread(loadingThread *thread)
   // We found an item that we can cache. Cache the first frame of it.
   int frameToCache = range.first;
 
-  // First check if we need to free up space to cache this frame.
+  // First check if we need to free up space to cache this frame. The victims are chosen by the
+  // eviction policy right before they are removed so that the accesses and caching durations that
+  // were recorded since the last update of the queues are considered. During playback, the order
+  // of the frames to remove follows the order of playback.
+  if (cacheLevelCurrent + frameSize >= cacheLevelMax && !playback->playing())
+    this->sortCacheDeQueueForEviction();
   while (cacheLevelCurrent + frameSize >= cacheLevelMax && !cacheDeQueue.isEmpty())
   {
     plItemFrame  frameToRemove     = cacheDeQueue.dequeue();
@@ -1368,6 +1494,7 @@ void VideoCache::itemAboutToBeDeleted(playlistItem *item)
 {
   // One of the items is about to be deleted. Let's stop the caching. Then the item can be deleted
   // and then we can re-think our caching strategy.
+  this->itemEvictionInfo.remove(item);
 
   // Are we currently loading a frame from this item in one of the interactive loading threads?
   bool loadingItem = (interactiveThread[0]->worker()->getCacheItem() == item ||
@@ -1424,7 +1551,9 @@ void VideoCache::itemNeedsRecache(playlistItem *item, recacheIndicator clearItem
   {
     // Something about the given playlistitem changed and all items in the cache are invalid.
     // If a thread is currently caching the given item, we have to stop caching, clear the cache,
-    // rethink what to cache and restart the caching.
+    // rethink what to cache and restart the caching. The measured caching times are not valid
+    // anymore either.
+    this->itemEvictionInfo.remove(item);
     if (workersState != workersIdle)
     {
       // Are we currently caching a frame from this item?
@@ -35,12 +35,16 @@
 #include <QDockWidget>
 #include <QElapsedTimer>
 #include <QLabel>
+#include <QMap>
 #include <QPointer>
 #include <QProgressDialog>
 #include <QQueue>
 #include <QTimer>
 #include <QWidget>
 
+#include <memory>
+
+#include "CacheEvictionPolicy.h"
 #include "ui/widgets/PlaylistTreeWidget.h"
 
 namespace video
@@ -109,17 +113,21 @@ private slots:
   void updateCacheQueue();
 
 private:
-  // A cache job. Has a pointer to a playlist item and a range of frames to be cached.
+  // A cache job. Has a pointer to a playlist item and a range of frames to be cached. If the job is
+  // sequential, the frames must be cached in order by one thread (see
+  // playlistItem::getSequentialCachingRanges()).
   struct cacheJob
   {
     cacheJob() {}
-    cacheJob(playlistItem *item, indexRange range)
+    cacheJob(playlistItem *item, indexRange range, bool sequential = false)
     {
-      plItem     = item;
-      frameRange = range;
+      plItem           = item;
+      frameRange       = range;
+      this->sequential = sequential;
     }
     QPointer<playlistItem> plItem;
     indexRange             frameRange;
+    bool                   sequential{false};
   };
   typedef QPair<QPointer<playlistItem>, int> plItemFrame;
 
@@ -142,8 +150,38 @@ private:
   int64_t cacheLevelCurrent;
 
   // Enqueue the job in the queue. If all frames within the range are already cached in the item, do
-  // nothing.
+  // nothing. If the item can only cache sequentially, one job per independent range is enqueued.
   void enqueueCacheJob(playlistItem *item, indexRange range);
+  // Tell all items which of their frames are in the cache queue (see
+  // playlistItem::setQueuedCachingRanges()).
+  void announceCacheQueueToItems(const QList<playlistItem *> &items);
+
+  // Decides in which order the frames in the cacheDeQueue are removed (the EvictionPolicy setting)
+  std::unique_ptr<CacheEvictionPolicy> evictionPolicy;
+  // What we know about the frames of each item: How long caching one frame takes on average (in
+  // seconds) and when each frame was accessed the last time (a value of the accessCounter).
+  struct ItemEvictionInfo
+  {
+    double             averageCachingDuration{};
+    int                nrMeasurements{};
+    QMap<int, int64_t> lastAccessOfFrame;
+    // The result of getSequentialCachingRanges() for the start/end range sequentialRangesOf
+    std::vector<indexRange> sequentialRanges;
+    indexRange              sequentialRangesOf{};
+    bool                    sequentialRangesValid{};
+  };
+  QMap<const playlistItem *, ItemEvictionInfo> itemEvictionInfo;
+  int64_t                                      accessCounter{};
+  void recordFrameAccess(const playlistItem *item, int frameIndex);
+  void recordCachingDuration(const playlistItem *item, double seconds);
+  // How many frames have to be cached to get the given frame of the item back into the cache
+  int getReloadDistance(playlistItem *item, int frameIndex);
+  // Enqueue all cached frames of all items but the selected one (at itemPos) in the cacheDeQueue in
+  // the order of the playlist based priorities.
+  void enqueueOtherItemsForEviction(const QList<playlistItem *> &allItems, int itemPos);
+  // Reorder the cacheDeQueue (which is in the order of the playlist based priorities) using the
+  // eviction policy. Called right before frames are removed from the cache.
+  void sortCacheDeQueueForEviction();
 
   // Start the given number of worker threads (if caching is running, also new jobs will be pushed
   // to the workers)
@@ -154,6 +192,13 @@ private:
   // How many threads are to be used when playback is running?
   int nrThreadsPlayback;
 
+  // The total number of threads that we may use (the NrThreads setting). Threads that are not
+  // busy caching or loading can be used to convert a single frame in parallel.
+  int  nrThreadsTotal{1};
+  bool intraFrameThreadingEnabled{true};
+  // Count the idle threads and update the number of threads available for intra frame conversion.
+  void updateIntraFrameThreads();
+
   // Our tiny internal state machine for the workers
   enum workersStateEnum
   {
@@ -139,7 +139,8 @@ unsigned videoHandlerRGB::getCachingFrameSize() const
 {
   auto hasAlpha = this->srcPixelFormat.hasAlpha();
   auto bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
-  return this->frameSize.width * this->frameSize.height * bytes;
+  return this->frameSize.width * this->frameSize.height * bytes +
+         this->getCachingPyramidSize(bytes);
 }
 
 QStringPairList videoHandlerRGB::getPixelValues(const QPoint &pixelPos,
@@ -540,12 +541,7 @@ void videoHandlerRGB::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   // before the RGB format can change.
   rgbFormatMutex.lock();
 
-  requestDataMutex.lock();
-  emit signalRequestRawData(frameIndex, true);
-  tmpBufferRawRGBDataCaching = rawData;
-  requestDataMutex.unlock();
-
-  if (frameIndex != rawData_frameIndex)
+  if (!this->requestRawDataForCaching(frameIndex, tmpBufferRawRGBDataCaching))
   {
     // Loading failed
     currentImageIndex = -1;
@@ -32,7 +32,9 @@
 
 #include "videoHandler.h"
 
+#include <QMetaMethod>
 #include <QPainter>
+#include <QtConcurrent>
 
 #include <common/FunctionsGui.h>
 
@@ -47,10 +49,23 @@ namespace video
 #define DEBUG_VIDEO(fmt, ...) ((void)0)
 #endif
 
+namespace
+{
+
+// The image pyramid is only used if the image is drawn smaller than this
+constexpr double PYRAMID_MAX_ZOOM_FACTOR = 0.5;
+
+} // namespace
+
 videoHandler::videoHandler()
 {
 }
 
+videoHandler::~videoHandler()
+{
+  this->currentImagePyramidFuture.waitForFinished();
+}
+
 void videoHandler::slotVideoControlChanged()
 {
   // Update the controls and get the new selected size
@@ -191,11 +206,14 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
     }
     else
     {
-      QMutexLocker lock(&imageCacheAccess);
-      if (cacheValid && imageCache.contains(frameIdx))
+      ImagePyramid cachedPyramid;
+      auto         cachedImage = this->getImageFromCache(frameIdx, &cachedPyramid);
+      if (!cachedImage.isNull())
       {
-        currentImage      = imageCache[frameIdx];
-        currentImageIndex = frameIdx;
+        QMutexLocker setLock(&currentImageSetMutex);
+        currentImage        = cachedImage;
+        currentImagePyramid = cachedPyramid;
+        currentImageIndex   = frameIdx;
         DEBUG_VIDEO("videoHandler::drawFrame %d loaded from cache", frameIdx);
       }
     }
@@ -209,9 +227,16 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
   videoRect.setSize(QSize(frameSize.width * zoomFactor, frameSize.height * zoomFactor));
   videoRect.moveCenter(QPoint(0, 0));
 
-  // Draw the current image (currentImage)
+  // Draw the current image (currentImage). When zoomed out, a pyramid of downscaled images is
+  // used. If the image did not come with one from the cache, it is built in the background. Until
+  // then, the full resolution image is drawn.
   currentImageSetMutex.lock();
-  painter->drawImage(videoRect, currentImage);
+  if (!currentImagePyramid.isBuiltFrom(currentImage) && zoomFactor < PYRAMID_MAX_ZOOM_FACTOR &&
+      ImagePyramid::isUseful(currentImage.size()))
+    this->buildCurrentImagePyramidInBackground();
+  const auto pyramid =
+      currentImagePyramid.isBuiltFrom(currentImage) ? &currentImagePyramid : nullptr;
+  drawImageClipped(painter, videoRect, currentImage, pyramid);
   currentImageSetMutex.unlock();
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
@@ -221,6 +246,26 @@ void videoHandler::drawFrame(QPainter *painter, int frameIdx, double zoomFactor,
   }
 }
 
+void videoHandler::buildCurrentImagePyramidInBackground()
+{
+  if (this->currentImagePyramidFuture.isRunning())
+    return;
+
+  this->currentImagePyramidFuture = QtConcurrent::run(
+      [this, image = this->currentImage]()
+      {
+        ImagePyramid pyramid(image);
+        {
+          QMutexLocker setLock(&this->currentImageSetMutex);
+          if (pyramid.isBuiltFrom(this->currentImage))
+            this->currentImagePyramid = std::move(pyramid);
+        }
+        // If the image changed in the meantime, the redraw starts building the pyramid of the new
+        // image.
+        emit signalHandlerChanged(true, RECACHE_NONE);
+      });
+}
+
 QImage videoHandler::calculateDifference(FrameHandler *   item2,
                                          const int        frameIdxItem0,
                                          const int        frameIdxItem1,
@@ -278,26 +323,63 @@ void videoHandler::cacheFrame(int frameIdx, bool testMode)
   }
 
   // Load the frame. While this is happening in the background the frame size must not change.
-  QImage cacheImage;
-  loadFrameForCaching(frameIdx, cacheImage);
+  CachedFrame cachedFrame;
+  if (this->cachesRawFrames())
+    this->loadRawFrameForCaching(frameIdx, cachedFrame.rawData);
+  else
+  {
+    loadFrameForCaching(frameIdx, cachedFrame.image);
+    if (ImagePyramid::isUseful(cachedFrame.image.size()))
+      cachedFrame.pyramid = ImagePyramid(cachedFrame.image);
+  }
 
   // Put it into the cache
-  if (!cacheImage.isNull())
+  if (!cachedFrame.image.isNull() || !cachedFrame.rawData.isEmpty())
   {
     DEBUG_VIDEO("videoHandler::cacheFrame insert frame %i into cache", frameIdx);
     QMutexLocker imageCacheLock(&imageCacheAccess);
     if (cacheValid && !testMode)
-      imageCache.insert(frameIdx, cacheImage);
+      imageCache.insert(frameIdx, cachedFrame);
   }
   else
     DEBUG_VIDEO("videoHandler::cacheFrame loading frame %i for caching failed", frameIdx);
 }
 
+QImage videoHandler::getImageFromCache(int frameIdx, ImagePyramid *pyramid)
+{
+  CachedFrame cachedFrame;
+  {
+    QMutexLocker lock(&imageCacheAccess);
+    if (!cacheValid || !imageCache.contains(frameIdx))
+      return {};
+    cachedFrame = imageCache.value(frameIdx);
+  }
+
+  // The conversion is done without holding the lock so that the caching threads are not blocked
+  if (cachedFrame.image.isNull() && !cachedFrame.rawData.isEmpty())
+  {
+    DEBUG_VIDEO("videoHandler::getImageFromCache converting raw frame %d", frameIdx);
+    return this->convertCachedRawFrame(cachedFrame.rawData);
+  }
+  if (pyramid != nullptr)
+    *pyramid = cachedFrame.pyramid;
+  return cachedFrame.image;
+}
+
 unsigned videoHandler::getCachingFrameSize() const
 {
   const auto hasAlpha = false;
   auto       bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
-  return this->frameSize.width * this->frameSize.height * bytes;
+  return this->frameSize.width * this->frameSize.height * bytes +
+         this->getCachingPyramidSize(bytes);
+}
+
+unsigned videoHandler::getCachingPyramidSize(int bytesPerPixel) const
+{
+  // The pyramids of all cached frames are built (if they are useful), independent of the zoom
+  // factor. So the size of a cached frame does not change when zooming.
+  const auto imageSize = QSize(this->frameSize.width, this->frameSize.height);
+  return unsigned(ImagePyramid::getMemoryUsage(imageSize, bytesPerPixel));
 }
 
 QList<int> videoHandler::getCachedFrames() const
@@ -385,6 +467,35 @@ void videoHandler::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   frameToCache = requestedFrame;
 }
 
+bool videoHandler::requestRawDataForCaching(int frameIndex, RawFrameBuffer &frameOut)
+{
+  static const auto concurrentSignal =
+      QMetaMethod::fromSignal(&videoHandler::signalRequestRawDataForCaching);
+  if (this->isSignalConnected(concurrentSignal))
+  {
+    auto success = false;
+    emit signalRequestRawDataForCaching(frameIndex, frameOut, success);
+    return success;
+  }
+
+  QMutexLocker lock(&this->requestDataMutex);
+
+  emit signalRequestRawData(frameIndex, true);
+  if (this->rawData_frameIndex != frameIndex)
+    return false;
+  frameOut = RawFrameBuffer(this->rawData);
+  return true;
+}
+
+bool videoHandler::requestRawDataForCaching(int frameIndex, QByteArray &rawDataOut)
+{
+  RawFrameBuffer frame;
+  if (!this->requestRawDataForCaching(frameIndex, frame))
+    return false;
+  rawDataOut = frame.toByteArray();
+  return true;
+}
+
 void videoHandler::invalidateAllBuffers()
 {
   currentFrameRawData_frameIndex = -1;
@@ -35,10 +35,13 @@
 #include <filesource/FrameFormatGuess.h>
 
 #include "FrameHandler.h"
+#include "ImagePyramid.h"
 #include "PixelFormat.h"
+#include "RawFrameBuffer.h"
 
 #include <QBasicTimer>
 #include <QFileInfo>
+#include <QFuture>
 #include <QMutex>
 
 namespace video
@@ -52,6 +55,7 @@ public:
   /*
    */
   videoHandler();
+  ~videoHandler();
 
   // Draw the frame with the given frame index and zoom factor. If onLoadShowLasFrame is set, show
   // the last frame if the frame with the current frame index is loaded in the background.
@@ -68,6 +72,13 @@ public:
   virtual void     removeFrameFromCache(int frameIndex);
   virtual void     removeAllFrameFromCache();
 
+  // Get the raw data of the given frame without converting it and without using the cache. Like
+  // caching, this can be called from multiple threads. Returns false if loading failed.
+  bool loadRawFrame(int frameIndex, RawFrameBuffer &frameOut)
+  {
+    return this->requestRawDataForCaching(frameIndex, frameOut);
+  }
+
   // Get the number of bytes for one frame (RGB or YUV) with the current format (if this video
   // handler uses raw data)
   virtual int64_t getBytesPerFrame() const { return -1; }
@@ -154,6 +165,14 @@ signals:
   // function returns.
   void signalRequestRawData(int frameIndex, bool caching);
 
+  // Items that can provide the raw data of several frames at the same time (e.g. because they use
+  // more than one decoder for caching) can connect to this signal. If it is connected, it is used
+  // for caching instead of signalRequestRawData. The frame must be written to frameOut and success
+  // must be set. The frame may point to memory of the item (e.g. a decoder) which must stay valid
+  // until the last copy of frameOut is destroyed. The signal is emitted from multiple caching
+  // threads without any locking.
+  void signalRequestRawDataForCaching(int frameIndex, RawFrameBuffer &frameOut, bool &success);
+
 protected:
   // --- Drawing: The current frame is kept in the FrameHandler::currentImage. But if
   // currentImageIndex is not identical to the requested frame in the draw event, we will have to
@@ -173,6 +192,12 @@ protected:
   // Only one thread at a time should request something to be loaded.
   QMutex requestDataMutex;
 
+  // Request the raw data of the given frame for caching. Uses signalRequestRawDataForCaching if
+  // connected and signalRequestRawData otherwise. Returns false if loading failed. The QByteArray
+  // version always provides the data in one consecutive buffer (which may require a copy).
+  bool requestRawDataForCaching(int frameIndex, RawFrameBuffer &frameOut);
+  bool requestRawDataForCaching(int frameIndex, QByteArray &rawDataOut);
+
   // We might need to update the currentImage
   int currentImage_frameIndex{-1};
 
@@ -193,8 +218,39 @@ protected:
   void setCacheInvalid() { cacheValid = false; }
 
   // --- Caching
+  // A cached frame is either the converted image or (if the handler caches raw frames, see
+  // cachesRawFrames()) the raw data of the frame which is converted when the frame is drawn.
+  struct CachedFrame
+  {
+    QImage       image;
+    QByteArray   rawData;
+    ImagePyramid pyramid;
+  };
   QMutex mutable imageCacheAccess;
-  QMap<int, QImage> imageCache;
+  QMap<int, CachedFrame> imageCache;
+
+  // Get the image of the given frame from the cache. If the raw frame was cached, it is converted
+  // now. Returns a null image if the frame is not in the cache. If the image pyramid of the frame
+  // was cached as well, it is written to pyramid.
+  QImage getImageFromCache(int frameIndex, ImagePyramid *pyramid = nullptr);
+
+  // The downscaled versions of currentImage. This comes from the cache or is built in the
+  // background when the current image is drawn zoomed out. Protected by the currentImageSetMutex.
+  ImagePyramid  currentImagePyramid;
+  QFuture<void> currentImagePyramidFuture;
+  // Start building the pyramid of the current image in the background (if this is not already
+  // running). The handler is redrawn when it is done. Call with the currentImageSetMutex locked.
+  void buildCurrentImagePyramidInBackground();
+
+  // The memory that the pyramid of a cached frame needs (see getCachingFrameSize)
+  unsigned getCachingPyramidSize(int bytesPerPixel) const;
+
+  // A video handler can cache the raw frames instead of the converted images. This usually needs
+  // less memory and the conversion settings can be changed without recaching. However, every frame
+  // has to be converted when it is drawn. By default, the converted images are cached.
+  virtual bool   cachesRawFrames() const { return false; }
+  virtual bool   loadRawFrameForCaching(int, QByteArray &) { return false; }
+  virtual QImage convertCachedRawFrame(const QByteArray &) { return {}; }
   // Is the cache valid? The cache can be ivalid in the following scenario:
   // Somethign about how an item is shown changes (e.g. the resolution) but caching of the item is
   // currently performed. If we just cleared the cache, the wrong (currently being cached) frames
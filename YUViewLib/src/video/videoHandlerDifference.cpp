@@ -76,10 +76,10 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
     }
     else
     {
-      QMutexLocker lock(&imageCacheAccess);
-      if (cacheValid && imageCache.contains(frameIdx))
+      auto cachedImage = this->getImageFromCache(frameIdx);
+      if (!cachedImage.isNull())
       {
-        currentImage      = imageCache[frameIdx];
+        currentImage      = cachedImage;
         currentImageIndex = frameIdx;
         DEBUG_VIDEO("videoHandler::drawFrame %d loaded from cache", frameIdx);
       }
@@ -93,7 +93,7 @@ void videoHandlerDifference::drawDifferenceFrame(QPainter *painter,
 
   // Draw the current image (currentImage)
   currentImageSetMutex.lock();
-  painter->drawImage(videoRect, currentImage);
+  drawImageClipped(painter, videoRect, currentImage);
   currentImageSetMutex.unlock();
 
   if (drawRawValues && zoomFactor >= SPLITVIEW_DRAW_VALUES_ZOOMFACTOR)
@@ -0,0 +1,489 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConversionYUVSIMD.h"
+
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define YUVIEW_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define YUVIEW_SIMD_X86 0
+#endif
+
+// With gcc and clang, the vectorized functions are compiled for their instruction set using the
+// target attribute. This way, the rest of YUView does not have to be built with these flags and we
+// can decide at runtime which version to use. MSVC allows the use of all intrinsics without flags.
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE4_1
+#define TARGET_AVX2
+#endif
+
+namespace video::yuv::simd
+{
+
+namespace
+{
+
+InstructionSet detectInstructionSet()
+{
+#if YUVIEW_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+  int cpuInfo[4];
+  __cpuid(cpuInfo, 0);
+  const auto maxLeaf = cpuInfo[0];
+
+  __cpuid(cpuInfo, 1);
+  const bool sse4_1 = (cpuInfo[2] & (1 << 19)) != 0;
+  // AVX2 also requires that the OS saves the YMM registers (OSXSAVE and XCR0 bits 1 and 2)
+  const bool osxsave = (cpuInfo[2] & (1 << 27)) != 0;
+  const bool avx     = (cpuInfo[2] & (1 << 28)) != 0;
+  bool       avx2    = false;
+  if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+  {
+    __cpuidex(cpuInfo, 7, 0);
+    avx2 = (cpuInfo[1] & (1 << 5)) != 0;
+  }
+#else
+  __builtin_cpu_init();
+  const bool sse4_1 = __builtin_cpu_supports("sse4.1");
+  const bool avx2   = __builtin_cpu_supports("avx2");
+#endif
+  if (avx2)
+    return InstructionSet::AVX2;
+  if (sse4_1)
+    return InstructionSet::SSE4_1;
+#endif
+  return InstructionSet::Scalar;
+}
+
+inline uint8_t clipTo8Bit(const int value)
+{
+  return uint8_t((value < 0) ? 0 : (value > 255) ? 255 : value);
+}
+
+// The reference implementation. This is also used for the remaining samples at the end of each
+// line that do not fill a whole vector.
+template <typename T>
+void convertLineScalar(const T *srcY,
+                       const T *srcU,
+                       const T *srcV,
+                       uint8_t *dst,
+                       const int                   startX,
+                       const int                   width,
+                       const int                   chromaSubsamplingHor,
+                       const ConversionParameters &parameters)
+{
+  const auto &c           = parameters.coefficients;
+  const auto  chromaShift = (chromaSubsamplingHor == 2) ? 1 : 0;
+
+  for (int x = startX; x < width; x++)
+  {
+    const int valY = (int(srcY[x]) >> parameters.inputShift) - parameters.yOffset;
+    const int valU = (int(srcU[x >> chromaShift]) >> parameters.inputShift) - parameters.cZero;
+    const int valV = (int(srcV[x >> chromaShift]) >> parameters.inputShift) - parameters.cZero;
+
+    const int yTmp = valY * c[0];
+    const int valR = (yTmp + valV * c[1]) >> parameters.outputShift;
+    const int valG = (yTmp + valU * c[2] + valV * c[3]) >> parameters.outputShift;
+    const int valB = (yTmp + valU * c[4]) >> parameters.outputShift;
+
+    dst[x * 4]     = clipTo8Bit(valB);
+    dst[x * 4 + 1] = clipTo8Bit(valG);
+    dst[x * 4 + 2] = clipTo8Bit(valR);
+    dst[x * 4 + 3] = 255;
+  }
+}
+
+#if YUVIEW_SIMD_X86
+
+// Load 16 samples as two vectors of 8 unsigned 16 bit values
+template <typename T>
+TARGET_SSE4_1 inline void load16Samples(const T *src, __m128i &low, __m128i &high)
+{
+  if constexpr (std::is_same_v<T, uint8_t>)
+  {
+    const auto samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    low                = _mm_cvtepu8_epi16(samples);
+    high               = _mm_unpackhi_epi8(samples, _mm_setzero_si128());
+  }
+  else
+  {
+    low  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 8));
+  }
+}
+
+// Load 8 (chroma) samples and repeat each of them once. The result are two vectors of 8 unsigned
+// 16 bit values.
+template <typename T>
+TARGET_SSE4_1 inline void load8SamplesRepeated(const T *src, __m128i &low, __m128i &high)
+{
+  __m128i samples;
+  if constexpr (std::is_same_v<T, uint8_t>)
+    samples = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+  else
+    samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+  low  = _mm_unpacklo_epi16(samples, samples);
+  high = _mm_unpackhi_epi16(samples, samples);
+}
+
+template <typename T, int chromaSubsamplingHor>
+TARGET_SSE4_1 inline void load16PixelsYUV(const T *srcY,
+                                          const T *srcU,
+                                          const T *srcV,
+                                          const int x,
+                                          __m128i   y[2],
+                                          __m128i   u[2],
+                                          __m128i   v[2])
+{
+  load16Samples(srcY + x, y[0], y[1]);
+  if constexpr (chromaSubsamplingHor == 1)
+  {
+    load16Samples(srcU + x, u[0], u[1]);
+    load16Samples(srcV + x, v[0], v[1]);
+  }
+  else
+  {
+    load8SamplesRepeated(srcU + x / 2, u[0], u[1]);
+    load8SamplesRepeated(srcV + x / 2, v[0], v[1]);
+  }
+}
+
+// Pack the given 2x8 signed 16 bit values for B, G and R to 8 bit (with saturation) and write 16
+// BGRA pixels.
+TARGET_SSE4_1 inline void
+store16PixelsBGRA(const __m128i b[2], const __m128i g[2], const __m128i r[2], uint8_t *dst)
+{
+  const auto valB  = _mm_packus_epi16(b[0], b[1]);
+  const auto valG  = _mm_packus_epi16(g[0], g[1]);
+  const auto valR  = _mm_packus_epi16(r[0], r[1]);
+  const auto alpha = _mm_set1_epi8(-1);
+
+  const auto bgLow  = _mm_unpacklo_epi8(valB, valG);
+  const auto bgHigh = _mm_unpackhi_epi8(valB, valG);
+  const auto raLow  = _mm_unpacklo_epi8(valR, alpha);
+  const auto raHigh = _mm_unpackhi_epi8(valR, alpha);
+
+  auto out = reinterpret_cast<__m128i *>(dst);
+  _mm_storeu_si128(out, _mm_unpacklo_epi16(bgLow, raLow));
+  _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(bgLow, raLow));
+  _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(bgHigh, raHigh));
+  _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(bgHigh, raHigh));
+}
+
+struct ConstantsSSE4_1
+{
+  TARGET_SSE4_1 explicit ConstantsSSE4_1(const ConversionParameters &parameters)
+  {
+    for (int i = 0; i < 5; i++)
+      this->coefficients[i] = _mm_set1_epi32(parameters.coefficients[i]);
+    this->yOffset     = _mm_set1_epi32(parameters.yOffset);
+    this->cZero       = _mm_set1_epi32(parameters.cZero);
+    this->inputShift  = _mm_cvtsi32_si128(parameters.inputShift);
+    this->outputShift = _mm_cvtsi32_si128(parameters.outputShift);
+  }
+
+  __m128i coefficients[5];
+  __m128i yOffset;
+  __m128i cZero;
+  __m128i inputShift;
+  __m128i outputShift;
+};
+
+// Convert 4 pixels (32 bit integers) to RGB (32 bit integers, not clipped yet)
+TARGET_SSE4_1 inline void convert4PixelsSSE4_1(__m128i                valY,
+                                               __m128i                valU,
+                                               __m128i                valV,
+                                               const ConstantsSSE4_1 &k,
+                                               __m128i               &valR,
+                                               __m128i               &valG,
+                                               __m128i               &valB)
+{
+  valY = _mm_sub_epi32(_mm_srl_epi32(valY, k.inputShift), k.yOffset);
+  valU = _mm_sub_epi32(_mm_srl_epi32(valU, k.inputShift), k.cZero);
+  valV = _mm_sub_epi32(_mm_srl_epi32(valV, k.inputShift), k.cZero);
+
+  const auto yTmp = _mm_mullo_epi32(valY, k.coefficients[0]);
+  valR = _mm_add_epi32(yTmp, _mm_mullo_epi32(valV, k.coefficients[1]));
+  valG = _mm_add_epi32(_mm_add_epi32(yTmp, _mm_mullo_epi32(valU, k.coefficients[2])),
+                       _mm_mullo_epi32(valV, k.coefficients[3]));
+  valB = _mm_add_epi32(yTmp, _mm_mullo_epi32(valU, k.coefficients[4]));
+
+  valR = _mm_sra_epi32(valR, k.outputShift);
+  valG = _mm_sra_epi32(valG, k.outputShift);
+  valB = _mm_sra_epi32(valB, k.outputShift);
+}
+
+// Convert 8 pixels (unsigned 16 bit) to RGB (signed 16 bit with saturation)
+TARGET_SSE4_1 inline void convert8PixelsSSE4_1(const __m128i          valY,
+                                               const __m128i          valU,
+                                               const __m128i          valV,
+                                               const ConstantsSSE4_1 &k,
+                                               __m128i               &valR,
+                                               __m128i               &valG,
+                                               __m128i               &valB)
+{
+  const auto zero = _mm_setzero_si128();
+  __m128i    r[2], g[2], b[2];
+  convert4PixelsSSE4_1(_mm_cvtepu16_epi32(valY),
+                       _mm_cvtepu16_epi32(valU),
+                       _mm_cvtepu16_epi32(valV),
+                       k,
+                       r[0],
+                       g[0],
+                       b[0]);
+  convert4PixelsSSE4_1(_mm_unpackhi_epi16(valY, zero),
+                       _mm_unpackhi_epi16(valU, zero),
+                       _mm_unpackhi_epi16(valV, zero),
+                       k,
+                       r[1],
+                       g[1],
+                       b[1]);
+  valR = _mm_packs_epi32(r[0], r[1]);
+  valG = _mm_packs_epi32(g[0], g[1]);
+  valB = _mm_packs_epi32(b[0], b[1]);
+}
+
+template <typename T, int chromaSubsamplingHor>
+TARGET_SSE4_1 void convertLineSSE4_1(const T *srcY,
+                                     const T *srcU,
+                                     const T *srcV,
+                                     uint8_t *dst,
+                                     const int                   width,
+                                     const ConversionParameters &parameters)
+{
+  const ConstantsSSE4_1 k(parameters);
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m128i y[2], u[2], v[2];
+    load16PixelsYUV<T, chromaSubsamplingHor>(srcY, srcU, srcV, x, y, u, v);
+
+    __m128i r[2], g[2], b[2];
+    convert8PixelsSSE4_1(y[0], u[0], v[0], k, r[0], g[0], b[0]);
+    convert8PixelsSSE4_1(y[1], u[1], v[1], k, r[1], g[1], b[1]);
+    store16PixelsBGRA(b, g, r, dst + x * 4);
+  }
+
+  convertLineScalar(srcY, srcU, srcV, dst, x, width, chromaSubsamplingHor, parameters);
+}
+
+struct ConstantsAVX2
+{
+  TARGET_AVX2 explicit ConstantsAVX2(const ConversionParameters &parameters)
+  {
+    for (int i = 0; i < 5; i++)
+      this->coefficients[i] = _mm256_set1_epi32(parameters.coefficients[i]);
+    this->yOffset     = _mm256_set1_epi32(parameters.yOffset);
+    this->cZero       = _mm256_set1_epi32(parameters.cZero);
+    this->inputShift  = _mm_cvtsi32_si128(parameters.inputShift);
+    this->outputShift = _mm_cvtsi32_si128(parameters.outputShift);
+  }
+
+  __m256i coefficients[5];
+  __m256i yOffset;
+  __m256i cZero;
+  __m128i inputShift;
+  __m128i outputShift;
+};
+
+TARGET_AVX2 inline __m128i packTo16Bit(const __m256i values)
+{
+  return _mm_packs_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+}
+
+// Convert 8 pixels (unsigned 16 bit) to RGB (signed 16 bit with saturation)
+TARGET_AVX2 inline void convert8PixelsAVX2(const __m128i        y,
+                                           const __m128i        u,
+                                           const __m128i        v,
+                                           const ConstantsAVX2 &k,
+                                           __m128i             &valR,
+                                           __m128i             &valG,
+                                           __m128i             &valB)
+{
+  const auto valY = _mm256_sub_epi32(_mm256_srl_epi32(_mm256_cvtepu16_epi32(y), k.inputShift),
+                                     k.yOffset);
+  const auto valU =
+      _mm256_sub_epi32(_mm256_srl_epi32(_mm256_cvtepu16_epi32(u), k.inputShift), k.cZero);
+  const auto valV =
+      _mm256_sub_epi32(_mm256_srl_epi32(_mm256_cvtepu16_epi32(v), k.inputShift), k.cZero);
+
+  const auto yTmp = _mm256_mullo_epi32(valY, k.coefficients[0]);
+  const auto r    = _mm256_add_epi32(yTmp, _mm256_mullo_epi32(valV, k.coefficients[1]));
+  const auto g =
+      _mm256_add_epi32(_mm256_add_epi32(yTmp, _mm256_mullo_epi32(valU, k.coefficients[2])),
+                       _mm256_mullo_epi32(valV, k.coefficients[3]));
+  const auto b = _mm256_add_epi32(yTmp, _mm256_mullo_epi32(valU, k.coefficients[4]));
+
+  valR = packTo16Bit(_mm256_sra_epi32(r, k.outputShift));
+  valG = packTo16Bit(_mm256_sra_epi32(g, k.outputShift));
+  valB = packTo16Bit(_mm256_sra_epi32(b, k.outputShift));
+}
+
+template <typename T, int chromaSubsamplingHor>
+TARGET_AVX2 void convertLineAVX2(const T *srcY,
+                                 const T *srcU,
+                                 const T *srcV,
+                                 uint8_t *dst,
+                                 const int                   width,
+                                 const ConversionParameters &parameters)
+{
+  const ConstantsAVX2 k(parameters);
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    __m128i y[2], u[2], v[2];
+    load16PixelsYUV<T, chromaSubsamplingHor>(srcY, srcU, srcV, x, y, u, v);
+
+    __m128i r[2], g[2], b[2];
+    convert8PixelsAVX2(y[0], u[0], v[0], k, r[0], g[0], b[0]);
+    convert8PixelsAVX2(y[1], u[1], v[1], k, r[1], g[1], b[1]);
+    store16PixelsBGRA(b, g, r, dst + x * 4);
+  }
+
+  convertLineScalar(srcY, srcU, srcV, dst, x, width, chromaSubsamplingHor, parameters);
+}
+
+#endif // YUVIEW_SIMD_X86
+
+template <typename T>
+void convertLine(const InstructionSet        instructionSet,
+                 const T                    *srcY,
+                 const T                    *srcU,
+                 const T                    *srcV,
+                 uint8_t                    *dst,
+                 const int                   width,
+                 const int                   chromaSubsamplingHor,
+                 const ConversionParameters &parameters)
+{
+#if YUVIEW_SIMD_X86
+  if (instructionSet == InstructionSet::AVX2 && isInstructionSetSupported(InstructionSet::AVX2))
+  {
+    if (chromaSubsamplingHor == 2)
+      convertLineAVX2<T, 2>(srcY, srcU, srcV, dst, width, parameters);
+    else
+      convertLineAVX2<T, 1>(srcY, srcU, srcV, dst, width, parameters);
+    return;
+  }
+  if (instructionSet != InstructionSet::Scalar &&
+      isInstructionSetSupported(InstructionSet::SSE4_1))
+  {
+    if (chromaSubsamplingHor == 2)
+      convertLineSSE4_1<T, 2>(srcY, srcU, srcV, dst, width, parameters);
+    else
+      convertLineSSE4_1<T, 1>(srcY, srcU, srcV, dst, width, parameters);
+    return;
+  }
+#else
+  (void)instructionSet;
+#endif
+  convertLineScalar(srcY, srcU, srcV, dst, 0, width, chromaSubsamplingHor, parameters);
+}
+
+} // namespace
+
+InstructionSet getSupportedInstructionSet()
+{
+  static const auto supportedInstructionSet = detectInstructionSet();
+  return supportedInstructionSet;
+}
+
+bool isInstructionSetSupported(const InstructionSet instructionSet)
+{
+  return int(instructionSet) <= int(getSupportedInstructionSet());
+}
+
+std::string_view getInstructionSetName(const InstructionSet instructionSet)
+{
+  switch (instructionSet)
+  {
+  case InstructionSet::SSE4_1:
+    return "SSE4.1";
+  case InstructionSet::AVX2:
+    return "AVX2";
+  default:
+    return "Scalar";
+  }
+}
+
+ConversionParameters getConversionParameters(const std::array<int, 5> &coefficients,
+                                             const int                 bitDepth,
+                                             const bool                fullRange)
+{
+  ConversionParameters parameters;
+  parameters.coefficients = coefficients;
+
+  // For more than 14 bit, 32 bit integers are not enough for the calculation. As we clip to 8 bit
+  // anyways, the two least significant bits are dropped first.
+  const auto effectiveBitDepth = (bitDepth > 14) ? bitDepth - 2 : bitDepth;
+  parameters.inputShift        = (bitDepth > 14) ? 2 : 0;
+  parameters.yOffset           = fullRange ? 0 : 16 << (effectiveBitDepth - 8);
+  parameters.cZero             = 128 << (effectiveBitDepth - 8);
+  parameters.outputShift       = 16 + effectiveBitDepth - 8;
+  return parameters;
+}
+
+void convertLineToBGRA(const InstructionSet        instructionSet,
+                       const uint8_t              *srcY,
+                       const uint8_t              *srcU,
+                       const uint8_t              *srcV,
+                       uint8_t                    *dst,
+                       const int                   width,
+                       const int                   chromaSubsamplingHor,
+                       const ConversionParameters &parameters)
+{
+  convertLine(instructionSet, srcY, srcU, srcV, dst, width, chromaSubsamplingHor, parameters);
+}
+
+void convertLineToBGRA(const InstructionSet        instructionSet,
+                       const uint16_t             *srcY,
+                       const uint16_t             *srcU,
+                       const uint16_t             *srcV,
+                       uint8_t                    *dst,
+                       const int                   width,
+                       const int                   chromaSubsamplingHor,
+                       const ConversionParameters &parameters)
+{
+  convertLine(instructionSet, srcY, srcU, srcV, dst, width, chromaSubsamplingHor, parameters);
+}
+
+} // namespace video::yuv::simd
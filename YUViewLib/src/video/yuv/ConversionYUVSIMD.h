@@ -0,0 +1,101 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Vectorized line conversion kernels for planar YUV to BGRA. This is kept free of any Qt types so
+// that it can be used (and tested) on plain buffers.
+namespace video::yuv::simd
+{
+
+enum class InstructionSet
+{
+  Scalar,
+  SSE4_1,
+  AVX2
+};
+
+// Get the best instruction set that is supported by this build and by the CPU we are running on.
+// The CPU is only queried once.
+InstructionSet getSupportedInstructionSet();
+bool           isInstructionSetSupported(InstructionSet instructionSet);
+std::string_view getInstructionSetName(InstructionSet instructionSet);
+
+/* The integer parameters of the YUV -> RGB conversion. For every sample, the conversion is:
+ *   Y' = (Y >> inputShift) - yOffset
+ *   U' = (U >> inputShift) - cZero
+ *   V' = (V >> inputShift) - cZero
+ *   R  = clip((Y' * c[0] + V' * c[1]) >> outputShift)
+ *   G  = clip((Y' * c[0] + U' * c[2] + V' * c[3]) >> outputShift)
+ *   B  = clip((Y' * c[0] + U' * c[4]) >> outputShift)
+ * with c being the coefficients from getColorConversionCoefficients. All calculations are done in
+ * 32 bit integers just like the scalar conversion functions do.
+ */
+struct ConversionParameters
+{
+  std::array<int, 5> coefficients{};
+  int                inputShift{};
+  int                yOffset{};
+  int                cZero{};
+  int                outputShift{16};
+};
+
+// Get the parameters for the given bit depth (8 to 16 bit) that result in exactly the same output
+// as the generic scalar YUV -> RGB conversion in videoHandlerYUV.
+ConversionParameters
+getConversionParameters(const std::array<int, 5> &coefficients, int bitDepth, bool fullRange);
+
+// Convert one line of width luma samples to BGRA (8 bit per component, alpha set to 255).
+// chromaSubsamplingHor must be 1 or 2. For 2, each chroma sample is used for two luma samples
+// (sample and hold). The samples are read in the native byte order.
+void convertLineToBGRA(InstructionSet              instructionSet,
+                       const uint8_t              *srcY,
+                       const uint8_t              *srcU,
+                       const uint8_t              *srcV,
+                       uint8_t                    *dst,
+                       int                         width,
+                       int                         chromaSubsamplingHor,
+                       const ConversionParameters &parameters);
+void convertLineToBGRA(InstructionSet              instructionSet,
+                       const uint16_t             *srcY,
+                       const uint16_t             *srcU,
+                       const uint16_t             *srcV,
+                       uint8_t                    *dst,
+                       int                         width,
+                       int                         chromaSubsamplingHor,
+                       const ConversionParameters &parameters);
+
+} // namespace video::yuv::simd
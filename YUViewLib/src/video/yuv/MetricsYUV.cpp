@@ -0,0 +1,470 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricsYUV.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define YUVIEW_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define YUVIEW_SIMD_X86 0
+#endif
+
+// See ConversionYUVSIMD.cpp
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE4_1 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE4_1
+#define TARGET_AVX2
+#endif
+
+namespace video::yuv::metrics
+{
+
+namespace
+{
+
+template <typename T> const T *getLine(const Plane &plane, const int y)
+{
+  return reinterpret_cast<const T *>(plane.data + y * plane.stride);
+}
+
+template <typename T0, typename T1>
+uint64_t getSumOfSquaredErrorsLineScalar(const T0 *src0,
+                                         const T1 *src1,
+                                         const int startX,
+                                         const int width,
+                                         const int shift0,
+                                         const int shift1)
+{
+  uint64_t sum = 0;
+  for (int x = startX; x < width; x++)
+  {
+    const int64_t diff = (int64_t(src0[x]) << shift0) - (int64_t(src1[x]) << shift1);
+    sum += uint64_t(diff * diff);
+  }
+  return sum;
+}
+
+#if YUVIEW_SIMD_X86
+
+// The 32 bit accumulators of the 8 bit kernels can not overflow for lines of up to 16384 vectors.
+
+TARGET_SSE4_1 uint64_t getSumOfSquaredErrorsLineSSE4_1(const uint8_t *src0,
+                                                       const uint8_t *src1,
+                                                       const int      width)
+{
+  auto sum = _mm_setzero_si128();
+  int  x   = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    const auto val0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + x));
+    const auto val1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + x));
+    const auto diffLow  = _mm_sub_epi16(_mm_cvtepu8_epi16(val0), _mm_cvtepu8_epi16(val1));
+    const auto diffHigh = _mm_sub_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(val0, 8)),
+                                        _mm_cvtepu8_epi16(_mm_srli_si128(val1, 8)));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(diffLow, diffLow));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(diffHigh, diffHigh));
+  }
+
+  alignas(16) uint32_t sums[4];
+  _mm_store_si128(reinterpret_cast<__m128i *>(sums), sum);
+  return uint64_t(sums[0]) + sums[1] + sums[2] + sums[3] +
+         getSumOfSquaredErrorsLineScalar(src0, src1, x, width, 0, 0);
+}
+
+// The squares of the 16 bit differences need 64 bit. _mm_mul_epi32 multiplies the even 32 bit
+// elements, so the odd elements are shifted down for a second multiplication.
+TARGET_SSE4_1 inline __m128i addSquares32(const __m128i sum, const __m128i diff)
+{
+  const auto diffOdd = _mm_srli_epi64(diff, 32);
+  return _mm_add_epi64(_mm_add_epi64(sum, _mm_mul_epi32(diff, diff)),
+                       _mm_mul_epi32(diffOdd, diffOdd));
+}
+
+TARGET_SSE4_1 uint64_t getSumOfSquaredErrorsLineSSE4_1(const uint16_t *src0,
+                                                       const uint16_t *src1,
+                                                       const int       width)
+{
+  auto sum = _mm_setzero_si128();
+  int  x   = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    const auto val0     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + x));
+    const auto val1     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + x));
+    const auto diffLow  = _mm_sub_epi32(_mm_cvtepu16_epi32(val0), _mm_cvtepu16_epi32(val1));
+    const auto diffHigh = _mm_sub_epi32(_mm_cvtepu16_epi32(_mm_srli_si128(val0, 8)),
+                                        _mm_cvtepu16_epi32(_mm_srli_si128(val1, 8)));
+    sum                 = addSquares32(sum, diffLow);
+    sum                 = addSquares32(sum, diffHigh);
+  }
+
+  alignas(16) uint64_t sums[2];
+  _mm_store_si128(reinterpret_cast<__m128i *>(sums), sum);
+  return sums[0] + sums[1] + getSumOfSquaredErrorsLineScalar(src0, src1, x, width, 0, 0);
+}
+
+TARGET_AVX2 uint64_t getSumOfSquaredErrorsLineAVX2(const uint8_t *src0,
+                                                   const uint8_t *src1,
+                                                   const int      width)
+{
+  auto sum = _mm256_setzero_si256();
+  int  x   = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    const auto val0 =
+        _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + x)));
+    const auto val1 =
+        _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + x)));
+    const auto diff = _mm256_sub_epi16(val0, val1);
+    sum             = _mm256_add_epi32(sum, _mm256_madd_epi16(diff, diff));
+  }
+
+  alignas(32) uint32_t sums[8];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(sums), sum);
+  uint64_t total = 0;
+  for (const auto value : sums)
+    total += value;
+  return total + getSumOfSquaredErrorsLineScalar(src0, src1, x, width, 0, 0);
+}
+
+TARGET_AVX2 uint64_t getSumOfSquaredErrorsLineAVX2(const uint16_t *src0,
+                                                   const uint16_t *src1,
+                                                   const int       width)
+{
+  auto sum = _mm256_setzero_si256();
+  int  x   = 0;
+  for (; x + 8 <= width; x += 8)
+  {
+    const auto val0 =
+        _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src0 + x)));
+    const auto val1 =
+        _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + x)));
+    const auto diff    = _mm256_sub_epi32(val0, val1);
+    const auto diffOdd = _mm256_srli_epi64(diff, 32);
+    sum                = _mm256_add_epi64(sum, _mm256_mul_epi32(diff, diff));
+    sum                = _mm256_add_epi64(sum, _mm256_mul_epi32(diffOdd, diffOdd));
+  }
+
+  alignas(32) uint64_t sums[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(sums), sum);
+  return sums[0] + sums[1] + sums[2] + sums[3] +
+         getSumOfSquaredErrorsLineScalar(src0, src1, x, width, 0, 0);
+}
+
+#endif
+
+template <typename T>
+uint64_t getSumOfSquaredErrorsVectorized(const simd::InstructionSet instructionSet,
+                                         const Plane               &plane0,
+                                         const Plane               &plane1,
+                                         const int                  width,
+                                         const int                  height)
+{
+  uint64_t sum = 0;
+  for (int y = 0; y < height; y++)
+  {
+    const auto src0 = getLine<T>(plane0, y);
+    const auto src1 = getLine<T>(plane1, y);
+#if YUVIEW_SIMD_X86
+    if (instructionSet == simd::InstructionSet::AVX2)
+      sum += getSumOfSquaredErrorsLineAVX2(src0, src1, width);
+    else if (instructionSet == simd::InstructionSet::SSE4_1)
+      sum += getSumOfSquaredErrorsLineSSE4_1(src0, src1, width);
+    else
+#else
+    (void)instructionSet;
+#endif
+      sum += getSumOfSquaredErrorsLineScalar(src0, src1, 0, width, 0, 0);
+  }
+  return sum;
+}
+
+template <typename T0, typename T1>
+uint64_t getSumOfSquaredErrorsScalar(const Plane &plane0,
+                                     const Plane &plane1,
+                                     const int    width,
+                                     const int    height,
+                                     const int    shift0,
+                                     const int    shift1)
+{
+  uint64_t sum = 0;
+  for (int y = 0; y < height; y++)
+    sum += getSumOfSquaredErrorsLineScalar(
+        getLine<T0>(plane0, y), getLine<T1>(plane1, y), 0, width, shift0, shift1);
+  return sum;
+}
+
+// Get the samples of the plane (scaled to the given bit depth) as floats
+std::vector<float>
+getSamples(const Plane &plane, const int width, const int height, const int bitDepth)
+{
+  const auto         scale = float(1 << (bitDepth - plane.bitDepth));
+  std::vector<float> samples(size_t(width) * height);
+  auto               dst = samples.data();
+  for (int y = 0; y < height; y++)
+  {
+    if (plane.bitDepth > 8)
+    {
+      const auto src = getLine<uint16_t>(plane, y);
+      for (int x = 0; x < width; x++)
+        *dst++ = float(src[x]) * scale;
+    }
+    else
+    {
+      const auto src = getLine<uint8_t>(plane, y);
+      for (int x = 0; x < width; x++)
+        *dst++ = float(src[x]) * scale;
+    }
+  }
+  return samples;
+}
+
+struct SSIMValues
+{
+  double ssim{};
+  // The contrast and structure terms without the luminance term
+  double contrastStructure{};
+};
+
+// Calculate the statistics of all 4x4 blocks first. Every 8x8 window is then made up of 2x2 blocks.
+SSIMValues calculateSSIM(const std::vector<float> &samples0,
+                         const std::vector<float> &samples1,
+                         const int                 width,
+                         const int                 height,
+                         const int                 bitDepth)
+{
+  struct BlockSums
+  {
+    double sum0{}, sum1{}, sumSquares0{}, sumSquares1{}, sumProducts{};
+  };
+
+  const auto nrBlocksX = width / 4;
+  const auto nrBlocksY = height / 4;
+
+  std::vector<BlockSums> blocks(size_t(nrBlocksX) * nrBlocksY);
+  for (int blockY = 0; blockY < nrBlocksY; blockY++)
+  {
+    for (int blockX = 0; blockX < nrBlocksX; blockX++)
+    {
+      auto &block = blocks[blockY * nrBlocksX + blockX];
+      for (int y = blockY * 4; y < blockY * 4 + 4; y++)
+      {
+        for (int x = blockX * 4; x < blockX * 4 + 4; x++)
+        {
+          const double val0 = samples0[size_t(y) * width + x];
+          const double val1 = samples1[size_t(y) * width + x];
+          block.sum0 += val0;
+          block.sum1 += val1;
+          block.sumSquares0 += val0 * val0;
+          block.sumSquares1 += val1 * val1;
+          block.sumProducts += val0 * val1;
+        }
+      }
+    }
+  }
+
+  const double maxValue          = (1 << bitDepth) - 1;
+  const double c1                = (0.01 * maxValue) * (0.01 * maxValue);
+  const double c2                = (0.03 * maxValue) * (0.03 * maxValue);
+  const double nrSamplesInWindow = 64;
+
+  SSIMValues sum;
+  for (int blockY = 0; blockY + 1 < nrBlocksY; blockY++)
+  {
+    for (int blockX = 0; blockX + 1 < nrBlocksX; blockX++)
+    {
+      BlockSums window;
+      for (const auto offset : {0, 1, nrBlocksX, nrBlocksX + 1})
+      {
+        const auto &block = blocks[blockY * nrBlocksX + blockX + offset];
+        window.sum0 += block.sum0;
+        window.sum1 += block.sum1;
+        window.sumSquares0 += block.sumSquares0;
+        window.sumSquares1 += block.sumSquares1;
+        window.sumProducts += block.sumProducts;
+      }
+
+      const auto mean0      = window.sum0 / nrSamplesInWindow;
+      const auto mean1      = window.sum1 / nrSamplesInWindow;
+      const auto variance0  = window.sumSquares0 / nrSamplesInWindow - mean0 * mean0;
+      const auto variance1  = window.sumSquares1 / nrSamplesInWindow - mean1 * mean1;
+      const auto covariance = window.sumProducts / nrSamplesInWindow - mean0 * mean1;
+
+      const auto luminance = (2 * mean0 * mean1 + c1) / (mean0 * mean0 + mean1 * mean1 + c1);
+      const auto contrastStructure = (2 * covariance + c2) / (variance0 + variance1 + c2);
+      sum.ssim += luminance * contrastStructure;
+      sum.contrastStructure += contrastStructure;
+    }
+  }
+
+  const auto nrWindows = double(nrBlocksX - 1) * (nrBlocksY - 1);
+  return {sum.ssim / nrWindows, sum.contrastStructure / nrWindows};
+}
+
+std::vector<float>
+downsample(const std::vector<float> &samples, const int width, const int height)
+{
+  const auto         widthOut  = width / 2;
+  const auto         heightOut = height / 2;
+  std::vector<float> downsampled(size_t(widthOut) * heightOut);
+  for (int y = 0; y < heightOut; y++)
+  {
+    const auto line0 = samples.data() + size_t(y) * 2 * width;
+    const auto line1 = line0 + width;
+    for (int x = 0; x < widthOut; x++)
+      downsampled[size_t(y) * widthOut + x] =
+          (line0[2 * x] + line0[2 * x + 1] + line1[2 * x] + line1[2 * x + 1]) / 4;
+  }
+  return downsampled;
+}
+
+constexpr auto MIN_SSIM_SIZE = 8;
+
+} // namespace
+
+int getCommonBitDepth(const Plane &plane0, const Plane &plane1)
+{
+  return std::max(plane0.bitDepth, plane1.bitDepth);
+}
+
+uint64_t getSumOfSquaredErrors(const simd::InstructionSet instructionSet,
+                               const Plane               &plane0,
+                               const Plane               &plane1)
+{
+  const auto width  = std::min(plane0.width, plane1.width);
+  const auto height = std::min(plane0.height, plane1.height);
+  const auto wide0  = plane0.bitDepth > 8;
+  const auto wide1  = plane1.bitDepth > 8;
+
+  if (plane0.bitDepth == plane1.bitDepth)
+  {
+    const auto usedInstructionSet = simd::isInstructionSetSupported(instructionSet)
+                                        ? instructionSet
+                                        : simd::getSupportedInstructionSet();
+    if (wide0)
+      return getSumOfSquaredErrorsVectorized<uint16_t>(
+          usedInstructionSet, plane0, plane1, width, height);
+    return getSumOfSquaredErrorsVectorized<uint8_t>(
+        usedInstructionSet, plane0, plane1, width, height);
+  }
+
+  const auto bitDepth = getCommonBitDepth(plane0, plane1);
+  const auto shift0   = bitDepth - plane0.bitDepth;
+  const auto shift1   = bitDepth - plane1.bitDepth;
+  if (wide0 && wide1)
+    return getSumOfSquaredErrorsScalar<uint16_t, uint16_t>(
+        plane0, plane1, width, height, shift0, shift1);
+  if (wide0)
+    return getSumOfSquaredErrorsScalar<uint16_t, uint8_t>(
+        plane0, plane1, width, height, shift0, shift1);
+  if (wide1)
+    return getSumOfSquaredErrorsScalar<uint8_t, uint16_t>(
+        plane0, plane1, width, height, shift0, shift1);
+  return getSumOfSquaredErrorsScalar<uint8_t, uint8_t>(
+      plane0, plane1, width, height, shift0, shift1);
+}
+
+double getPSNR(const double mse, const int bitDepth)
+{
+  if (mse <= 0)
+    return std::numeric_limits<double>::infinity();
+  const double maxValue = (1 << bitDepth) - 1;
+  return 10 * std::log10(maxValue * maxValue / mse);
+}
+
+double getSSIM(const Plane &plane0, const Plane &plane1)
+{
+  const auto width    = std::min(plane0.width, plane1.width);
+  const auto height   = std::min(plane0.height, plane1.height);
+  const auto bitDepth = getCommonBitDepth(plane0, plane1);
+  if (width < MIN_SSIM_SIZE || height < MIN_SSIM_SIZE)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  return calculateSSIM(getSamples(plane0, width, height, bitDepth),
+                       getSamples(plane1, width, height, bitDepth),
+                       width,
+                       height,
+                       bitDepth)
+      .ssim;
+}
+
+double getMSSSIM(const Plane &plane0, const Plane &plane1)
+{
+  constexpr std::array<double, 5> weights = {0.0448, 0.2856, 0.3001, 0.2363, 0.1333};
+
+  auto       width    = std::min(plane0.width, plane1.width);
+  auto       height   = std::min(plane0.height, plane1.height);
+  const auto bitDepth = getCommonBitDepth(plane0, plane1);
+  if (width < MIN_SSIM_SIZE || height < MIN_SSIM_SIZE)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  auto samples0 = getSamples(plane0, width, height, bitDepth);
+  auto samples1 = getSamples(plane1, width, height, bitDepth);
+
+  std::vector<SSIMValues> scales;
+  while (true)
+  {
+    scales.push_back(calculateSSIM(samples0, samples1, width, height, bitDepth));
+    if (scales.size() == weights.size() || width / 2 < MIN_SSIM_SIZE ||
+        height / 2 < MIN_SSIM_SIZE)
+      break;
+
+    samples0 = downsample(samples0, width, height);
+    samples1 = downsample(samples1, width, height);
+    width /= 2;
+    height /= 2;
+  }
+
+  double weightSum = 0;
+  for (size_t i = 0; i < scales.size(); i++)
+    weightSum += weights[i];
+
+  // Negative values (anti correlation) are clipped to 0 as the exponents are not integers
+  double msssim = 1.0;
+  for (size_t i = 0; i < scales.size(); i++)
+  {
+    const auto isLastScale = (i + 1 == scales.size());
+    const auto value       = isLastScale ? scales[i].ssim : scales[i].contrastStructure;
+    msssim *= std::pow(std::max(value, 0.0), weights[i] / weightSum);
+  }
+  return msssim;
+}
+
+} // namespace video::yuv::metrics
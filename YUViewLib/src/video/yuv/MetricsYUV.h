@@ -0,0 +1,77 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "ConversionYUVSIMD.h"
+
+#include <cstdint>
+
+// Objective quality metrics between two planes of samples. Like the conversion kernels, this is
+// kept free of any Qt types.
+namespace video::yuv::metrics
+{
+
+// One plane of samples. Samples with a bit depth above 8 are stored in 16 bit in the native byte
+// order.
+struct Plane
+{
+  const uint8_t *data{};
+  int64_t        stride{}; // In bytes
+  int            width{};
+  int            height{};
+  int            bitDepth{8};
+};
+
+// All metrics compare the top left part that is covered by both planes. If the bit depths of the
+// planes differ, the samples of the plane with the lower bit depth are scaled up.
+int getCommonBitDepth(const Plane &plane0, const Plane &plane1);
+
+// Get the sum of the squared differences of all samples. The vectorized kernels are used if both
+// planes have the same number of bytes per sample.
+uint64_t getSumOfSquaredErrors(simd::InstructionSet instructionSet,
+                               const Plane         &plane0,
+                               const Plane         &plane1);
+
+// Get the PSNR for the given MSE and bit depth. For identical planes (MSE 0) this is infinity.
+double getPSNR(double mse, int bitDepth);
+
+// Get the mean SSIM. Instead of the gaussian window of the original paper, the statistics are
+// calculated in 8x8 windows which overlap by 4 samples in each direction (like x264 and ffmpeg do).
+double getSSIM(const Plane &plane0, const Plane &plane1);
+
+// Get the MS-SSIM over 5 scales with the weights of Wang et al. Every scale is downsampled by
+// averaging 2x2 samples. Planes which are too small for 5 scales use as many scales as possible
+// (with renormalized weights).
+double getMSSSIM(const Plane &plane0, const Plane &plane1);
+
+} // namespace video::yuv::metrics
@@ -0,0 +1,371 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SequenceMetricsYUV.h"
+
+#include <video/yuv/MetricsYUV.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+
+namespace video::yuv
+{
+
+namespace
+{
+
+bool isFormatSupported(const PixelFormatYUV &format)
+{
+  return format.isValid() && !format.getPredefinedFormat() && format.isPlanar() &&
+         !format.isUVInterleaved() && (format.getBitsPerSample() <= 8 || !format.isBigEndian());
+}
+
+// Get the Y, U and V planes (only Y for 4:0:0) of the frame. Returns an empty list if the frame
+// does not fit the format.
+std::vector<metrics::Plane>
+getPlanes(const RawFrameBuffer &frame, const PixelFormatYUV &format, const Size frameSize)
+{
+  const auto bitDepth       = int(format.getBitsPerSample());
+  const auto bytesPerSample = (bitDepth > 8) ? 2 : 1;
+  const auto nrPlanes       = (format.getSubsampling() == Subsampling::YUV_400) ? 1 : 3;
+
+  std::vector<metrics::Plane> planes;
+  for (int i = 0; i < nrPlanes; i++)
+  {
+    metrics::Plane plane;
+    plane.width    = int(frameSize.width) / ((i == 0) ? 1 : format.getSubsamplingHor());
+    plane.height   = int(frameSize.height) / ((i == 0) ? 1 : format.getSubsamplingVer());
+    plane.stride   = plane.width * bytesPerSample;
+    plane.bitDepth = bitDepth;
+    planes.push_back(plane);
+  }
+
+  if (frame.isPacked())
+  {
+    const auto &data = frame.getPackedData();
+    if (data.size() < format.bytesPerFrame(frameSize))
+      return {};
+
+    auto ptr = reinterpret_cast<const uint8_t *>(data.constData());
+    for (auto &plane : planes)
+    {
+      plane.data = ptr;
+      ptr += plane.stride * plane.height;
+    }
+    const auto planeOrder = format.getPlaneOrder();
+    if (nrPlanes == 3 && (planeOrder == PlaneOrder::YVU || planeOrder == PlaneOrder::YVUA))
+      std::swap(planes[1].data, planes[2].data);
+  }
+  else
+  {
+    // Decoders always provide the planes in the order Y, U, V
+    const auto &framePlanes = frame.getPlanes();
+    if (int(framePlanes.size()) < nrPlanes)
+      return {};
+    for (int i = 0; i < nrPlanes; i++)
+    {
+      if (framePlanes[i].widthInBytes < planes[i].stride ||
+          framePlanes[i].height < planes[i].height)
+        return {};
+      planes[i].data   = framePlanes[i].data;
+      planes[i].stride = framePlanes[i].stride;
+    }
+  }
+
+  return planes;
+}
+
+FrameMetrics calculateFrameMetrics(videoHandlerYUV               *video0,
+                                   videoHandlerYUV               *video1,
+                                   const PixelFormatYUV           format0,
+                                   const PixelFormatYUV           format1,
+                                   const Size                     frameSize0,
+                                   const Size                     frameSize1,
+                                   const int                      frameIndex0,
+                                   const int                      frameIndex1,
+                                   const SequenceMetricsSettings &settings)
+{
+  FrameMetrics frameMetrics;
+  frameMetrics.frameIndex0 = frameIndex0;
+  frameMetrics.frameIndex1 = frameIndex1;
+
+  // The frames may point into the memory of a decoder. Frame 1 is released at the end of this
+  // function. Frame 0 is copied before frame 1 is loaded. Otherwise, a decoder of video0 would be
+  // blocked while waiting for a decoder of video1 (which may be the same item).
+  RawFrameBuffer frame0, frame1;
+  if (!video0->loadRawFrame(frameIndex0, frame0))
+    return frameMetrics;
+  if (frame0.isView())
+    frame0 = RawFrameBuffer(frame0.toByteArray());
+  if (!video1->loadRawFrame(frameIndex1, frame1))
+    return frameMetrics;
+
+  const auto planes0 = getPlanes(frame0, format0, frameSize0);
+  const auto planes1 = getPlanes(frame1, format1, frameSize1);
+  if (planes0.empty() || planes0.size() != planes1.size())
+    return frameMetrics;
+
+  for (size_t i = 0; i < planes0.size(); i++)
+  {
+    const auto &plane0 = planes0[i];
+    const auto &plane1 = planes1[i];
+
+    const auto nrSamples = double(std::min(plane0.width, plane1.width)) *
+                           std::min(plane0.height, plane1.height);
+    const auto sumOfSquaredErrors =
+        metrics::getSumOfSquaredErrors(settings.instructionSet, plane0, plane1);
+
+    PlaneMetrics planeMetrics;
+    planeMetrics.mse  = (nrSamples > 0) ? double(sumOfSquaredErrors) / nrSamples : 0.0;
+    planeMetrics.psnr =
+        metrics::getPSNR(planeMetrics.mse, metrics::getCommonBitDepth(plane0, plane1));
+    if (settings.calculateSSIM)
+      planeMetrics.ssim = metrics::getSSIM(plane0, plane1);
+    if (settings.calculateMSSSIM)
+      planeMetrics.msssim = metrics::getMSSSIM(plane0, plane1);
+    frameMetrics.planes.push_back(planeMetrics);
+  }
+
+  frameMetrics.valid = true;
+  return frameMetrics;
+}
+
+// Split the frames into ranges that are each evaluated in order by one thread. Consecutive frames
+// are read in order so that decoders don't have to seek and raw files can be read ahead.
+std::vector<indexRange> getWorkRanges(const indexRange               range0,
+                                      const std::vector<indexRange> &sequentialRanges,
+                                      const int                      nrThreads)
+{
+  std::vector<indexRange> ranges;
+  int                     nrFramesInRanges = 0;
+  for (const auto &range : sequentialRanges)
+  {
+    const auto first = std::max(range.first, range0.first);
+    const auto last  = std::min(range.second, range0.second);
+    if (first <= last)
+    {
+      ranges.push_back({first, last});
+      nrFramesInRanges += last - first + 1;
+    }
+  }
+
+  const auto nrFrames = range0.second - range0.first + 1;
+  if (!ranges.empty() && nrFramesInRanges == nrFrames)
+    return ranges;
+
+  // A few blocks per thread so that the threads finish at about the same time
+  ranges.clear();
+  const auto blockSize = std::max(nrFrames / (nrThreads * 4), 1);
+  for (int first = range0.first; first <= range0.second; first += blockSize)
+    ranges.push_back({first, std::min(first + blockSize - 1, range0.second)});
+  return ranges;
+}
+
+void calculateAverage(SequenceMetricsResult &result)
+{
+  auto firstValidFrame = std::find_if(result.frames.begin(),
+                                      result.frames.end(),
+                                      [](const FrameMetrics &frame) { return frame.valid; });
+  if (firstValidFrame == result.frames.end())
+    return;
+
+  const auto nrPlanes = firstValidFrame->planes.size();
+  result.average.assign(nrPlanes, {});
+  result.psnrOfMeanMSE.assign(nrPlanes, 0.0);
+  result.nrValidFrames = 0;
+
+  for (const auto &frame : result.frames)
+  {
+    if (!frame.valid)
+      continue;
+    result.nrValidFrames++;
+    for (size_t i = 0; i < nrPlanes; i++)
+    {
+      result.average[i].mse += frame.planes[i].mse;
+      result.average[i].psnr += frame.planes[i].psnr;
+      result.average[i].ssim += frame.planes[i].ssim;
+      result.average[i].msssim += frame.planes[i].msssim;
+    }
+  }
+
+  if (result.nrValidFrames == 0)
+    return;
+
+  for (size_t i = 0; i < nrPlanes; i++)
+  {
+    auto &average = result.average[i];
+    average.mse /= result.nrValidFrames;
+    average.psnr /= result.nrValidFrames;
+    average.ssim /= result.nrValidFrames;
+    average.msssim /= result.nrValidFrames;
+    result.psnrOfMeanMSE[i] = metrics::getPSNR(average.mse, result.bitDepth);
+  }
+}
+
+} // namespace
+
+void SequenceMetricsResult::writeCSV(QTextStream &stream) const
+{
+  const auto  nrPlanes     = this->average.size();
+  const char *planeNames[] = {"Y", "U", "V"};
+
+  stream << "Frame;Reference Frame";
+  for (size_t i = 0; i < nrPlanes; i++)
+    stream << ";MSE " << planeNames[i] << ";PSNR " << planeNames[i] << ";SSIM " << planeNames[i]
+           << ";MS-SSIM " << planeNames[i];
+  stream << "\n";
+
+  for (const auto &frame : this->frames)
+  {
+    if (!frame.valid)
+      continue;
+    stream << frame.frameIndex0 << ";" << frame.frameIndex1;
+    for (const auto &plane : frame.planes)
+      stream << ";" << plane.mse << ";" << plane.psnr << ";" << plane.ssim << ";" << plane.msssim;
+    stream << "\n";
+  }
+
+  stream << "Average;";
+  for (const auto &plane : this->average)
+    stream << ";" << plane.mse << ";" << plane.psnr << ";" << plane.ssim << ";" << plane.msssim;
+  stream << "\n";
+
+  // Only the PSNR columns are set
+  stream << "Average (PSNR of mean MSE);";
+  for (const auto psnr : this->psnrOfMeanMSE)
+    stream << ";;" << psnr << ";;";
+  stream << "\n";
+}
+
+SequenceMetricsResult calculateSequenceMetrics(videoHandlerYUV                *video0,
+                                               videoHandlerYUV                *video1,
+                                               const indexRange                range0,
+                                               const int                       range1Start,
+                                               const SequenceMetricsSettings  &settings,
+                                               const std::function<void(int)> &progress,
+                                               const std::atomic_bool         *abort)
+{
+  SequenceMetricsResult result;
+
+  // Take a copy of the formats so that a change while we are running does not crash anything
+  const auto format0    = video0->getPixelFormatYUV();
+  const auto format1    = video1->getPixelFormatYUV();
+  const auto frameSize0 = video0->getFrameSize();
+  const auto frameSize1 = video1->getFrameSize();
+
+  if (!isFormatSupported(format0) || !isFormatSupported(format1))
+  {
+    result.error = "Only planar YUV formats in the native byte order are supported.";
+    return result;
+  }
+  if (format0.getSubsampling() != format1.getSubsampling())
+  {
+    result.error = "The chroma subsampling of the two items differs.";
+    return result;
+  }
+  if (range0.second < range0.first)
+  {
+    result.error = "The frame range is empty.";
+    return result;
+  }
+
+  result.bitDepth = int(std::max(format0.getBitsPerSample(), format1.getBitsPerSample()));
+
+  const auto nrFrames = range0.second - range0.first + 1;
+  result.frames.resize(nrFrames);
+
+  const auto nrThreads = std::min(
+      (settings.nrThreads > 0) ? settings.nrThreads : QThread::idealThreadCount(), nrFrames);
+
+  const auto workRanges = getWorkRanges(range0, settings.sequentialRanges, nrThreads);
+
+  std::atomic_int nextRange{0};
+  std::atomic_int nrFramesDone{0};
+
+  // Every worker takes the next range and evaluates its frames in order until all ranges are done.
+  // The results are written to separate entries so no locking is needed.
+  auto worker = [&]() {
+    while (true)
+    {
+      const auto rangeIdx = nextRange++;
+      if (rangeIdx >= int(workRanges.size()))
+        return;
+
+      for (auto frameIndex0 = workRanges[rangeIdx].first;
+           frameIndex0 <= workRanges[rangeIdx].second;
+           frameIndex0++)
+      {
+        const auto i           = frameIndex0 - range0.first;
+        const auto frameIndex1 = range1Start + i;
+        if (abort != nullptr && *abort)
+        {
+          result.frames[i].frameIndex0 = frameIndex0;
+          result.frames[i].frameIndex1 = frameIndex1;
+          continue;
+        }
+
+        result.frames[i] = calculateFrameMetrics(video0,
+                                                 video1,
+                                                 format0,
+                                                 format1,
+                                                 frameSize0,
+                                                 frameSize1,
+                                                 frameIndex0,
+                                                 frameIndex1,
+                                                 settings);
+        const auto done = ++nrFramesDone;
+        if (progress)
+          progress(done);
+      }
+    }
+  };
+
+  // Use an own thread pool. The caller may already run in the global pool.
+  QThreadPool threadPool;
+  threadPool.setMaxThreadCount(nrThreads);
+
+  std::vector<QFuture<void>> futures;
+  for (int i = 0; i < nrThreads; i++)
+    futures.push_back(QtConcurrent::run(&threadPool, worker));
+  for (auto &future : futures)
+    future.waitForFinished();
+
+  calculateAverage(result);
+  return result;
+}
+
+} // namespace video::yuv
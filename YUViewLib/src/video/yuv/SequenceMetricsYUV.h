@@ -0,0 +1,116 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <common/Typedef.h>
+#include <video/yuv/ConversionYUVSIMD.h>
+
+#include <QString>
+#include <QTextStream>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace video::yuv
+{
+
+class videoHandlerYUV;
+
+struct PlaneMetrics
+{
+  double mse{};
+  double psnr{};
+  double ssim{};
+  double msssim{};
+};
+
+struct FrameMetrics
+{
+  int  frameIndex0{};
+  int  frameIndex1{};
+  bool valid{};
+  // Y, U and V (only Y for 4:0:0)
+  std::vector<PlaneMetrics> planes;
+};
+
+struct SequenceMetricsSettings
+{
+  bool calculateSSIM{true};
+  bool calculateMSSSIM{true};
+  // The number of threads that evaluate frames in parallel. 0 uses one thread per core. If an item
+  // decodes its frames, this should not be more than the number of decoders that can run in
+  // parallel (playlistItem::cachingThreadLimit).
+  int                  nrThreads{};
+  simd::InstructionSet instructionSet{simd::getSupportedInstructionSet()};
+  // The frames of video0 that should be read in order by one thread (e.g. the GOPs of a bitstream,
+  // see playlistItem::getSequentialCachingRanges). They must cover range0. If not set, range0 is
+  // split into blocks of consecutive frames.
+  std::vector<indexRange> sequentialRanges;
+};
+
+struct SequenceMetricsResult
+{
+  // If the two items can not be compared at all, this is set and no frames are evaluated
+  QString error;
+  int     bitDepth{};
+
+  std::vector<FrameMetrics> frames;
+
+  // The mean of every metric over all valid frames. psnrOfMeanMSE is the PSNR of average.mse which
+  // (unlike the mean of the PSNR values) is not dominated by frames that are almost identical.
+  std::vector<PlaneMetrics> average;
+  std::vector<double>       psnrOfMeanMSE;
+  int                       nrValidFrames{};
+
+  // Write one line per frame, a line with the averages and a final line with psnrOfMeanMSE. Values
+  // are separated by ';'.
+  void writeCSV(QTextStream &stream) const;
+};
+
+// Compare the frames in range0 of video0 to the frames of video1 (starting at frame range1Start).
+// Unlike calculateDifference, this reads the raw YUV frames directly (the image cache and the RGB
+// conversion are not used) and evaluates multiple frames in parallel. The progress callback is
+// called with the number of evaluated frames from the worker threads. If abort is set, the
+// remaining frames are skipped (and marked as invalid).
+// Both videos must use a planar YUV format with the same subsampling.
+SequenceMetricsResult
+calculateSequenceMetrics(videoHandlerYUV                *video0,
+                         videoHandlerYUV                *video1,
+                         indexRange                      range0,
+                         int                             range1Start,
+                         const SequenceMetricsSettings  &settings,
+                         const std::function<void(int)> &progress = {},
+                         const std::atomic_bool         *abort    = nullptr);
+
+} // namespace video::yuv
@@ -47,7 +47,9 @@
 #include <common/Functions.h>
 #include <common/FunctionsGui.h>
 #include <common/InfoItemAndData.h>
+#include <video/IntraFrameThreads.h>
 #include <video/LimitedRangeToFullRange.h>
+#include <video/yuv/ConversionYUVSIMD.h>
 #include <video/yuv/PixelFormatYUVGuess.h>
 #include <video/yuv/videoHandlerYUVCustomFormatDialog.h>
 
@@ -2276,29 +2278,168 @@ bool convertYUVPlanarToRGB(const QByteArray         &sourceBuffer,
   return true;
 }
 
-// Convert the given raw YUV data in sourceBuffer (using srcPixelFormat) to image (RGB-888), using
-// the buffer tmpRGBBuffer for intermediate RGB values.
-void convertYUVToImage(const QByteArray         &sourceBuffer,
-                       QImage                   &outputImage,
-                       const PixelFormatYUV     &yuvFormat,
-                       const Size               &curFrameSize,
-                       const ConversionSettings &conversionSettings)
+// Can the given planar format be converted using the vectorized line conversion? This covers the
+// most common formats (4:4:4, 4:2:2 and 4:2:0 with 8 to 16 bit, nearest neighbor chroma
+// upsampling, all components displayed and no YUV math). For everything else, the scalar
+// conversion functions are used.
+bool canConvertYUVPlanarToRGBVectorized(const PixelFormatYUV     &format,
+                                        const Size                curFrameSize,
+                                        const ConversionSettings &conversionSettings)
 {
-  if (!yuvFormat.canConvertToRGB(curFrameSize) || sourceBuffer.isEmpty())
+  const auto subsampling = format.getSubsampling();
+  if (subsampling != Subsampling::YUV_444 && subsampling != Subsampling::YUV_422 &&
+      subsampling != Subsampling::YUV_420)
+    return false;
+
+  const auto bps = format.getBitsPerSample();
+  if (bps < 8 || bps > 16 || (bps > 8 && format.isBigEndian()) || format.isUVInterleaved())
+    return false;
+
+  if (int(curFrameSize.width) % format.getSubsamplingHor() != 0 ||
+      int(curFrameSize.height) % format.getSubsamplingVer() != 0)
+    return false;
+
+  // Only nearest neighbor upsampling is vectorized. For 4:4:4 without a chroma offset, there is no
+  // interpolation anyways.
+  const auto noChromaOffset = format.getChromaOffset().x == 0 && format.getChromaOffset().y == 0;
+  if (conversionSettings.chromaInterpolation != ChromaInterpolation::NearestNeighbor &&
+      !(subsampling == Subsampling::YUV_444 && noChromaOffset))
+    return false;
+
+  return conversionSettings.componentDisplayMode == ComponentDisplayMode::DisplayAll &&
+         !conversionSettings.mathParameters.at(Component::Luma).mathRequired() &&
+         !conversionSettings.mathParameters.at(Component::Chroma).mathRequired();
+}
+
+// The start and the line stride (in bytes) of the Y, U and V planes of a planar YUV frame
+struct PlanarYUVSource
+{
+  std::array<const unsigned char *, 3> planes{};
+  std::array<int64_t, 3>               strides{};
+};
+
+// Convert the planar YUV planes line by line using the vectorized conversion functions. If the
+// video cache has spare threads, the lines are converted in parallel. The output is identical to
+// the output of convertYUVPlanarToRGB. If matchSpecialized420Conversion is set, the output is
+// identical to convertYUV420ToRGB instead (which uses a different rounding for 10 bit input).
+void convertYUVPlanesToRGBVectorized(const PlanarYUVSource      &source,
+                                     uchar                     *targetBuffer,
+                                     const Size                 curFrameSize,
+                                     const PixelFormatYUV      &format,
+                                     const ConversionSettings  &conversionSettings,
+                                     const simd::InstructionSet instructionSet,
+                                     const bool                 matchSpecialized420Conversion)
+{
+  const auto w              = int(curFrameSize.width);
+  const auto h              = int(curFrameSize.height);
+  const auto bps            = format.getBitsPerSample();
+  const auto subsamplingHor = format.getSubsamplingHor();
+  const auto subsamplingVer = format.getSubsamplingVer();
+
+  std::array<int, 5> RGBConv;
+  getColorConversionCoefficients(conversionSettings.colorConversion, RGBConv.data());
+  const bool fullRange  = isFullRange(conversionSettings.colorConversion);
+  auto       parameters = simd::getConversionParameters(RGBConv, bps, fullRange);
+  if (matchSpecialized420Conversion)
   {
-    outputImage = QImage();
-    return;
+    parameters.inputShift  = (bps == 10) ? 2 : 0;
+    parameters.yOffset     = fullRange ? 0 : 16;
+    parameters.cZero       = 128;
+    parameters.outputShift = 16;
   }
 
-  DEBUG_YUV("videoHandlerYUV::convertYUVToImage");
+  // All lines are independent so the frame can be split into bands that are converted in parallel
+  auto convertRows = [&](const int rowStart, const int rowEnd) {
+    for (int y = rowStart; y < rowEnd; y++)
+    {
+      const auto yChroma = y / subsamplingVer;
+      const auto srcY    = source.planes[0] + y * source.strides[0];
+      const auto srcU    = source.planes[1] + yChroma * source.strides[1];
+      const auto srcV    = source.planes[2] + yChroma * source.strides[2];
+      auto       dst     = targetBuffer + int64_t(y) * w * 4;
+      if (bps > 8)
+        simd::convertLineToBGRA(instructionSet,
+                                reinterpret_cast<const uint16_t *>(srcY),
+                                reinterpret_cast<const uint16_t *>(srcU),
+                                reinterpret_cast<const uint16_t *>(srcV),
+                                dst,
+                                w,
+                                subsamplingHor,
+                                parameters);
+      else
+        simd::convertLineToBGRA(
+            instructionSet, srcY, srcU, srcV, dst, w, subsamplingHor, parameters);
+    }
+  };
+  intraFrameThreads::processRowBands(w, h, subsamplingVer, convertRows);
+}
 
-  // Create the output image in the right format.
-  // In both cases, we will set the alpha channel to 255. The format of the raw buffer is: BGRA
-  // (each 8 bit). Internally, this is how QImage allocates the number of bytes per line (with depth
-  // = 32): const int bytes_per_line = ((width * depth + 31) >> 5) << 2; // bytes per scanline (must
-  // be multiple of 4)
-  auto qFrameSize          = QSize(int(curFrameSize.width), int(curFrameSize.height));
-  auto platformImageFormat = functionsGui::platformImageFormat(yuvFormat.hasAlpha());
+// Convert planar YUV data in one consecutive buffer using convertYUVPlanesToRGBVectorized.
+bool convertYUVPlanarToRGBVectorized(const QByteArray          &sourceBuffer,
+                                     uchar                     *targetBuffer,
+                                     const Size                 curFrameSize,
+                                     const PixelFormatYUV      &format,
+                                     const ConversionSettings  &conversionSettings,
+                                     const simd::InstructionSet instructionSet,
+                                     const bool                 matchSpecialized420Conversion)
+{
+  const auto w              = int(curFrameSize.width);
+  const auto h              = int(curFrameSize.height);
+  const auto bytesPerSample = (format.getBitsPerSample() > 8) ? 2 : 1;
+  const auto strideLuma     = int64_t(w) * bytesPerSample;
+  const auto strideChroma   = int64_t(w / format.getSubsamplingHor()) * bytesPerSample;
+  const auto nrBytesLuma    = strideLuma * h;
+  const auto nrBytesChroma  = strideChroma * (h / format.getSubsamplingVer());
+  if (sourceBuffer.size() < nrBytesLuma + 2 * nrBytesChroma)
+    return false;
+
+  const bool uPlaneFirst =
+      (format.getPlaneOrder() == PlaneOrder::YUV || format.getPlaneOrder() == PlaneOrder::YUVA);
+  const auto srcY = reinterpret_cast<const unsigned char *>(sourceBuffer.data());
+
+  PlanarYUVSource source;
+  source.planes[0]  = srcY;
+  source.planes[1]  = uPlaneFirst ? srcY + nrBytesLuma : srcY + nrBytesLuma + nrBytesChroma;
+  source.planes[2]  = uPlaneFirst ? srcY + nrBytesLuma + nrBytesChroma : srcY + nrBytesLuma;
+  source.strides[0] = strideLuma;
+  source.strides[1] = strideChroma;
+  source.strides[2] = strideChroma;
+
+  convertYUVPlanesToRGBVectorized(source,
+                                  targetBuffer,
+                                  curFrameSize,
+                                  format,
+                                  conversionSettings,
+                                  instructionSet,
+                                  matchSpecialized420Conversion);
+  return true;
+}
+
+// 8/10 bit 4:2:0, nearest neighbor, chroma offset (0,1) (the default for 4:2:0), all components
+// displayed and no yuv math. We can use a specialized function for this.
+bool canUseSpecialized420Conversion(const PixelFormatYUV     &yuvFormat,
+                                    const ConversionSettings &conversionSettings)
+{
+  return (yuvFormat.getBitsPerSample() == 8 || yuvFormat.getBitsPerSample() == 10) &&
+         yuvFormat.getSubsampling() == Subsampling::YUV_420 &&
+         conversionSettings.chromaInterpolation == ChromaInterpolation::NearestNeighbor &&
+         yuvFormat.getChromaOffset().x == 0 && yuvFormat.getChromaOffset().y == 1 &&
+         conversionSettings.componentDisplayMode == ComponentDisplayMode::DisplayAll &&
+         !yuvFormat.isUVInterleaved() &&
+         !conversionSettings.mathParameters.at(Component::Luma).mathRequired() &&
+         !conversionSettings.mathParameters.at(Component::Chroma).mathRequired();
+}
+
+// Create the output image in the right format.
+// In both cases, we will set the alpha channel to 255. The format of the raw buffer is: BGRA
+// (each 8 bit). Internally, this is how QImage allocates the number of bytes per line (with depth
+// = 32): const int bytes_per_line = ((width * depth + 31) >> 5) << 2; // bytes per scanline (must
+// be multiple of 4)
+QImage createOutputImage(const Size &curFrameSize, const bool hasAlpha)
+{
+  QImage outputImage;
+  auto   qFrameSize          = QSize(int(curFrameSize.width), int(curFrameSize.height));
+  auto   platformImageFormat = functionsGui::platformImageFormat(hasAlpha);
   if (is_Q_OS_WIN || is_Q_OS_MAC)
     outputImage = QImage(qFrameSize, platformImageFormat);
   else if (is_Q_OS_LINUX)
@@ -2319,29 +2460,66 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
          curFrameSize.width * curFrameSize.height * 4);
 #endif
 
+  return outputImage;
+}
+
+void convertToPlatformImageFormat(QImage &outputImage, const bool hasAlpha)
+{
+  if (is_Q_OS_LINUX)
+  {
+    // On linux, we may have to convert the image to the platform image format if it is not one of
+    // the RGBA formats.
+    auto format = functionsGui::platformImageFormat(hasAlpha);
+    if (format != QImage::Format_ARGB32_Premultiplied && format != QImage::Format_ARGB32 &&
+        format != QImage::Format_RGB32)
+      outputImage = outputImage.convertToFormat(format);
+  }
+}
+
+// If the CPU supports it, the most common planar formats are converted using vector
+// instructions. The output is bit exact to the scalar conversion functions. The line based
+// conversion is also used (even without vector instructions) if the frame can be split and
+// converted by multiple threads.
+bool useLineBasedConversion(const simd::InstructionSet instructionSet)
+{
+  return instructionSet != simd::InstructionSet::Scalar ||
+         intraFrameThreads::getNrSpareThreads() > 0;
+}
+
+// Convert the given raw YUV data in sourceBuffer (using srcPixelFormat) to image (RGB-888), using
+// the buffer tmpRGBBuffer for intermediate RGB values.
+void convertYUVToImage(const QByteArray         &sourceBuffer,
+                       QImage                   &outputImage,
+                       const PixelFormatYUV     &yuvFormat,
+                       const Size               &curFrameSize,
+                       const ConversionSettings &conversionSettings)
+{
+  if (!yuvFormat.canConvertToRGB(curFrameSize) || sourceBuffer.isEmpty())
+  {
+    outputImage = QImage();
+    return;
+  }
+
+  DEBUG_YUV("videoHandlerYUV::convertYUVToImage");
+
+  outputImage = createOutputImage(curFrameSize, yuvFormat.hasAlpha());
+
+  const auto instructionSet = simd::getSupportedInstructionSet();
+  const auto lineBased      = useLineBasedConversion(instructionSet);
+
   auto convOK = false;
   if (yuvFormat.isPlanar())
   {
-    if ((yuvFormat.getBitsPerSample() == 8 || yuvFormat.getBitsPerSample() == 10) &&
-        yuvFormat.getSubsampling() == Subsampling::YUV_420 &&
-        conversionSettings.chromaInterpolation == ChromaInterpolation::NearestNeighbor &&
-        yuvFormat.getChromaOffset().x == 0 && yuvFormat.getChromaOffset().y == 1 &&
-        conversionSettings.componentDisplayMode == ComponentDisplayMode::DisplayAll &&
-        !yuvFormat.isUVInterleaved() &&
-        !conversionSettings.mathParameters.at(Component::Luma).mathRequired() &&
-        !conversionSettings.mathParameters.at(Component::Chroma).mathRequired())
-    // 8/10 bit 4:2:0, nearest neighbor, chroma offset (0,1) (the default for 4:2:0), all components
-    // displayed and no yuv math. We can use a specialized function for this.
-    {
-      if (yuvFormat.getBitsPerSample() == 8)
-        convOK = convertYUV420ToRGB<8>(
-            sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
-      else if (yuvFormat.getBitsPerSample() == 10)
-        convOK = convertYUV420ToRGB<10>(
-            sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
-    }
+    if (lineBased &&
+        canConvertYUVPlanarToRGBVectorized(yuvFormat, curFrameSize, conversionSettings))
+      convOK = convertYUVPlanarToRGBLineBased(sourceBuffer,
+                                              outputImage.bits(),
+                                              curFrameSize,
+                                              yuvFormat,
+                                              conversionSettings,
+                                              instructionSet);
     else
-      convOK = convertYUVPlanarToRGB(
+      convOK = convertYUVPlanarToRGBScalar(
           sourceBuffer, outputImage.bits(), curFrameSize, yuvFormat, conversionSettings);
   }
   else
@@ -2364,27 +2542,136 @@ void convertYUVToImage(const QByteArray         &sourceBuffer,
           convertYUVPackedToPlanar(sourceBuffer, tmpPlanarYUVSource, curFrameSize, yuvFormat);
 
     if (convOK)
-      convOK &= convertYUVPlanarToRGB(
-          tmpPlanarYUVSource, outputImage.bits(), curFrameSize, newPixelFormat, conversionSettings);
+    {
+      if (lineBased &&
+          canConvertYUVPlanarToRGBVectorized(newPixelFormat, curFrameSize, conversionSettings))
+        convOK &= convertYUVPlanarToRGBVectorized(tmpPlanarYUVSource,
+                                                  outputImage.bits(),
+                                                  curFrameSize,
+                                                  newPixelFormat,
+                                                  conversionSettings,
+                                                  instructionSet,
+                                                  false);
+      else
+        convOK &= convertYUVPlanarToRGB(tmpPlanarYUVSource,
+                                        outputImage.bits(),
+                                        curFrameSize,
+                                        newPixelFormat,
+                                        conversionSettings);
+    }
   }
 
   assert(convOK);
 
-  if (is_Q_OS_LINUX)
+  convertToPlatformImageFormat(outputImage, yuvFormat.hasAlpha());
+
+  DEBUG_YUV("videoHandlerYUV::convertYUVToImage Done");
+}
+
+// Convert the given raw YUV frame to image. If the planes of the frame are separate (e.g. the
+// output picture of a decoder) and the line based conversion can be used, the planes are converted
+// directly. Otherwise the frame is copied into one buffer first.
+void convertYUVToImage(const RawFrameBuffer     &frame,
+                       QImage                   &outputImage,
+                       const PixelFormatYUV     &yuvFormat,
+                       const Size               &curFrameSize,
+                       const ConversionSettings &conversionSettings)
+{
+  if (frame.isPacked())
   {
-    // On linux, we may have to convert the image to the platform image format if it is not one of
-    // the RGBA formats.
-    auto format = functionsGui::platformImageFormat(yuvFormat.hasAlpha());
-    if (format != QImage::Format_ARGB32_Premultiplied && format != QImage::Format_ARGB32 &&
-        format != QImage::Format_RGB32)
-      outputImage = outputImage.convertToFormat(format);
+    convertYUVToImage(
+        frame.getPackedData(), outputImage, yuvFormat, curFrameSize, conversionSettings);
+    return;
   }
 
-  DEBUG_YUV("videoHandlerYUV::convertYUVToImage Done");
+  const auto  instructionSet = simd::getSupportedInstructionSet();
+  const auto &planes         = frame.getPlanes();
+
+  auto canConvertPlanes = !frame.isNull() && yuvFormat.canConvertToRGB(curFrameSize) &&
+                          yuvFormat.isPlanar() && planes.size() >= 3 &&
+                          useLineBasedConversion(instructionSet) &&
+                          canConvertYUVPlanarToRGBVectorized(
+                              yuvFormat, curFrameSize, conversionSettings);
+  if (canConvertPlanes)
+  {
+    const auto bytesPerSample = (yuvFormat.getBitsPerSample() > 8) ? 2 : 1;
+    for (int c = 0; c < 3; c++)
+    {
+      const auto hor = (c == 0) ? 1 : yuvFormat.getSubsamplingHor();
+      const auto ver = (c == 0) ? 1 : yuvFormat.getSubsamplingVer();
+      if (planes[c].widthInBytes < int(curFrameSize.width) / hor * bytesPerSample ||
+          planes[c].height < int(curFrameSize.height) / ver)
+        canConvertPlanes = false;
+    }
+  }
+
+  if (!canConvertPlanes)
+  {
+    convertYUVToImage(
+        frame.toByteArray(), outputImage, yuvFormat, curFrameSize, conversionSettings);
+    return;
+  }
+
+  DEBUG_YUV("videoHandlerYUV::convertYUVToImage from planes");
+
+  const bool  uPlaneFirst = (yuvFormat.getPlaneOrder() == PlaneOrder::YUV ||
+                             yuvFormat.getPlaneOrder() == PlaneOrder::YUVA);
+  const auto &planeU      = uPlaneFirst ? planes[1] : planes[2];
+  const auto &planeV      = uPlaneFirst ? planes[2] : planes[1];
+
+  PlanarYUVSource source;
+  source.planes  = {planes[0].data, planeU.data, planeV.data};
+  source.strides = {planes[0].stride, planeU.stride, planeV.stride};
+
+  outputImage = createOutputImage(curFrameSize, yuvFormat.hasAlpha());
+  convertYUVPlanesToRGBVectorized(source,
+                                  outputImage.bits(),
+                                  curFrameSize,
+                                  yuvFormat,
+                                  conversionSettings,
+                                  instructionSet,
+                                  canUseSpecialized420Conversion(yuvFormat, conversionSettings));
+  convertToPlatformImageFormat(outputImage, yuvFormat.hasAlpha());
 }
 
 } // namespace
 
+bool convertYUVPlanarToRGBScalar(const QByteArray         &sourceBuffer,
+                                 uchar                    *targetBuffer,
+                                 const Size                frameSize,
+                                 const PixelFormatYUV     &format,
+                                 const ConversionSettings &conversionSettings)
+{
+  if (canUseSpecialized420Conversion(format, conversionSettings))
+  {
+    if (format.getBitsPerSample() == 8)
+      return convertYUV420ToRGB<8>(
+          sourceBuffer, targetBuffer, frameSize, format, conversionSettings);
+    return convertYUV420ToRGB<10>(
+        sourceBuffer, targetBuffer, frameSize, format, conversionSettings);
+  }
+  return convertYUVPlanarToRGB(sourceBuffer, targetBuffer, frameSize, format, conversionSettings);
+}
+
+bool convertYUVPlanarToRGBLineBased(const QByteArray          &sourceBuffer,
+                                    uchar                     *targetBuffer,
+                                    const Size                 frameSize,
+                                    const PixelFormatYUV      &format,
+                                    const ConversionSettings  &conversionSettings,
+                                    const simd::InstructionSet instructionSet)
+{
+  if (!canConvertYUVPlanarToRGBVectorized(format, frameSize, conversionSettings))
+    return false;
+  return convertYUVPlanarToRGBVectorized(
+      sourceBuffer,
+      targetBuffer,
+      frameSize,
+      format,
+      conversionSettings,
+      instructionSet,
+      canUseSpecialized420Conversion(format, conversionSettings));
+}
+
 std::vector<PixelFormatYUV> videoHandlerYUV::formatPresetList = {
     PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV),
     PixelFormatYUV(Subsampling::YUV_420, 10, PlaneOrder::YUV),
@@ -2401,6 +2688,10 @@ videoHandlerYUV::videoHandlerYUV() : videoHandler()
   // If we know nothing about the YUV format, assume YUV 4:2:0 8 bit planar by default.
   const auto defaultPixelFormat = PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV);
   this->srcPixelFormat          = defaultPixelFormat;
+
+  this->settings.beginGroup("VideoCache");
+  this->rawFrameCaching = this->settings.value("CacheRawFrames", false).toBool();
+  this->settings.endGroup();
 }
 
 videoHandlerYUV::~videoHandlerYUV()
@@ -2410,9 +2701,13 @@ videoHandlerYUV::~videoHandlerYUV()
 
 unsigned videoHandlerYUV::getCachingFrameSize() const
 {
+  if (this->rawFrameCaching)
+    return functions::clipToUnsigned(this->getBytesPerFrame());
+
   auto hasAlpha = this->srcPixelFormat.hasAlpha();
   auto bytes    = functionsGui::bytesPerPixel(functionsGui::platformImageFormat(hasAlpha));
-  return this->frameSize.width * this->frameSize.height * bytes;
+  return this->frameSize.width * this->frameSize.height * bytes +
+         this->getCachingPyramidSize(bytes);
 }
 
 void videoHandlerYUV::loadValues(Size newFramesize, const QString &)
@@ -2682,6 +2977,13 @@ void videoHandlerYUV::slotYUVControlChanged()
     // Emit that this item needs redraw and the cache needs updating.
     this->currentImageIndex       = -1;
     this->currentImage_frameIndex = -1;
+    if (this->rawFrameCaching)
+    {
+      // The cached raw frames are still valid. Only the converted images must be updated.
+      this->doubleBufferImageFrameIndex = -1;
+      emit signalHandlerChanged(true, RECACHE_NONE);
+      return;
+    }
     this->setCacheInvalid();
     emit signalHandlerChanged(true, RECACHE_CLEAR);
   }
@@ -3234,12 +3536,9 @@ void videoHandlerYUV::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   const auto curFrameSize       = this->frameSize;
   const auto conversionSettings = this->conversionSettings;
 
-  requestDataMutex.lock();
-  emit       signalRequestRawData(frameIndex, true);
-  QByteArray tmpBufferRawYUVDataCaching = rawData;
-  requestDataMutex.unlock();
-
-  if (frameIndex != rawData_frameIndex)
+  // The frame may point directly to the memory of a decoder. It is released after the conversion.
+  RawFrameBuffer rawFrame;
+  if (!this->requestRawDataForCaching(frameIndex, rawFrame))
   {
     // Loading failed
     DEBUG_YUV("videoHandlerYUV::loadFrameForCaching Loading failed");
@@ -3247,8 +3546,27 @@ void videoHandlerYUV::loadFrameForCaching(int frameIndex, QImage &frameToCache)
   }
 
   // Convert YUV to image. This can then be cached.
+  convertYUVToImage(rawFrame, frameToCache, yuvFormat, curFrameSize, conversionSettings);
+}
+
+bool videoHandlerYUV::loadRawFrameForCaching(int frameIndex, QByteArray &rawFrame)
+{
+  DEBUG_YUV("videoHandlerYUV::loadRawFrameForCaching " << frameIndex);
+
+  if (!this->requestRawDataForCaching(frameIndex, rawFrame))
+  {
+    DEBUG_YUV("videoHandlerYUV::loadRawFrameForCaching Loading failed");
+    return false;
+  }
+  return true;
+}
+
+QImage videoHandlerYUV::convertCachedRawFrame(const QByteArray &rawFrame)
+{
+  QImage image;
   convertYUVToImage(
-      tmpBufferRawYUVDataCaching, frameToCache, yuvFormat, curFrameSize, conversionSettings);
+      rawFrame, image, this->srcPixelFormat, this->frameSize, this->conversionSettings);
+  return image;
 }
 
 // Load the raw YUV data for the given frame index into currentFrameRawData.
@@ -3260,6 +3578,19 @@ bool videoHandlerYUV::loadRawYUVData(int frameIndex)
 
   DEBUG_YUV("videoHandlerYUV::loadRawYUVData " << frameIndex);
 
+  if (this->rawFrameCaching)
+  {
+    // The raw frame may be in the cache
+    QMutexLocker lock(&this->imageCacheAccess);
+    if (this->cacheValid && this->imageCache.contains(frameIndex))
+    {
+      this->currentFrameRawData            = this->imageCache.value(frameIndex).rawData;
+      this->currentFrameRawData_frameIndex = frameIndex;
+      DEBUG_YUV("videoHandlerYUV::loadRawYUVData " << frameIndex << " taken from cache");
+      return true;
+    }
+  }
+
   // The function loadFrameForCaching also uses the signalRequesRawYUVData to request raw data.
   // However, only one thread can use this at a time.
   requestDataMutex.lock();
@@ -34,6 +34,7 @@
 
 #include <common/EnumMapper.h>
 #include <video/videoHandler.h>
+#include <video/yuv/ConversionYUVSIMD.h>
 #include <video/yuv/PixelFormatYUV.h>
 
 #include "ui_videoHandlerYUV.h"
@@ -72,6 +73,25 @@ struct ConversionSettings
   std::map<Component, MathParameters> mathParameters;
 };
 
+// Convert a planar YUV frame in one buffer to BGRA using the scalar conversion functions (the
+// specialized 4:2:0 conversion if possible, the generic planar conversion otherwise). This is what
+// is used if the frame is not converted line by line.
+bool convertYUVPlanarToRGBScalar(const QByteArray         &sourceBuffer,
+                                 uchar                    *targetBuffer,
+                                 const Size                frameSize,
+                                 const PixelFormatYUV     &format,
+                                 const ConversionSettings &conversionSettings);
+
+// Convert a planar YUV frame in one buffer to BGRA line by line using the given instruction set.
+// The output is identical to convertYUVPlanarToRGBScalar. Returns false if the format or the
+// settings are not supported by the line based conversion.
+bool convertYUVPlanarToRGBLineBased(const QByteArray          &sourceBuffer,
+                                    uchar                     *targetBuffer,
+                                    const Size                 frameSize,
+                                    const PixelFormatYUV      &format,
+                                    const ConversionSettings  &conversionSettings,
+                                    const simd::InstructionSet instructionSet);
+
 /** The videoHandlerYUV can be used in any playlistItem to read/display YUV data. A playlistItem
  * could even provide multiple YUV videos. A videoHandlerYUV supports handling of YUV data and can
  * return a specific frame as a image by calling getOneFrame. All conversions from the various YUV
@@ -150,6 +170,7 @@ public:
   {
     return QString::fromStdString(srcPixelFormat.getName());
   }
+  PixelFormatYUV getPixelFormatYUV() const { return this->srcPixelFormat; }
   // Set the current YUV format and update the control. Only emit a signalHandlerChanged signal
   // if emitSignal is true.
   virtual void setPixelFormatYUV(const PixelFormatYUV &fmt, bool emitSignal = false);
@@ -203,6 +224,11 @@ protected:
   // currentFrame) will not be modified.
   virtual void loadFrameForCaching(int frameIndex, QImage &frameToCache) override;
 
+  // If enabled, the raw YUV frames are cached and converted when they are drawn
+  bool   cachesRawFrames() const override { return this->rawFrameCaching; }
+  bool   loadRawFrameForCaching(int frameIndex, QByteArray &rawFrame) override;
+  QImage convertCachedRawFrame(const QByteArray &rawFrame) override;
+
 private:
   // Load the raw YUV data for the given frame index into currentFrameRawYUVData.
   // Return false is loading failed.
@@ -226,6 +252,10 @@ private:
 
   SafeUi<Ui::videoHandlerYUV> ui;
 
+  // Cache the raw YUV frames instead of the converted images (setting VideoCache/CacheRawFrames).
+  // This is read once when the handler is created so that the caching frame size does not change.
+  bool rawFrameCaching{};
+
   bool           diffReady{};
   QByteArray     diffYUV;
   PixelFormatYUV diffYUVFormat{};
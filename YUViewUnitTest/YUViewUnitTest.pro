@@ -1,4 +1,4 @@
-QT += core xml 
+QT += core xml concurrent widgets
 
 TARGET = YUViewUnitTest
 TEMPLATE = app
@@ -11,9 +11,14 @@ CONFIG += c++17
 SOURCES += $$files(*.cpp, true)
 HEADERS += $$files(*.h, true)
 
+# The batch processing of the command line tool is tested here as well
+SOURCES += $$top_srcdir/YUViewCLI/src/BatchJob.cpp
+HEADERS += $$top_srcdir/YUViewCLI/src/BatchJob.h
+
 INCLUDEPATH += $$top_srcdir/submodules/googletest/googletest/include \
                $$top_srcdir/submodules/googletest/googlemock/include \
                $$top_srcdir/YUViewLib/src \
+               $$top_srcdir/YUViewCLI/src \
                $$top_srcdir/YUViewUnitTest/common
 LIBS += -L$$top_builddir/submodules/googletest-qmake/gtest -lgtest
 LIBS += -L$$top_builddir/submodules/googletest-qmake/gtest_main -lgtest_main
@@ -0,0 +1,87 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <BatchJob.h>
+
+namespace
+{
+
+batch::Options optionsWithFrameRange(indexRange frameRange)
+{
+  batch::Options options;
+  options.frameRange = frameRange;
+  return options;
+}
+
+TEST(BatchJobTest, getFramesToProcessWithoutFrameRangeReturnsItemRange)
+{
+  const auto frames = batch::getFramesToProcess({0, 99}, batch::Options());
+  ASSERT_TRUE(frames);
+  EXPECT_EQ(*frames, indexRange(0, 99));
+}
+
+TEST(BatchJobTest, getFramesToProcessIntersectsFrameRangeWithItemRange)
+{
+  EXPECT_EQ(batch::getFramesToProcess({0, 99}, optionsWithFrameRange({10, 20})),
+            indexRange(10, 20));
+  EXPECT_EQ(batch::getFramesToProcess({0, 99}, optionsWithFrameRange({50, 200})),
+            indexRange(50, 99));
+  EXPECT_EQ(batch::getFramesToProcess({10, 99}, optionsWithFrameRange({0, 10})),
+            indexRange(10, 10));
+}
+
+TEST(BatchJobTest, getFramesToProcessRejectsFrameRangeOutsideOfItemRange)
+{
+  EXPECT_FALSE(batch::getFramesToProcess({0, 99}, optionsWithFrameRange({100, 200})));
+  EXPECT_FALSE(batch::getFramesToProcess({10, 99}, optionsWithFrameRange({0, 9})));
+}
+
+TEST(BatchJobTest, getOutputBaseNamesUsesCompleteBaseName)
+{
+  EXPECT_EQ(batch::getOutputBaseNames({"/videos/a.yuv", "/videos/b.bin.csv"}),
+            QStringList({"a", "b.bin"}));
+}
+
+TEST(BatchJobTest, getOutputBaseNamesAppendsPositionToDuplicateNames)
+{
+  EXPECT_EQ(batch::getOutputBaseNames({"/first/video.yuv", "/second/Video.hevc", "other.yuv"}),
+            QStringList({"video_1", "Video_2", "other"}));
+}
+
+TEST(BatchJobTest, getOutputBaseNamesFailsIfNamesCanNotBeToldApart)
+{
+  EXPECT_TRUE(batch::getOutputBaseNames({"a/video.yuv", "b/video.yuv", "video_1.yuv"}).isEmpty());
+}
+
+} // namespace
@@ -34,6 +34,10 @@
 
 #include <common/Functions.h>
 
+#include <TemporaryFile.h>
+
+#include <QString>
+
 namespace
 {
 
@@ -67,4 +71,16 @@ TEST(FunctionsTest, toInt)
   EXPECT_FALSE(functions::toInt("NotANumber"));
 }
 
+TEST(FunctionsTest, getFileKey)
+{
+  yuviewTest::TemporaryFile file1(ByteVector(10, 1));
+  yuviewTest::TemporaryFile file2(ByteVector(20, 1));
+  const auto                path1 = QString::fromStdString(file1.getFilePathString());
+  const auto                path2 = QString::fromStdString(file2.getFilePathString());
+
+  EXPECT_FALSE(functions::getFileKey(path1).isEmpty());
+  EXPECT_EQ(functions::getFileKey(path1), functions::getFileKey(path1));
+  EXPECT_NE(functions::getFileKey(path1), functions::getFileKey(path2));
+}
+
 } // namespace
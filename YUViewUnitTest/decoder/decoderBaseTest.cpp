@@ -0,0 +1,155 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <decoder/decoderBase.h>
+
+#include <QCoreApplication>
+#include <QSettings>
+
+namespace decoder::test
+{
+
+namespace
+{
+
+// Write the VideoCache settings to a separate organization so that the settings of the
+// application are not changed. The settings are removed and the organization and application names
+// are restored on destruction.
+class VideoCacheSettings
+{
+public:
+  VideoCacheSettings(const int nrThreads, const int nrCachingDecoders)
+  {
+    this->organizationName = QCoreApplication::organizationName();
+    this->applicationName  = QCoreApplication::applicationName();
+    QCoreApplication::setOrganizationName("YUViewUnitTest");
+    QCoreApplication::setApplicationName("decoderBaseTest");
+
+    QSettings settings;
+    settings.beginGroup("VideoCache");
+    settings.setValue("SetNrThreads", true);
+    settings.setValue("NrThreads", nrThreads);
+    if (nrCachingDecoders > 0)
+      settings.setValue("NrCachingDecoders", nrCachingDecoders);
+  }
+
+  ~VideoCacheSettings()
+  {
+    {
+      QSettings settings;
+      settings.remove("VideoCache");
+    }
+    QCoreApplication::setOrganizationName(this->organizationName);
+    QCoreApplication::setApplicationName(this->applicationName);
+  }
+
+private:
+  QString organizationName;
+  QString applicationName;
+};
+
+} // namespace
+
+TEST(DecoderBaseTest, DefaultNrCachingDecodersIsLimitedByNrThreads)
+{
+  {
+    VideoCacheSettings settings(2, 0);
+    EXPECT_EQ(getNrCachingDecoders(), 2);
+  }
+  {
+    VideoCacheSettings settings(16, 0);
+    EXPECT_EQ(getNrCachingDecoders(), 4);
+  }
+}
+
+TEST(DecoderBaseTest, NrCachingDecodersIsClippedToNrThreads)
+{
+  {
+    VideoCacheSettings settings(3, 8);
+    EXPECT_EQ(getNrCachingDecoders(), 3);
+  }
+  {
+    VideoCacheSettings settings(8, -1);
+    EXPECT_EQ(getNrCachingDecoders(), 1);
+  }
+}
+
+TEST(DecoderBaseTest, InteractiveDecoderUsesAllThreads)
+{
+  VideoCacheSettings settings(8, 4);
+
+  const auto interactive = getDecoderThreading(false);
+  EXPECT_EQ(interactive.nrThreads, 8);
+  EXPECT_EQ(interactive.nrFrameThreads, 1);
+  EXPECT_EQ(interactive.nrTileThreads, 8);
+}
+
+TEST(DecoderBaseTest, CachingDecodersShareTheNotReservedThreads)
+{
+  {
+    VideoCacheSettings settings(8, 4);
+
+    const auto caching = getDecoderThreading(true);
+    EXPECT_EQ(caching.nrThreads, 1);
+    EXPECT_EQ(caching.nrFrameThreads, 1);
+    EXPECT_EQ(caching.nrTileThreads, 1);
+  }
+  {
+    VideoCacheSettings settings(20, 2);
+
+    const auto caching = getDecoderThreading(true);
+    EXPECT_EQ(caching.nrThreads, 5);
+    EXPECT_EQ(caching.nrFrameThreads, 5);
+    EXPECT_EQ(caching.nrTileThreads, 1);
+  }
+}
+
+TEST(DecoderBaseTest, DecodersGetAtLeastOneThread)
+{
+  VideoCacheSettings settings(1, 0);
+
+  EXPECT_EQ(getNrCachingDecoders(), 1);
+  EXPECT_EQ(getDecoderThreading(false).nrThreads, 1);
+  EXPECT_EQ(getDecoderThreading(true).nrThreads, 1);
+}
+
+TEST(DecoderBaseTest, NrThreadsIsLimitedToTheMaximumOfTheLibraries)
+{
+  VideoCacheSettings settings(1000, 1);
+
+  EXPECT_EQ(getDecoderThreading(false).nrThreads, 64);
+  EXPECT_EQ(getDecoderThreading(true).nrThreads, 32);
+}
+
+} // namespace decoder::test
@@ -0,0 +1,104 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/FileReadAhead.h>
+#include <filesource/FileSource.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+
+ByteVector createTestData(const int size)
+{
+  ByteVector data;
+  for (int i = 0; i < size; i++)
+    data.push_back(static_cast<unsigned char>(i % 251));
+  return data;
+}
+
+void waitForBufferedBytes(const FileReadAhead &readAhead, const int64_t nrBytes)
+{
+  for (int i = 0; i < 1000 && readAhead.getNrBufferedBytes() < nrBytes; i++)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+} // namespace
+
+TEST(FileReadAheadTest, PlannedRangesAreReadUpToTheBufferLimit)
+{
+  const auto                data = createTestData(1000);
+  yuviewTest::TemporaryFile file(data);
+
+  FileSource fileSource;
+  EXPECT_TRUE(fileSource.openFile(file.getFilePath()));
+
+  FileReadAhead readAhead(&fileSource, 400, 200);
+  readAhead.setPlannedRanges({{0, 100}, {100, 100}, {200, 100}, {300, 100}, {400, 100}});
+  waitForBufferedBytes(readAhead, 400);
+  EXPECT_EQ(readAhead.getNrBufferedBytes(), 400);
+
+  const auto range = readAhead.takeRange({100, 100});
+  ASSERT_NE(range, nullptr);
+  EXPECT_EQ(std::memcmp(range.get(), data.data() + 100, 100), 0);
+
+  // Taking the rest of the first chunk makes space for the next one
+  EXPECT_NE(readAhead.takeRange({0, 100}), nullptr);
+  waitForBufferedBytes(readAhead, 300);
+  EXPECT_EQ(readAhead.getNrBufferedBytes(), 300);
+  EXPECT_NE(readAhead.takeRange({400, 100}), nullptr);
+}
+
+TEST(FileReadAheadTest, RangesWhichAreNotPlannedAreNotReturned)
+{
+  yuviewTest::TemporaryFile file(createTestData(1000));
+
+  FileSource fileSource;
+  EXPECT_TRUE(fileSource.openFile(file.getFilePath()));
+
+  FileReadAhead readAhead(&fileSource, 1000, 1000);
+  readAhead.setPlannedRanges({{0, 100}, {100, 100}});
+  waitForBufferedBytes(readAhead, 200);
+
+  EXPECT_EQ(readAhead.takeRange({500, 100}), nullptr);
+  EXPECT_EQ(readAhead.takeRange({0, 50}), nullptr);
+
+  readAhead.setPlannedRanges({{100, 100}});
+  EXPECT_EQ(readAhead.takeRange({0, 100}), nullptr);
+  EXPECT_NE(readAhead.takeRange({100, 100}), nullptr);
+  EXPECT_EQ(readAhead.getNrBufferedBytes(), 0);
+}
@@ -108,16 +108,24 @@ TEST_P(FileSourceAnnexBTest, TestNalUnitParsing)
   const auto [nalSizes, data] = generateAnnexBStream(testParameters);
   yuviewTest::TemporaryFile temporaryFile(data);
 
-  FileSourceAnnexBFile annexBFile(temporaryFile.getFilePath());
-  EXPECT_EQ(static_cast<int>(annexBFile.getNrBytesBeforeFirstNAL()),
-            testParameters.startCodePositions.at(0));
-
-  auto nalData = annexBFile.getNextNALUnit();
-  int  counter = 0;
-  while (nalData.size() > 0)
+  // Read the file memory mapped and in chunks
+  for (const auto useFileMapping : {true, false})
   {
-    EXPECT_EQ(nalSizes.at(counter++), static_cast<int>(nalData.size()));
-    nalData = annexBFile.getNextNALUnit();
+    FileSourceAnnexBFile annexBFile;
+    annexBFile.setUseFileMapping(useFileMapping);
+    EXPECT_TRUE(annexBFile.openFile(temporaryFile.getFilePath()));
+    EXPECT_EQ(static_cast<int>(annexBFile.getNrBytesBeforeFirstNAL()),
+              testParameters.startCodePositions.at(0));
+
+    auto nalData = annexBFile.getNextNALUnit();
+    int  counter = 0;
+    while (nalData.size() > 0)
+    {
+      EXPECT_EQ(nalSizes.at(counter++), static_cast<int>(nalData.size()));
+      nalData = annexBFile.getNextNALUnit();
+    }
+    EXPECT_EQ(counter, static_cast<int>(nalSizes.size()));
+    EXPECT_TRUE(annexBFile.atEnd());
   }
 }
 
@@ -133,10 +141,10 @@ INSTANTIATE_TEST_SUITE_P(
            TestParameters({3, 10000, {4, 80, 208, 9990}}),
            TestParameters({3, 10000, {4, 80, 208, 9997}}),
 
-           // Test cases where a buffer reload is needed (the buffer is 500k)
+           // Test cases where a buffer reload is needed (the chunks are 500k)
            TestParameters({3, 1000000, {80, 208, 500, 50000, 800000}}),
 
-           // The buffer is 500k in size. Test all variations with a start code around this position
+           // The chunks are 500k. Test all variations with a start code around this position
            TestParameters({3, 800000, {80, 208, 500, 50000, 499997}}),
            TestParameters({3, 800000, {80, 208, 500, 50000, 499998}}),
            TestParameters({3, 800000, {80, 208, 500, 50000, 499999}}),
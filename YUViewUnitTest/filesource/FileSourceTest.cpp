@@ -0,0 +1,102 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/FileSource.h>
+
+#include <cstring>
+
+namespace
+{
+
+ByteVector createTestData(const int size)
+{
+  ByteVector data;
+  for (int i = 0; i < size; i++)
+    data.push_back(static_cast<unsigned char>(i % 251));
+  return data;
+}
+
+} // namespace
+
+TEST(FileSourceTest, MappedDataIsIdenticalToReadData)
+{
+  const auto                data = createTestData(10000);
+  yuviewTest::TemporaryFile file(data);
+
+  FileSource fileSource;
+  EXPECT_TRUE(fileSource.openFile(file.getFilePath()));
+  EXPECT_FALSE(fileSource.isMapped());
+  EXPECT_EQ(fileSource.getMappedData(0, 10), nullptr);
+
+  EXPECT_TRUE(fileSource.mapFile());
+  EXPECT_TRUE(fileSource.isMapped());
+
+  QByteArray readData;
+  EXPECT_EQ(fileSource.readBytes(readData, 1234, 5000), 5000);
+
+  const auto mappedData = fileSource.getMappedData(1234, 5000);
+  ASSERT_NE(mappedData, nullptr);
+  EXPECT_EQ(std::memcmp(mappedData.get(), readData.constData(), 5000), 0);
+}
+
+TEST(FileSourceTest, MappedDataOutsideOfFileIsNotReturned)
+{
+  yuviewTest::TemporaryFile file(createTestData(100));
+
+  FileSource fileSource;
+  EXPECT_TRUE(fileSource.openFile(file.getFilePath()));
+  EXPECT_TRUE(fileSource.mapFile());
+
+  EXPECT_NE(fileSource.getMappedData(0, 100), nullptr);
+  EXPECT_EQ(fileSource.getMappedData(0, 101), nullptr);
+  EXPECT_EQ(fileSource.getMappedData(90, 20), nullptr);
+  EXPECT_EQ(fileSource.getMappedData(-1, 10), nullptr);
+}
+
+TEST(FileSourceTest, MappedDataStaysValidAfterReopeningTheFile)
+{
+  const auto                data = createTestData(1000);
+  yuviewTest::TemporaryFile file(data);
+
+  FileSource fileSource;
+  EXPECT_TRUE(fileSource.openFile(file.getFilePath()));
+  EXPECT_TRUE(fileSource.mapFile());
+  const auto mappedData = fileSource.getMappedData(500, 100);
+  ASSERT_NE(mappedData, nullptr);
+
+  EXPECT_TRUE(fileSource.openFile(file.getFilePath()));
+  EXPECT_FALSE(fileSource.isMapped());
+  EXPECT_EQ(std::memcmp(mappedData.get(), data.data() + 500, 100), 0);
+}
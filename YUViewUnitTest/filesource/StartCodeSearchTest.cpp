@@ -0,0 +1,113 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <filesource/StartCodeSearch.h>
+
+#include <random>
+#include <vector>
+
+namespace filesource::test
+{
+
+namespace
+{
+
+using video::yuv::simd::InstructionSet;
+
+constexpr auto ALL_INSTRUCTION_SETS = {
+    InstructionSet::Scalar, InstructionSet::SSE4_1, InstructionSet::AVX2};
+
+std::size_t findNextStartCodeReference(const std::vector<unsigned char> &data)
+{
+  for (std::size_t i = 0; i + 2 < data.size(); i++)
+    if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)
+      return i;
+  return data.size();
+}
+
+TEST(StartCodeSearchTest, StartCodeAtAllPositions)
+{
+  for (const auto size : {3, 16, 17, 18, 33, 34, 35, 100})
+  {
+    for (int startCodePos = 0; startCodePos + 3 <= size; startCodePos++)
+    {
+      std::vector<unsigned char> data(size, 0x80);
+      data[startCodePos]     = 0;
+      data[startCodePos + 1] = 0;
+      data[startCodePos + 2] = 1;
+
+      for (const auto instructionSet : ALL_INSTRUCTION_SETS)
+      {
+        if (!video::yuv::simd::isInstructionSetSupported(instructionSet))
+          continue;
+
+        EXPECT_EQ(findNextStartCode(instructionSet, data.data(), data.size()),
+                  std::size_t(startCodePos));
+        // A start code which is cut off at the end is not found
+        EXPECT_EQ(findNextStartCode(instructionSet, data.data(), startCodePos + 2),
+                  std::size_t(startCodePos + 2));
+      }
+    }
+  }
+}
+
+TEST(StartCodeSearchTest, RandomDataMatchesReference)
+{
+  // Use many zero and one bytes so that there are many (partial) start codes
+  std::mt19937                       generator(42);
+  std::uniform_int_distribution<int> distribution(0, 7);
+
+  for (int i = 0; i < 500; i++)
+  {
+    std::vector<unsigned char> data(generator() % 300);
+    for (auto &value : data)
+    {
+      const auto randomValue = distribution(generator);
+      value                  = randomValue < 3 ? 0 : randomValue < 5 ? 1 : 0x80 + randomValue;
+    }
+
+    const auto expectedPos = findNextStartCodeReference(data);
+    for (const auto instructionSet : ALL_INSTRUCTION_SETS)
+    {
+      if (!video::yuv::simd::isInstructionSetSupported(instructionSet))
+        continue;
+
+      EXPECT_EQ(findNextStartCode(instructionSet, data.data(), data.size()), expectedPos);
+    }
+  }
+}
+
+} // namespace
+
+} // namespace filesource::test
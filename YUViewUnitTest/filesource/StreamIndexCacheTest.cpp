@@ -0,0 +1,78 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <filesource/StreamIndexCache.h>
+
+#include <QTemporaryDir>
+
+#include <fstream>
+
+namespace filesource::test
+{
+
+TEST(StreamIndexCacheTest, StoredIndexCanBeLoadedAgain)
+{
+  yuviewTest::TemporaryFile file(ByteVector(1000, 0));
+  const auto                filePath = QString::fromStdString(file.getFilePathString());
+
+  QTemporaryDir    directory;
+  StreamIndexCache cache(directory.path());
+
+  const auto indexData = QByteArray(5000, 'x');
+  EXPECT_TRUE(cache.storeIndex(filePath, "Index/1", indexData));
+
+  EXPECT_EQ(cache.loadIndex(filePath, "Index/1"), indexData);
+  EXPECT_FALSE(cache.loadIndex(filePath, "Index/2").has_value());
+  EXPECT_FALSE(cache.loadIndex(filePath + "_other", "Index/1").has_value());
+}
+
+TEST(StreamIndexCacheTest, IndexOfChangedFileIsNotLoaded)
+{
+  yuviewTest::TemporaryFile file(ByteVector(1000, 0));
+  const auto                filePath = QString::fromStdString(file.getFilePathString());
+
+  QTemporaryDir    directory;
+  StreamIndexCache cache(directory.path());
+  EXPECT_TRUE(cache.storeIndex(filePath, "Index/1", QByteArray(100, 'x')));
+
+  {
+    std::ofstream fileWriter(file.getFilePath(), std::ios::binary | std::ios::app);
+    fileWriter << "more data";
+  }
+
+  EXPECT_FALSE(cache.loadIndex(filePath, "Index/1").has_value());
+}
+
+} // namespace filesource::test
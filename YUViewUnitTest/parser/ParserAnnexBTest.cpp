@@ -0,0 +1,119 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <parser/HEVC/ParserAnnexBHEVC.h>
+
+#include <QAbstractItemModel>
+
+#include <algorithm>
+
+namespace parser::test
+{
+
+namespace
+{
+
+// An HEVC stream (64x64, CTB size 16) with a VPS, SPS and PPS and three frames with two slices
+// each. Only the slice headers are valid. The slice data is not parsed.
+const ByteVector HEVC_STREAM_WITH_TWO_SLICES_PER_FRAME = {
+    // VPS
+    0x00, 0x00, 0x00, 0x01, 0x40, 0x01, 0x0c, 0x01, 0xff, 0xff, 0x01, 0x60, 0x00, 0x00, 0x03, 0x00,
+    0x90, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00, 0x1e, 0xf0, 0x24,
+    // SPS
+    0x00, 0x00, 0x00, 0x01, 0x42, 0x01, 0x01, 0x01, 0x60, 0x00, 0x00, 0x03, 0x00, 0x90, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x03, 0x00, 0x1e, 0xa0, 0x20, 0x81, 0x05, 0x97, 0xea, 0xf0, 0x82,
+    // PPS
+    0x00, 0x00, 0x00, 0x01, 0x44, 0x01, 0xc0, 0x71, 0x81, 0x12,
+    // IDR (POC 0)
+    0x00, 0x00, 0x00, 0x01, 0x26, 0x01, 0xaf, 0x80, 0xab, 0xcd, 0xef,
+    0x00, 0x00, 0x00, 0x01, 0x26, 0x01, 0x30, 0xf8, 0xab, 0xcd, 0xef,
+    // TRAIL_R (POC 1)
+    0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0xd8, 0x0b, 0xe0, 0xab, 0xcd, 0xef,
+    0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x61, 0x80, 0xbe, 0xab, 0xcd, 0xef,
+    // TRAIL_R (POC 2)
+    0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0xd8, 0x13, 0xe0, 0xab, 0xcd, 0xef,
+    0x00, 0x00, 0x00, 0x01, 0x02, 0x01, 0x61, 0x81, 0x3e, 0xab, 0xcd, 0xef};
+
+// One line per item with its depth and the data of all columns
+void dumpTree(const QAbstractItemModel &model,
+              const QModelIndex        &parent,
+              const int                 depth,
+              std::vector<std::string> &lines)
+{
+  for (int row = 0; row < model.rowCount(parent); row++)
+  {
+    auto line = std::to_string(depth);
+    for (int column = 0; column < model.columnCount(parent); column++)
+      line += "|" + model.data(model.index(row, column, parent)).toString().toStdString();
+    lines.push_back(line);
+    dumpTree(model, model.index(row, 0, parent), depth + 1, lines);
+  }
+}
+
+std::vector<std::string> parseFileAndDumpTree(const std::filesystem::path &filePath,
+                                              const bool                   deferLogging)
+{
+  hevc::ParserAnnexBHEVC parser;
+  parser.enableModel();
+  if (!deferLogging)
+    parser.disableDeferredLogging();
+
+  auto file = std::make_unique<FileSourceAnnexBFile>(filePath);
+  EXPECT_TRUE(parser.parseAnnexBFile(file));
+  EXPECT_EQ(parser.getNumberPOCs(), 3u);
+  parser.updateNumberModelItems();
+
+  std::vector<std::string> lines;
+  dumpTree(*parser.getPacketItemModel(), {}, 0, lines);
+  return lines;
+}
+
+} // namespace
+
+TEST(ParserAnnexBTest, LoggingSlicesInWorkerThreadsCreatesTheSameTree)
+{
+  yuviewTest::TemporaryFile temporaryFile(HEVC_STREAM_WITH_TWO_SLICES_PER_FRAME);
+
+  const auto tree         = parseFileAndDumpTree(temporaryFile.getFilePath(), false);
+  const auto deferredTree = parseFileAndDumpTree(temporaryFile.getFilePath(), true);
+
+  const auto nrSlices = std::count_if(tree.begin(), tree.end(), [](const std::string &line) {
+    return line.rfind("1|slice_segment_layer_rbsp|", 0) == 0;
+  });
+  EXPECT_EQ(nrSlices, 6);
+  EXPECT_EQ(tree, deferredTree);
+}
+
+} // namespace parser::test
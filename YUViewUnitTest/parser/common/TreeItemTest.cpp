@@ -0,0 +1,137 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <parser/common/TreeItem.h>
+
+namespace parser::test
+{
+
+TEST(TreeItemTest, NumericValuesAreFormattedWhenRequested)
+{
+  auto root = TreeItem::createRootItem();
+  root->setProperties("Name", "Value", "Coding", "Code", "Meaning");
+
+  auto unsignedItem = root->createChildItem("flag", true, "u(1)", "1");
+  auto signedItem   = root->createChildItem("delta", int64_t(-5), "se(v)", "0001011", "Meaning");
+  auto stringItem   = root->createChildItem("pts", std::string("1.5s"));
+
+  EXPECT_EQ(root->getData(0), "Name");
+  EXPECT_EQ(root->getData(4), "Meaning");
+  EXPECT_EQ(unsignedItem->getData(1), "1");
+  EXPECT_EQ(unsignedItem->getData(3), "1");
+  EXPECT_EQ(signedItem->getData(0), "delta");
+  EXPECT_EQ(signedItem->getData(1), "-5");
+  EXPECT_EQ(signedItem->getData(2), "se(v)");
+  EXPECT_EQ(signedItem->getData(3), "0001011");
+  EXPECT_EQ(signedItem->getData(4), "Meaning");
+  EXPECT_EQ(stringItem->getData(1), "1.5s");
+  EXPECT_EQ(stringItem->getData(3), "");
+}
+
+TEST(TreeItemTest, LongAndNonBinaryCodesAreKept)
+{
+  auto root = TreeItem::createRootItem();
+
+  const std::string longCode(70, '1');
+  EXPECT_EQ(root->createChildItem("a", 1, {}, longCode)->getData(3), longCode);
+  EXPECT_EQ(root->createChildItem("b", 1, {}, "0x1f")->getData(3), "0x1f");
+  EXPECT_EQ(root->createChildItem("c", 1, {}, std::string(64, '0'))->getData(3),
+            std::string(64, '0'));
+}
+
+TEST(TreeItemTest, ParentAndChildIndices)
+{
+  auto root  = TreeItem::createRootItem();
+  auto level = root->createChildItem("level");
+  for (int i = 0; i < 5000; i++)
+    level->createChildItem("element", i);
+
+  EXPECT_EQ(root->getNrChildItems(), 1u);
+  EXPECT_EQ(level->getNrChildItems(), 5000u);
+  EXPECT_EQ(level->getParentItem(), root.get());
+
+  auto child = level->getChild(4321);
+  ASSERT_TRUE(child);
+  EXPECT_EQ(child->getData(1), "4321");
+  EXPECT_EQ(child->getParentItem(), level.get());
+  EXPECT_EQ(level->getIndexOfChildItem(child.get()), 4321u);
+  EXPECT_FALSE(root->getIndexOfChildItem(child.get()));
+  EXPECT_FALSE(level->getChild(5000));
+}
+
+TEST(TreeItemTest, ItemsKeepTheTreeAlive)
+{
+  std::shared_ptr<TreeItem> child;
+  {
+    auto root = TreeItem::createRootItem();
+    root->setStreamIndex(3);
+    EXPECT_EQ(root->createChildItem("x")->getStreamIndex(), 3);
+    EXPECT_EQ(root->getName(true), "Stream 3 - ");
+    child = root->createChildItem("child")->createChildItem("grandchild", 7);
+  }
+  EXPECT_EQ(child->getData(0), "grandchild");
+  EXPECT_EQ(child->getStreamIndex(), 3);
+  EXPECT_EQ(child->getName(true), "grandchild");
+  ASSERT_NE(child->getParentItem(), nullptr);
+  EXPECT_EQ(child->getParentItem()->getData(0), "child");
+}
+
+TEST(TreeItemTest, AdoptedItemsKeepTheTreeAlive)
+{
+  std::shared_ptr<TreeItem> adoptedChild;
+  {
+    auto root    = TreeItem::createRootItem();
+    auto nalRoot = root->createChildItem("nal");
+    nalRoot->createChildItem("header", 1);
+
+    auto otherRoot = TreeItem::createRootItem();
+    otherRoot->createChildItem("slice")->createChildItem("element", 5);
+    otherRoot->createChildItem("trailing", 0);
+
+    nalRoot->adoptChildItems(otherRoot);
+    otherRoot.reset();
+    ASSERT_EQ(nalRoot->getNrChildItems(), 3u);
+    EXPECT_EQ(nalRoot->getChild(1)->getData(0), "slice");
+    EXPECT_EQ(nalRoot->getChild(2)->getParentItem(), nalRoot.get());
+    EXPECT_EQ(nalRoot->getIndexOfChildItem(nalRoot->getChild(2).get()), 2u);
+
+    adoptedChild = nalRoot->getChild(1)->getChild(0);
+  }
+  EXPECT_EQ(adoptedChild->getData(1), "5");
+  ASSERT_NE(adoptedChild->getParentItem(), nullptr);
+  ASSERT_NE(adoptedChild->getParentItem()->getParentItem(), nullptr);
+  EXPECT_EQ(adoptedChild->getParentItem()->getParentItem()->getData(0), "nal");
+}
+
+} // namespace parser::test
@@ -0,0 +1,112 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <statistics/ColorMapper.h>
+
+namespace stats::color::test
+{
+
+namespace
+{
+
+void expectSameColors(const ColorMapper &colorMapper, Range<int> testRange)
+{
+  const ColorLookupTable colorLookupTable(colorMapper);
+  EXPECT_TRUE(colorLookupTable.isBuiltFrom(colorMapper));
+
+  for (int value = testRange.min; value <= testRange.max; value++)
+  {
+    EXPECT_EQ(colorLookupTable.getColor(value), colorMapper.getColor(value)) << "Value " << value;
+    for (const auto offset : {0.0, 0.25, 0.5})
+    {
+      const auto valueDouble = double(value) + offset;
+      EXPECT_EQ(colorLookupTable.getColor(valueDouble), colorMapper.getColor(valueDouble))
+          << "Value " << valueDouble;
+    }
+  }
+}
+
+} // namespace
+
+TEST(ColorMapperTest, LookupTableMatchesGradient)
+{
+  expectSameColors(ColorMapper({-10, 50}, Color(0, 0, 0), Color(255, 128, 0, 100)), {-20, 60});
+}
+
+TEST(ColorMapperTest, LookupTableMatchesPredefinedTypes)
+{
+  for (const auto predefinedType : PredefinedTypeMapper.getValues())
+    expectSameColors(ColorMapper({0, 40}, predefinedType), {-5, 45});
+}
+
+TEST(ColorMapperTest, LookupTableMatchesMap)
+{
+  const auto colorMap =
+      ColorMap({{-3, Color(255, 0, 0)}, {2, Color(0, 255, 0)}, {7, Color(0, 0, 255)}});
+  expectSameColors(ColorMapper(colorMap, Color(10, 20, 30)), {-10, 10});
+}
+
+TEST(ColorMapperTest, LookupTableWithHugeRange)
+{
+  // No table is created for this range. The colors are calculated on request.
+  expectSameColors(ColorMapper({-1000000, 1000000}, PredefinedType::Jet), {-100, 100});
+  expectSameColors(ColorMapper({{-1000000, Color(255, 0, 0)}, {1000000, Color(0, 0, 255)}},
+                               Color(10, 20, 30)),
+                   {-10, 10});
+}
+
+TEST(ColorMapperTest, LookupTableBulkColors)
+{
+  const auto             colorMapper = ColorMapper({0, 10}, PredefinedType::Hot);
+  const ColorLookupTable colorLookupTable(colorMapper);
+
+  const auto colors = colorLookupTable.getColors(std::vector<int>({0, 5, 10, 20}));
+  ASSERT_EQ(colors.size(), 4u);
+  EXPECT_EQ(colors[1], colorMapper.getColor(5));
+  EXPECT_EQ(colors[3], colorMapper.getColor(10));
+}
+
+TEST(ColorMapperTest, LookupTableIsOutdatedWhenMapperChanges)
+{
+  auto                   colorMapper = ColorMapper({{1, Color(255, 0, 0)}}, Color(0, 0, 0));
+  const ColorLookupTable colorLookupTable(colorMapper);
+
+  colorMapper.colorMapOther = Color(255, 255, 255);
+  EXPECT_FALSE(colorLookupTable.isBuiltFrom(colorMapper));
+
+  colorMapper = ColorMapper({0, 10}, PredefinedType::Jet);
+  EXPECT_FALSE(colorLookupTable.isBuiltFrom(colorMapper));
+}
+
+} // namespace stats::color::test
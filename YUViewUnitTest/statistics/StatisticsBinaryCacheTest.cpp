@@ -0,0 +1,140 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <TemporaryFile.h>
+#include <statistics/StatisticsBinaryCache.h>
+
+#include <fstream>
+
+namespace
+{
+
+stats::FrameTypeData createTestFrameTypeData()
+{
+  stats::FrameTypeData data;
+  data.addBlockValue(0, 8, 16, 8, -3);
+  data.addBlockValue(16, 8, 8, 8, 7);
+  data.addBlockVector(32, 0, 8, 4, 12, -24);
+  data.addLine(64, 64, 32, 32, 0, 0, 31, 31);
+  data.addBlockAffineTF(8, 16, 16, 16, 1, 2, 3, 4, 5, 6);
+  data.addPolygonValue({{0, 0}, {10, 0}, {10, 10}}, 5);
+  data.addPolygonVector({{0, 0}, {8, 0}, {8, 8}, {0, 8}}, -1, 2);
+  return data;
+}
+
+class BinaryCacheFileRemover
+{
+public:
+  BinaryCacheFileRemover(const std::filesystem::path &statisticsFilePath)
+      : cacheFilePath(stats::StatisticsBinaryCache::getCacheFilePath(statisticsFilePath))
+  {
+  }
+  ~BinaryCacheFileRemover() { std::filesystem::remove(this->cacheFilePath); }
+
+private:
+  std::filesystem::path cacheFilePath;
+};
+
+} // namespace
+
+TEST(StatisticsBinaryCache, testWriteAndReadCache)
+{
+  yuviewTest::TemporaryFile statisticsFile(ByteVector(100, 'a'));
+  const auto                statisticsFilePath = statisticsFile.getFilePath();
+  BinaryCacheFileRemover    remover(statisticsFilePath);
+
+  const auto data = createTestFrameTypeData();
+  {
+    stats::StatisticsBinaryCache cache;
+    EXPECT_FALSE(cache.open(statisticsFilePath));
+    EXPECT_TRUE(cache.startWriting(statisticsFilePath));
+    cache.addFrameTypeData(0, 3, data);
+    cache.addFrameTypeData(2, 1, stats::FrameTypeData());
+    EXPECT_TRUE(cache.finishWriting(true, 2));
+  }
+
+  stats::StatisticsBinaryCache cache;
+  EXPECT_TRUE(cache.open(statisticsFilePath));
+  EXPECT_TRUE(cache.isFileSortedByPOC());
+  EXPECT_EQ(cache.getMaxPOC(), 2);
+  EXPECT_EQ(cache.getPOCs(), std::vector<int>({0, 2}));
+
+  stats::FrameTypeData readData;
+  EXPECT_FALSE(cache.loadFrameTypeData(0, 1, readData));
+  EXPECT_TRUE(cache.loadFrameTypeData(0, 3, readData));
+
+  ASSERT_EQ(readData.valueData.size(), size_t(2));
+  EXPECT_EQ(readData.valueData[1].pos[0], 16);
+  EXPECT_EQ(readData.valueData[1].size[1], 8);
+  EXPECT_EQ(readData.valueData[0].value, -3);
+  EXPECT_EQ(readData.maxBlockSize, data.maxBlockSize);
+
+  ASSERT_EQ(readData.vectorData.size(), size_t(2));
+  EXPECT_FALSE(readData.vectorData[0].isLine);
+  EXPECT_EQ(readData.vectorData[0].point[0], stats::Point(12, -24));
+  EXPECT_TRUE(readData.vectorData[1].isLine);
+  EXPECT_EQ(readData.vectorData[1].point[1], stats::Point(31, 31));
+
+  ASSERT_EQ(readData.affineTFData.size(), size_t(1));
+  EXPECT_EQ(readData.affineTFData[0].point[2], stats::Point(5, 6));
+
+  ASSERT_EQ(readData.polygonValueData.size(), size_t(1));
+  EXPECT_EQ(readData.polygonValueData[0].corners, data.polygonValueData[0].corners);
+  EXPECT_EQ(readData.polygonValueData[0].value, 5);
+  ASSERT_EQ(readData.polygonVectorData.size(), size_t(1));
+  EXPECT_EQ(readData.polygonVectorData[0].corners, data.polygonVectorData[0].corners);
+  EXPECT_EQ(readData.polygonVectorData[0].point, stats::Point(-1, 2));
+}
+
+TEST(StatisticsBinaryCache, testCacheIsNotUsedIfStatisticsFileChanged)
+{
+  yuviewTest::TemporaryFile statisticsFile(ByteVector(100, 'a'));
+  const auto                statisticsFilePath = statisticsFile.getFilePath();
+  BinaryCacheFileRemover    remover(statisticsFilePath);
+
+  {
+    stats::StatisticsBinaryCache cache;
+    EXPECT_TRUE(cache.startWriting(statisticsFilePath));
+    cache.addFrameTypeData(0, 0, createTestFrameTypeData());
+    EXPECT_TRUE(cache.finishWriting(false, 0));
+  }
+
+  {
+    std::ofstream file(statisticsFilePath, std::ios::app);
+    file << "more statistics";
+  }
+
+  stats::StatisticsBinaryCache cache;
+  EXPECT_FALSE(cache.open(statisticsFilePath));
+}
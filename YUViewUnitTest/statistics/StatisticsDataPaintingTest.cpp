@@ -0,0 +1,132 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <statistics/StatisticsDataPainting.h>
+
+#include <QImage>
+#include <QPainter>
+
+namespace
+{
+
+QImage paintStatistics(stats::StatisticsData &data, double zoomFactor)
+{
+  const auto frameSize = data.getFrameSize();
+  const auto width     = int(frameSize.width * zoomFactor);
+  const auto height    = int(frameSize.height * zoomFactor);
+
+  QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::white);
+
+  QPainter painter(&image);
+  // The statistics are drawn centered around the origin
+  painter.translate(image.width() / 2, image.height() / 2);
+  stats::paintStatisticsData(&painter, data, 0, zoomFactor);
+  return image;
+}
+
+TEST(StatisticsDataPainting, BlockValuesArePaintedInTheMappedColor)
+{
+  stats::StatisticsData data;
+  data.setFrameSize(Size(32, 16));
+
+  constexpr auto typeID = 0;
+
+  const auto blue  = Color(0, 0, 255);
+  const auto black = Color(0, 0, 0);
+  stats::StatisticsType valueType(
+      typeID, "Something", stats::color::ColorMapper({0, 10}, black, blue));
+  valueType.render          = true;
+  valueType.renderValueData = true;
+  valueType.renderGrid      = false;
+  valueType.alphaFactor     = 100;
+  data.addStatType(valueType);
+
+  data.setFrameIndex(0);
+  data[typeID].addBlockValue(0, 0, 16, 16, 10);
+  data[typeID].addBlockValue(16, 0, 16, 16, 0);
+
+  for (const auto zoomFactor : {1.0, 2.0, 3.0})
+  {
+    const auto image = paintStatistics(data, zoomFactor);
+    EXPECT_EQ(image.pixel(int(4 * zoomFactor), int(4 * zoomFactor)), qRgb(0, 0, 255));
+    EXPECT_EQ(image.pixel(int(20 * zoomFactor), int(12 * zoomFactor)), qRgb(0, 0, 0));
+  }
+
+  // The colors of the blocks must be updated if the color mapping changes
+  data.getStatisticsTypes().at(0).colorMapper = stats::color::ColorMapper({0, 10}, blue, black);
+  const auto image = paintStatistics(data, 1.0);
+  EXPECT_EQ(image.pixel(4, 4), qRgb(0, 0, 0));
+  EXPECT_EQ(image.pixel(20, 12), qRgb(0, 0, 255));
+}
+
+TEST(StatisticsDataPainting, OnlyRenderedValuesAreRasterizedWithOnePixelPerCell)
+{
+  stats::StatisticsData data;
+  data.setFrameSize(Size(64, 32));
+
+  constexpr auto typeID = 0;
+
+  const auto blue  = Color(0, 0, 255);
+  const auto black = Color(0, 0, 0);
+  stats::StatisticsType valueType(
+      typeID, "Something", stats::color::ColorMapper({0, 10}, black, blue));
+  valueType.render          = true;
+  valueType.renderValueData = true;
+  valueType.renderGrid      = false;
+  valueType.alphaFactor     = 100;
+  data.addStatType(valueType);
+
+  data.setFrameIndex(0);
+  data[typeID].addBlockValue(0, 0, 64, 32, 0);
+  data[typeID].addBlockValue(8, 16, 8, 8, 10);
+  data[typeID].addBlockValue(32, 8, 16, 8, 10);
+
+  const auto image = paintStatistics(data, 2.0);
+  EXPECT_EQ(image.pixel(2 * 12, 2 * 20), qRgb(0, 0, 255));
+  EXPECT_EQ(image.pixel(2 * 40, 2 * 12), qRgb(0, 0, 255));
+  EXPECT_EQ(image.pixel(2 * 20, 2 * 20), qRgb(0, 0, 0));
+
+  // All blocks are multiples of 8x8 samples
+  const auto &rasterizedValues = data.getRasterizedValues();
+  ASSERT_EQ(rasterizedValues.count(typeID), 1u);
+  EXPECT_EQ(rasterizedValues.at(typeID).cellSize, 8);
+  EXPECT_EQ(rasterizedValues.at(typeID).image.size(), QSize(8, 4));
+
+  data.getStatisticsTypes().at(0).render = false;
+  paintStatistics(data, 2.0);
+  EXPECT_TRUE(data.getRasterizedValues().empty());
+}
+
+} // namespace
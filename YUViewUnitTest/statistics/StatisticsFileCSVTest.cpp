@@ -265,4 +265,53 @@ TEST(StatisticsFileCSV, testCSVFileParsing)
                                           {576, 40, 32, 24, 0}});
 }
 
-} // namespace
\ No newline at end of file
+TEST(StatisticsFileCSV, testPOCTypeSplitAcrossParallelRanges)
+{
+  std::string stats_str = "%;syntax-version;v1.2\n"
+                          "%;seq-specs;test;0;256;64;0;\n"
+                          "%;type;0;PredMode;range;\n"
+                          "%;defaultRange;0;4;jet\n"
+                          "%;type;1;Skipflag;range;\n"
+                          "%;defaultRange;0;4;jet\n";
+  for (int poc = 0; poc < 2; poc++)
+    for (int typeID = 0; typeID < 2; typeID++)
+      for (int x = 0; x < 256; x += 8)
+        stats_str += std::to_string(poc) + ";" + std::to_string(x) + ";0;8;8;" +
+                     std::to_string(typeID) + ";" + std::to_string(poc + typeID) + "\n";
+  yuviewTest::TemporaryFile csvFile(ByteVector(stats_str.begin(), stats_str.end()));
+
+  stats::StatisticsData    statData;
+  stats::StatisticsFileCSV statFile(QString::fromStdString(csvFile.getFilePathString()), statData);
+
+  // Split the file into ranges of a few lines each so that all POC/types span multiple ranges
+  statFile.setParallelIndexingLimits(256, 16);
+
+  using POCType = std::pair<int, int>;
+  std::map<POCType, int> nrReadPOCTypeSignals;
+  QObject::connect(&statFile,
+                   &stats::StatisticsFileBase::readPOCType,
+                   [&](int poc, int typeID) { nrReadPOCTypeSignals[{poc, typeID}]++; });
+
+  std::atomic_bool breakAtomic;
+  breakAtomic.store(false);
+  statFile.readFrameAndTypePositionsFromFile(std::ref(breakAtomic));
+
+  EXPECT_EQ(nrReadPOCTypeSignals,
+            (std::map<POCType, int>{{{0, 0}, 1}, {{0, 1}, 1}, {{1, 0}, 1}, {{1, 1}, 1}}));
+  EXPECT_EQ(statFile.getMaxPoc(), 1);
+
+  for (int poc = 0; poc < 2; poc++)
+  {
+    for (int typeID = 0; typeID < 2; typeID++)
+    {
+      statFile.loadStatisticData(statData, poc, typeID);
+      EXPECT_EQ(statData.getFrameIndex(), poc);
+      ASSERT_EQ(statData[typeID].valueData.size(), size_t(32));
+      EXPECT_EQ(statData[typeID].valueData.front().pos[0], 0);
+      EXPECT_EQ(statData[typeID].valueData.back().pos[0], 248);
+      EXPECT_EQ(statData[typeID].valueData.back().value, poc + typeID);
+    }
+  }
+}
+
+} // namespace
@@ -37,6 +37,8 @@
 #include <TemporaryFile.h>
 #include <statistics/StatisticsFileVTMBMS.h>
 
+#include <map>
+
 namespace
 {
 
@@ -217,4 +219,44 @@ TEST(StatisticsFileCSV, testCSVFileParsing)
       });
 }
 
+TEST(StatisticsFileVTMBMS, testPOCSplitAcrossParallelRanges)
+{
+  std::string stats_str = "# VTMBMS Block Statistics\n"
+                          "# Sequence size: [256x 64]\n"
+                          "# Block Statistic Type: PredMode; Integer; [0, 4]\n";
+  for (int poc = 0; poc < 2; poc++)
+    for (int x = 0; x < 256; x += 8)
+      stats_str += "BlockStat: POC " + std::to_string(poc) + " @(" + std::to_string(x) +
+                   ",   0) [ 8x 8] PredMode=" + std::to_string(poc + 1) + "\n";
+  yuviewTest::TemporaryFile vtmbmsFile(ByteVector(stats_str.begin(), stats_str.end()));
+
+  stats::StatisticsData       statData;
+  stats::StatisticsFileVTMBMS statFile(QString::fromStdString(vtmbmsFile.getFilePathString()),
+                                       statData);
+
+  // Split the file into ranges of a few lines each so that both POCs span multiple ranges
+  statFile.setParallelIndexingLimits(256, 16);
+
+  std::map<int, int> nrReadPOCSignals;
+  QObject::connect(
+      &statFile, &stats::StatisticsFileBase::readPOC, [&](int poc) { nrReadPOCSignals[poc]++; });
+
+  std::atomic_bool breakAtomic;
+  breakAtomic.store(false);
+  statFile.readFrameAndTypePositionsFromFile(std::ref(breakAtomic));
+
+  EXPECT_EQ(nrReadPOCSignals, (std::map<int, int>{{0, 1}, {1, 1}}));
+  EXPECT_EQ(statFile.getMaxPoc(), 1);
+
+  for (int poc = 0; poc < 2; poc++)
+  {
+    statFile.loadStatisticData(statData, poc, 1);
+    EXPECT_EQ(statData.getFrameIndex(), poc);
+    ASSERT_EQ(statData[1].valueData.size(), size_t(32));
+    EXPECT_EQ(statData[1].valueData.front().pos[0], 0);
+    EXPECT_EQ(statData[1].valueData.back().pos[0], 248);
+    EXPECT_EQ(statData[1].valueData.back().value, poc + 1);
+  }
+}
+
 } // namespace
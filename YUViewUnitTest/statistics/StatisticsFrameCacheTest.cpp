@@ -0,0 +1,113 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <statistics/StatisticsFrameCache.h>
+
+namespace stats::test
+{
+
+namespace
+{
+
+FrameTypeDataMap createFrameData(int nrBlocks)
+{
+  FrameTypeDataMap data;
+  for (int i = 0; i < nrBlocks; i++)
+  {
+    data[0].addBlockValue(i * 8, 0, 8, 8, i);
+    data[1].addBlockVector(i * 8, 0, 8, 8, i, -i);
+  }
+  return data;
+}
+
+} // namespace
+
+TEST(StatisticsFrameCacheTest, AddGetAndRemoveFrames)
+{
+  StatisticsFrameCache cache;
+  EXPECT_FALSE(cache.get(0));
+  EXPECT_EQ(cache.getNrBytes(), 0);
+
+  cache.add(3, createFrameData(10));
+  cache.add(5, createFrameData(20));
+  EXPECT_EQ(cache.getNrFrames(), 2u);
+  EXPECT_TRUE(cache.contains(3));
+  EXPECT_FALSE(cache.contains(4));
+  EXPECT_EQ(cache.getFrameIndices(), std::vector<int>({3, 5}));
+
+  const auto frame = cache.get(5);
+  ASSERT_TRUE(frame);
+  ASSERT_EQ(frame->size(), 2u);
+  EXPECT_EQ(frame->at(0).valueData.size(), 20u);
+  EXPECT_EQ(frame->at(1).vectorData.size(), 20u);
+  EXPECT_EQ(frame->at(0).valueData.at(7).value, 7);
+
+  cache.remove(3);
+  EXPECT_FALSE(cache.contains(3));
+  EXPECT_EQ(cache.getNrFrames(), 1u);
+
+  cache.clear();
+  EXPECT_EQ(cache.getNrFrames(), 0u);
+  EXPECT_TRUE(cache.getFrameIndices().empty());
+  EXPECT_EQ(cache.getNrBytes(), 0);
+}
+
+TEST(StatisticsFrameCacheTest, MemoryUsageIsCounted)
+{
+  StatisticsFrameCache cache;
+  cache.add(0, createFrameData(100));
+  const auto bytesOneFrame = cache.getNrBytes();
+  EXPECT_GE(bytesOneFrame, int64_t(100 * (sizeof(StatsItemValue) + sizeof(StatsItemVector))));
+
+  // Replacing a frame must not count it twice
+  cache.add(0, createFrameData(100));
+  EXPECT_EQ(cache.getNrBytes(), bytesOneFrame);
+
+  cache.add(1, createFrameData(100));
+  EXPECT_EQ(cache.getNrBytes(), 2 * bytesOneFrame);
+
+  cache.remove(0);
+  EXPECT_EQ(cache.getNrBytes(), bytesOneFrame);
+}
+
+TEST(StatisticsFrameCacheTest, EstimatedFrameSizeDoesNotDependOnCachedFrames)
+{
+  const auto estimate = StatisticsFrameCache::estimateFrameSize(Size(64, 32), 2);
+  EXPECT_EQ(estimate, unsigned(32 * 2 * sizeof(StatsItemVector)));
+  EXPECT_EQ(StatisticsFrameCache::estimateFrameSize(Size(64, 32), 0), 0u);
+  EXPECT_EQ(StatisticsFrameCache::estimateFrameSize(Size(4, 4), 1),
+            unsigned(sizeof(StatsItemVector)));
+}
+
+} // namespace stats::test
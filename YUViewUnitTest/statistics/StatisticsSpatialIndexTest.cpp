@@ -0,0 +1,142 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <statistics/StatisticsSpatialIndex.h>
+
+#include <algorithm>
+
+namespace stats::test
+{
+
+namespace
+{
+
+// A frame of 128x64 pixels covered by 8x8 blocks. The value of a block is its index.
+FrameTypeData createBlockValues()
+{
+  FrameTypeData data;
+  for (unsigned short y = 0; y < 64; y += 8)
+    for (unsigned short x = 0; x < 128; x += 8)
+      data.addBlockValue(x, y, 8, 8, int(data.valueData.size()));
+  return data;
+}
+
+std::vector<unsigned> getOverlappingBlocks(const FrameTypeData &data, const QRect &area)
+{
+  std::vector<unsigned> blocks;
+  for (unsigned i = 0; i < unsigned(data.valueData.size()); i++)
+  {
+    const auto &item = data.valueData[i];
+    if (QRect(item.pos[0], item.pos[1], item.size[0], item.size[1]).intersects(area))
+      blocks.push_back(i);
+  }
+  return blocks;
+}
+
+bool contains(const std::vector<unsigned> &candidates, const std::vector<unsigned> &blocks)
+{
+  return std::includes(candidates.begin(), candidates.end(), blocks.begin(), blocks.end());
+}
+
+} // namespace
+
+TEST(StatisticsSpatialIndexTest, FindValuesAtPosition)
+{
+  const auto data  = createBlockValues();
+  const auto index = StatisticsSpatialIndex(data);
+
+  const auto candidates = index.getValuesIn(QRect(QPoint(37, 21), QSize(1, 1)));
+  EXPECT_TRUE(contains(candidates, {2 * 16 + 4}));
+  EXPECT_LT(candidates.size(), data.valueData.size());
+
+  EXPECT_TRUE(index.getValuesIn(QRect(QPoint(200, 10), QSize(1, 1))).empty());
+  EXPECT_TRUE(index.getValuesIn(QRect(QPoint(-5, -5), QSize(2, 2))).empty());
+}
+
+TEST(StatisticsSpatialIndexTest, FindValuesInArea)
+{
+  const auto data  = createBlockValues();
+  const auto index = StatisticsSpatialIndex(data);
+
+  for (const auto &area : {QRect(0, 0, 128, 64), QRect(20, 10, 50, 30), QRect(-10, 40, 30, 100)})
+  {
+    const auto candidates = index.getValuesIn(area);
+    EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+    EXPECT_EQ(std::adjacent_find(candidates.begin(), candidates.end()), candidates.end());
+    EXPECT_TRUE(contains(candidates, getOverlappingBlocks(data, area)));
+  }
+}
+
+TEST(StatisticsSpatialIndexTest, BlocksSpanningCellsAreFoundOnce)
+{
+  auto data = createBlockValues();
+  data.addBlockValue(0, 0, 128, 64, 128);
+
+  const auto index      = StatisticsSpatialIndex(data);
+  const auto candidates = index.getValuesIn(QRect(0, 0, 128, 64));
+  EXPECT_EQ(candidates.size(), data.valueData.size());
+  EXPECT_EQ(std::adjacent_find(candidates.begin(), candidates.end()), candidates.end());
+  EXPECT_TRUE(contains(index.getValuesIn(QRect(QPoint(100, 50), QSize(1, 1))), {128}));
+}
+
+TEST(StatisticsSpatialIndexTest, IndexIsOutdatedWhenDataIsAdded)
+{
+  auto       data  = createBlockValues();
+  const auto index = StatisticsSpatialIndex(data);
+  EXPECT_TRUE(index.isUpToDate(data));
+
+  data.addBlockVector(0, 0, 8, 8, 1, 1);
+  EXPECT_FALSE(index.isUpToDate(data));
+}
+
+TEST(StatisticsSpatialIndexTest, VectorReach)
+{
+  FrameTypeData data;
+  data.addBlockVector(0, 0, 8, 8, 40, 80);
+  data.addLine(8, 0, 8, 8, 0, 0, 20, 30);
+
+  const auto index = StatisticsSpatialIndex(data);
+  EXPECT_GE(index.getVectorReach(1), 80);
+  EXPECT_GE(index.getVectorReach(4), 30);
+  EXPECT_LT(index.getVectorReach(4), 80);
+
+  // The arrow of the first block ends in the area. The block is only found if the area is extended
+  // by the reach.
+  const auto area  = QRect(40, 80, 8, 8);
+  const auto reach = index.getVectorReach(1);
+  EXPECT_FALSE(contains(index.getVectorsIn(area), {0}));
+  EXPECT_TRUE(contains(index.getVectorsIn(area.adjusted(-reach, -reach, reach, reach)), {0}));
+}
+
+} // namespace stats::test
@@ -0,0 +1,96 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/CacheEvictionPolicy.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+constexpr int64_t FRAME_SIZE = 1920 * 1080 * 3 / 2;
+
+} // namespace
+
+TEST(CacheEvictionPolicyTest, PlaylistOrderKeepsTheOrderOfTheCandidates)
+{
+  const std::vector<EvictionCandidate> candidates = {
+      {FRAME_SIZE, 0.5, 3}, {FRAME_SIZE, 0.001, 0}, {FRAME_SIZE, 0.1, 7}};
+
+  const auto policy = createCacheEvictionPolicy(EvictionPolicy::PlaylistOrder);
+  EXPECT_THAT(policy->getEvictionOrder(candidates), ElementsAre(0, 1, 2));
+}
+
+TEST(CacheEvictionPolicyTest, CostAwareWithoutMeasurementsKeepsThePlaylistOrder)
+{
+  const std::vector<EvictionCandidate> candidates = {
+      {FRAME_SIZE, 0.0, 0}, {FRAME_SIZE, 0.0, 0}, {FRAME_SIZE, 0.0, 0}};
+
+  const auto policy = createCacheEvictionPolicy(EvictionPolicy::CostAware);
+  EXPECT_THAT(policy->getEvictionOrder(candidates), ElementsAre(0, 1, 2));
+}
+
+TEST(CacheEvictionPolicyTest, CostAwareRemovesFramesThatAreCheapToReloadFirst)
+{
+  // Two decoded frames (far from the last random access point) and two frames of a raw file.
+  const std::vector<EvictionCandidate> candidates = {{FRAME_SIZE, 0.2, 0},
+                                                     {FRAME_SIZE, 0.4, 0},
+                                                     {FRAME_SIZE, 0.002, 0},
+                                                     {FRAME_SIZE, 0.002, 0}};
+
+  const auto policy = createCacheEvictionPolicy(EvictionPolicy::CostAware);
+  EXPECT_THAT(policy->getEvictionOrder(candidates), ElementsAre(2, 3, 0, 1));
+}
+
+TEST(CacheEvictionPolicyTest, CostAwareWeighsTheCostPerByte)
+{
+  // The same reload cost frees four times the memory for the first candidate.
+  const std::vector<EvictionCandidate> candidates = {{FRAME_SIZE, 0.01, 0},
+                                                     {FRAME_SIZE * 4, 0.01, 0}};
+
+  const auto policy = createCacheEvictionPolicy(EvictionPolicy::CostAware);
+  EXPECT_THAT(policy->getEvictionOrder(candidates), ElementsAre(1, 0));
+}
+
+TEST(CacheEvictionPolicyTest, CostAwareKeepsRecentlyAccessedFramesLonger)
+{
+  const std::vector<EvictionCandidate> candidates = {
+      {FRAME_SIZE, 0.01, 20}, {FRAME_SIZE, 0.01, 10}, {FRAME_SIZE, 0.01, 0}};
+
+  const auto policy = createCacheEvictionPolicy(EvictionPolicy::CostAware);
+  EXPECT_THAT(policy->getEvictionOrder(candidates), ElementsAre(2, 1, 0));
+}
+
+} // namespace video::test
@@ -0,0 +1,143 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/DiskFrameCache.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace video::test
+{
+
+namespace
+{
+
+QByteArray createFrameData(const int size, const char seed)
+{
+  QByteArray data(size, 0);
+  for (int i = 0; i < size; i++)
+    data[i] = char(seed + (i / 64) % 16);
+  return data;
+}
+
+} // namespace
+
+TEST(DiskFrameCacheTest, StoredFramesCanBeLoadedAgain)
+{
+  QTemporaryDir  directory;
+  DiskFrameCache cache(directory.path(), 100 * 1000 * 1000);
+
+  const auto frame0 = createFrameData(10000, 10);
+  const auto frame1 = createFrameData(10000, 20);
+  EXPECT_TRUE(cache.storeFrame("source", 0, frame0));
+  EXPECT_TRUE(cache.storeFrame("source", 1, frame1));
+
+  EXPECT_EQ(cache.getNrFrames(), 2);
+  EXPECT_EQ(cache.loadFrame("source", 0), frame0);
+  EXPECT_EQ(cache.loadFrame("source", 1), frame1);
+  EXPECT_FALSE(cache.loadFrame("source", 2).has_value());
+  EXPECT_FALSE(cache.loadFrame("otherSource", 0).has_value());
+
+  // The frames are compressed
+  EXPECT_LT(cache.getSizeOnDisk(), 2 * 10000);
+}
+
+TEST(DiskFrameCacheTest, FramesArePersistent)
+{
+  QTemporaryDir directory;
+  const auto    frame = createFrameData(10000, 30);
+  {
+    DiskFrameCache cache(directory.path(), 100 * 1000 * 1000);
+    cache.storeFrameInBackground("source", 5, frame);
+  }
+
+  DiskFrameCache cache(directory.path(), 100 * 1000 * 1000);
+  cache.waitForBackgroundTasks();
+  EXPECT_TRUE(cache.containsFrame("source", 5));
+  EXPECT_EQ(cache.loadFrame("source", 5), frame);
+}
+
+TEST(DiskFrameCacheTest, LeastRecentlyUsedFramesAreDeletedFirst)
+{
+  QTemporaryDir  directory;
+  DiskFrameCache cache(directory.path(), 100 * 1000 * 1000);
+
+  for (int i = 0; i < 3; i++)
+    cache.storeFrame("source", i, createFrameData(10000, char(i)));
+  EXPECT_TRUE(cache.loadFrame("source", 0).has_value());
+
+  // Only two of the frames fit. Frame 1 was not used for the longest time.
+  cache.setMaxSize(cache.getSizeOnDisk() - 1);
+  EXPECT_TRUE(cache.containsFrame("source", 0));
+  EXPECT_FALSE(cache.containsFrame("source", 1));
+  EXPECT_TRUE(cache.containsFrame("source", 2));
+}
+
+TEST(DiskFrameCacheTest, FramesOfEarlierSessionsAreDeletedFirst)
+{
+  QTemporaryDir directory;
+  {
+    DiskFrameCache cache(directory.path(), 100 * 1000 * 1000);
+    cache.storeFrame("source", 0, createFrameData(10000, 50));
+  }
+
+  DiskFrameCache cache(directory.path(), 100 * 1000 * 1000);
+  cache.waitForBackgroundTasks();
+  cache.storeFrame("source", 1, createFrameData(10000, 60));
+  EXPECT_EQ(cache.getNrFrames(), 2);
+
+  cache.setMaxSize(cache.getSizeOnDisk() - 1);
+  EXPECT_FALSE(cache.containsFrame("source", 0));
+  EXPECT_TRUE(cache.containsFrame("source", 1));
+}
+
+TEST(DiskFrameCacheTest, CorruptFilesAreNotLoaded)
+{
+  QTemporaryDir  directory;
+  DiskFrameCache cache(directory.path(), 100 * 1000 * 1000);
+  cache.storeFrame("source", 0, createFrameData(10000, 40));
+
+  for (const auto &file : QDir(directory.path()).entryInfoList(QDir::Files))
+  {
+    QFile corruptFile(file.filePath());
+    ASSERT_TRUE(corruptFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    corruptFile.write("not a frame");
+  }
+
+  EXPECT_FALSE(cache.loadFrame("source", 0).has_value());
+  EXPECT_FALSE(cache.containsFrame("source", 0));
+}
+
+} // namespace video::test
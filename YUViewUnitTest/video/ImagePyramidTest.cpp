@@ -0,0 +1,100 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/ImagePyramid.h>
+
+namespace video::test
+{
+
+TEST(ImagePyramidTest, LevelsHalveTheSizeDownToTheMinimumSize)
+{
+  QImage image(1000, 300, QImage::Format_RGB32);
+  image.fill(Qt::red);
+
+  const ImagePyramid pyramid(image);
+
+  // 500x150, 250x75 and 125x37. 62x18 would be smaller than 64 in both directions.
+  ASSERT_EQ(pyramid.getNrLevels(), 3);
+  EXPECT_EQ(pyramid.getImageForScale(image, 0.5).size(), image.size());
+  EXPECT_EQ(pyramid.getImageForScale(image, 0.4).size(), QSize(500, 150));
+  EXPECT_EQ(pyramid.getImageForScale(image, 0.25).size(), QSize(250, 75));
+  EXPECT_EQ(pyramid.getImageForScale(image, 0.01).size(), QSize(125, 37));
+  EXPECT_EQ(pyramid.getImageForScale(image, 0.4).pixel(10, 10), QColor(Qt::red).rgb());
+}
+
+TEST(ImagePyramidTest, DownscalingAveragesTwoByTwoPixels)
+{
+  QImage image(256, 2, QImage::Format_RGB32);
+  for (int x = 0; x < image.width(); x++)
+  {
+    image.setPixel(x, 0, qRgb(0, 100, 200));
+    image.setPixel(x, 1, qRgb((x % 2) ? 40 : 0, 100, 0));
+  }
+
+  const ImagePyramid pyramid(image);
+
+  ASSERT_GE(pyramid.getNrLevels(), 1);
+  const auto &level = pyramid.getImageForScale(image, 0.5 - 0.01);
+  ASSERT_EQ(level.size(), QSize(128, 1));
+  EXPECT_EQ(level.pixel(0, 0), qRgb(10, 100, 100));
+}
+
+TEST(ImagePyramidTest, IsBuiltFromTheSourceImageOnly)
+{
+  QImage image(128, 128, QImage::Format_RGB32);
+  image.fill(Qt::blue);
+  const ImagePyramid pyramid(image);
+
+  EXPECT_TRUE(pyramid.isBuiltFrom(image));
+  EXPECT_FALSE(ImagePyramid().isBuiltFrom(image));
+
+  auto modifiedImage = image;
+  modifiedImage.setPixel(0, 0, qRgb(1, 2, 3));
+  EXPECT_FALSE(pyramid.isBuiltFrom(modifiedImage));
+}
+
+TEST(ImagePyramidTest, OnlyLargeImagesUseAPyramid)
+{
+  EXPECT_FALSE(ImagePyramid::isUseful(QSize(1920, 1080)));
+  EXPECT_TRUE(ImagePyramid::isUseful(QSize(3840, 2160)));
+
+  EXPECT_EQ(ImagePyramid::getMemoryUsage(QSize(1920, 1080), 4), 0);
+  // The levels need about a third of the memory of the full image
+  const auto fullImageBytes = int64_t(7680) * 4320 * 4;
+  const auto pyramidBytes   = ImagePyramid::getMemoryUsage(QSize(7680, 4320), 4);
+  EXPECT_GT(pyramidBytes, fullImageBytes / 4);
+  EXPECT_LT(pyramidBytes, fullImageBytes / 3);
+}
+
+} // namespace video::test
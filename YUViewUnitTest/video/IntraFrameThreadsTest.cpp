@@ -0,0 +1,122 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/IntraFrameThreads.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace video::test
+{
+
+namespace
+{
+
+struct ProcessedBands
+{
+  std::vector<std::pair<int, int>> bands;
+  std::vector<int>                 processedCountPerRow;
+};
+
+ProcessedBands runProcessRowBands(const int  nrSpareThreads,
+                                  const Size frameSize,
+                                  const int  rowAlignment)
+{
+  intraFrameThreads::setNrSpareThreads(nrSpareThreads);
+
+  ProcessedBands result;
+  result.processedCountPerRow.resize(frameSize.height);
+
+  std::mutex mutex;
+  intraFrameThreads::processRowBands(
+      int(frameSize.width), int(frameSize.height), rowAlignment, [&](int rowStart, int rowEnd) {
+        std::lock_guard<std::mutex> lock(mutex);
+        result.bands.push_back({rowStart, rowEnd});
+        for (int row = rowStart; row < rowEnd; row++)
+          result.processedCountPerRow.at(row)++;
+      });
+
+  intraFrameThreads::setNrSpareThreads(0);
+  return result;
+}
+
+} // namespace
+
+TEST(IntraFrameThreadsTest, NoSpareThreadsProcessesFrameInOneBand)
+{
+  const auto result = runProcessRowBands(0, Size(7680, 4320), 2);
+  EXPECT_THAT(result.bands, ElementsAre(std::make_pair(0, 4320)));
+}
+
+TEST(IntraFrameThreadsTest, SmallFramesAreNotSplit)
+{
+  const auto result = runProcessRowBands(8, Size(176, 144), 2);
+  EXPECT_THAT(result.bands, ElementsAre(std::make_pair(0, 144)));
+}
+
+TEST(IntraFrameThreadsTest, AllRowsAreProcessedExactlyOnce)
+{
+  for (const auto nrSpareThreads : {1, 3, 7, 15})
+  {
+    for (const auto rowAlignment : {1, 2, 4})
+    {
+      const auto result = runProcessRowBands(nrSpareThreads, Size(7680, 4322), rowAlignment);
+
+      EXPECT_GT(result.bands.size(), 1u);
+      EXPECT_LE(result.bands.size(), unsigned(nrSpareThreads + 1));
+      for (const auto &band : result.bands)
+        EXPECT_EQ(band.first % rowAlignment, 0);
+      for (const auto count : result.processedCountPerRow)
+        ASSERT_EQ(count, 1);
+    }
+  }
+}
+
+TEST(IntraFrameThreadsTest, ConcurrentConversionsShareSpareThreads)
+{
+  intraFrameThreads::setNrSpareThreads(3);
+
+  std::atomic_int nrSpareThreadsDuringConversion{-1};
+  intraFrameThreads::processRowBands(7680, 4320, 2, [&](int rowStart, int) {
+    if (rowStart == 0)
+      nrSpareThreadsDuringConversion = intraFrameThreads::getNrSpareThreads();
+  });
+
+  // All spare threads were used by the conversion. Another conversion had to run on its own.
+  EXPECT_EQ(nrSpareThreadsDuringConversion.load(), 0);
+  EXPECT_EQ(intraFrameThreads::getNrSpareThreads(), 3);
+  intraFrameThreads::setNrSpareThreads(0);
+}
+
+} // namespace video::test
@@ -0,0 +1,154 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/RawFrameBuffer.h>
+
+namespace video::test
+{
+
+namespace
+{
+
+QByteArray toQByteArray(const std::vector<unsigned char> &data)
+{
+  return QByteArray(reinterpret_cast<const char *>(data.data()), int(data.size()));
+}
+
+} // namespace
+
+TEST(RawFrameBufferTest, DefaultConstructedBufferIsNull)
+{
+  RawFrameBuffer buffer;
+  EXPECT_TRUE(buffer.isNull());
+  EXPECT_TRUE(buffer.isPacked());
+  EXPECT_TRUE(buffer.toByteArray().isEmpty());
+}
+
+TEST(RawFrameBufferTest, PackedBufferIsNotCopied)
+{
+  const auto     data = toQByteArray({1, 2, 3, 4, 5, 6});
+  RawFrameBuffer buffer(data);
+
+  EXPECT_FALSE(buffer.isNull());
+  EXPECT_TRUE(buffer.isPacked());
+  EXPECT_EQ(buffer.toByteArray(), data);
+  EXPECT_EQ(buffer.toByteArray().constData(), data.constData());
+}
+
+TEST(RawFrameBufferTest, PackedViewIsCopiedAndKeepsOwnerAlive)
+{
+  auto ownerData = std::make_shared<std::vector<char>>(std::vector<char>({1, 2, 3, 4}));
+  auto view      = QByteArray::fromRawData(ownerData->data(), int(ownerData->size()));
+
+  std::weak_ptr<std::vector<char>> weakOwner = ownerData;
+  {
+    RawFrameBuffer buffer(view, ownerData);
+    ownerData.reset();
+    EXPECT_FALSE(weakOwner.expired());
+
+    const auto copy = buffer.toByteArray();
+    EXPECT_EQ(copy, view);
+    EXPECT_NE(copy.constData(), view.constData());
+  }
+  EXPECT_TRUE(weakOwner.expired());
+}
+
+TEST(RawFrameBufferTest, PlanesWithStrideAreCopiedWithoutPadding)
+{
+  // A 2x2 luma plane with a stride of 4 and two 1x1 chroma planes with a stride of 2
+  const std::vector<unsigned char> luma    = {1, 2, 0, 0, 3, 4, 0, 0};
+  const std::vector<unsigned char> chromaU = {5, 0};
+  const std::vector<unsigned char> chromaV = {6, 0};
+
+  RawFrameBuffer buffer(
+      {{luma.data(), 4, 2, 2}, {chromaU.data(), 2, 1, 1}, {chromaV.data(), 2, 1, 1}}, {});
+
+  EXPECT_FALSE(buffer.isNull());
+  EXPECT_FALSE(buffer.isPacked());
+  EXPECT_EQ(buffer.getPlanes().size(), 3u);
+  EXPECT_EQ(buffer.toByteArray(), toQByteArray({1, 2, 3, 4, 5, 6}));
+}
+
+TEST(RawFrameBufferTest, BufferWithMissingPlaneDataIsNull)
+{
+  const std::vector<unsigned char> luma = {1, 2, 3, 4};
+
+  RawFrameBuffer buffer({{luma.data(), 2, 2, 2}, {nullptr, 1, 1, 1}}, {});
+  EXPECT_TRUE(buffer.isNull());
+  EXPECT_TRUE(buffer.toByteArray().isEmpty());
+}
+
+TEST(RawFrameBufferTest, OnlyBuffersThatDoNotOwnTheirDataAreViews)
+{
+  const std::vector<unsigned char> luma = {1, 2, 3, 4};
+  const auto                       data = toQByteArray(luma);
+
+  EXPECT_FALSE(RawFrameBuffer(data).isView());
+  EXPECT_TRUE(RawFrameBuffer(QByteArray::fromRawData(data.constData(), data.size()), {}).isView());
+  EXPECT_TRUE(RawFrameBuffer({{luma.data(), 2, 2, 2}}, {}).isView());
+}
+
+TEST(RawFrameBufferTest, ReleaseFunctionIsCalledOnceAfterLastCopyIsDestroyed)
+{
+  const std::vector<unsigned char> luma = {1, 2, 3, 4};
+
+  int nrCalls = 0;
+  {
+    RawFrameBuffer buffer({{luma.data(), 2, 2, 2}}, {});
+    buffer.addReleaseFunction([&nrCalls]() { nrCalls++; });
+
+    {
+      auto copy = buffer;
+      EXPECT_EQ(copy.toByteArray(), toQByteArray({1, 2, 3, 4}));
+    }
+    EXPECT_EQ(nrCalls, 0);
+  }
+  EXPECT_EQ(nrCalls, 1);
+}
+
+TEST(RawFrameBufferTest, PreviousOwnerIsReleasedAfterReleaseFunction)
+{
+  std::vector<int> releaseOrder;
+  {
+    auto owner = std::shared_ptr<const void>(
+        nullptr, [&releaseOrder](const void *) { releaseOrder.push_back(1); });
+
+    RawFrameBuffer buffer(std::vector<RawFrameBuffer::Plane>(), owner);
+    owner.reset();
+    buffer.addReleaseFunction([&releaseOrder]() { releaseOrder.push_back(2); });
+  }
+  EXPECT_THAT(releaseOrder, ElementsAre(2, 1));
+}
+
+} // namespace video::test
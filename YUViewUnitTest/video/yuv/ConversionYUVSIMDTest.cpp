@@ -0,0 +1,232 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/yuv/ConversionYUVSIMD.h>
+#include <video/yuv/PixelFormatYUV.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <QByteArray>
+
+#include <cstring>
+#include <random>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+using simd::InstructionSet;
+
+constexpr auto ALL_INSTRUCTION_SETS = {
+    InstructionSet::Scalar, InstructionSet::SSE4_1, InstructionSet::AVX2};
+constexpr auto TEST_WIDTHS = {1, 2, 15, 16, 17, 32, 62, 100};
+
+bool isFullRange(const ColorConversion colorConversion)
+{
+  return colorConversion == ColorConversion::BT709_FullRange ||
+         colorConversion == ColorConversion::BT601_FullRange ||
+         colorConversion == ColorConversion::BT2020_FullRange;
+}
+
+template <typename T> std::vector<T> createRandomSamples(const int count, const int bitDepth)
+{
+  std::mt19937                       generator(count * 17 + bitDepth);
+  std::uniform_int_distribution<int> distribution(0, (1 << bitDepth) - 1);
+
+  std::vector<T> samples(count);
+  for (auto &sample : samples)
+    sample = T(distribution(generator));
+  return samples;
+}
+
+// A planar YUV frame with random samples in the native byte order
+QByteArray createRandomFrame(const PixelFormatYUV &format, const Size frameSize)
+{
+  const auto bitDepth  = int(format.getBitsPerSample());
+  const auto nrSamples = int(format.bytesPerFrame(frameSize) / ((bitDepth > 8) ? 2 : 1));
+
+  QByteArray frame(int(format.bytesPerFrame(frameSize)), 0);
+  if (bitDepth > 8)
+  {
+    const auto samples = createRandomSamples<uint16_t>(nrSamples, bitDepth);
+    std::memcpy(frame.data(), samples.data(), samples.size() * 2);
+  }
+  else
+  {
+    const auto samples = createRandomSamples<uint8_t>(nrSamples, bitDepth);
+    std::memcpy(frame.data(), samples.data(), samples.size());
+  }
+  return frame;
+}
+
+ConversionSettings createConversionSettings(const ColorConversion colorConversion)
+{
+  // The same YUV math parameters that the videoHandlerYUV uses by default (no math)
+  ConversionSettings settings;
+  settings.colorConversion                   = colorConversion;
+  settings.mathParameters[Component::Luma]   = MathParameters(1, 125, false);
+  settings.mathParameters[Component::Chroma] = MathParameters(1, 128, false);
+  return settings;
+}
+
+// Convert lines with every instruction set and compare them to the scalar line conversion
+template <typename T>
+void testLineConversion(const int bitDepth, const ColorConversion colorConversion)
+{
+  std::array<int, 5> RGBConv;
+  getColorConversionCoefficients(colorConversion, RGBConv.data());
+  const auto parameters =
+      simd::getConversionParameters(RGBConv, bitDepth, isFullRange(colorConversion));
+
+  for (const auto width : TEST_WIDTHS)
+  {
+    for (const auto chromaSubsamplingHor : {1, 2})
+    {
+      if (width % chromaSubsamplingHor != 0)
+        continue;
+
+      const auto widthChroma = width / chromaSubsamplingHor;
+      const auto srcY        = createRandomSamples<T>(width, bitDepth);
+      const auto srcU        = createRandomSamples<T>(widthChroma, bitDepth);
+      const auto srcV        = createRandomSamples<T>(widthChroma + 1, bitDepth);
+
+      std::vector<uint8_t> expected(width * 4);
+      simd::convertLineToBGRA(InstructionSet::Scalar,
+                              srcY.data(),
+                              srcU.data(),
+                              srcV.data(),
+                              expected.data(),
+                              width,
+                              chromaSubsamplingHor,
+                              parameters);
+
+      for (const auto instructionSet : ALL_INSTRUCTION_SETS)
+      {
+        if (!simd::isInstructionSetSupported(instructionSet))
+          continue;
+
+        std::vector<uint8_t> dst(width * 4);
+        simd::convertLineToBGRA(instructionSet,
+                                srcY.data(),
+                                srcU.data(),
+                                srcV.data(),
+                                dst.data(),
+                                width,
+                                chromaSubsamplingHor,
+                                parameters);
+        ASSERT_EQ(dst, expected) << simd::getInstructionSetName(instructionSet) << " width "
+                                 << width << " subsampling " << chromaSubsamplingHor;
+      }
+    }
+  }
+}
+
+// Convert whole frames line by line with every instruction set and compare them to the scalar
+// frame conversion functions that are used if the frame is not converted line by line.
+void testFrameConversion(const Subsampling subsampling, const int bitDepth)
+{
+  const auto format = PixelFormatYUV(subsampling, unsigned(bitDepth), PlaneOrder::YUV);
+
+  for (const auto frameSize : {Size(2, 2), Size(16, 4), Size(34, 6), Size(100, 2)})
+  {
+    const auto frame = createRandomFrame(format, frameSize);
+
+    for (const auto colorConversion : ColorConversionMapper.getValues())
+    {
+      const auto settings = createConversionSettings(colorConversion);
+
+      std::vector<uchar> expected(frameSize.width * frameSize.height * 4);
+      ASSERT_TRUE(
+          convertYUVPlanarToRGBScalar(frame, expected.data(), frameSize, format, settings));
+
+      for (const auto instructionSet : ALL_INSTRUCTION_SETS)
+      {
+        if (!simd::isInstructionSetSupported(instructionSet))
+          continue;
+
+        std::vector<uchar> dst(expected.size());
+        ASSERT_TRUE(convertYUVPlanarToRGBLineBased(
+            frame, dst.data(), frameSize, format, settings, instructionSet));
+        ASSERT_EQ(dst, expected) << simd::getInstructionSetName(instructionSet) << " "
+                                 << format.getName() << " " << frameSize.width << "x"
+                                 << frameSize.height << " " << int(colorConversion);
+      }
+    }
+  }
+}
+
+} // namespace
+
+TEST(ConversionYUVSIMDTest, ScalarIsAlwaysSupported)
+{
+  EXPECT_TRUE(simd::isInstructionSetSupported(InstructionSet::Scalar));
+  EXPECT_TRUE(simd::isInstructionSetSupported(simd::getSupportedInstructionSet()));
+}
+
+TEST(ConversionYUVSIMDTest, Convert8BitLineIsBitExact)
+{
+  for (const auto colorConversion : ColorConversionMapper.getValues())
+    testLineConversion<uint8_t>(8, colorConversion);
+}
+
+TEST(ConversionYUVSIMDTest, ConvertHighBitDepthLineIsBitExact)
+{
+  for (const auto bitDepth : {9, 10, 12, 14, 16})
+    for (const auto colorConversion : ColorConversionMapper.getValues())
+      testLineConversion<uint16_t>(bitDepth, colorConversion);
+}
+
+TEST(ConversionYUVSIMDTest, LineBasedFrameConversionMatchesScalarConversion)
+{
+  for (const auto subsampling : {Subsampling::YUV_444, Subsampling::YUV_422, Subsampling::YUV_420})
+    for (const auto bitDepth : {8, 9, 10, 12, 14, 16})
+      testFrameConversion(subsampling, bitDepth);
+}
+
+TEST(ConversionYUVSIMDTest, LineBasedConversionRejectsUnsupportedSettings)
+{
+  const auto format    = PixelFormatYUV(Subsampling::YUV_420, 8, PlaneOrder::YUV);
+  const auto frameSize = Size(16, 4);
+  const auto frame     = createRandomFrame(format, frameSize);
+
+  auto settings                 = createConversionSettings(ColorConversion::BT709_LimitedRange);
+  settings.componentDisplayMode = ComponentDisplayMode::DisplayY;
+
+  std::vector<uchar> dst(frameSize.width * frameSize.height * 4);
+  EXPECT_FALSE(convertYUVPlanarToRGBLineBased(
+      frame, dst.data(), frameSize, format, settings, InstructionSet::Scalar));
+}
+
+} // namespace video::yuv::test
@@ -0,0 +1,209 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/yuv/MetricsYUV.h>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+using simd::InstructionSet;
+
+constexpr auto ALL_INSTRUCTION_SETS = {
+    InstructionSet::Scalar, InstructionSet::SSE4_1, InstructionSet::AVX2};
+
+// A plane with random samples. Lines are padded to test the stride.
+struct TestPlane
+{
+  TestPlane(const int width, const int height, const int bitDepth, const unsigned seed)
+      : width(width), height(height), bitDepth(bitDepth)
+  {
+    this->stride = (width + 3) * this->getBytesPerSample();
+    this->data.resize(this->stride * height);
+
+    std::mt19937                       generator(seed);
+    std::uniform_int_distribution<int> distribution(0, (1 << bitDepth) - 1);
+    for (int y = 0; y < height; y++)
+      for (int x = 0; x < width; x++)
+        this->setSample(x, y, distribution(generator));
+  }
+
+  int getBytesPerSample() const { return (this->bitDepth > 8) ? 2 : 1; }
+
+  int getSample(const int x, const int y) const
+  {
+    const auto src = this->data.data() + y * this->stride + x * this->getBytesPerSample();
+    if (this->bitDepth > 8)
+    {
+      uint16_t value;
+      std::memcpy(&value, src, 2);
+      return value;
+    }
+    return *src;
+  }
+
+  void setSample(const int x, const int y, const int value)
+  {
+    const auto dst = this->data.data() + y * this->stride + x * this->getBytesPerSample();
+    if (this->bitDepth > 8)
+    {
+      const auto value16 = uint16_t(value);
+      std::memcpy(dst, &value16, 2);
+    }
+    else
+      *dst = uint8_t(value);
+  }
+
+  metrics::Plane getPlane() const
+  {
+    return {this->data.data(), this->stride, this->width, this->height, this->bitDepth};
+  }
+
+  int                  width{};
+  int                  height{};
+  int                  bitDepth{};
+  int64_t              stride{};
+  std::vector<uint8_t> data;
+};
+
+uint64_t getSumOfSquaredErrorsReference(const TestPlane &plane0, const TestPlane &plane1)
+{
+  const auto bitDepth = std::max(plane0.bitDepth, plane1.bitDepth);
+  uint64_t   sum      = 0;
+  for (int y = 0; y < std::min(plane0.height, plane1.height); y++)
+  {
+    for (int x = 0; x < std::min(plane0.width, plane1.width); x++)
+    {
+      const int64_t diff = (int64_t(plane0.getSample(x, y)) << (bitDepth - plane0.bitDepth)) -
+                           (int64_t(plane1.getSample(x, y)) << (bitDepth - plane1.bitDepth));
+      sum += uint64_t(diff * diff);
+    }
+  }
+  return sum;
+}
+
+} // namespace
+
+TEST(MetricsYUVTest, SumOfSquaredErrorsMatchesReference)
+{
+  for (const auto bitDepth : {8, 10, 16})
+  {
+    for (const auto width : {1, 7, 8, 16, 17, 33, 100})
+    {
+      const TestPlane plane0(width, 5, bitDepth, width);
+      const TestPlane plane1(width, 5, bitDepth, width + 1000);
+      const auto      expected = getSumOfSquaredErrorsReference(plane0, plane1);
+
+      for (const auto instructionSet : ALL_INSTRUCTION_SETS)
+      {
+        if (!simd::isInstructionSetSupported(instructionSet))
+          continue;
+        EXPECT_EQ(metrics::getSumOfSquaredErrors(
+                      instructionSet, plane0.getPlane(), plane1.getPlane()),
+                  expected)
+            << simd::getInstructionSetName(instructionSet) << " bit depth " << bitDepth
+            << " width " << width;
+      }
+    }
+  }
+}
+
+TEST(MetricsYUVTest, DifferentSizesAndBitDepthsCompareTheOverlappingScaledPart)
+{
+  const TestPlane plane0(20, 10, 8, 1);
+  const TestPlane plane1(16, 12, 10, 2);
+
+  EXPECT_EQ(metrics::getCommonBitDepth(plane0.getPlane(), plane1.getPlane()), 10);
+  EXPECT_EQ(metrics::getSumOfSquaredErrors(
+                simd::getSupportedInstructionSet(), plane0.getPlane(), plane1.getPlane()),
+            getSumOfSquaredErrorsReference(plane0, plane1));
+}
+
+TEST(MetricsYUVTest, IdenticalPlanes)
+{
+  const TestPlane plane(64, 48, 10, 3);
+
+  EXPECT_EQ(metrics::getSumOfSquaredErrors(
+                InstructionSet::Scalar, plane.getPlane(), plane.getPlane()),
+            0u);
+  EXPECT_TRUE(std::isinf(metrics::getPSNR(0.0, 10)));
+  EXPECT_DOUBLE_EQ(metrics::getSSIM(plane.getPlane(), plane.getPlane()), 1.0);
+  EXPECT_DOUBLE_EQ(metrics::getMSSSIM(plane.getPlane(), plane.getPlane()), 1.0);
+}
+
+TEST(MetricsYUVTest, SSIMDecreasesWithDistortion)
+{
+  const TestPlane original(128, 128, 8, 4);
+
+  auto                               slightlyDistorted = original;
+  auto                               stronglyDistorted = original;
+  std::mt19937                       generator(5);
+  std::uniform_int_distribution<int> noise(-20, 20);
+  for (int y = 0; y < original.height; y++)
+  {
+    for (int x = 0; x < original.width; x++)
+    {
+      const auto value = original.getSample(x, y);
+      slightlyDistorted.setSample(x, y, std::clamp(value + noise(generator) / 10, 0, 255));
+      stronglyDistorted.setSample(x, y, std::clamp(value + noise(generator), 0, 255));
+    }
+  }
+
+  const auto ssimSlight   = metrics::getSSIM(original.getPlane(), slightlyDistorted.getPlane());
+  const auto ssimStrong   = metrics::getSSIM(original.getPlane(), stronglyDistorted.getPlane());
+  const auto msssimSlight = metrics::getMSSSIM(original.getPlane(), slightlyDistorted.getPlane());
+  const auto msssimStrong = metrics::getMSSSIM(original.getPlane(), stronglyDistorted.getPlane());
+
+  EXPECT_LT(ssimSlight, 1.0);
+  EXPECT_LT(ssimStrong, ssimSlight);
+  EXPECT_GT(ssimStrong, 0.0);
+  EXPECT_LT(msssimSlight, 1.0);
+  EXPECT_LT(msssimStrong, msssimSlight);
+  EXPECT_GT(msssimStrong, 0.0);
+}
+
+TEST(MetricsYUVTest, SSIMOfTooSmallPlanesIsNaN)
+{
+  const TestPlane plane(7, 16, 8, 6);
+  EXPECT_TRUE(std::isnan(metrics::getSSIM(plane.getPlane(), plane.getPlane())));
+  EXPECT_TRUE(std::isnan(metrics::getMSSSIM(plane.getPlane(), plane.getPlane())));
+}
+
+} // namespace video::yuv::test
@@ -0,0 +1,187 @@
+/*  This file is part of YUView - The YUV player with advanced analytics toolset
+ *   <https://github.com/IENT/YUView>
+ *   Copyright (C) 2015  Institut für Nachrichtentechnik, RWTH Aachen University, GERMANY
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   In addition, as a special exception, the copyright holders give
+ *   permission to link the code of portions of this program with the
+ *   OpenSSL library under certain conditions as described in each
+ *   individual source file, and distribute linked combinations including
+ *   the two.
+ *
+ *   You must obey the GNU General Public License in all respects for all
+ *   of the code used other than OpenSSL. If you modify file(s) with this
+ *   exception, you may extend this exception to your version of the
+ *   file(s), but you are not obligated to do so. If you do not wish to do
+ *   so, delete this exception statement from your version. If you delete
+ *   this exception statement from all source files in the program, then
+ *   also delete it here.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common/Testing.h>
+
+#include <video/yuv/SequenceMetricsYUV.h>
+#include <video/yuv/videoHandlerYUV.h>
+
+#include <QString>
+#include <QTextStream>
+
+#include <cmath>
+#include <vector>
+
+namespace video::yuv::test
+{
+
+namespace
+{
+
+constexpr auto FRAME_SIZE       = Size(16, 16);
+constexpr auto REFERENCE_SAMPLE = 100;
+
+// A 4:2:0 8 bit video in which all samples of frame i have the value sampleValues[i]
+class TestVideo
+{
+public:
+  explicit TestVideo(const std::vector<int> &sampleValues)
+  {
+    this->video.setFrameSize(FRAME_SIZE);
+    this->video.setPixelFormatYUV(PixelFormatYUV(Subsampling::YUV_420, 8));
+
+    const auto bytesPerFrame = this->video.getPixelFormatYUV().bytesPerFrame(FRAME_SIZE);
+    QObject::connect(&this->video,
+                     &videoHandler::signalRequestRawDataForCaching,
+                     [sampleValues, bytesPerFrame](
+                         int frameIndex, RawFrameBuffer &frameOut, bool &success) {
+                       if (frameIndex < 0 || frameIndex >= int(sampleValues.size()))
+                         return;
+                       frameOut = RawFrameBuffer(
+                           QByteArray(int(bytesPerFrame), char(sampleValues[frameIndex])));
+                       success = true;
+                     });
+  }
+
+  videoHandlerYUV video;
+};
+
+double psnr8Bit(const double mse) { return 10 * std::log10(255.0 * 255.0 / mse); }
+
+SequenceMetricsSettings settingsWithoutSSIM()
+{
+  SequenceMetricsSettings settings;
+  settings.calculateSSIM   = false;
+  settings.calculateMSSSIM = false;
+  settings.nrThreads       = 2;
+  return settings;
+}
+
+TEST(SequenceMetricsYUVTest, MetricsOfFramesWithKnownDifferences)
+{
+  // The frames differ by 1, 3 and 2 in every sample so the MSE is 1, 9 and 4
+  TestVideo video0({REFERENCE_SAMPLE, REFERENCE_SAMPLE, REFERENCE_SAMPLE});
+  TestVideo video1({REFERENCE_SAMPLE + 1, REFERENCE_SAMPLE - 3, REFERENCE_SAMPLE + 2});
+
+  const auto result = calculateSequenceMetrics(
+      &video0.video, &video1.video, {0, 2}, 0, settingsWithoutSSIM());
+
+  ASSERT_TRUE(result.error.isEmpty());
+  EXPECT_EQ(result.bitDepth, 8);
+  EXPECT_EQ(result.nrValidFrames, 3);
+  ASSERT_EQ(result.frames.size(), 3u);
+
+  const double expectedMSE[] = {1.0, 9.0, 4.0};
+  for (int frame = 0; frame < 3; frame++)
+  {
+    EXPECT_TRUE(result.frames[frame].valid);
+    EXPECT_EQ(result.frames[frame].frameIndex0, frame);
+    EXPECT_EQ(result.frames[frame].frameIndex1, frame);
+    ASSERT_EQ(result.frames[frame].planes.size(), 3u);
+    for (const auto &plane : result.frames[frame].planes)
+    {
+      EXPECT_DOUBLE_EQ(plane.mse, expectedMSE[frame]);
+      EXPECT_DOUBLE_EQ(plane.psnr, psnr8Bit(expectedMSE[frame]));
+    }
+  }
+
+  ASSERT_EQ(result.average.size(), 3u);
+  ASSERT_EQ(result.psnrOfMeanMSE.size(), 3u);
+  const auto expectedMeanPSNR = (psnr8Bit(1.0) + psnr8Bit(9.0) + psnr8Bit(4.0)) / 3;
+  for (size_t plane = 0; plane < 3; plane++)
+  {
+    EXPECT_DOUBLE_EQ(result.average[plane].mse, 14.0 / 3);
+    EXPECT_DOUBLE_EQ(result.average[plane].psnr, expectedMeanPSNR);
+    EXPECT_DOUBLE_EQ(result.psnrOfMeanMSE[plane], psnr8Bit(14.0 / 3));
+  }
+}
+
+TEST(SequenceMetricsYUVTest, ReferenceFramesStartAtRange1Start)
+{
+  TestVideo video0({REFERENCE_SAMPLE, REFERENCE_SAMPLE});
+  TestVideo video1({0, REFERENCE_SAMPLE + 2, REFERENCE_SAMPLE + 2});
+
+  const auto result = calculateSequenceMetrics(
+      &video0.video, &video1.video, {0, 1}, 1, settingsWithoutSSIM());
+
+  ASSERT_EQ(result.nrValidFrames, 2);
+  EXPECT_EQ(result.frames[0].frameIndex1, 1);
+  EXPECT_EQ(result.frames[1].frameIndex1, 2);
+  EXPECT_DOUBLE_EQ(result.average[0].mse, 4.0);
+}
+
+TEST(SequenceMetricsYUVTest, FramesThatCanNotBeLoadedAreInvalid)
+{
+  TestVideo video0({REFERENCE_SAMPLE, REFERENCE_SAMPLE});
+  TestVideo video1({REFERENCE_SAMPLE + 1});
+
+  const auto result = calculateSequenceMetrics(
+      &video0.video, &video1.video, {0, 1}, 0, settingsWithoutSSIM());
+
+  EXPECT_EQ(result.nrValidFrames, 1);
+  EXPECT_TRUE(result.frames[0].valid);
+  EXPECT_FALSE(result.frames[1].valid);
+  EXPECT_DOUBLE_EQ(result.psnrOfMeanMSE[0], psnr8Bit(1.0));
+}
+
+TEST(SequenceMetricsYUVTest, CSVContainsPSNROfMeanMSE)
+{
+  TestVideo video0({REFERENCE_SAMPLE, REFERENCE_SAMPLE});
+  TestVideo video1({REFERENCE_SAMPLE + 1, REFERENCE_SAMPLE + 3});
+
+  const auto result = calculateSequenceMetrics(
+      &video0.video, &video1.video, {0, 1}, 0, settingsWithoutSSIM());
+
+  QString     csv;
+  QTextStream stream(&csv);
+  result.writeCSV(stream);
+  stream.flush();
+
+  const auto lines = csv.trimmed().split("\n");
+  ASSERT_EQ(lines.size(), 5);
+  EXPECT_TRUE(lines[3].startsWith("Average;"));
+
+  const auto columns = lines[4].split(";");
+  ASSERT_EQ(columns.size(), 2 + 3 * 4);
+  EXPECT_EQ(columns[0], "Average (PSNR of mean MSE)");
+  for (int plane = 0; plane < 3; plane++)
+  {
+    EXPECT_TRUE(columns[2 + plane * 4].isEmpty());
+    EXPECT_NEAR(columns[3 + plane * 4].toDouble(), psnr8Bit(5.0), 1e-4);
+    EXPECT_TRUE(columns[4 + plane * 4].isEmpty());
+    EXPECT_TRUE(columns[5 + plane * 4].isEmpty());
+  }
+}
+
+} // namespace
+
+} // namespace video::yuv::test